@@ -0,0 +1,753 @@
+/**
+ * @file OrientaBench.cpp
+ * @brief Benchmarki gorących ścieżek aplikacji "Orienta" (target `wds_Orienta_bench`).
+ * @details Grupy benchmarków:
+ * - ramki: CRC-16, wydzielanie linii, parsowanie CSV (`FrameParser`);
+ * - odbiór: UDP i TCP przez `NetworkFrameSource` na interfejsie pętli zwrotnej;
+ * - pamięć współdzielona: zapis, odczyt i przekazanie do innego procesu (`SharedFrameRing`);
+ * - orientacja: `AhrsFusion` (Madgwick, Mahony), `HeadingEstimator`, `GyroBiasEstimator`;
+ * - analiza: `FilterBank`, `RollingStatistics`, `EventDetector`, `Fft`, `AllanDeviation`;
+ * - widoki: `ImuDataHandler` oraz renderowanie poza ekranem `SensorGraph`, `Compass2DRenderer` i pasków IMU.
+ *
+ * Danymi wejściowymi są dołączone pliki `simulation_data*.log`, z których budowane są ramki
+ * `CSV*CRC16\r\n` w formacie portu szeregowego.
+ *
+ * Wyniki są zapisywane w formacie JSON (domyślnie) lub CSV, aby można je było porównywać
+ * między kompilacjami, np.:
+ * @code
+ * wds_Orienta_bench --format json --output before.json
+ * wds_Orienta_bench --format csv --repetitions 10 --data simulation_data3.log
+ * @endcode
+ * Domyślnie używana jest platforma `offscreen` (można ją zmienić opcją `-platform`).
+ * @author Mateusz Wojtaszek
+ * @date 2025-05-30
+ * @bug Brak znanych błędów.
+ */
+
+#include "FrameParser.h"
+#include "ImuDataHandler.h"
+#include "SensorGraph.h"
+#include "Compass2DRenderer.h"
+#include "NetworkFrameSource.h"
+#include "SharedFrameRing.h"
+#include "AhrsFusion.h"
+#include "HeadingEstimator.h"
+#include "GyroBiasEstimator.h"
+#include "FilterBank.h"
+#include "Fft.h"
+#include "RollingStatistics.h"
+#include "EventDetector.h"
+#include "AllanDeviation.h"
+#include "SimdSupport.h"
+#include "LatencyTracer.h"
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QImage>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLayout>
+#include <QPainter>
+#include <QProcess>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTemporaryFile>
+#include <QTextStream>
+#include <QUdpSocket>
+#include <QDebug>
+#include <algorithm>
+#include <utility>
+#include <cstdio>
+#include <cstring>
+
+constexpr int IMU_VALUE_COUNT_BENCH = 12;
+constexpr int SERIAL_VALUE_COUNT_BENCH = 14;
+constexpr int CHUNK_SIZE_BYTES_BENCH = 64; // Typowa porcja danych z readyRead przy 115200 bd
+constexpr int DEFAULT_REPETITIONS_BENCH = 5;
+constexpr int DEFAULT_RENDER_FRAMES_BENCH = 200;
+constexpr qint64 FRAME_PERIOD_NS_BENCH = 10000000; // Syntetyczny czas odbioru ramek - 100 Hz
+constexpr int UDP_BATCH_DATAGRAMS_BENCH = 256; // Datagramy wysyłane przed oczekiwaniem na odbiór (bufor gniazda)
+constexpr int NETWORK_TIMEOUT_MS_BENCH = 2000; // Limit oczekiwania na ramki (np. datagramy odrzucone przez jądro)
+constexpr quint64 SHM_HANDOFF_FRAMES_BENCH = 100000; // Ramki przekazywane do procesu czytelnika
+constexpr qint64 SHM_HANDOFF_PERIOD_NS_BENCH = 5000; // Odstęp ramek - czytelnik zdąży odczytać każdą
+constexpr qint64 SHM_READER_TIMEOUT_NS_BENCH = 10000000000; // Limit pracy procesu czytelnika
+constexpr int SHM_READER_START_TIMEOUT_MS_BENCH = 5000;
+const QByteArray GPS_SUFFIX_BENCH = ",51.107900,17.059500"; // Stała pozycja GPS dołączana do ramek IMU
+
+/**
+ * @brief Wynik jednego benchmarku.
+ */
+struct BenchResult {
+    QString name; //!< Nazwa benchmarku.
+    qint64 itemsPerRun = 0; //!< Liczba elementów (linii, ramek, klatek) w jednym powtórzeniu.
+    int repetitions = 0; //!< Liczba mierzonych powtórzeń.
+    double minNsPerItem = 0.0; //!< Najlepszy czas na element [ns].
+    double medianNsPerItem = 0.0; //!< Mediana czasu na element [ns].
+    double itemsPerSecond = 0.0; //!< Przepustowość wyliczona z mediany.
+};
+
+/**
+ * @brief Dane wejściowe benchmarków zbudowane z plików symulacyjnych.
+ */
+struct BenchData {
+    QVector<QVector<float>> imuFrames; //!< Ramki IMU (12 wartości).
+    QList<QByteArray> payloads; //!< Ładunki CSV (14 wartości) bez sumy kontrolnej.
+    QList<QByteArray> lines; //!< Pełne linie `CSV*CRC16` bez końca linii.
+    QByteArray stream; //!< Strumień bajtów jak z portu szeregowego (`CSV*CRC16\r\n`).
+};
+
+/**
+ * @brief Wczytuje pliki symulacyjne i buduje z nich ramki w formacie portu szeregowego.
+ */
+static BenchData loadBenchData(const QStringList &dataFiles) {
+    BenchData data;
+    for (const QString &path: dataFiles) {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            qWarning() << "Failed to open benchmark data file:" << path << "Error:" << file.errorString();
+            continue;
+        }
+        while (!file.atEnd()) {
+            const QByteArray line = file.readLine().trimmed();
+            if (line.isEmpty() || line.startsWith('#')) {
+                continue;
+            }
+            QVector<float> frame;
+            if (FrameParser::parseCsv(line, IMU_VALUE_COUNT_BENCH, frame) != FrameParser::Status::Ok) {
+                continue;
+            }
+            const QByteArray payload = line + GPS_SUFFIX_BENCH;
+            const QByteArray crcHex = QByteArray::number(FrameParser::calculateCrc16(payload), 16)
+                    .toUpper().rightJustified(4, '0');
+            const QByteArray serialLine = payload + '*' + crcHex;
+            data.imuFrames.append(frame);
+            data.payloads.append(payload);
+            data.lines.append(serialLine);
+            data.stream += serialLine + "\r\n";
+        }
+    }
+    return data;
+}
+
+/**
+ * @brief Uruchamia benchmark: jedno powtórzenie rozgrzewkowe i `repetitions` mierzonych.
+ * @param name [in] Nazwa benchmarku.
+ * @param itemsPerRun [in] Liczba elementów przetwarzanych przez jedno wywołanie `run`.
+ * @param repetitions [in] Liczba mierzonych powtórzeń.
+ * @param run [in] Funkcja wykonująca jedno powtórzenie.
+ */
+template<typename Run>
+static BenchResult runBenchmark(const QString &name, qint64 itemsPerRun, int repetitions, Run &&run) {
+    run(); // Rozgrzewka (pamięć podręczna, alokacje, leniwa inicjalizacja Qt)
+
+    QVector<double> nsPerItem;
+    nsPerItem.reserve(repetitions);
+    QElapsedTimer timer;
+    for (int i = 0; i < repetitions; ++i) {
+        timer.start();
+        run();
+        nsPerItem.append(static_cast<double>(timer.nsecsElapsed()) / qMax<qint64>(1, itemsPerRun));
+    }
+    std::sort(nsPerItem.begin(), nsPerItem.end());
+
+    BenchResult result;
+    result.name = name;
+    result.itemsPerRun = itemsPerRun;
+    result.repetitions = repetitions;
+    result.minNsPerItem = nsPerItem.first();
+    result.medianNsPerItem = nsPerItem[nsPerItem.size() / 2];
+    result.itemsPerSecond = result.medianNsPerItem > 0.0 ? 1.0e9 / result.medianNsPerItem : 0.0;
+    qInfo().noquote() << QStringLiteral("%1: median %2 ns/item, min %3 ns/item")
+            .arg(name, -28)
+            .arg(result.medianNsPerItem, 0, 'f', 1)
+            .arg(result.minNsPerItem, 0, 'f', 1);
+    return result;
+}
+
+/**
+ * @brief Renderuje widget do obrazu w pamięci (bez wyświetlania na ekranie).
+ */
+static void renderOffscreen(QWidget &widget, QImage &target) {
+    target.fill(Qt::white);
+    QPainter painter(&target);
+    widget.render(&painter);
+}
+
+/**
+ * @brief Przetwarza zdarzenia, dopóki licznik odebranych ramek nie osiągnie `expected` (lub upłynie limit).
+ * @return `true`, jeśli odebrano wszystkie ramki.
+ */
+static bool waitForFrames(const quint64 &received, quint64 expected) {
+    QElapsedTimer timeout;
+    timeout.start();
+    while (received < expected) {
+        if (timeout.elapsed() > NETWORK_TIMEOUT_MS_BENCH) {
+            return false;
+        }
+        QCoreApplication::processEvents(QEventLoop::AllEvents);
+    }
+    return true;
+}
+
+/**
+ * @brief Benchmarki odbioru z sieci: nadawca i `NetworkFrameSource` w tym samym procesie, przez pętlę zwrotną.
+ * @details Wynik obejmuje pełną ścieżkę: gniazdo, pętlę zdarzeń Qt, wydzielanie linii, CRC i CSV -
+ * `items_per_second` to pakiety (UDP) lub ramki (TCP) na sekundę.
+ */
+static void runNetworkBenchmarks(const BenchData &data, int repetitions, QList<BenchResult> &results) {
+    const qint64 lineCount = data.lines.size();
+    quint64 framesReceived = 0;
+    quint64 incompleteRuns = 0;
+
+    NetworkFrameSource udpSource;
+    if (udpSource.openUdp(QHostAddress::LocalHost, 0)) {
+        QObject::connect(&udpSource, &FrameSource::frameReceived, [&framesReceived](const SensorFrame &) {
+            ++framesReceived;
+        });
+        QUdpSocket sender;
+        const quint16 port = udpSource.localPort();
+        results << runBenchmark(QStringLiteral("udp_ingest_loopback"), lineCount, repetitions, [&] {
+            quint64 expected = framesReceived;
+            for (qsizetype first = 0; first < data.lines.size(); first += UDP_BATCH_DATAGRAMS_BENCH) {
+                const qsizetype last = qMin<qsizetype>(first + UDP_BATCH_DATAGRAMS_BENCH, data.lines.size());
+                for (qsizetype i = first; i < last; ++i) {
+                    sender.writeDatagram(data.lines[i], QHostAddress::LocalHost, port); // Koniec linii dopisuje odbiorca
+                }
+                expected += static_cast<quint64>(last - first);
+                if (!waitForFrames(framesReceived, expected)) {
+                    ++incompleteRuns;
+                    framesReceived = expected; // Utracone datagramy nie blokują kolejnych paczek
+                }
+            }
+        });
+    } else {
+        qWarning() << "udp_ingest_loopback skipped:" << udpSource.getLastError();
+    }
+
+    QTcpServer server;
+    NetworkFrameSource tcpSource;
+    if (server.listen(QHostAddress::LocalHost, 0) &&
+        tcpSource.openTcp(QStringLiteral("127.0.0.1"), server.serverPort()) &&
+        server.waitForNewConnection(NETWORK_TIMEOUT_MS_BENCH)) {
+        QTcpSocket *sender = server.nextPendingConnection();
+        QObject::connect(&tcpSource, &FrameSource::frameReceived, [&framesReceived](const SensorFrame &) {
+            ++framesReceived;
+        });
+        results << runBenchmark(QStringLiteral("tcp_ingest_loopback"), lineCount, repetitions, [&] {
+            const quint64 expected = framesReceived + static_cast<quint64>(lineCount);
+            sender->write(data.stream);
+            if (!waitForFrames(framesReceived, expected)) {
+                ++incompleteRuns;
+                framesReceived = expected;
+            }
+        });
+    } else {
+        qWarning() << "tcp_ingest_loopback skipped:" << (server.isListening() ? tcpSource.getLastError()
+                                                                                 : server.errorString());
+    }
+
+    if (incompleteRuns > 0) {
+        qWarning() << "Network benchmarks:" << incompleteRuns
+                   << "batch(es) timed out waiting for frames - results include the timeout.";
+    }
+}
+
+/**
+ * @brief Proces czytelnika benchmarku `shm_ring_handoff_cross_process` (uruchamiany przez `--shm-reader`).
+ * @details Dołącza do segmentu, zgłasza gotowość (`ready`) i aktywnie odpytuje bufor do odebrania
+ * `frames` ramek. Na standardowe wyjście wypisuje: min, medianę, p99 i maksimum opóźnienia przekazania [ns]
+ * oraz liczbę ramek odebranych i utraconych. Zegar `LatencyTracer::nowNs()` jest monotoniczny
+ * i wspólny dla procesów, więc opóźnienie liczone jest bezpośrednio z czasu zapisu w slocie.
+ * @return Kod wyjścia procesu.
+ */
+static int runSharedMemoryReader(const QString &name, quint64 frames) {
+    SharedFrameRing ring;
+    QString errorString;
+    if (!ring.attach(name, &errorString)) {
+        std::fprintf(stderr, "Cannot attach to %s: %s\n", qPrintable(name), qPrintable(errorString));
+        return 1;
+    }
+    QVector<qint64> latencies;
+    latencies.reserve(static_cast<qsizetype>(frames));
+    quint64 cursor = ring.writeIndex();
+    quint64 lost = 0;
+    quint64 lostNow = 0;
+    qint64 publishedNs = 0;
+    SensorFrame frame;
+    std::printf("ready\n");
+    std::fflush(stdout);
+
+    const qint64 deadlineNs = LatencyTracer::nowNs() + SHM_READER_TIMEOUT_NS_BENCH;
+    while (static_cast<quint64>(latencies.size()) + lost < frames) {
+        if (ring.read(cursor, frame, lostNow, &publishedNs)) {
+            latencies.append(LatencyTracer::nowNs() - publishedNs);
+            lost += lostNow;
+        } else if (LatencyTracer::nowNs() > deadlineNs) {
+            break;
+        }
+    }
+    if (latencies.isEmpty()) {
+        std::fprintf(stderr, "No frames received from %s\n", qPrintable(name));
+        return 1;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    std::printf("%lld %lld %lld %lld %lld %llu\n",
+                static_cast<long long>(latencies.first()),
+                static_cast<long long>(latencies[latencies.size() / 2]),
+                static_cast<long long>(latencies[latencies.size() * 99 / 100]),
+                static_cast<long long>(latencies.last()),
+                static_cast<long long>(latencies.size()),
+                static_cast<unsigned long long>(lost));
+    return 0;
+}
+
+/**
+ * @brief Benchmarki bufora w pamięci współdzielonej: koszt zapisu i odczytu ramki oraz opóźnienie
+ * przekazania ramki do osobnego procesu.
+ * @details W `shm_ring_handoff_cross_process` pola `min`/`median` to opóźnienie przekazania jednej ramki
+ * (od zapisu do odczytu w drugim procesie), a nie czas przetwarzania; p99 jest wypisywane w logu.
+ * Pomiar wymaga co najmniej dwóch wolnych rdzeni (pisarz i czytelnik aktywnie czekają).
+ */
+static void runSharedMemoryBenchmarks(const BenchData &data, int repetitions, QList<BenchResult> &results) {
+    const QString name = QStringLiteral("/orienta-bench-%1").arg(QCoreApplication::applicationPid());
+    QVector<SensorFrame> frames;
+    frames.reserve(data.imuFrames.size());
+    for (const QVector<float> &values: data.imuFrames) {
+        SensorFrame frame;
+        frame.values = values;
+        frame.values << 51.1079f << 17.0595f;
+        frame.deviceId = 1;
+        frames.append(frame);
+    }
+    const qint64 frameCount = frames.size();
+
+    SharedFrameRing writer;
+    QString errorString;
+    if (!writer.create(name, static_cast<quint32>(frameCount), &errorString)) {
+        qWarning() << "Shared memory benchmarks skipped:" << errorString;
+        return;
+    }
+    results << runBenchmark(QStringLiteral("shm_ring_publish"), frameCount, repetitions, [&] {
+        for (const SensorFrame &frame: frames) {
+            writer.publish(frame);
+        }
+    });
+
+    SharedFrameRing reader;
+    if (reader.attach(name, &errorString)) {
+        volatile quint32 sink = 0;
+        results << runBenchmark(QStringLiteral("shm_ring_read"), frameCount, repetitions, [&] {
+            quint64 cursor = reader.writeIndex() - static_cast<quint64>(frameCount); // Ostatnie okrążenie bufora
+            quint64 lost = 0;
+            SensorFrame frame;
+            quint32 read = 0;
+            while (reader.read(cursor, frame, lost)) {
+                ++read;
+            }
+            sink = sink + read;
+        });
+        reader.close();
+    } else {
+        qWarning() << "shm_ring_read skipped:" << errorString;
+    }
+
+    QProcess readerProcess;
+    readerProcess.start(QCoreApplication::applicationFilePath(),
+                        {QStringLiteral("--shm-reader"), name,
+                         QStringLiteral("--shm-frames"), QString::number(SHM_HANDOFF_FRAMES_BENCH)});
+    if (!readerProcess.waitForReadyRead(SHM_READER_START_TIMEOUT_MS_BENCH) ||
+        !readerProcess.readLine().startsWith("ready")) {
+        qWarning() << "shm_ring_handoff_cross_process skipped: reader process did not start."
+                   << readerProcess.readAllStandardError();
+        readerProcess.kill();
+        readerProcess.waitForFinished();
+        return;
+    }
+    qint64 nextNs = LatencyTracer::nowNs();
+    for (quint64 i = 0; i < SHM_HANDOFF_FRAMES_BENCH; ++i) {
+        while (LatencyTracer::nowNs() < nextNs) {
+            // Aktywne oczekiwanie - uśpienie wątku zaburzyłoby odstęp rzędu mikrosekund
+        }
+        writer.publish(frames[static_cast<qsizetype>(i % static_cast<quint64>(frameCount))]);
+        nextNs += SHM_HANDOFF_PERIOD_NS_BENCH;
+    }
+    readerProcess.waitForFinished(static_cast<int>(SHM_READER_TIMEOUT_NS_BENCH / 1000000));
+    const QList<QByteArray> fields = readerProcess.readAllStandardOutput().trimmed().split(' ');
+    if (readerProcess.exitCode() != 0 || fields.size() != 6) {
+        qWarning() << "shm_ring_handoff_cross_process failed:" << readerProcess.readAllStandardError();
+        return;
+    }
+    BenchResult result;
+    result.name = QStringLiteral("shm_ring_handoff_cross_process");
+    result.itemsPerRun = fields[4].toLongLong();
+    result.repetitions = 1;
+    result.minNsPerItem = fields[0].toDouble();
+    result.medianNsPerItem = fields[1].toDouble();
+    result.itemsPerSecond = result.medianNsPerItem > 0.0 ? 1.0e9 / result.medianNsPerItem : 0.0;
+    qInfo().noquote() << QStringLiteral("%1: median %2 ns, min %3 ns, p99 %4 ns, max %5 ns, lost %6")
+            .arg(result.name, -28)
+            .arg(result.medianNsPerItem, 0, 'f', 1)
+            .arg(result.minNsPerItem, 0, 'f', 1)
+            .arg(QString::fromLatin1(fields[2]), QString::fromLatin1(fields[3]), QString::fromLatin1(fields[5]));
+    results << result;
+}
+
+/**
+ * @brief Benchmarki fuzji orientacji (`AhrsFusion::updateBatch()` dla paczek ramek jak z `DeviceManager`)
+ * i kursu kompasu z kompensacją przechyłu (`HeadingEstimator`).
+ * @details Nazwa zestawu instrukcji jądra wektorowego (`SimdFloat4::backendName()`) jest wypisywana w logu,
+ * aby porównać wyniki kompilacji z `ORIENTA_FORCE_SCALAR_SIMD` i bez.
+ */
+static void runAhrsBenchmarks(const BenchData &data, int repetitions, QList<BenchResult> &results) {
+    constexpr int batchFrames = 8; // Ok. 4 ms przy 2 kHz - typowa paczka sygnału framesReady
+    QVector<const float *> inputs;
+    QVector<qint64> timestampsNs;
+    inputs.reserve(data.imuFrames.size());
+    timestampsNs.reserve(data.imuFrames.size());
+    for (const QVector<float> &frame: data.imuFrames) {
+        inputs.append(frame.constData());
+        timestampsNs.append(timestampsNs.isEmpty() ? 0 : timestampsNs.last() + FRAME_PERIOD_NS_BENCH);
+    }
+    const int frameCount = static_cast<int>(inputs.size());
+    QVector<AhrsFusion::EulerAngles> angles(frameCount);
+    qInfo() << "AHRS vector kernel:" << SimdFloat4::backendName();
+
+    for (const auto &[name, algorithm]: {std::pair{QStringLiteral("ahrs_madgwick_batch"), AhrsFusion::Algorithm::Madgwick},
+                                         std::pair{QStringLiteral("ahrs_mahony_batch"), AhrsFusion::Algorithm::Mahony}}) {
+        AhrsFusion fusion(algorithm);
+        results << runBenchmark(name, frameCount, repetitions, [&] {
+            fusion.reset();
+            for (int first = 0; first < frameCount; first += batchFrames) {
+                const int count = qMin(batchFrames, frameCount - first);
+                fusion.updateBatch(inputs.constData() + first, timestampsNs.constData() + first, count,
+                                   angles.data() + first);
+            }
+        });
+    }
+
+    // Kurs kompasu: ramka po ramce (ścieżka na żywo) i całe nagranie naraz (wczytanie do odtwarzania)
+    QVector<float> headings(frameCount);
+    results << runBenchmark(QStringLiteral("heading_tilt_scalar"), frameCount, repetitions, [&] {
+        for (int i = 0; i < frameCount; ++i) {
+            headings[i] = HeadingEstimator::magneticHeading(inputs[i]);
+        }
+    });
+    HeadingEstimator headingEstimator;
+    results << runBenchmark(QStringLiteral("heading_tilt_batch"), frameCount, repetitions, [&] {
+        headingEstimator.magneticHeadings(inputs.constData(), frameCount, headings.data());
+    });
+
+    // Detektor spoczynku i bias żyroskopu: ramka po ramce, jak w MainWindow::prepareImuBatch()
+    GyroBiasEstimator gyroBias;
+    float gyro[3];
+    results << runBenchmark(QStringLiteral("gyro_bias_update"), frameCount, repetitions, [&] {
+        gyroBias.reset();
+        for (int i = 0; i < frameCount; ++i) {
+            gyroBias.addSample(inputs[i]);
+            std::copy(inputs[i], inputs[i] + 3, gyro);
+            gyroBias.apply(gyro);
+        }
+    });
+
+    // Filtry kanałów IMU (górno-, dolnoprzepustowy, notch, średnia) - jednostka: próbka kanału
+    FilterBank filterBank;
+    FilterBank::Stage highPass{FilterBank::StageType::HighPass, 0.5f, 0.7071f, 1};
+    FilterBank::Stage notch{FilterBank::StageType::Notch, 25.0f, 5.0f, 1};
+    FilterBank::Stage lowPass{FilterBank::StageType::LowPass, 20.0f, 0.7071f, 1};
+    FilterBank::Stage average{FilterBank::StageType::MovingAverage, 0.0f, 0.0f, 8};
+    filterBank.configure({highPass, notch, lowPass, average}, 1.0e9f / FRAME_PERIOD_NS_BENCH);
+    QVector<float> filtered(frameCount * FilterBank::FRAME_STRIDE);
+    QVector<float *> filterOutputs(frameCount);
+    for (int i = 0; i < frameCount; ++i) {
+        filterOutputs[i] = filtered.data() + i * FilterBank::FRAME_STRIDE;
+    }
+    results << runBenchmark(QStringLiteral("filter_bank_batch"), static_cast<qint64>(frameCount) * FilterBank::CHANNELS,
+                            repetitions, [&] {
+        filterBank.reset();
+        for (int first = 0; first < frameCount; first += batchFrames) {
+            filterBank.process(inputs.constData() + first, filterOutputs.constData() + first,
+                               qMin(batchFrames, frameCount - first));
+        }
+    });
+
+    // Statystyki 12 kanałów w oknie 5 s (Welford + kolejki monotoniczne) - jednostka: ramka
+    RollingStatistics statistics;
+    results << runBenchmark(QStringLiteral("rolling_statistics_update"), frameCount, repetitions, [&] {
+        statistics.reset();
+        for (int i = 0; i < frameCount; ++i) {
+            statistics.addFrame(inputs[i], timestampsNs[i]);
+        }
+    });
+
+    // Detektory zdarzeń (próg, pochodna, energia z histerezą) w paczkach jak na żywo - jednostka: ramka
+    EventDetector eventDetector;
+    results << runBenchmark(QStringLiteral("event_detector_batch"), frameCount, repetitions, [&] {
+        eventDetector.reset();
+        for (int first = 0; first < frameCount; first += batchFrames) {
+            eventDetector.process(inputs.constData() + first, timestampsNs.constData() + first,
+                                  qMin(batchFrames, frameCount - first));
+        }
+    });
+
+    // Widmo akcelerometru X jak w SpectrumAnalyzer (okno 512, nakładanie 75%) - jednostka: jedna transformata
+    constexpr int fftSize = 512;
+    constexpr int fftHop = fftSize / 4;
+    const int windowCount = frameCount >= fftSize ? (frameCount - fftSize) / fftHop + 1 : 0;
+    if (windowCount > 0) {
+        const Fft fft(fftSize);
+        QVector<float> re(fftSize);
+        QVector<float> im(fftSize);
+        results << runBenchmark(QStringLiteral("fft_spectrum_512"), windowCount, repetitions, [&] {
+            for (int window = 0; window < windowCount; ++window) {
+                for (int i = 0; i < fftSize; ++i) {
+                    re[i] = inputs[window * fftHop + i][3];
+                }
+                std::fill(im.begin(), im.end(), 0.0f);
+                fft.forward(re.data(), im.data());
+            }
+        });
+    }
+
+    // Odchylenie Allana całego nagrania (odczyt porcjami + pula wątków) - jednostka: ramka pliku
+    QTemporaryFile recording;
+    if (frameCount > 0 && recording.open()) {
+        QTextStream out(&recording);
+        for (const QVector<float> &frame: data.imuFrames) {
+            for (int i = 0; i < frame.size(); ++i) {
+                out << (i > 0 ? "," : "") << frame[i];
+            }
+            out << '\n';
+        }
+        out.flush();
+        recording.close();
+        AllanDeviation::Result allanResult;
+        results << runBenchmark(QStringLiteral("allan_deviation_file"), frameCount, repetitions, [&] {
+            AllanDeviation::analyzeFile(recording.fileName(), allanResult);
+        });
+    }
+}
+
+static QList<BenchResult> runAll(const BenchData &data, int repetitions, int renderFrames) {
+    QList<BenchResult> results;
+    const qint64 lineCount = data.lines.size();
+    volatile quint32 sink = 0; // Zapobiega usunięciu obliczeń przez optymalizator
+
+    // --- Ścieżka odbioru danych ---
+    results << runBenchmark(QStringLiteral("crc16"), lineCount, repetitions, [&] {
+        quint32 accumulator = 0;
+        for (const QByteArray &payload: data.payloads) {
+            accumulator += FrameParser::calculateCrc16(payload);
+        }
+        sink = sink + accumulator;
+    });
+
+    results << runBenchmark(QStringLiteral("line_framing"), lineCount, repetitions, [&] {
+        FrameParser parser;
+        QByteArray line;
+        quint32 lines = 0;
+        for (qsizetype offset = 0; offset < data.stream.size(); offset += CHUNK_SIZE_BYTES_BENCH) {
+            parser.append(data.stream.mid(offset, CHUNK_SIZE_BYTES_BENCH));
+            while (parser.takeLine(line)) {
+                ++lines;
+            }
+        }
+        sink = sink + lines;
+    });
+
+    results << runBenchmark(QStringLiteral("csv_parse"), lineCount, repetitions, [&] {
+        QVector<float> values;
+        quint32 parsed = 0;
+        for (const QByteArray &payload: data.payloads) {
+            parsed += FrameParser::parseCsv(payload, SERIAL_VALUE_COUNT_BENCH, values) == FrameParser::Status::Ok;
+        }
+        sink = sink + parsed;
+    });
+
+    results << runBenchmark(QStringLiteral("verify_and_parse_line"), lineCount, repetitions, [&] {
+        FrameParser::CrcCheck check;
+        QVector<float> values;
+        quint32 parsed = 0;
+        for (const QByteArray &line: data.lines) {
+            if (FrameParser::verifyCrc(line, check) == FrameParser::Status::Ok) {
+                parsed += FrameParser::parseCsv(check.payload, SERIAL_VALUE_COUNT_BENCH, values) ==
+                          FrameParser::Status::Ok;
+            }
+        }
+        sink = sink + parsed;
+    });
+
+    runNetworkBenchmarks(data, repetitions, results);
+    runSharedMemoryBenchmarks(data, repetitions, results);
+    runAhrsBenchmarks(data, repetitions, results);
+
+    // --- Aktualizacja widoków (bez odrysowania) ---
+    ImuDataHandler imuHandler;
+    imuHandler.resize(1280, 720);
+    if (imuHandler.layout()) {
+        imuHandler.layout()->activate();
+    }
+    qint64 frameTimeNs = 0;
+    results << runBenchmark(QStringLiteral("process_imu_frame"), data.imuFrames.size(), repetitions, [&] {
+        for (const QVector<float> &frame: data.imuFrames) {
+            imuHandler.processFrame(frame, frameTimeNs += FRAME_PERIOD_NS_BENCH);
+        }
+    });
+
+    // --- Renderowanie poza ekranem ---
+    const int frameCount = qMin<int>(renderFrames, data.imuFrames.size());
+
+    SensorGraph graph(QStringLiteral("Accelerometer Data"), -4000, 4000);
+    graph.resize(640, 360);
+    QImage graphImage(graph.size(), QImage::Format_ARGB32_Premultiplied);
+    results << runBenchmark(QStringLiteral("render_sensor_graph"), frameCount, repetitions, [&] {
+        for (int i = 0; i < frameCount; ++i) {
+            const QVector<float> &frame = data.imuFrames[i];
+            graph.addData({static_cast<int>(frame[3]), static_cast<int>(frame[4]), static_cast<int>(frame[5])},
+                          frameTimeNs += FRAME_PERIOD_NS_BENCH);
+            renderOffscreen(graph, graphImage);
+        }
+    });
+
+    Compass2DRenderer compass;
+    compass.resize(300, 300);
+    QImage compassImage(compass.size(), QImage::Format_ARGB32_Premultiplied);
+    results << runBenchmark(QStringLiteral("render_compass"), frameCount, repetitions, [&] {
+        for (int i = 0; i < frameCount; ++i) {
+            compass.setHeading(static_cast<float>(i % 360));
+            renderOffscreen(compass, compassImage);
+        }
+    });
+
+    imuHandler.showCurrentData();
+    QImage barImage(imuHandler.size(), QImage::Format_ARGB32_Premultiplied);
+    results << runBenchmark(QStringLiteral("render_imu_bar_view"), frameCount, repetitions, [&] {
+        for (int i = 0; i < frameCount; ++i) {
+            imuHandler.processFrame(data.imuFrames[i], frameTimeNs += FRAME_PERIOD_NS_BENCH);
+            renderOffscreen(imuHandler, barImage);
+        }
+    });
+
+    return results;
+}
+
+static QByteArray resultsToJson(const QList<BenchResult> &results, const QStringList &dataFiles, qint64 lineCount) {
+    QJsonArray resultArray;
+    for (const BenchResult &result: results) {
+        resultArray.append(QJsonObject{
+            {QStringLiteral("name"), result.name},
+            {QStringLiteral("items_per_run"), result.itemsPerRun},
+            {QStringLiteral("repetitions"), result.repetitions},
+            {QStringLiteral("min_ns_per_item"), result.minNsPerItem},
+            {QStringLiteral("median_ns_per_item"), result.medianNsPerItem},
+            {QStringLiteral("items_per_second"), result.itemsPerSecond},
+        });
+    }
+    const QJsonObject root{
+        {QStringLiteral("suite"), QStringLiteral("wds_Orienta_bench")},
+        {QStringLiteral("qt_version"), QString::fromLatin1(qVersion())},
+        {QStringLiteral("platform"), QGuiApplication::platformName()},
+        {QStringLiteral("timestamp"), QDateTime::currentDateTimeUtc().toString(Qt::ISODate)},
+        {QStringLiteral("data_files"), QJsonArray::fromStringList(dataFiles)},
+        {QStringLiteral("data_lines"), lineCount},
+        {QStringLiteral("results"), resultArray},
+    };
+    return QJsonDocument(root).toJson(QJsonDocument::Indented);
+}
+
+static QByteArray resultsToCsv(const QList<BenchResult> &results) {
+    QByteArray csv = "name,items_per_run,repetitions,min_ns_per_item,median_ns_per_item,items_per_second\n";
+    for (const BenchResult &result: results) {
+        csv += QStringLiteral("%1,%2,%3,%4,%5,%6\n")
+                .arg(result.name)
+                .arg(result.itemsPerRun)
+                .arg(result.repetitions)
+                .arg(result.minNsPerItem, 0, 'f', 2)
+                .arg(result.medianNsPerItem, 0, 'f', 2)
+                .arg(result.itemsPerSecond, 0, 'f', 1)
+                .toUtf8();
+    }
+    return csv;
+}
+
+int main(int argc, char *argv[]) {
+    // Proces czytelnika benchmarku pamięci współdzielonej - bez QApplication, aby nie zaburzać pomiaru
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], "--shm-reader") == 0) {
+            quint64 frames = SHM_HANDOFF_FRAMES_BENCH;
+            for (int j = 1; j + 1 < argc; ++j) {
+                if (std::strcmp(argv[j], "--shm-frames") == 0) {
+                    frames = QByteArray(argv[j + 1]).toULongLong();
+                }
+            }
+            return runSharedMemoryReader(QString::fromLocal8Bit(argv[i + 1]), frames);
+        }
+    }
+
+    // Renderowanie bez ekranu, o ile nie wybrano innej platformy
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+    app.setApplicationName("wds_Orienta_bench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Orienta hot-path benchmarks"));
+    parser.addHelpOption();
+    const QCommandLineOption formatOption(QStringLiteral("format"), QStringLiteral("Output format: json or csv."),
+                                          QStringLiteral("format"), QStringLiteral("json"));
+    const QCommandLineOption outputOption(QStringLiteral("output"),
+                                          QStringLiteral("Output file (standard output if omitted)."),
+                                          QStringLiteral("file"));
+    const QCommandLineOption repetitionsOption(QStringLiteral("repetitions"),
+                                               QStringLiteral("Measured repetitions per benchmark."),
+                                               QStringLiteral("count"),
+                                               QString::number(DEFAULT_REPETITIONS_BENCH));
+    const QCommandLineOption renderFramesOption(QStringLiteral("render-frames"),
+                                                QStringLiteral("Frames rendered per repetition."),
+                                                QStringLiteral("count"),
+                                                QString::number(DEFAULT_RENDER_FRAMES_BENCH));
+    const QCommandLineOption dataOption(QStringLiteral("data"),
+                                        QStringLiteral("Simulation log file (may be repeated)."),
+                                        QStringLiteral("file"));
+    parser.addOptions({formatOption, outputOption, repetitionsOption, renderFramesOption, dataOption});
+    parser.process(app);
+
+    QStringList dataFiles = parser.values(dataOption);
+    if (dataFiles.isEmpty()) {
+        const QDir sourceDir(QStringLiteral(ORIENTA_SOURCE_DIR));
+        for (const QString &fileName: sourceDir.entryList({QStringLiteral("simulation_data*.log")}, QDir::Files)) {
+            dataFiles << sourceDir.filePath(fileName);
+        }
+    }
+
+    const BenchData data = loadBenchData(dataFiles);
+    if (data.lines.isEmpty()) {
+        qCritical() << "No benchmark data loaded from" << dataFiles;
+        return 1;
+    }
+    qInfo() << "Loaded" << data.lines.size() << "frames from" << dataFiles.size() << "file(s).";
+
+    const int repetitions = qMax(1, parser.value(repetitionsOption).toInt());
+    const int renderFrames = qMax(1, parser.value(renderFramesOption).toInt());
+    const QList<BenchResult> results = runAll(data, repetitions, renderFrames);
+
+    const QByteArray output = parser.value(formatOption).compare(QLatin1String("csv"), Qt::CaseInsensitive) == 0
+                                  ? resultsToCsv(results)
+                                  : resultsToJson(results, dataFiles, data.lines.size());
+    if (parser.isSet(outputOption)) {
+        QFile outputFile(parser.value(outputOption));
+        if (!outputFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            qCritical() << "Failed to write benchmark results to" << outputFile.fileName();
+            return 1;
+        }
+        outputFile.write(output);
+    } else {
+        QTextStream(stdout) << output;
+    }
+    return 0;
+}
@@ -6,6 +6,7 @@
  */
 
 #include "ImuDataHandler.h" // Załóżmy, że ImuDataHandler.h jest w ścieżce include
+#include "LatencyTracer.h"  // Monotoniczny znacznik czasu próbek
 #include <QApplication>
 #include <QMainWindow>
 #include <QTimer>
@@ -65,7 +66,8 @@ public slots:
         magData.append(QRandomGenerator::global()->bounded(-1000, 1000));
         magData.append(QRandomGenerator::global()->bounded(-1000, 1000));
 
-        m_imuHandler->updateData(accData, gyroData, magData);
+        // Czas próbki z zegara monotonicznego (jak SensorFrame::hostTimestampNs) - oś czasu wykresów
+        m_imuHandler->updateData(accData, gyroData, magData, LatencyTracer::nowNs());
     }
 
     void simulateRotation() {
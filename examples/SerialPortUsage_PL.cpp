@@ -6,24 +6,25 @@
  */
 
 #include "SerialPortHandler.h"
+#include "SensorFrame.h"
 #include <QCoreApplication>
 #include <QDebug>
 
-// Slot do obsługi nowych danych
-void onNewData(const QVector<float> &data) {
-    qDebug() << "Odebrano nowe dane:" << data;
+// Slot do obsługi nowych ramek
+void onFrameReceived(const SensorFrame &frame) {
+    qDebug() << "Odebrano ramkę (czas odbioru" << frame.hostTimestampNs << "ns):" << frame.values;
     // Przetwórz dane (np. zaktualizuj interfejs użytkownika, zapisz do pliku itp.)
     // Przykład: Dostęp do poszczególnych wartości
-    // if (data.size() == 12) {
-    //     float accX = data[0];
-    //     float accY = data[1];
+    // if (frame.values.size() >= 12) {
+    //     float gyroX = frame.values[0];
+    //     float accX = frame.values[3];
     //     // ... i tak dalej
     // }
 }
 
 // Slot do obsługi błędów
-void onError(QSerialPort::SerialPortError error, const QString &errorString) {
-    qCritical() << "Błąd portu szeregowego:" << error << "-" << errorString;
+void onError(const QString &errorString) {
+    qCritical() << "Błąd portu szeregowego:" << errorString;
     // Obsłuż błąd (np. spróbuj połączyć się ponownie, powiadom użytkownika)
 }
 
@@ -33,8 +34,8 @@ int main(int argc, char *argv[]) {
     SerialPortHandler portHandler;
 
     // Połącz sygnały ze slotami
-    QObject::connect(&portHandler, &SerialPortHandler::newDataReceived, &onNewData);
-    QObject::connect(&portHandler, &SerialPortHandler::errorOccurred, &onError);
+    QObject::connect(&portHandler, &FrameSource::frameReceived, &onFrameReceived);
+    QObject::connect(&portHandler, &FrameSource::errorOccurred, &onError);
 
     // Skonfiguruj i otwórz port
     // Zastąp "COM3" lub "/dev/ttyS0" rzeczywistą nazwą portu
@@ -43,8 +44,8 @@ int main(int argc, char *argv[]) {
 
     if (portHandler.openPort(portName, baudRate)) {
         qInfo() << "Pomyślnie otwarto port" << portName;
-        // Port jest teraz otwarty, a readData() będzie wywoływane asynchronicznie,
-        // gdy nadejdą dane.
+        // Port jest teraz otwarty - każda poprawna linia (CRC, format) jest emitowana
+        // asynchronicznie jako frameReceived().
     } else {
         qWarning() << "Nie udało się otworzyć portu" << portName << ". Błąd:" << portHandler.getLastError();
         // Aplikacja może zakończyć działanie lub spróbować innych portów, jeśli otwarcie się nie powiedzie
@@ -0,0 +1,44 @@
+/**
+ * @file SharedFrameRingUsage_PL.cpp
+ * @brief Przykład czytelnika ramek eksportowanych do pamięci współdzielonej (SharedFrameRing).
+ * @details Proces dołącza do segmentu utworzonego przez aplikację (*Settings › Export Frames (Shared Memory)*
+ * albo `wds_Orienta --headless ... --shm /orienta-frames`) i odpytuje go w pętli bez blokad.
+ * Odczyt nie wymaga wywołań systemowych, dlatego pętla aktywnie czeka (jeden rdzeń) - program
+ * sterujący może zamiast tego sprawdzać bufor raz na swój cykl.
+ */
+
+#include "SharedFrameRing.h"
+#include "LatencyTracer.h"
+#include <QDebug>
+
+int main() {
+    SharedFrameRing ring;
+    QString errorString;
+    if (!ring.attach(QString::fromLatin1(SharedFrameRing::DEFAULT_NAME), &errorString)) {
+        qCritical() << "Nie można dołączyć do segmentu:" << errorString;
+        return 1;
+    }
+
+    // Tylko nowe ramki; kursor 0 odczytałby również historię dostępną w buforze
+    quint64 cursor = ring.writeIndex();
+    SensorFrame frame;
+    quint64 lostFrames = 0;
+    qint64 publishedNs = 0;
+    quint64 received = 0;
+
+    while (!ring.isWriterClosed()) {
+        if (!ring.read(cursor, frame, lostFrames, &publishedNs)) {
+            continue; // Brak nowych danych - kolejna próba
+        }
+        if (lostFrames > 0) {
+            qWarning() << "Czytelnik nie nadążał - pominięto" << lostFrames << "ramek.";
+        }
+        const qint64 handoffNs = LatencyTracer::nowNs() - publishedNs; // Ten sam zegar monotoniczny w obu procesach
+        if (++received % 100 == 0) {
+            qDebug() << "Urządzenie" << frame.deviceId << "akcelerometr X:" << frame.values.value(0)
+                     << "przekazanie:" << handoffNs << "ns";
+        }
+    }
+    qInfo() << "Aplikacja zamknęła segment po" << received << "ramkach.";
+    return 0;
+}
@@ -0,0 +1,318 @@
+/**
+ * @file AhrsFusion.cpp
+ * @brief Implementacja klasy AhrsFusion.
+ * @details Równania kroków filtrów odpowiadają referencyjnym implementacjom autorów algorytmów
+ * (wersje MARG z magnetometrem i IMU bez niego).
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-10
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include "AhrsFusion.h"
+#include "SimdSupport.h"
+#include <QtMath>
+#include <cmath>
+
+constexpr float DEG_TO_RAD_AF = 0.017453292519943295f;
+constexpr float MIN_NORM_SQUARED_AF = 1.0e-12f; // Poniżej - wektor uznawany za brak danych
+constexpr float DEFAULT_DT_S_AF = 0.01f; // Krok, gdy odstępu ramek nie da się wyznaczyć (pierwsza ramka, zły czas)
+constexpr float MAX_DT_S_AF = 0.1f; // Dłuższa przerwa (utracone ramki) nie jest całkowana w jednym kroku
+constexpr int INIT_ITERATIONS_AF = 200; // Kroki korekcji przy ustalaniu orientacji początkowej
+constexpr float INIT_BETA_AF = 2.5f;
+
+namespace {
+/**
+ * @brief Zwraca `1 / sqrt(x)` dla dodatniego `x` (skalarnie).
+ */
+inline float invSqrt(float x) {
+    return 1.0f / std::sqrt(x);
+}
+} // namespace
+
+AhrsFusion::AhrsFusion(Algorithm algorithm)
+    : m_algorithm(algorithm) {
+}
+
+void AhrsFusion::setAlgorithm(Algorithm algorithm) {
+    if (m_algorithm == algorithm) {
+        return;
+    }
+    m_algorithm = algorithm;
+    m_integralX = m_integralY = m_integralZ = 0.0f;
+}
+
+void AhrsFusion::setMahonyGains(float kp, float ki) {
+    m_twoKp = 2.0f * kp;
+    m_twoKi = 2.0f * ki;
+    if (ki <= 0.0f) {
+        m_integralX = m_integralY = m_integralZ = 0.0f;
+    }
+}
+
+void AhrsFusion::reset() {
+    m_q0 = 1.0f;
+    m_q1 = m_q2 = m_q3 = 0.0f;
+    m_integralX = m_integralY = m_integralZ = 0.0f;
+    m_lastTimestampNs = 0;
+    m_initialized = false;
+}
+
+void AhrsFusion::updateBatch(const float *const *frames, const qint64 *timestampsNs, int count, EulerAngles *angles) {
+    if (count <= 0) {
+        return;
+    }
+    prepareSamples(frames, count);
+
+    for (int i = 0; i < count; ++i) {
+        if (!m_initialized) {
+            if (m_accNormSquared[i] > 0.0f) {
+                initialize(i);
+            }
+        } else {
+            float dt = DEFAULT_DT_S_AF;
+            if (m_lastTimestampNs > 0 && timestampsNs[i] > m_lastTimestampNs) {
+                dt = qMin(static_cast<float>(timestampsNs[i] - m_lastTimestampNs) * 1.0e-9f, MAX_DT_S_AF);
+            }
+            if (m_algorithm == Algorithm::Madgwick) {
+                madgwickStep(i, dt, m_beta, true);
+            } else {
+                mahonyStep(i, dt);
+            }
+        }
+        m_lastTimestampNs = timestampsNs[i];
+        angles[i] = toEulerAngles(orientation());
+    }
+}
+
+void AhrsFusion::prepareSamples(const float *const *frames, int count) {
+    // Tablice zaokrąglone do pełnych wektorów - ogon wypełniony zerami
+    const int paddedCount = (count + SimdFloat4::LANES - 1) / SimdFloat4::LANES * SimdFloat4::LANES;
+    QVector<float> *channels[] = {&m_gx, &m_gy, &m_gz, &m_ax, &m_ay, &m_az, &m_mx, &m_my, &m_mz};
+    for (QVector<float> *channel: channels) {
+        channel->resize(paddedCount);
+    }
+    m_accNormSquared.resize(paddedCount);
+    m_magNormSquared.resize(paddedCount);
+    for (int i = 0; i < paddedCount; ++i) {
+        const float *frame = i < count ? frames[i] : nullptr;
+        for (int axis = 0; axis < 3; ++axis) {
+            (*channels[axis])[i] = frame ? frame[GYRO_X_INDEX + axis] : 0.0f;
+            (*channels[3 + axis])[i] = frame ? frame[ACC_X_INDEX + axis] : 0.0f;
+            (*channels[6 + axis])[i] = frame ? frame[MAG_X_INDEX + axis] : 0.0f;
+        }
+    }
+
+    const SimdFloat4 degToRad = SimdFloat4::broadcast(DEG_TO_RAD_AF);
+    const SimdFloat4 minNorm = SimdFloat4::broadcast(MIN_NORM_SQUARED_AF);
+    for (int i = 0; i < paddedCount; i += SimdFloat4::LANES) {
+        (SimdFloat4::load(&m_gx[i]) * degToRad).store(&m_gx[i]);
+        (SimdFloat4::load(&m_gy[i]) * degToRad).store(&m_gy[i]);
+        (SimdFloat4::load(&m_gz[i]) * degToRad).store(&m_gz[i]);
+
+        const SimdFloat4 ax = SimdFloat4::load(&m_ax[i]);
+        const SimdFloat4 ay = SimdFloat4::load(&m_ay[i]);
+        const SimdFloat4 az = SimdFloat4::load(&m_az[i]);
+        const SimdFloat4 accNormSquared = SimdFloat4::mulAdd(ax, ax, SimdFloat4::mulAdd(ay, ay, az * az));
+        const SimdFloat4 accScale = SimdFloat4::rsqrt(SimdFloat4::max(accNormSquared, minNorm));
+        (ax * accScale).store(&m_ax[i]);
+        (ay * accScale).store(&m_ay[i]);
+        (az * accScale).store(&m_az[i]);
+        accNormSquared.store(&m_accNormSquared[i]);
+
+        const SimdFloat4 mx = SimdFloat4::load(&m_mx[i]);
+        const SimdFloat4 my = SimdFloat4::load(&m_my[i]);
+        const SimdFloat4 mz = SimdFloat4::load(&m_mz[i]);
+        const SimdFloat4 magNormSquared = SimdFloat4::mulAdd(mx, mx, SimdFloat4::mulAdd(my, my, mz * mz));
+        const SimdFloat4 magScale = SimdFloat4::rsqrt(SimdFloat4::max(magNormSquared, minNorm));
+        (mx * magScale).store(&m_mx[i]);
+        (my * magScale).store(&m_my[i]);
+        (mz * magScale).store(&m_mz[i]);
+        magNormSquared.store(&m_magNormSquared[i]);
+    }
+    // Znacznik braku danych sprawdzany w krokach filtru
+    for (int i = 0; i < count; ++i) {
+        if (m_accNormSquared[i] <= MIN_NORM_SQUARED_AF) {
+            m_accNormSquared[i] = 0.0f;
+        }
+        if (m_magNormSquared[i] <= MIN_NORM_SQUARED_AF) {
+            m_magNormSquared[i] = 0.0f;
+        }
+    }
+}
+
+void AhrsFusion::initialize(int index) {
+    m_q0 = 1.0f;
+    m_q1 = m_q2 = m_q3 = 0.0f;
+    m_integralX = m_integralY = m_integralZ = 0.0f;
+    // Zbieżność do orientacji wyznaczonej przez grawitację i pole magnetyczne - w konwencji filtru,
+    // bez osobnego wzoru na kąty początkowe
+    for (int i = 0; i < INIT_ITERATIONS_AF; ++i) {
+        madgwickStep(index, DEFAULT_DT_S_AF, INIT_BETA_AF, false);
+    }
+    m_initialized = true;
+}
+
+void AhrsFusion::madgwickStep(int index, float dt, float beta, bool useGyro) {
+    const float q0 = m_q0, q1 = m_q1, q2 = m_q2, q3 = m_q3;
+    const float gx = useGyro ? m_gx[index] : 0.0f;
+    const float gy = useGyro ? m_gy[index] : 0.0f;
+    const float gz = useGyro ? m_gz[index] : 0.0f;
+
+    // Pochodna kwaternionu z prędkości kątowej
+    float qDot0 = 0.5f * (-q1 * gx - q2 * gy - q3 * gz);
+    float qDot1 = 0.5f * (q0 * gx + q2 * gz - q3 * gy);
+    float qDot2 = 0.5f * (q0 * gy - q1 * gz + q3 * gx);
+    float qDot3 = 0.5f * (q0 * gz + q1 * gy - q2 * gx);
+
+    if (m_accNormSquared[index] > 0.0f) {
+        const float ax = m_ax[index], ay = m_ay[index], az = m_az[index];
+        float s0, s1, s2, s3;
+        if (m_magNormSquared[index] > 0.0f) {
+            const float mx = m_mx[index], my = m_my[index], mz = m_mz[index];
+            const float _2q0mx = 2.0f * q0 * mx;
+            const float _2q0my = 2.0f * q0 * my;
+            const float _2q0mz = 2.0f * q0 * mz;
+            const float _2q1mx = 2.0f * q1 * mx;
+            const float _2q0 = 2.0f * q0;
+            const float _2q1 = 2.0f * q1;
+            const float _2q2 = 2.0f * q2;
+            const float _2q3 = 2.0f * q3;
+            const float _2q0q2 = 2.0f * q0 * q2;
+            const float _2q2q3 = 2.0f * q2 * q3;
+            const float q0q0 = q0 * q0, q0q1 = q0 * q1, q0q2 = q0 * q2, q0q3 = q0 * q3;
+            const float q1q1 = q1 * q1, q1q2 = q1 * q2, q1q3 = q1 * q3;
+            const float q2q2 = q2 * q2, q2q3 = q2 * q3, q3q3 = q3 * q3;
+
+            // Kierunek pola magnetycznego Ziemi w układzie odniesienia (składowa pozioma na osi X)
+            const float hx = mx * q0q0 - _2q0my * q3 + _2q0mz * q2 + mx * q1q1 + _2q1 * my * q2 + _2q1 * mz * q3
+                             - mx * q2q2 - mx * q3q3;
+            const float hy = _2q0mx * q3 + my * q0q0 - _2q0mz * q1 + _2q1mx * q2 - my * q1q1 + my * q2q2
+                             + _2q2 * mz * q3 - my * q3q3;
+            const float _2bx = std::sqrt(hx * hx + hy * hy);
+            const float _2bz = -_2q0mx * q2 + _2q0my * q1 + mz * q0q0 + _2q1mx * q3 - mz * q1q1 + _2q2 * my * q3
+                               - mz * q2q2 + mz * q3q3;
+            const float _4bx = 2.0f * _2bx;
+            const float _4bz = 2.0f * _2bz;
+
+            // Gradient funkcji celu
+            const float fAx = 2.0f * q1q3 - _2q0q2 - ax;
+            const float fAy = 2.0f * q0q1 + _2q2q3 - ay;
+            const float fAz = 1.0f - 2.0f * q1q1 - 2.0f * q2q2 - az;
+            const float fMx = _2bx * (0.5f - q2q2 - q3q3) + _2bz * (q1q3 - q0q2) - mx;
+            const float fMy = _2bx * (q1q2 - q0q3) + _2bz * (q0q1 + q2q3) - my;
+            const float fMz = _2bx * (q0q2 + q1q3) + _2bz * (0.5f - q1q1 - q2q2) - mz;
+            s0 = -_2q2 * fAx + _2q1 * fAy - _2bz * q2 * fMx + (-_2bx * q3 + _2bz * q1) * fMy + _2bx * q2 * fMz;
+            s1 = _2q3 * fAx + _2q0 * fAy - 4.0f * q1 * fAz + _2bz * q3 * fMx + (_2bx * q2 + _2bz * q0) * fMy
+                 + (_2bx * q3 - _4bz * q1) * fMz;
+            s2 = -_2q0 * fAx + _2q3 * fAy - 4.0f * q2 * fAz + (-_4bx * q2 - _2bz * q0) * fMx
+                 + (_2bx * q1 + _2bz * q3) * fMy + (_2bx * q0 - _4bz * q2) * fMz;
+            s3 = _2q1 * fAx + _2q2 * fAy + (-_4bx * q3 + _2bz * q1) * fMx + (-_2bx * q0 + _2bz * q2) * fMy
+                 + _2bx * q1 * fMz;
+        } else {
+            // Tylko grawitacja
+            const float _2q0 = 2.0f * q0, _2q1 = 2.0f * q1, _2q2 = 2.0f * q2, _2q3 = 2.0f * q3;
+            const float _4q0 = 4.0f * q0, _4q1 = 4.0f * q1, _4q2 = 4.0f * q2;
+            const float _8q1 = 8.0f * q1, _8q2 = 8.0f * q2;
+            const float q0q0 = q0 * q0, q1q1 = q1 * q1, q2q2 = q2 * q2, q3q3 = q3 * q3;
+            s0 = _4q0 * q2q2 + _2q2 * ax + _4q0 * q1q1 - _2q1 * ay;
+            s1 = _4q1 * q3q3 - _2q3 * ax + 4.0f * q0q0 * q1 - _2q0 * ay - _4q1 + _8q1 * q1q1 + _8q1 * q2q2 + _4q1 * az;
+            s2 = 4.0f * q0q0 * q2 + _2q0 * ax + _4q2 * q3q3 - _2q3 * ay - _4q2 + _8q2 * q1q1 + _8q2 * q2q2 + _4q2 * az;
+            s3 = 4.0f * q1q1 * q3 - _2q1 * ax + 4.0f * q2q2 * q3 - _2q2 * ay;
+        }
+        const float sNormSquared = s0 * s0 + s1 * s1 + s2 * s2 + s3 * s3;
+        if (sNormSquared > MIN_NORM_SQUARED_AF) {
+            const float scale = beta * invSqrt(sNormSquared);
+            qDot0 -= scale * s0;
+            qDot1 -= scale * s1;
+            qDot2 -= scale * s2;
+            qDot3 -= scale * s3;
+        }
+    }
+
+    m_q0 = q0 + qDot0 * dt;
+    m_q1 = q1 + qDot1 * dt;
+    m_q2 = q2 + qDot2 * dt;
+    m_q3 = q3 + qDot3 * dt;
+    normalizeState();
+}
+
+void AhrsFusion::mahonyStep(int index, float dt) {
+    float gx = m_gx[index], gy = m_gy[index], gz = m_gz[index];
+    const float q0 = m_q0, q1 = m_q1, q2 = m_q2, q3 = m_q3;
+
+    if (m_accNormSquared[index] > 0.0f) {
+        const float ax = m_ax[index], ay = m_ay[index], az = m_az[index];
+        const float q0q0 = q0 * q0, q0q1 = q0 * q1, q0q2 = q0 * q2, q0q3 = q0 * q3;
+        const float q1q1 = q1 * q1, q1q2 = q1 * q2, q1q3 = q1 * q3;
+        const float q2q2 = q2 * q2, q2q3 = q2 * q3, q3q3 = q3 * q3;
+
+        // Przewidywany kierunek grawitacji (połowa wektora)
+        const float halfVx = q1q3 - q0q2;
+        const float halfVy = q0q1 + q2q3;
+        const float halfVz = q0q0 - 0.5f + q3q3;
+        // Błąd: iloczyn wektorowy kierunków zmierzonych i przewidywanych
+        float halfEx = ay * halfVz - az * halfVy;
+        float halfEy = az * halfVx - ax * halfVz;
+        float halfEz = ax * halfVy - ay * halfVx;
+
+        if (m_magNormSquared[index] > 0.0f) {
+            const float mx = m_mx[index], my = m_my[index], mz = m_mz[index];
+            const float hx = 2.0f * (mx * (0.5f - q2q2 - q3q3) + my * (q1q2 - q0q3) + mz * (q1q3 + q0q2));
+            const float hy = 2.0f * (mx * (q1q2 + q0q3) + my * (0.5f - q1q1 - q3q3) + mz * (q2q3 - q0q1));
+            const float bx = std::sqrt(hx * hx + hy * hy);
+            const float bz = 2.0f * (mx * (q1q3 - q0q2) + my * (q2q3 + q0q1) + mz * (0.5f - q1q1 - q2q2));
+            const float halfWx = bx * (0.5f - q2q2 - q3q3) + bz * (q1q3 - q0q2);
+            const float halfWy = bx * (q1q2 - q0q3) + bz * (q0q1 + q2q3);
+            const float halfWz = bx * (q0q2 + q1q3) + bz * (0.5f - q1q1 - q2q2);
+            halfEx += my * halfWz - mz * halfWy;
+            halfEy += mz * halfWx - mx * halfWz;
+            halfEz += mx * halfWy - my * halfWx;
+        }
+
+        if (m_twoKi > 0.0f) {
+            m_integralX += m_twoKi * halfEx * dt;
+            m_integralY += m_twoKi * halfEy * dt;
+            m_integralZ += m_twoKi * halfEz * dt;
+            gx += m_integralX;
+            gy += m_integralY;
+            gz += m_integralZ;
+        }
+        gx += m_twoKp * halfEx;
+        gy += m_twoKp * halfEy;
+        gz += m_twoKp * halfEz;
+    }
+
+    gx *= 0.5f * dt;
+    gy *= 0.5f * dt;
+    gz *= 0.5f * dt;
+    m_q0 = q0 + (-q1 * gx - q2 * gy - q3 * gz);
+    m_q1 = q1 + (q0 * gx + q2 * gz - q3 * gy);
+    m_q2 = q2 + (q0 * gy - q1 * gz + q3 * gx);
+    m_q3 = q3 + (q0 * gz + q1 * gy - q2 * gx);
+    normalizeState();
+}
+
+void AhrsFusion::normalizeState() {
+    const float normSquared = m_q0 * m_q0 + m_q1 * m_q1 + m_q2 * m_q2 + m_q3 * m_q3;
+    if (normSquared <= MIN_NORM_SQUARED_AF || !std::isfinite(normSquared)) {
+        reset(); // Stan zdegenerowany (np. wartości NaN z uszkodzonej ramki) - ponowna inicjalizacja
+        return;
+    }
+    const float scale = invSqrt(normSquared);
+    m_q0 *= scale;
+    m_q1 *= scale;
+    m_q2 *= scale;
+    m_q3 *= scale;
+}
+
+AhrsFusion::EulerAngles AhrsFusion::toEulerAngles(const QQuaternion &orientation) {
+    const float q0 = orientation.scalar(), q1 = orientation.x(), q2 = orientation.y(), q3 = orientation.z();
+    EulerAngles angles;
+    angles.roll = qRadiansToDegrees(std::atan2(q0 * q1 + q2 * q3, 0.5f - q1 * q1 - q2 * q2));
+    angles.pitch = qRadiansToDegrees(std::asin(qBound(-1.0f, 2.0f * (q0 * q2 - q1 * q3), 1.0f)));
+    // Obrót wokół osi Z skierowanej w górę jest dodatni przeciwnie do ruchu wskazówek zegara - kurs ma znak przeciwny
+    const float heading = 360.0f - qRadiansToDegrees(std::atan2(q1 * q2 + q0 * q3, 0.5f - q2 * q2 - q3 * q3));
+    angles.yaw = heading >= 360.0f ? heading - 360.0f : heading; // atan2 w (-180, 180] - wynik w [0, 360)
+    return angles;
+}
@@ -0,0 +1,174 @@
+#ifndef AHRSFUSION_H
+#define AHRSFUSION_H
+
+/**
+ * @file AhrsFusion.h
+ * @brief Definicja klasy AhrsFusion - wyznaczanie orientacji (AHRS) z surowych danych żyroskopu, akcelerometru i magnetometru.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-10
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include <QQuaternion>
+#include <QVector>
+#include <QtGlobal>
+
+/**
+ * @class AhrsFusion
+ * @brief Filtr Madgwicka lub Mahony'ego liczony na hoście z pełną częstotliwością ramek.
+ *
+ * @details
+ * Pozwala zastąpić kąty ROLL/PITCH/YAW wyliczane przez firmware czujnika orientacją wyznaczoną
+ * w aplikacji - także dla tańszych głowic bez fuzji na pokładzie. Wejściem są kanały ramki IMU
+ * (żyroskop [dps], akcelerometr [mg], magnetometr [mG]); jednostki akcelerometru i magnetometru nie
+ * mają znaczenia, bo oba wektory są normalizowane.
+ *
+ * `updateBatch()` przetwarza paczkę ramek w dwóch etapach:
+ * 1. niezależne od stanu przygotowanie próbek (przeliczenie na rad/s, normalizacja wektorów
+ *    `rsqrt`) - jądro wektorowe `SimdFloat4`, `SimdFloat4::LANES` ramek na iterację,
+ * 2. rekurencyjna aktualizacja kwaternionu - z natury sekwencyjna (każda ramka zależy od poprzedniej).
+ *
+ * Układ odniesienia: oś X na północ magnetyczną, oś Z w górę (akcelerometr leżącego czujnika
+ * wskazuje +1 g na osi Z). Przy braku pola magnetycznego (zerowy wektor) filtr działa w trybie
+ * IMU - kurs dryfuje wraz z żyroskopem.
+ */
+class AhrsFusion {
+public:
+    /**
+     * @enum Algorithm
+     * @brief Algorytm fuzji.
+     */
+    enum class Algorithm {
+        Madgwick, //!< Spadek gradientowy (S. Madgwick, 2010) - parametr `beta`.
+        Mahony //!< Nieliniowy filtr komplementarny PI (R. Mahony, 2008) - wzmocnienia `Kp`, `Ki`.
+    };
+
+    /**
+     * @struct EulerAngles
+     * @brief Orientacja w konwencji danych czujnika [°].
+     */
+    struct EulerAngles {
+        float roll = 0.0f; //!< Przechylenie (obrót wokół X).
+        float pitch = 0.0f; //!< Pochylenie (obrót wokół Y).
+        float yaw = 0.0f; //!< Kurs magnetyczny w zakresie [0, 360), zgodnie z ruchem wskazówek zegara od północy.
+    };
+
+    static constexpr int GYRO_X_INDEX = 0; //!< Indeks żyroskopu X w ramce IMU (kolejne: Y, Z).
+    static constexpr int ACC_X_INDEX = 3; //!< Indeks akcelerometru X w ramce IMU.
+    static constexpr int MAG_X_INDEX = 6; //!< Indeks magnetometru X w ramce IMU.
+    static constexpr int MIN_FRAME_VALUES = 9; //!< Minimalna liczba wartości ramki (żyroskop, akcelerometr, magnetometr).
+    static constexpr float DEFAULT_MADGWICK_BETA = 0.1f; //!< Domyślne `beta` filtru Madgwicka.
+    static constexpr float DEFAULT_MAHONY_KP = 1.0f; //!< Domyślne wzmocnienie proporcjonalne filtru Mahony'ego.
+    static constexpr float DEFAULT_MAHONY_KI = 0.02f; //!< Domyślne wzmocnienie całkujące filtru Mahony'ego.
+
+    /**
+     * @brief Konstruktor klasy AhrsFusion.
+     * @param algorithm [in] Algorytm fuzji.
+     */
+    explicit AhrsFusion(Algorithm algorithm = Algorithm::Madgwick);
+
+    /**
+     * @brief Zmienia algorytm; orientacja jest zachowywana.
+     * @param algorithm [in] Algorytm fuzji.
+     */
+    void setAlgorithm(Algorithm algorithm);
+
+    /** @brief Zwraca bieżący algorytm. */
+    Algorithm algorithm() const { return m_algorithm; }
+
+    /**
+     * @brief Ustawia `beta` filtru Madgwicka (większe - szybsza korekta, większy szum).
+     * @param beta [in] Wzmocnienie korekcji gradientowej.
+     */
+    void setMadgwickBeta(float beta) { m_beta = beta; }
+
+    /**
+     * @brief Ustawia wzmocnienia filtru Mahony'ego.
+     * @param kp [in] Wzmocnienie proporcjonalne.
+     * @param ki [in] Wzmocnienie całkujące (estymacja dryfu żyroskopu); 0 wyłącza całkowanie.
+     */
+    void setMahonyGains(float kp, float ki);
+
+    /**
+     * @brief Zeruje stan filtru - kolejna ramka ustali orientację początkową z akcelerometru i magnetometru.
+     * @details Wywoływane po zmianie urządzenia lub przy przewinięciu odtwarzania.
+     */
+    void reset();
+
+    /** @brief Informuje, czy filtr ma ustaloną orientację. */
+    bool isInitialized() const { return m_initialized; }
+
+    /** @brief Zwraca bieżącą orientację (z układu czujnika do układu odniesienia). */
+    QQuaternion orientation() const { return QQuaternion(m_q0, m_q1, m_q2, m_q3); }
+
+    /**
+     * @brief Aktualizuje filtr paczką kolejnych ramek jednego urządzenia.
+     * @param frames [in] Wskaźniki na wartości ramek IMU (co najmniej `MIN_FRAME_VALUES` każda).
+     * @param timestampsNs [in] Monotoniczne czasy odbioru ramek [ns] - odstępy wyznaczają krok całkowania.
+     * @param count [in] Liczba ramek.
+     * @param angles [out] Orientacja po każdej ramce (`count` elementów).
+     */
+    void updateBatch(const float *const *frames, const qint64 *timestampsNs, int count, EulerAngles *angles);
+
+    /**
+     * @brief Przelicza kwaternion orientacji na kąty Eulera (kolejność Z-Y-X).
+     * @param orientation [in] Orientacja zwrócona przez `orientation()`.
+     * @return Kąty w stopniach; `yaw` jako kurs [0, 360).
+     */
+    static EulerAngles toEulerAngles(const QQuaternion &orientation);
+
+private:
+    /**
+     * @brief Etap wektorowy: przepisuje kanały do tablic SoA, przelicza żyroskop na rad/s i normalizuje wektory.
+     */
+    void prepareSamples(const float *const *frames, int count);
+
+    /**
+     * @brief Ustala orientację początkową z pierwszej próbki (wiele kroków korekcji bez żyroskopu).
+     * @param index [in] Indeks próbki w tablicach SoA.
+     */
+    void initialize(int index);
+
+    /**
+     * @brief Krok filtru Madgwicka.
+     * @param index [in] Indeks próbki w tablicach SoA.
+     * @param dt [in] Krok czasu [s].
+     * @param beta [in] Wzmocnienie korekcji.
+     * @param useGyro [in] `false` - tylko korekcja (inicjalizacja).
+     */
+    void madgwickStep(int index, float dt, float beta, bool useGyro);
+
+    /**
+     * @brief Krok filtru Mahony'ego.
+     * @param index [in] Indeks próbki w tablicach SoA.
+     * @param dt [in] Krok czasu [s].
+     */
+    void mahonyStep(int index, float dt);
+
+    /** @brief Normalizuje kwaternion stanu. */
+    void normalizeState();
+
+    Algorithm m_algorithm; //!< Wybrany algorytm.
+    float m_beta = DEFAULT_MADGWICK_BETA; //!< `beta` filtru Madgwicka.
+    float m_twoKp = 2.0f * DEFAULT_MAHONY_KP; //!< `2 * Kp` filtru Mahony'ego.
+    float m_twoKi = 2.0f * DEFAULT_MAHONY_KI; //!< `2 * Ki` filtru Mahony'ego.
+    float m_q0 = 1.0f; //!< Kwaternion orientacji - część rzeczywista.
+    float m_q1 = 0.0f; //!< Kwaternion orientacji - X.
+    float m_q2 = 0.0f; //!< Kwaternion orientacji - Y.
+    float m_q3 = 0.0f; //!< Kwaternion orientacji - Z.
+    float m_integralX = 0.0f; //!< Człon całkujący filtru Mahony'ego (estymowany dryf żyroskopu) - X.
+    float m_integralY = 0.0f; //!< Człon całkujący - Y.
+    float m_integralZ = 0.0f; //!< Człon całkujący - Z.
+    qint64 m_lastTimestampNs = 0; //!< Czas poprzedniej ramki.
+    bool m_initialized = false; //!< Orientacja początkowa ustalona.
+
+    // Próbki paczki w układzie SoA (pojemność zachowywana między paczkami)
+    QVector<float> m_gx, m_gy, m_gz; //!< Żyroskop [rad/s].
+    QVector<float> m_ax, m_ay, m_az; //!< Znormalizowany akcelerometr.
+    QVector<float> m_mx, m_my, m_mz; //!< Znormalizowany magnetometr.
+    QVector<float> m_accNormSquared; //!< Kwadrat normy akcelerometru przed normalizacją (0 - brak danych).
+    QVector<float> m_magNormSquared; //!< Kwadrat normy magnetometru przed normalizacją (0 - brak danych).
+};
+
+#endif // AHRSFUSION_H
@@ -0,0 +1,279 @@
+/**
+ * @file AllanDeviation.cpp
+ * @brief Implementacja klasy AllanDeviation.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-17
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include "AllanDeviation.h"
+#include "FrameParser.h"
+#include "FrameRecorder.h"
+#include <QFile>
+#include <QSaveFile>
+#include <QTextStream>
+#include <QThread>
+#include <QThreadPool>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+constexpr int CHUNK_FRAMES_AD = 65536; // Ramki wczytywane naraz (ok. 2,4 MB na bufor)
+constexpr int TAU_GROUPS_AD = 4; // Grupy czasów tau na kanał - zadania puli: CHANNELS * TAU_GROUPS_AD
+constexpr qint64 MAX_CLUSTER_FRAMES_AD = 1000000000LL; // Najdłuższy rozważany klaster (dalsze nie mają danych)
+constexpr int IMU_VALUE_COUNT_AD = FrameRecorder::IMU_VALUE_COUNT;
+constexpr int TIME_COLUMN_AD = IMU_VALUE_COUNT_AD; // Czas odbioru [ms] w nagraniach FrameRecorder
+constexpr double DEFAULT_SAMPLE_PERIOD_S_AD = 0.01; // Nagrania bez kolumny czasu - krok odtwarzania
+constexpr int PROGRESS_SCALE_AD = 1000;
+
+namespace {
+/**
+ * @brief Stan jednego czasu tau: bufor kołowy sumy skumulowanej co `decimation` ramek i suma kwadratów różnic.
+ */
+struct TauAccumulator {
+    qint64 clusterFrames = 0; //!< Długość klastra m [ramki].
+    qint64 decimation = 1; //!< Co ile ramek zapamiętywana jest suma (potęga dwójki).
+    int steps = 0; //!< m / decimation - odległość x[k+m] od x[k] w buforze.
+    std::vector<double> ring; //!< Ostatnie 2 * steps + 1 wartości sumy skumulowanej.
+    int next = 0; //!< Pozycja zapisu w buforze.
+    qint64 stored = 0; //!< Liczba zapisanych wartości.
+    double sumSquares = 0.0; //!< Suma kwadratów drugich różnic.
+    qint64 terms = 0; //!< Liczba drugich różnic.
+
+    /** @brief Zapisuje kolejną wartość sumy i - gdy bufor jest pełny - dodaje drugą różnicę. */
+    void push(double cumulative) {
+        ring[next] = cumulative;
+        const int size = static_cast<int>(ring.size());
+        const int newest = next;
+        next = next + 1 == size ? 0 : next + 1;
+        if (++stored < size) {
+            return;
+        }
+        int middle = newest - steps;
+        if (middle < 0) {
+            middle += size;
+        }
+        const double difference = cumulative - 2.0 * ring[middle] + ring[next]; // ring[next] - najstarsza
+        sumSquares += difference * difference;
+        ++terms;
+    }
+};
+
+/**
+ * @brief Zadanie puli: jeden kanał i podzbiór czasów tau (posortowany rosnąco wg `decimation`).
+ */
+struct ChannelTask {
+    int channel = 0; //!< Indeks kanału.
+    bool hasOffset = false; //!< Czy pierwsza próbka już wyznaczyła przesunięcie.
+    double offset = 0.0; //!< Pierwsza próbka - odejmowana, aby suma nie rosła (nie zmienia drugich różnic).
+    double cumulative = 0.0; //!< Suma skumulowana x[index].
+    qint64 index = 0; //!< Liczba przetworzonych ramek.
+    std::vector<TauAccumulator> taus; //!< Czasy tau zadania.
+
+    /** @brief Przetwarza porcję próbek kanału. */
+    void process(const float *samples, int count) {
+        if (!hasOffset && count > 0) {
+            hasOffset = true;
+            offset = samples[0];
+        }
+        for (int i = 0; i < count; ++i) {
+            cumulative += samples[i] - offset;
+            ++index;
+            for (TauAccumulator &tau: taus) {
+                // Wielokrotność większej potęgi dwójki jest też wielokrotnością mniejszej - dalsze tau pominięte
+                if ((index & (tau.decimation - 1)) != 0) {
+                    break;
+                }
+                tau.push(cumulative);
+            }
+        }
+    }
+};
+
+/**
+ * @brief Tworzy logarytmiczną siatkę długości klastrów z krokiem zapamiętywania sumy.
+ */
+std::vector<TauAccumulator> createTauGrid() {
+    std::vector<TauAccumulator> grid;
+    for (int point = 0;; ++point) {
+        qint64 clusterFrames = std::llround(std::pow(10.0, static_cast<double>(point) / AllanDeviation::POINTS_PER_DECADE));
+        if (clusterFrames > MAX_CLUSTER_FRAMES_AD) {
+            break;
+        }
+        qint64 decimation = 1;
+        while (clusterFrames / (decimation * 2) >= AllanDeviation::MIN_CLUSTER_STEPS) {
+            decimation *= 2;
+        }
+        clusterFrames -= clusterFrames % decimation;
+        if (!grid.empty() && grid.back().clusterFrames == clusterFrames) {
+            continue; // Krótkie klastry: kolejne punkty siatki zaokrąglają się do tej samej liczby ramek
+        }
+        TauAccumulator tau;
+        tau.clusterFrames = clusterFrames;
+        tau.decimation = decimation;
+        tau.steps = static_cast<int>(clusterFrames / decimation);
+        tau.ring.assign(2 * tau.steps + 1, 0.0);
+        grid.push_back(std::move(tau));
+    }
+    return grid;
+}
+
+/**
+ * @brief Wczytuje porcję ramek do bufora (kanał po kanale).
+ * @return Liczba wczytanych ramek (0 - koniec pliku).
+ */
+int readChunk(QFile &file, std::vector<float> &chunk, QVector<float> &values, qint64 &frameCount,
+              double &firstTimeMs, double &lastTimeMs, bool &timed) {
+    int frames = 0;
+    QByteArray line;
+    while (frames < CHUNK_FRAMES_AD && !file.atEnd()) {
+        line = file.readLine().trimmed();
+        if (line.isEmpty() || line.startsWith('#')) {
+            continue; // Nagłówek, komentarze i znaczniki luk (# gap) - analiza traktuje nagranie jako ciągłe
+        }
+        if (FrameParser::parseCsv(line, IMU_VALUE_COUNT_AD, IMU_VALUE_COUNT_AD + 1, values) != FrameParser::Status::Ok) {
+            continue;
+        }
+        for (int channel = 0; channel < AllanDeviation::CHANNELS; ++channel) {
+            chunk[static_cast<size_t>(channel) * CHUNK_FRAMES_AD + frames] = values[channel];
+        }
+        const bool hasTime = values.size() > TIME_COLUMN_AD;
+        if (frameCount == 0) {
+            timed = hasTime;
+            firstTimeMs = hasTime ? values[TIME_COLUMN_AD] : 0.0;
+        }
+        timed = timed && hasTime;
+        if (hasTime) {
+            lastTimeMs = values[TIME_COLUMN_AD];
+        }
+        ++frameCount;
+        ++frames;
+    }
+    return frames;
+}
+}
+
+bool AllanDeviation::analyzeFile(const QString &filePath, Result &result, QString *errorString,
+                                 const ProgressCallback &progress, int threadCount) {
+    result = Result();
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (errorString) *errorString = file.errorString();
+        return false;
+    }
+    const qint64 fileSize = qMax<qint64>(1, file.size());
+
+    // Zadania: każdy kanał z TAU_GROUPS_AD grupami czasów (co TAU_GROUPS_AD-ty tau - równy podział pracy)
+    const std::vector<TauAccumulator> grid = createTauGrid();
+    std::vector<ChannelTask> tasks;
+    tasks.reserve(CHANNELS * TAU_GROUPS_AD);
+    for (int channel = 0; channel < CHANNELS; ++channel) {
+        for (int group = 0; group < TAU_GROUPS_AD; ++group) {
+            ChannelTask task;
+            task.channel = channel;
+            for (size_t i = group; i < grid.size(); i += TAU_GROUPS_AD) {
+                task.taus.push_back(grid[i]);
+            }
+            // x[0] = 0 - pierwsza wartość sumy dla wszystkich tau
+            for (TauAccumulator &tau: task.taus) {
+                tau.push(0.0);
+            }
+            tasks.push_back(std::move(task));
+        }
+    }
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(threadCount > 0 ? threadCount : QThread::idealThreadCount());
+    std::vector<float> chunks[2] = {std::vector<float>(static_cast<size_t>(CHANNELS) * CHUNK_FRAMES_AD),
+                                    std::vector<float>(static_cast<size_t>(CHANNELS) * CHUNK_FRAMES_AD)};
+    QVector<float> values;
+    double firstTimeMs = 0.0;
+    double lastTimeMs = 0.0;
+    bool timed = false;
+    int current = 0;
+    int frames = readChunk(file, chunks[current], values, result.frameCount, firstTimeMs, lastTimeMs, timed);
+    while (frames > 0) {
+        const float *chunkData = chunks[current].data();
+        for (ChannelTask &task: tasks) {
+            pool.start([&task, chunkData, frames] {
+                task.process(chunkData + static_cast<size_t>(task.channel) * CHUNK_FRAMES_AD, frames);
+            });
+        }
+        // Kolejna porcja wczytywana w czasie obliczeń na bieżącej
+        current = 1 - current;
+        const int nextFrames = readChunk(file, chunks[current], values, result.frameCount, firstTimeMs, lastTimeMs,
+                                         timed);
+        pool.waitForDone();
+        frames = nextFrames;
+        if (progress && !progress(static_cast<int>(file.pos() * PROGRESS_SCALE_AD / fileSize))) {
+            if (errorString) *errorString = QStringLiteral("Analysis cancelled.");
+            return false;
+        }
+    }
+
+    if (result.frameCount < 3) {
+        if (errorString) *errorString = QStringLiteral("Recording has fewer than 3 frames.");
+        return false;
+    }
+    result.samplePeriodS = timed && lastTimeMs > firstTimeMs
+                               ? (lastTimeMs - firstTimeMs) / 1000.0 / static_cast<double>(result.frameCount - 1)
+                               : DEFAULT_SAMPLE_PERIOD_S_AD;
+
+    for (size_t i = 0; i < grid.size(); ++i) {
+        const int group = static_cast<int>(i % TAU_GROUPS_AD);
+        const size_t position = i / TAU_GROUPS_AD;
+        const TauAccumulator &first = tasks[group].taus[position];
+        if (first.terms == 0) {
+            break; // Klaster dłuższy niż połowa nagrania
+        }
+        Point point;
+        point.clusterFrames = first.clusterFrames;
+        point.tauS = static_cast<double>(first.clusterFrames) * result.samplePeriodS;
+        point.terms = first.terms;
+        const double clusterSquared = static_cast<double>(first.clusterFrames) * static_cast<double>(first.clusterFrames);
+        for (int channel = 0; channel < CHANNELS; ++channel) {
+            const TauAccumulator &tau = tasks[channel * TAU_GROUPS_AD + group].taus[position];
+            point.deviation[channel] = std::sqrt(tau.sumSquares / (2.0 * clusterSquared * static_cast<double>(tau.terms)));
+        }
+        result.points.append(point);
+    }
+    return true;
+}
+
+bool AllanDeviation::writeCsv(const Result &result, const QString &filePath, QString *errorString) {
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        if (errorString) *errorString = file.errorString();
+        return false;
+    }
+    QTextStream out(&file);
+    out << "# frames," << result.frameCount << ",tau0_s," << QString::number(result.samplePeriodS, 'g', 9) << '\n';
+    out << "tau_s,cluster_frames,terms";
+    for (int channel = 0; channel < CHANNELS; ++channel) {
+        out << ',' << channelName(channel);
+    }
+    out << '\n';
+    for (const Point &point: result.points) {
+        out << QString::number(point.tauS, 'g', 9) << ',' << point.clusterFrames << ',' << point.terms;
+        for (double deviation: point.deviation) {
+            out << ',' << QString::number(deviation, 'g', 9);
+        }
+        out << '\n';
+    }
+    out.flush();
+    if (!file.commit()) {
+        if (errorString) *errorString = file.errorString();
+        return false;
+    }
+    return true;
+}
+
+QString AllanDeviation::channelName(int channel) {
+    static const char *const names[CHANNELS] = {
+        "gyro_x_dps", "gyro_y_dps", "gyro_z_dps",
+        "acc_x_mg", "acc_y_mg", "acc_z_mg",
+        "mag_x_mgauss", "mag_y_mgauss", "mag_z_mgauss"
+    };
+    return channel >= 0 && channel < CHANNELS ? QString::fromLatin1(names[channel]) : QString();
+}
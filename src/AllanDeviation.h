@@ -0,0 +1,90 @@
+#ifndef ALLANDEVIATION_H
+#define ALLANDEVIATION_H
+
+/**
+ * @file AllanDeviation.h
+ * @brief Definicja klasy AllanDeviation - nakładkowe odchylenie Allana kanałów IMU z pliku nagrania.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-17
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include <QString>
+#include <QVector>
+#include <functional>
+
+/**
+ * @class AllanDeviation
+ * @brief Liczy nakładkowe odchylenie Allana (OADEV) 9 kanałów czujników z nagrania `simulation_data*.log`.
+ *
+ * @details
+ * Dla klastra `m` ramek wariancja Allana wynika z drugich różnic sumy skumulowanej `x` odczytów:
+ * `AVAR(m) = sum (x[k+2m] - 2 x[k+m] + x[k])² / (2 m² (N - 2m))`, a `tau = m * tau0`. Czasy `tau`
+ * tworzą siatkę logarytmiczną (`POINTS_PER_DECADE` na dekadę). Każdy `tau` ma własny bufor kołowy
+ * sumy skumulowanej o długości `2m + 1`, więc plik jest czytany strumieniowo, porcjami ramek,
+ * a pamięć nie zależy od długości nagrania. Dla długich klastrów suma jest zapamiętywana co `d`
+ * ramek (`d` - potęga dwójki, `m / d >= MIN_CLUSTER_STEPS`), a różnice są liczone co `d` ramek
+ * zamiast co ramkę - ograniczenie nakładania bez zauważalnej utraty dokładności, które utrzymuje
+ * koszt ramki i rozmiar buforów na stałym poziomie.
+ *
+ * Porcje są przetwarzane w puli wątków: zadaniem jest para (kanał, grupa czasów `tau`) z własnym
+ * stanem, a kolejna porcja jest wczytywana w czasie przetwarzania poprzedniej. `tau0` to średni
+ * odstęp ramek z kolumny czasu nagrania (bez niej - 10 ms, jak przy odtwarzaniu).
+ */
+class AllanDeviation {
+public:
+    static constexpr int CHANNELS = 9; //!< Żyroskop X-Z [dps], akcelerometr X-Z [mg], magnetometr X-Z [mG].
+    static constexpr int POINTS_PER_DECADE = 10; //!< Gęstość siatki czasów `tau`.
+    static constexpr int MIN_CLUSTER_STEPS = 64; //!< Najmniejsza liczba kroków bufora na klaster (`m / d`).
+
+    /** @brief Punkt charakterystyki: czas uśredniania i odchylenie każdego kanału. */
+    struct Point {
+        double tauS = 0.0; //!< Czas uśredniania [s].
+        qint64 clusterFrames = 0; //!< Długość klastra `m` [ramki].
+        qint64 terms = 0; //!< Liczba zsumowanych drugich różnic (miara niepewności punktu).
+        double deviation[CHANNELS] = {}; //!< Odchylenie Allana kanałów (w jednostkach kanału).
+    };
+
+    /** @brief Wynik analizy nagrania. */
+    struct Result {
+        QVector<Point> points; //!< Punkty charakterystyki, rosnąco wg `tauS`.
+        qint64 frameCount = 0; //!< Liczba przeanalizowanych ramek.
+        double samplePeriodS = 0.0; //!< Przyjęty odstęp ramek `tau0` [s].
+    };
+
+    /**
+     * @brief Postęp analizy: wywoływany po każdej porcji ramek.
+     * @return `false`, aby przerwać analizę.
+     */
+    using ProgressCallback = std::function<bool(int permille)>;
+
+    /**
+     * @brief Analizuje plik nagrania.
+     * @param filePath [in] Plik w formacie `simulation_data*.log` (12 wartości IMU, opcjonalnie czas [ms]).
+     * @param result [out] Charakterystyka Allana.
+     * @param errorString [out] Opcjonalnie: opis błędu.
+     * @param progress [in] Opcjonalnie: postęp w promilach rozmiaru pliku (z wątku wywołującego).
+     * @param threadCount [in] Liczba wątków puli; 0 - liczba rdzeni.
+     * @return `true` po udanej analizie; `false` przy błędzie odczytu, zbyt krótkim nagraniu lub przerwaniu.
+     */
+    static bool analyzeFile(const QString &filePath, Result &result, QString *errorString = nullptr,
+                            const ProgressCallback &progress = {}, int threadCount = 0);
+
+    /**
+     * @brief Zapisuje charakterystykę do pliku CSV (wiersz na `tau`, kolumna na kanał).
+     * @param result [in] Wynik analizy.
+     * @param filePath [in] Plik docelowy (nadpisywany).
+     * @param errorString [out] Opcjonalnie: opis błędu.
+     * @return `true`, jeśli plik został zapisany.
+     */
+    static bool writeCsv(const Result &result, const QString &filePath, QString *errorString = nullptr);
+
+    /**
+     * @brief Zwraca nazwę kanału z jednostką, używaną w nagłówku CSV (np. `gyro_x_dps`).
+     * @param channel [in] Indeks kanału (0 - `CHANNELS - 1`).
+     */
+    static QString channelName(int channel);
+};
+
+#endif // ALLANDEVIATION_H
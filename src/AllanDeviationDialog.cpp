@@ -0,0 +1,123 @@
+/**
+ * @file AllanDeviationDialog.cpp
+ * @brief Implementacja klasy AllanDeviationDialog.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-17
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include "AllanDeviationDialog.h"
+#include <QtCharts/QChart>
+#include <QtCharts/QChartView>
+#include <QtCharts/QLegend>
+#include <QtCharts/QLineSeries>
+#include <QtCharts/QLogValueAxis>
+#include <QComboBox>
+#include <QDialogButtonBox>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QMessageBox>
+#include <QPainter>
+#include <QPushButton>
+#include <QVBoxLayout>
+#include <QtMath>
+#include <limits>
+
+constexpr int AXES_PER_SENSOR_ADD = 3;
+
+AllanDeviationDialog::AllanDeviationDialog(const AllanDeviation::Result &result, const QString &sourceName,
+                                           QWidget *parent)
+    : QDialog(parent),
+      m_result(result),
+      m_sourceName(sourceName),
+      m_sensorCombo(new QComboBox(this)),
+      m_chart(new QChart()) {
+    setWindowTitle(tr("Allan Deviation - %1").arg(sourceName));
+    resize(800, 600);
+
+    m_sensorCombo->addItems({tr("Gyroscope [dps]"), tr("Accelerometer [mg]"), tr("Magnetometer [mG]")});
+    m_chart->legend()->setAlignment(Qt::AlignTop);
+    auto *chartView = new QChartView(m_chart, this); // Widok przejmuje własność wykresu
+    chartView->setRenderHint(QPainter::Antialiasing);
+
+    auto *infoLabel = new QLabel(tr("%1 frames, tau0 = %2 ms").arg(m_result.frameCount)
+                                     .arg(m_result.samplePeriodS * 1.0e3, 0, 'f', 3), this);
+    auto *sensorLayout = new QHBoxLayout();
+    sensorLayout->addWidget(new QLabel(tr("Sensor:"), this));
+    sensorLayout->addWidget(m_sensorCombo);
+    sensorLayout->addStretch();
+    sensorLayout->addWidget(infoLabel);
+
+    auto *buttons = new QDialogButtonBox(QDialogButtonBox::Close, this);
+    QPushButton *exportButton = buttons->addButton(tr("Export CSV..."), QDialogButtonBox::ActionRole);
+
+    auto *mainLayout = new QVBoxLayout(this);
+    mainLayout->addLayout(sensorLayout);
+    mainLayout->addWidget(chartView);
+    mainLayout->addWidget(buttons);
+
+    connect(m_sensorCombo, &QComboBox::currentIndexChanged, this, &AllanDeviationDialog::showSensor);
+    connect(exportButton, &QPushButton::clicked, this, &AllanDeviationDialog::exportCsv);
+    connect(buttons, &QDialogButtonBox::rejected, this, &QDialog::reject);
+    showSensor();
+}
+
+void AllanDeviationDialog::showSensor() {
+    m_chart->removeAllSeries();
+    for (QAbstractAxis *axis : m_chart->axes()) {
+        m_chart->removeAxis(axis);
+        delete axis;
+    }
+
+    const int firstChannel = m_sensorCombo->currentIndex() * AXES_PER_SENSOR_ADD;
+    const QString axisNames[AXES_PER_SENSOR_ADD] = {QStringLiteral("X"), QStringLiteral("Y"), QStringLiteral("Z")};
+    auto *axisX = new QLogValueAxis();
+    axisX->setTitleText(tr("Averaging time τ [s]"));
+    axisX->setLabelFormat(QStringLiteral("%g"));
+    auto *axisY = new QLogValueAxis();
+    axisY->setTitleText(tr("Allan deviation %1").arg(m_sensorCombo->currentText()));
+    axisY->setLabelFormat(QStringLiteral("%g"));
+    m_chart->addAxis(axisX, Qt::AlignBottom);
+    m_chart->addAxis(axisY, Qt::AlignLeft);
+
+    double minY = std::numeric_limits<double>::max();
+    double maxY = 0.0;
+    for (int axis = 0; axis < AXES_PER_SENSOR_ADD; ++axis) {
+        auto *series = new QLineSeries();
+        series->setName(axisNames[axis]);
+        for (const AllanDeviation::Point &point : std::as_const(m_result.points)) {
+            const double deviation = point.deviation[firstChannel + axis];
+            if (deviation <= 0.0) {
+                continue; // Oś logarytmiczna nie przyjmuje zera (np. stały kanał)
+            }
+            series->append(point.tauS, deviation);
+            minY = qMin(minY, deviation);
+            maxY = qMax(maxY, deviation);
+        }
+        m_chart->addSeries(series);
+        series->attachAxis(axisX);
+        series->attachAxis(axisY);
+    }
+    if (!m_result.points.isEmpty()) {
+        axisX->setRange(m_result.points.first().tauS, m_result.points.last().tauS);
+    }
+    if (maxY > 0.0) {
+        axisY->setRange(minY / 2.0, maxY * 2.0); // Margines wokół danych na osi logarytmicznej
+    }
+}
+
+void AllanDeviationDialog::exportCsv() {
+    const QString suggestedName = QFileInfo(m_sourceName).completeBaseName() + QStringLiteral("_adev.csv");
+    const QString filePath = QFileDialog::getSaveFileName(this, tr("Export Allan Deviation"), suggestedName,
+                                                          tr("CSV files (*.csv)"));
+    if (filePath.isEmpty()) {
+        return;
+    }
+    QString errorString;
+    if (!AllanDeviation::writeCsv(m_result, filePath, &errorString)) {
+        QMessageBox::warning(this, tr("Allan Deviation"), tr("Failed to write CSV file: %1").arg(errorString));
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef ALLANDEVIATIONDIALOG_H
+#define ALLANDEVIATIONDIALOG_H
+
+/**
+ * @file AllanDeviationDialog.h
+ * @brief Definicja klasy AllanDeviationDialog - wykres log-log odchylenia Allana i eksport CSV.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-17
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include "AllanDeviation.h"
+#include <QDialog>
+
+QT_BEGIN_NAMESPACE
+class QComboBox;
+class QChart;
+QT_END_NAMESPACE
+
+/**
+ * @class AllanDeviationDialog
+ * @brief Pokazuje wynik `AllanDeviation::analyzeFile()` jako wykres w skali logarytmicznej.
+ *
+ * @details
+ * Wykres przedstawia osie X, Y, Z wybranego czujnika (żyroskop, akcelerometr, magnetometr -
+ * jednostki są różne, więc czujniki nie są łączone na jednym wykresie). Przycisk eksportu zapisuje
+ * wszystkie kanały do CSV (`AllanDeviation::writeCsv()`).
+ */
+class AllanDeviationDialog : public QDialog {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Konstruktor.
+     * @param result [in] Wynik analizy.
+     * @param sourceName [in] Nazwa analizowanego nagrania (tytuł okna).
+     * @param parent [in] Widget nadrzędny.
+     */
+    AllanDeviationDialog(const AllanDeviation::Result &result, const QString &sourceName, QWidget *parent = nullptr);
+
+private slots:
+    /** @brief Rysuje osie czujnika wybranego na liście. */
+    void showSensor();
+
+    /** @brief Pyta o plik i zapisuje charakterystykę do CSV. */
+    void exportCsv();
+
+private:
+    AllanDeviation::Result m_result; //!< Wynik analizy.
+    QString m_sourceName; //!< Nazwa nagrania.
+    QComboBox *m_sensorCombo; //!< Wybór czujnika.
+    QChart *m_chart; //!< Wykres log-log.
+};
+
+#endif // ALLANDEVIATIONDIALOG_H
@@ -6,6 +6,9 @@
  */
 
 #include "Compass2DRenderer.h"
+#include "LatencyTracer.h"
+#include "PerfCounters.h"
+#include <QElapsedTimer>
 #include <QPainter>
 #include <QtMath> // Dla qDegreesToRadians, qSin, qCos, fmod
 #include <QPen>
@@ -58,6 +61,8 @@ QSize Compass2DRenderer::minimumSizeHint() const {
 
 void Compass2DRenderer::paintEvent(QPaintEvent *event) {
     Q_UNUSED(event); // Zaznaczenie, że parametr event nie jest używany w tej funkcji
+    QElapsedTimer paintTimer;
+    paintTimer.start();
     QPainter painter(this);
     painter.setRenderHint(QPainter::Antialiasing); // Włączenie antyaliasingu dla gładszych krawędzi
 
@@ -144,4 +149,7 @@ void Compass2DRenderer::paintEvent(QPaintEvent *event) {
     painter.drawEllipse(QRectF(-6, -6, 12, 12));
 
     painter.restore(); // Przywrócenie stanu sprzed rysowania igły
+    painter.end();
+    PerfCounters::addPaintTime(PerfCounters::PaintSource::Compass, paintTimer.nsecsElapsed());
+    LatencyTracer::markPaint(); // Koniec potoku: dane ramki są już na ekranie
 }
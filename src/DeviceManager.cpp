@@ -0,0 +1,296 @@
+/**
+ * @file DeviceManager.cpp
+ * @brief Implementacja klasy DeviceManager.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-04
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include "DeviceManager.h"
+#include "SerialPortHandler.h"
+#include "NetworkFrameSource.h"
+#include "FrameDiagnostics.h"
+#include "LatencyTracer.h"
+#include <QSerialPortInfo>
+#include <QThread>
+#include <QTimer>
+#include <QDebug>
+
+constexpr qsizetype INITIAL_BATCH_CAPACITY_DM = 256; // Ramek na paczkę - bufory rosną w razie potrzeby
+
+DeviceManager::DeviceManager(QObject *parent)
+    : QObject(parent),
+      m_ioThread(new QThread(this)),
+      m_ioContext(new QObject()),
+      m_flushTimer(nullptr) {
+    qRegisterMetaType<SensorFrame>();
+    qRegisterMetaType<QVector<SensorFrame>>();
+    for (QVector<SensorFrame> &batch: m_batchPool) {
+        batch.reserve(INITIAL_BATCH_CAPACITY_DM);
+    }
+
+    m_ioThread->setObjectName(QStringLiteral("OrientaIO"));
+    m_ioContext->moveToThread(m_ioThread);
+    m_ioThread->start();
+
+    // Timer musi powstać w wątku, w którym będzie działał
+    QMetaObject::invokeMethod(m_ioContext, [this] {
+        m_flushTimer = new QTimer(m_ioContext);
+        m_flushTimer->setInterval(FLUSH_INTERVAL_MS);
+        m_flushTimer->setTimerType(Qt::PreciseTimer);
+        QObject::connect(m_flushTimer, &QTimer::timeout, m_ioContext, [this] { flushFrames(); });
+    }, Qt::BlockingQueuedConnection);
+}
+
+DeviceManager::~DeviceManager() {
+    stopPublishing();
+    stopSharedMemoryExport();
+    removeAllDevices();
+    QMetaObject::invokeMethod(m_ioContext, [this] {
+        delete m_ioContext; // Usuwa również timer
+    }, Qt::BlockingQueuedConnection);
+    m_ioThread->quit();
+    m_ioThread->wait();
+}
+
+int DeviceManager::addSerialDevice(const QString &portName, qint32 baudRate, QString *errorString) {
+    // Numer seryjny adaptera USB nie zmienia się po przełożeniu do innego gniazda
+    const QString serialNumber = QSerialPortInfo(portName).serialNumber();
+    const QString key = serialNumber.isEmpty() ? portName : QStringLiteral("serial:") + serialNumber;
+    return addSource(portName, key, [portName, baudRate](QObject *parent, QString &openError) -> FrameSource * {
+        auto *handler = new SerialPortHandler(parent);
+        if (!handler->openPort(portName, baudRate)) {
+            openError = handler->getLastError();
+            delete handler;
+            return nullptr;
+        }
+        return handler;
+    }, errorString);
+}
+
+int DeviceManager::addNetworkDevice(const QString &address, QString *errorString) {
+    NetworkFrameSource::Protocol protocol = NetworkFrameSource::Protocol::Udp;
+    QString host;
+    quint16 port = 0;
+    QString key = address.trimmed();
+    if (NetworkFrameSource::parseAddress(address, protocol, host, port)) {
+        key = QStringLiteral("%1://%2:%3")
+                .arg(protocol == NetworkFrameSource::Protocol::Tcp ? QStringLiteral("tcp") : QStringLiteral("udp"),
+                     host.toLower())
+                .arg(port);
+    }
+    return addSource(address.trimmed(), key, [address](QObject *parent, QString &openError) -> FrameSource * {
+        auto *source = new NetworkFrameSource(parent);
+        if (!source->open(address)) {
+            openError = source->getLastError();
+            delete source;
+            return nullptr;
+        }
+        return source;
+    }, errorString);
+}
+
+int DeviceManager::addSource(const QString &name, const QString &key,
+                             const std::function<FrameSource *(QObject *, QString &)> &openSource, QString *errorString) {
+    for (const QString &openName: std::as_const(m_deviceNames)) {
+        if (openName == name) {
+            if (errorString) {
+                *errorString = tr("Source %1 is already open.").arg(name);
+            }
+            return -1;
+        }
+    }
+
+    const int deviceId = m_nextDeviceId;
+    bool opened = false;
+    QString openError;
+    QMetaObject::invokeMethod(m_ioContext, [&] {
+        FrameSource *source = openSource(m_ioContext, openError);
+        if (!source) {
+            return;
+        }
+        source->setDeviceId(deviceId);
+        QObject::connect(source, &FrameSource::frameReceived, m_ioContext, [this](const SensorFrame &frame) {
+            if (m_sharedRing) {
+                m_sharedRing->publish(frame); // Od razu, bez czekania na paczkę
+            }
+            m_merger.push(frame);
+            if (!m_flushTimer->isActive()) {
+                m_flushTimer->start(); // Timer działa tylko, gdy są ramki do przekazania
+            }
+        });
+        QObject::connect(source, &FrameSource::errorOccurred, m_ioContext, [this, deviceId](const QString &message) {
+            emit deviceError(deviceId, message);
+        });
+        m_sources.insert(deviceId, source);
+        m_merger.addDevice(deviceId);
+        opened = true;
+    }, Qt::BlockingQueuedConnection);
+
+    if (!opened) {
+        if (errorString) {
+            *errorString = openError;
+        }
+        return -1;
+    }
+    ++m_nextDeviceId;
+    m_deviceNames.insert(deviceId, name);
+    m_deviceKeys.insert(deviceId, key);
+    qInfo() << "Device" << deviceId << "opened on" << name << "-" << m_deviceNames.size() << "device(s) active.";
+    emit devicesChanged();
+    return deviceId;
+}
+
+void DeviceManager::removeDevice(int deviceId) {
+    if (!m_deviceNames.contains(deviceId)) {
+        return;
+    }
+    QMetaObject::invokeMethod(m_ioContext, [this, deviceId] {
+        flushFrames(); // Ramki odebrane przed zamknięciem nie powinny przepaść
+        if (FrameSource *source = m_sources.take(deviceId)) {
+            source->close();
+            delete source;
+        }
+        m_merger.removeDevice(deviceId);
+        if (m_sources.isEmpty()) {
+            m_flushTimer->stop(); // Bez urządzeń wątek I/O nie budzi się wcale
+        }
+    }, Qt::BlockingQueuedConnection);
+    m_deviceNames.remove(deviceId);
+    m_deviceKeys.remove(deviceId);
+    emit devicesChanged();
+}
+
+void DeviceManager::removeAllDevices() {
+    for (int deviceId: deviceIds()) {
+        removeDevice(deviceId);
+    }
+}
+
+QString DeviceManager::deviceName(int deviceId) const {
+    return QStringLiteral("#%1 %2").arg(deviceId).arg(m_deviceNames.value(deviceId));
+}
+
+QString DeviceManager::deviceKey(int deviceId) const {
+    return m_deviceKeys.value(deviceId);
+}
+
+DeviceManager::DeviceStats DeviceManager::deviceStats(int deviceId) const {
+    DeviceStats stats;
+    stats.portName = m_deviceNames.value(deviceId);
+    QMetaObject::invokeMethod(m_ioContext, [&] {
+        if (const FrameSource *source = m_sources.value(deviceId)) {
+            stats.sequence = source->sequenceStats();
+            stats.timingSummary = source->frameTimingStats().summaryText();
+            stats.rejectedFrames = source->frameDiagnostics()->totalCount();
+        }
+    }, Qt::BlockingQueuedConnection);
+    return stats;
+}
+
+void DeviceManager::setReorderWindowMs(int windowMs) {
+    QMetaObject::invokeMethod(m_ioContext, [this, windowMs] {
+        m_merger.setReorderWindowNs(static_cast<qint64>(windowMs) * 1000000);
+    }, Qt::BlockingQueuedConnection);
+}
+
+bool DeviceManager::startPublishing(const QString &serverName, QString *errorString) {
+    stopPublishing();
+    bool started = false;
+    QString fullName;
+    QMetaObject::invokeMethod(m_ioContext, [&] {
+        auto *publisher = new FramePublisher(m_ioContext);
+        if (!publisher->start(serverName, errorString)) {
+            delete publisher;
+            return;
+        }
+        m_publisher = publisher;
+        fullName = publisher->fullServerName();
+        started = true;
+    }, Qt::BlockingQueuedConnection);
+    m_publisherName = fullName;
+    return started;
+}
+
+void DeviceManager::stopPublishing() {
+    if (!isPublishing()) {
+        return;
+    }
+    QMetaObject::invokeMethod(m_ioContext, [this] {
+        delete m_publisher;
+        m_publisher = nullptr;
+    }, Qt::BlockingQueuedConnection);
+    m_publisherName.clear();
+}
+
+FramePublisher::Stats DeviceManager::publisherStats() const {
+    FramePublisher::Stats stats;
+    QMetaObject::invokeMethod(m_ioContext, [&] {
+        if (m_publisher) {
+            stats = m_publisher->stats();
+        }
+    }, Qt::BlockingQueuedConnection);
+    return stats;
+}
+
+bool DeviceManager::startSharedMemoryExport(const QString &name, quint32 capacity, QString *errorString) {
+    stopSharedMemoryExport();
+    auto *ring = new SharedFrameRing;
+    if (!ring->create(name, capacity, errorString)) {
+        delete ring;
+        return false;
+    }
+    // Wskaźnik podmieniany w wątku I/O - zapis ramek nie wymaga synchronizacji
+    QMetaObject::invokeMethod(m_ioContext, [this, ring] {
+        m_sharedRing = ring;
+    }, Qt::BlockingQueuedConnection);
+    m_sharedRingName = name;
+    return true;
+}
+
+void DeviceManager::stopSharedMemoryExport() {
+    if (!isExportingSharedMemory()) {
+        return;
+    }
+    SharedFrameRing *ring = nullptr;
+    QMetaObject::invokeMethod(m_ioContext, [this, &ring] {
+        ring = m_sharedRing;
+        m_sharedRing = nullptr;
+    }, Qt::BlockingQueuedConnection);
+    delete ring;
+    m_sharedRingName.clear();
+}
+
+quint64 DeviceManager::sharedMemoryFramesWritten() const {
+    quint64 frames = 0;
+    QMetaObject::invokeMethod(m_ioContext, [&] {
+        if (m_sharedRing) {
+            frames = m_sharedRing->writeIndex();
+        }
+    }, Qt::BlockingQueuedConnection);
+    return frames;
+}
+
+void DeviceManager::flushFrames() {
+    if (m_merger.pendingFrames() == 0) {
+        m_flushTimer->stop(); // Bezczynny wątek I/O nie budzi się - kolejna ramka uruchomi timer ponownie
+        return;
+    }
+    // Kolejkowany sygnał trzyma kopię (współdzieloną) paczki do czasu obsłużenia w wątku GUI - wybierany
+    // jest bufor już zwolniony, aby clear() zachował pojemność zamiast odłączać dane (alokacja tylko,
+    // gdy wątek GUI zalega z wszystkimi paczkami)
+    int slot = 0;
+    while (slot < BATCH_POOL_SIZE - 1 && !m_batchPool[slot].isDetached()) {
+        ++slot;
+    }
+    QVector<SensorFrame> &batch = m_batchPool[slot];
+    batch.clear();
+    m_merger.popReady(LatencyTracer::nowNs(), batch);
+    if (!batch.isEmpty()) {
+        if (m_publisher) {
+            m_publisher->publish(batch); // Przed przekazaniem do GUI - klienci nie czekają na wątek GUI
+        }
+        emit framesReady(batch);
+    }
+}
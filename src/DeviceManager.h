@@ -0,0 +1,228 @@
+#ifndef DEVICEMANAGER_H
+#define DEVICEMANAGER_H
+
+/**
+ * @file DeviceManager.h
+ * @brief Definicja klasy DeviceManager - obsługa wielu źródeł ramek (port szeregowy, sieć) w jednym wątku I/O.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-04
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include <QObject>
+#include <QHash>
+#include <QMap>
+#include <QString>
+#include <QVector>
+#include <functional>
+#include "SensorFrame.h"
+#include "SequenceTracker.h"
+#include "FrameMerger.h"
+#include "FramePublisher.h"
+#include "SharedFrameRing.h"
+
+class QThread;
+class QTimer;
+class FrameSource;
+
+/**
+ * @class DeviceManager
+ * @brief Otwiera wiele źródeł ramek, znakuje ramki identyfikatorem urządzenia i scala je w jeden strumień.
+ *
+ * @details
+ * Wszystkie źródła (`SerialPortHandler`, `NetworkFrameSource`) żyją w jednym wątku I/O - pętla zdarzeń
+ * tego wątku multipleksuje deskryptory wszystkich portów i gniazd, więc liczba wątków nie rośnie
+ * z liczbą urządzeń. Ramki trafiają
+ * do `FrameMerger`, a co `FLUSH_INTERVAL_MS` gotowe ramki (uporządkowane wg czasu odbioru) są
+ * przekazywane do wątku GUI jedną paczką (`framesReady()`). Liczba wybudzeń wątku GUI zależy więc
+ * od interwału, a nie od liczby urządzeń i częstotliwości ramek. Timer paczek działa tylko wtedy, gdy
+ * w `FrameMerger` czekają ramki - bez danych wątek I/O nie jest wybudzany.
+ *
+ * Opcjonalnie te same paczki są publikowane innym procesom przez gniazdo lokalne (`FramePublisher`,
+ * `startPublishing()`); kodowanie i zapis do klientów odbywa się w wątku I/O, niezależnie od GUI.
+ * Procesom wymagającym najmniejszego opóźnienia ramki są udostępniane w pamięci współdzielonej
+ * (`SharedFrameRing`, `startSharedMemoryExport()`) - każda ramka zaraz po zdekodowaniu, bez paczkowania.
+ *
+ * Metody publiczne wywołuje się z wątku, w którym żyje obiekt (GUI); operacje na portach są
+ * wykonywane synchronicznie w wątku I/O.
+ */
+class DeviceManager : public QObject {
+    Q_OBJECT
+
+public:
+    static constexpr int FLUSH_INTERVAL_MS = 4; //!< Okres przekazywania paczek ramek do wątku GUI.
+    static constexpr int BATCH_POOL_SIZE = 4; //!< Liczba buforów paczek używanych na zmianę.
+
+    /**
+     * @struct DeviceStats
+     * @brief Migawka statystyk jednego urządzenia.
+     */
+    struct DeviceStats {
+        QString portName; //!< Nazwa portu lub adres źródła sieciowego.
+        SequenceTracker::Stats sequence; //!< Statystyki numerów sekwencyjnych.
+        QString timingSummary; //!< Podsumowanie odstępów i jittera (`FrameTimingStats::summaryText()`).
+        quint64 rejectedFrames = 0; //!< Linie odrzucone (CRC, format).
+    };
+
+    /**
+     * @brief Konstruktor - uruchamia wątek I/O.
+     * @param parent [in] Obiekt nadrzędny.
+     */
+    explicit DeviceManager(QObject *parent = nullptr);
+
+    /**
+     * @brief Destruktor - zamyka wszystkie porty i zatrzymuje wątek I/O.
+     */
+    ~DeviceManager() override;
+
+    /**
+     * @brief Otwiera port szeregowy jako nowe urządzenie.
+     * @param portName [in] Nazwa portu.
+     * @param baudRate [in] Prędkość transmisji.
+     * @param errorString [out] Opcjonalnie: opis błędu, jeśli otwarcie się nie powiodło.
+     * @return Identyfikator urządzenia (> 0) albo -1 w przypadku błędu.
+     */
+    int addSerialDevice(const QString &portName, qint32 baudRate = 115200, QString *errorString = nullptr);
+
+    /**
+     * @brief Otwiera źródło sieciowe jako nowe urządzenie.
+     * @param address [in] Adres `udp://[adres]:port` lub `tcp://host:port` (`NetworkFrameSource`).
+     * @param errorString [out] Opcjonalnie: opis błędu, jeśli otwarcie się nie powiodło.
+     * @return Identyfikator urządzenia (> 0) albo -1 w przypadku błędu.
+     */
+    int addNetworkDevice(const QString &address, QString *errorString = nullptr);
+
+    /**
+     * @brief Zamyka urządzenie i odrzuca jego oczekujące ramki.
+     * @param deviceId [in] Identyfikator urządzenia.
+     */
+    void removeDevice(int deviceId);
+
+    /** @brief Zamyka wszystkie urządzenia. */
+    void removeAllDevices();
+
+    /** @brief Zwraca identyfikatory otwartych urządzeń (rosnąco). */
+    QList<int> deviceIds() const { return m_deviceNames.keys(); }
+
+    /** @brief Informuje, czy otwarte jest co najmniej jedno urządzenie. */
+    bool hasDevices() const { return !m_deviceNames.isEmpty(); }
+
+    /**
+     * @brief Zwraca nazwę urządzenia do wyświetlenia (np. `#2 ttyUSB1`).
+     * @param deviceId [in] Identyfikator urządzenia.
+     */
+    QString deviceName(int deviceId) const;
+
+    /**
+     * @brief Zwraca trwały identyfikator urządzenia do zapisu ustawień (np. kalibracji).
+     * @details Dla portu szeregowego - numer seryjny adaptera USB (`serial:<numer>`), a gdy go brak,
+     * nazwa portu; dla źródła sieciowego - adres `protokół://host:port`. W odróżnieniu od `deviceName()`
+     * nie zależy od kolejności otwierania urządzeń.
+     * @param deviceId [in] Identyfikator urządzenia.
+     */
+    QString deviceKey(int deviceId) const;
+
+    /**
+     * @brief Zwraca migawkę statystyk urządzenia (pobieraną w wątku I/O).
+     * @param deviceId [in] Identyfikator urządzenia.
+     */
+    DeviceStats deviceStats(int deviceId) const;
+
+    /**
+     * @brief Ustawia maksymalny czas oczekiwania na ramki wolniejszych urządzeń przy scalaniu.
+     * @param windowMs [in] Okno w milisekundach.
+     */
+    void setReorderWindowMs(int windowMs);
+
+    /**
+     * @brief Uruchamia publikację scalonego strumienia ramek przez gniazdo lokalne.
+     * @param serverName [in] Nazwa serwera (`FramePublisher::DEFAULT_SERVER_NAME`).
+     * @param errorString [out] Opcjonalnie: opis błędu.
+     * @return `true`, jeśli serwer nasłuchuje.
+     */
+    bool startPublishing(const QString &serverName, QString *errorString = nullptr);
+
+    /** @brief Zatrzymuje publikację i rozłącza klientów. */
+    void stopPublishing();
+
+    /** @brief Informuje, czy publikacja jest włączona. */
+    bool isPublishing() const { return !m_publisherName.isEmpty(); }
+
+    /** @brief Zwraca pełną nazwę gniazda publikacji (pusta, jeśli wyłączona). */
+    QString publisherName() const { return m_publisherName; }
+
+    /** @brief Zwraca liczniki publikacji (pobierane w wątku I/O). */
+    FramePublisher::Stats publisherStats() const;
+
+    /**
+     * @brief Uruchamia eksport ramek do bufora cyklicznego w pamięci współdzielonej.
+     * @param name [in] Nazwa segmentu POSIX (`SharedFrameRing::DEFAULT_NAME`).
+     * @param capacity [in] Liczba slotów bufora.
+     * @param errorString [out] Opcjonalnie: opis błędu.
+     * @return `true`, jeśli segment został utworzony.
+     */
+    bool startSharedMemoryExport(const QString &name, quint32 capacity = SharedFrameRing::DEFAULT_CAPACITY,
+                                 QString *errorString = nullptr);
+
+    /** @brief Zatrzymuje eksport i usuwa segment pamięci współdzielonej. */
+    void stopSharedMemoryExport();
+
+    /** @brief Informuje, czy eksport do pamięci współdzielonej jest włączony. */
+    bool isExportingSharedMemory() const { return !m_sharedRingName.isEmpty(); }
+
+    /** @brief Zwraca nazwę segmentu eksportu (pusta, jeśli wyłączony). */
+    QString sharedMemoryName() const { return m_sharedRingName; }
+
+    /** @brief Zwraca liczbę ramek zapisanych do pamięci współdzielonej (pobierana w wątku I/O). */
+    quint64 sharedMemoryFramesWritten() const;
+
+signals:
+    /**
+     * @brief Paczka ramek wszystkich urządzeń uporządkowana wg `SensorFrame::hostTimestampNs`.
+     * @param frames [out] Ramki (z ustawionym `SensorFrame::deviceId`).
+     */
+    void framesReady(const QVector<SensorFrame> &frames);
+
+    /** @brief Zmieniła się lista urządzeń. */
+    void devicesChanged();
+
+    /**
+     * @brief Błąd komunikacji urządzenia.
+     * @param deviceId [out] Identyfikator urządzenia.
+     * @param errorString [out] Opis błędu.
+     */
+    void deviceError(int deviceId, const QString &errorString);
+
+private:
+    /**
+     * @brief Tworzy i otwiera źródło w wątku I/O, a następnie rejestruje je jako urządzenie.
+     * @param name [in] Nazwa źródła (port lub adres) - nie może się powtarzać.
+     * @param key [in] Trwały identyfikator urządzenia (zob. `deviceKey()`).
+     * @param openSource [in] Funkcja wywoływana w wątku I/O: tworzy źródło z podanym rodzicem
+     * i otwiera je; zwraca `nullptr` (i opis błędu) w razie niepowodzenia.
+     * @param errorString [out] Opcjonalnie: opis błędu.
+     * @return Identyfikator urządzenia albo -1.
+     */
+    int addSource(const QString &name, const QString &key,
+                  const std::function<FrameSource *(QObject *, QString &)> &openSource, QString *errorString);
+
+    /** @brief Przekazuje gotowe ramki do odbiorców (wątek I/O). */
+    void flushFrames();
+
+    QThread *m_ioThread; //!< Wątek I/O wszystkich portów.
+    QObject *m_ioContext; //!< Obiekt w wątku I/O - rodzic źródeł i timera.
+    QTimer *m_flushTimer; //!< Timer paczek (w wątku I/O).
+    QHash<int, FrameSource *> m_sources; //!< Źródła urządzeń (dostęp tylko w wątku I/O).
+    FrameMerger m_merger; //!< Scalanie strumieni (dostęp tylko w wątku I/O).
+    QVector<SensorFrame> m_batchPool[BATCH_POOL_SIZE]; //!< Bufory paczek wielokrotnego użytku (wątek I/O).
+    FramePublisher *m_publisher = nullptr; //!< Publikacja ramek innym procesom (wątek I/O); `nullptr` - wyłączona.
+    QString m_publisherName; //!< Pełna nazwa gniazda publikacji (wątek GUI).
+    SharedFrameRing *m_sharedRing = nullptr; //!< Eksport do pamięci współdzielonej (zapis w wątku I/O); `nullptr` - wyłączony.
+    QString m_sharedRingName; //!< Nazwa segmentu eksportu (wątek GUI).
+    QMap<int, QString> m_deviceNames; //!< Nazwy (porty, adresy) otwartych urządzeń (wątek GUI).
+    QMap<int, QString> m_deviceKeys; //!< Trwałe identyfikatory otwartych urządzeń (wątek GUI).
+    int m_nextDeviceId = 1; //!< Kolejny identyfikator urządzenia.
+};
+
+#endif // DEVICEMANAGER_H
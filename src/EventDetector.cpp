@@ -0,0 +1,150 @@
+/**
+ * @file EventDetector.cpp
+ * @brief Implementacja klasy EventDetector.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-18
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include "EventDetector.h"
+#include <QtMath>
+#include <cmath>
+
+constexpr int GYRO_X_IDX_ED = 0; // Kolejne: Y, Z
+constexpr int ACC_X_IDX_ED = 3;
+constexpr float ONE_G_MG_ED = 1000.0f;
+constexpr double MG_PER_NS_TO_G_PER_S_ED = 1.0e6; // (mg / 1000) / (ns / 1e9)
+
+EventDetector::EventDetector()
+    : m_holdNs(DEFAULT_HOLD_NS),
+      m_hasPrevious(false),
+      m_previousNs(0),
+      m_slopeStartNs(0),
+      m_slopeStartAccMagnitude(0.0f),
+      m_derivative(0.0f),
+      m_gyroEnergy(0.0) {
+    for (int kind = 0; kind < KIND_COUNT; ++kind) {
+        m_levels[kind] = defaultLevel(static_cast<Kind>(kind));
+    }
+}
+
+void EventDetector::setLevel(Kind kind, const Level &level) {
+    Level &target = m_levels[static_cast<int>(kind)];
+    target = level;
+    target.off = qMin(level.off, level.on); // Histereza nie może być odwrócona
+    m_states[static_cast<int>(kind)] = State();
+}
+
+void EventDetector::setHoldTime(qint64 holdNs) {
+    m_holdNs = qMax<qint64>(0, holdNs);
+}
+
+int EventDetector::process(const float *const *frames, const qint64 *timestampsNs, int count) {
+    m_events.clear();
+    for (int i = 0; i < count; ++i) {
+        const float *frame = frames[i];
+        const qint64 timestampNs = timestampsNs[i];
+        if (m_hasPrevious && timestampNs < m_previousNs) {
+            reset(); // Czas się cofnął - nowe odtwarzanie
+        }
+        const float *acc = frame + ACC_X_IDX_ED;
+        const float *gyro = frame + GYRO_X_IDX_ED;
+        const float accMagnitude = std::sqrt(acc[0] * acc[0] + acc[1] * acc[1] + acc[2] * acc[2]);
+        const double gyroSquared = static_cast<double>(gyro[0]) * gyro[0] + static_cast<double>(gyro[1]) * gyro[1] +
+                                   static_cast<double>(gyro[2]) * gyro[2];
+
+        if (!m_hasPrevious) {
+            m_gyroEnergy = gyroSquared;
+            m_derivative = 0.0f;
+            m_slopeStartNs = timestampNs;
+            m_slopeStartAccMagnitude = accMagnitude;
+        } else if (timestampNs > m_previousNs) { // Ramki o tym samym czasie nie zmieniają pochodnej
+            const qint64 dtNs = timestampNs - m_previousNs;
+            // Czas odbioru ramek z paczki różni się o mikrosekundy - pochodna dopiero po minimalnym odcinku
+            const qint64 spanNs = timestampNs - m_slopeStartNs;
+            if (spanNs >= DERIVATIVE_MIN_SPAN_NS) {
+                m_derivative = static_cast<float>((accMagnitude - m_slopeStartAccMagnitude) *
+                                                  MG_PER_NS_TO_G_PER_S_ED / spanNs);
+                m_slopeStartNs = timestampNs;
+                m_slopeStartAccMagnitude = accMagnitude;
+            }
+            // Wykładnicza średnia z krokiem zależnym od odstępu ramek: alfa = dt / (tau + dt)
+            const double alpha = static_cast<double>(dtNs) / static_cast<double>(ENERGY_TIME_CONSTANT_NS + dtNs);
+            m_gyroEnergy += alpha * (gyroSquared - m_gyroEnergy);
+        }
+        m_hasPrevious = true;
+        m_previousNs = timestampNs;
+
+        update(Kind::Threshold, std::fabs(accMagnitude - ONE_G_MG_ED), timestampNs);
+        update(Kind::Derivative, std::fabs(m_derivative), timestampNs);
+        update(Kind::Energy, static_cast<float>(std::sqrt(m_gyroEnergy)), timestampNs);
+    }
+    return static_cast<int>(m_events.size());
+}
+
+void EventDetector::update(Kind kind, float value, qint64 timestampNs) {
+    const Level &level = m_levels[static_cast<int>(kind)];
+    if (!level.enabled) {
+        return;
+    }
+    State &state = m_states[static_cast<int>(kind)];
+    if (!state.active) {
+        if (value >= level.on) {
+            state.active = true;
+            state.startNs = timestampNs;
+            state.peakNs = timestampNs;
+            state.peak = value;
+            state.belowSinceNs = -1;
+        }
+        return;
+    }
+    if (value > state.peak) {
+        state.peak = value;
+        state.peakNs = timestampNs;
+    }
+    if (value >= level.off) {
+        state.belowSinceNs = -1;
+        return;
+    }
+    if (state.belowSinceNs < 0) {
+        state.belowSinceNs = timestampNs;
+    }
+    if (timestampNs - state.belowSinceNs >= m_holdNs) {
+        m_events.append({kind, state.startNs, state.belowSinceNs, state.peakNs, state.peak});
+        state.active = false;
+    }
+}
+
+void EventDetector::reset() {
+    for (State &state : m_states) {
+        state = State();
+    }
+    m_hasPrevious = false;
+    m_derivative = 0.0f;
+    m_gyroEnergy = 0.0;
+}
+
+EventDetector::Level EventDetector::defaultLevel(Kind kind) {
+    switch (kind) {
+    case Kind::Threshold:
+        return {true, 800.0f, 400.0f}; // Spadek swobodny daje odchylenie ok. 1000 mg
+    case Kind::Derivative:
+        return {true, 200.0f, 50.0f}; // 2 g w ciągu 10 ms
+    case Kind::Energy:
+        return {true, 250.0f, 150.0f};
+    }
+    return {};
+}
+
+QString EventDetector::kindName(Kind kind) {
+    switch (kind) {
+    case Kind::Threshold:
+        return QStringLiteral("threshold");
+    case Kind::Derivative:
+        return QStringLiteral("derivative");
+    case Kind::Energy:
+        return QStringLiteral("energy");
+    }
+    return {};
+}
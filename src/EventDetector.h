@@ -0,0 +1,136 @@
+#ifndef EVENTDETECTOR_H
+#define EVENTDETECTOR_H
+
+/**
+ * @file EventDetector.h
+ * @brief Definicja klasy EventDetector - strumieniowe wykrywanie wstrząsów, upadków i gwałtownych obrotów.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-18
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include <QString>
+#include <QVector>
+
+/**
+ * @class EventDetector
+ * @brief Trzy detektory zdarzeń na strumieniu ramek IMU, każdy z histerezą; koszt ramki jest stały.
+ *
+ * @details
+ * - `Threshold` - odchylenie modułu przyspieszenia od 1 g [mg]: uderzenia i swobodny spadek (moduł bliski 0).
+ * - `Derivative` - pochodna modułu przyspieszenia [g/s] (szarpnięcie): początek uderzenia także wtedy,
+ *   gdy akcelerometr się nasyca. Liczona względem próbki sprzed co najmniej `DERIVATIVE_MIN_SPAN_NS`,
+ *   aby ramki odebrane paczką (np. datagramy UDP w odstępach mikrosekund) nie zamieniały szumu rzędu
+ *   mg w tysiące g/s.
+ * - `Energy` - wartość skuteczna modułu prędkości kątowej [dps] z wykładniczą średnią kwadratu
+ *   (stała czasowa `ENERGY_TIME_CONSTANT_NS`): gwałtowne obroty i potrząsanie.
+ *
+ * Zdarzenie zaczyna się, gdy sygnał osiągnie próg włączenia (`Level::on`), a kończy, gdy pozostaje
+ * poniżej progu wyłączenia (`Level::off`) przez `holdTime()` - krótkie spadki w trakcie uderzenia nie
+ * dzielą go na kilka zdarzeń. Zdarzenie jest zgłaszane po zakończeniu, razem z wartością szczytową.
+ * Detektor przechowuje tylko stan bieżący (bez bufora próbek), więc może działać bez końca.
+ */
+class EventDetector {
+public:
+    /** @brief Rodzaj detektora. */
+    enum class Kind {
+        Threshold, //!< Odchylenie modułu przyspieszenia od 1 g [mg].
+        Derivative, //!< Pochodna modułu przyspieszenia [g/s].
+        Energy //!< Wartość skuteczna modułu prędkości kątowej [dps].
+    };
+
+    static constexpr int KIND_COUNT = 3; //!< Liczba rodzajów detektorów.
+    static constexpr qint64 DEFAULT_HOLD_NS = 200000000LL; //!< Domyślny czas podtrzymania zdarzenia (200 ms).
+    static constexpr qint64 ENERGY_TIME_CONSTANT_NS = 100000000LL; //!< Stała czasowa detektora `Energy` (100 ms).
+    static constexpr qint64 DERIVATIVE_MIN_SPAN_NS = 2000000LL; //!< Najkrótszy odcinek pochodnej `Derivative` (2 ms).
+
+    /** @brief Progi detektora. */
+    struct Level {
+        bool enabled = true; //!< Czy detektor działa.
+        float on = 0.0f; //!< Próg rozpoczęcia zdarzenia.
+        float off = 0.0f; //!< Próg zakończenia zdarzenia (nie większy niż `on`).
+    };
+
+    /** @brief Wykryte zdarzenie. */
+    struct Event {
+        Kind kind = Kind::Threshold; //!< Detektor, który wykrył zdarzenie.
+        qint64 startNs = 0; //!< Czas osiągnięcia progu włączenia [ns].
+        qint64 endNs = 0; //!< Czas spadku poniżej progu wyłączenia [ns].
+        qint64 peakNs = 0; //!< Czas wartości szczytowej [ns].
+        float peak = 0.0f; //!< Wartość szczytowa sygnału detektora.
+    };
+
+    /** @brief Konstruktor - detektory z domyślnymi progami (`defaultLevel()`). */
+    EventDetector();
+
+    /**
+     * @brief Zmienia progi detektora; wyłączenie lub zmiana przerywa bieżące zdarzenie tego detektora.
+     * @param kind [in] Detektor.
+     * @param level [in] Progi (`off` jest ograniczany do `on`).
+     */
+    void setLevel(Kind kind, const Level &level);
+
+    /** @brief Zwraca progi detektora. */
+    const Level &level(Kind kind) const { return m_levels[static_cast<int>(kind)]; }
+
+    /**
+     * @brief Ustawia czas, przez który sygnał musi pozostać poniżej progu wyłączenia, aby zakończyć zdarzenie.
+     * @param holdNs [in] Czas podtrzymania [ns] (nieujemny).
+     */
+    void setHoldTime(qint64 holdNs);
+
+    /** @brief Zwraca czas podtrzymania zdarzenia [ns]. */
+    qint64 holdTime() const { return m_holdNs; }
+
+    /**
+     * @brief Przetwarza paczkę ramek.
+     * @details Czas wcześniejszy niż ostatniej ramki (np. nowe odtwarzanie) zeruje stan detektorów.
+     * @param frames [in] Ramki IMU (żyroskop [dps] i akcelerometr [mg] na początku ramki).
+     * @param timestampsNs [in] Czasy ramek [ns].
+     * @param count [in] Liczba ramek.
+     * @return Liczba zdarzeń zakończonych w tej paczce (dostępnych przez `events()`).
+     */
+    int process(const float *const *frames, const qint64 *timestampsNs, int count);
+
+    /** @brief Zwraca zdarzenia zakończone w ostatnim wywołaniu `process()`. */
+    const QVector<Event> &events() const { return m_events; }
+
+    /** @brief Czy detektor jest w trakcie zdarzenia. */
+    bool isActive(Kind kind) const { return m_states[static_cast<int>(kind)].active; }
+
+    /** @brief Przerywa bieżące zdarzenia i zeruje historię sygnałów (np. po przeskoku w nagraniu). */
+    void reset();
+
+    /** @brief Zwraca domyślne progi detektora. */
+    static Level defaultLevel(Kind kind);
+
+    /** @brief Zwraca nazwę detektora używaną w QSettings (np. `threshold`). */
+    static QString kindName(Kind kind);
+
+private:
+    /** @brief Stan detektora między ramkami. */
+    struct State {
+        bool active = false; //!< Czy trwa zdarzenie.
+        qint64 startNs = 0; //!< Początek bieżącego zdarzenia.
+        qint64 peakNs = 0; //!< Czas wartości szczytowej.
+        float peak = 0.0f; //!< Wartość szczytowa.
+        qint64 belowSinceNs = -1; //!< Od kiedy sygnał jest poniżej progu wyłączenia (-1 - nie jest).
+    };
+
+    /** @brief Aktualizuje detektor próbką sygnału i ewentualnie zgłasza zakończone zdarzenie. */
+    void update(Kind kind, float value, qint64 timestampNs);
+
+    Level m_levels[KIND_COUNT]; //!< Progi detektorów.
+    State m_states[KIND_COUNT]; //!< Stan detektorów.
+    qint64 m_holdNs; //!< Czas podtrzymania zdarzenia.
+    bool m_hasPrevious; //!< Czy znana jest poprzednia ramka (pochodna, średnia energii).
+    qint64 m_previousNs; //!< Czas poprzedniej ramki.
+    qint64 m_slopeStartNs; //!< Czas próbki, od której liczona jest pochodna.
+    float m_slopeStartAccMagnitude; //!< Moduł przyspieszenia tej próbki [mg].
+    float m_derivative; //!< Ostatnia pochodna modułu przyspieszenia [g/s].
+    double m_gyroEnergy; //!< Wykładnicza średnia kwadratu modułu prędkości kątowej [dps²].
+    QVector<Event> m_events; //!< Zdarzenia z ostatniej paczki (pojemność zachowywana).
+};
+
+#endif // EVENTDETECTOR_H
@@ -0,0 +1,245 @@
+/**
+ * @file EventTimelineView.cpp
+ * @brief Implementacja klasy EventTimelineView.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-18
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include "EventTimelineView.h"
+#include <QCheckBox>
+#include <QDateTime>
+#include <QDoubleSpinBox>
+#include <QGridLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QPushButton>
+#include <QSettings>
+#include <QSignalBlocker>
+#include <QTableWidget>
+#include <QVBoxLayout>
+#include <algorithm>
+
+constexpr int COLUMN_COUNT_ETV = 4; // Czas, detektor, wartość szczytowa, czas trwania
+constexpr int DETECTOR_COLUMN_ETV = 1;
+constexpr int MAX_EVENTS_ETV = 2000; // Najwcześniejsze zdarzenia są usuwane z listy
+constexpr qint64 DUPLICATE_TOLERANCE_NS_ETV = 500000000LL; // Po przewinięciu zdarzenie może zacząć się nieco inaczej
+constexpr qint64 NS_PER_MS_ETV = 1000000;
+constexpr float MAX_LEVELS_ETV[EventDetector::KIND_COUNT] = {16000.0f, 10000.0f, 4000.0f}; // mg, g/s, dps
+const char *const UNITS_ETV[EventDetector::KIND_COUNT] = {" mg", " g/s", " dps"};
+const QString SETTINGS_GROUP_ETV = QStringLiteral("events");
+
+// Czas nagrania jako g:mm:ss.zzz (nagrania bywają dłuższe niż doba - bez QTime)
+static QString formatRecordingTime(qint64 timeNs) {
+    const qint64 totalMs = qMax<qint64>(0, timeNs / NS_PER_MS_ETV);
+    return QStringLiteral("%1:%2:%3.%4")
+            .arg(totalMs / 3600000)
+            .arg(totalMs / 60000 % 60, 2, 10, QLatin1Char('0'))
+            .arg(totalMs / 1000 % 60, 2, 10, QLatin1Char('0'))
+            .arg(totalMs % 1000, 3, 10, QLatin1Char('0'));
+}
+
+EventTimelineView::EventTimelineView(QWidget *parent)
+    : QWidget(parent),
+      m_onLabel(new QLabel(this)),
+      m_offLabel(new QLabel(this)),
+      m_countLabel(new QLabel(this)),
+      m_clearButton(new QPushButton(this)),
+      m_table(new QTableWidget(0, COLUMN_COUNT_ETV, this)) {
+    auto *levelsLayout = new QGridLayout();
+    levelsLayout->addWidget(m_onLabel, 0, 1);
+    levelsLayout->addWidget(m_offLabel, 0, 2);
+    QSettings settings;
+    settings.beginGroup(SETTINGS_GROUP_ETV);
+    for (int kind = 0; kind < EventDetector::KIND_COUNT; ++kind) {
+        const auto detectorKind = static_cast<EventDetector::Kind>(kind);
+        const EventDetector::Level defaults = EventDetector::defaultLevel(detectorKind);
+        const QString prefix = EventDetector::kindName(detectorKind) + QLatin1Char('/');
+        m_enabledChecks[kind] = new QCheckBox(this);
+        m_enabledChecks[kind]->setChecked(settings.value(prefix + QStringLiteral("enabled"), defaults.enabled).toBool());
+        m_onSpins[kind] = new QDoubleSpinBox(this);
+        m_offSpins[kind] = new QDoubleSpinBox(this);
+        for (QDoubleSpinBox *spin : {m_onSpins[kind], m_offSpins[kind]}) {
+            spin->setRange(0.0, MAX_LEVELS_ETV[kind]);
+            spin->setDecimals(0);
+            spin->setSingleStep(10.0);
+            spin->setSuffix(QLatin1String(UNITS_ETV[kind]));
+        }
+        m_onSpins[kind]->setValue(settings.value(prefix + QStringLiteral("on"), defaults.on).toDouble());
+        m_offSpins[kind]->setValue(settings.value(prefix + QStringLiteral("off"), defaults.off).toDouble());
+        levelsLayout->addWidget(m_enabledChecks[kind], kind + 1, 0);
+        levelsLayout->addWidget(m_onSpins[kind], kind + 1, 1);
+        levelsLayout->addWidget(m_offSpins[kind], kind + 1, 2);
+    }
+    settings.endGroup();
+    levelsLayout->setColumnStretch(3, 1);
+
+    m_table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_table->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_table->setSelectionMode(QAbstractItemView::SingleSelection);
+    m_table->verticalHeader()->setVisible(false);
+    m_table->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+
+    auto *listLayout = new QHBoxLayout();
+    listLayout->addWidget(m_countLabel);
+    listLayout->addStretch();
+    listLayout->addWidget(m_clearButton);
+
+    auto *mainLayout = new QVBoxLayout(this);
+    mainLayout->addLayout(levelsLayout);
+    mainLayout->addLayout(listLayout);
+    mainLayout->addWidget(m_table);
+    retranslateUi();
+
+    applyLevels();
+    for (int kind = 0; kind < EventDetector::KIND_COUNT; ++kind) {
+        connect(m_enabledChecks[kind], &QCheckBox::toggled, this, &EventTimelineView::applyLevels);
+        connect(m_onSpins[kind], &QDoubleSpinBox::valueChanged, this, &EventTimelineView::applyLevels);
+        connect(m_offSpins[kind], &QDoubleSpinBox::valueChanged, this, &EventTimelineView::applyLevels);
+    }
+    connect(m_clearButton, &QPushButton::clicked, this, &EventTimelineView::clear);
+    connect(m_table, &QTableWidget::cellClicked, this, &EventTimelineView::selectEvent);
+}
+
+void EventTimelineView::addFrames(const float *const *frames, const qint64 *timestampsNs, int count,
+                                  bool fromRecording, qint64 recordingOffsetNs) {
+    if (count == 0 || m_detector.process(frames, timestampsNs, count) == 0) {
+        return;
+    }
+    for (const EventDetector::Event &event : m_detector.events()) {
+        appendEvent(event, fromRecording, recordingOffsetNs, timestampsNs[count - 1]);
+    }
+    updateCountLabel();
+}
+
+void EventTimelineView::appendEvent(const EventDetector::Event &event, bool fromRecording, qint64 recordingOffsetNs,
+                                    qint64 latestFrameNs) {
+    Entry entry;
+    entry.kind = event.kind;
+    entry.fromRecording = fromRecording;
+    entry.startNs = event.startNs + (fromRecording ? recordingOffsetNs : 0);
+    entry.endNs = event.endNs + (fromRecording ? recordingOffsetNs : 0);
+    if (fromRecording) {
+        // Po przewinięciu wstecz ten sam fragment nagrania jest analizowany ponownie
+        for (const Entry &existing : std::as_const(m_entries)) {
+            if (existing.fromRecording && existing.kind == entry.kind &&
+                entry.startNs <= existing.endNs + DUPLICATE_TOLERANCE_NS_ETV &&
+                entry.endNs >= existing.startNs - DUPLICATE_TOLERANCE_NS_ETV) {
+                return;
+            }
+        }
+    }
+    // Po przewinięciu nagrania wstecz zdarzenie może być wcześniejsze niż ostatnie na liście
+    const auto position = std::upper_bound(m_entries.begin(), m_entries.end(), entry.startNs,
+                                           [](qint64 startNs, const Entry &existing) {
+                                               return startNs < existing.startNs;
+                                           });
+    int row = static_cast<int>(position - m_entries.begin());
+    if (m_entries.size() >= static_cast<size_t>(MAX_EVENTS_ETV)) {
+        if (row == 0) {
+            return; // Wcześniejsze niż wszystkie zachowane - i tak zostałoby usunięte
+        }
+        m_entries.pop_front(); // Deque - bez przesuwania pozostałych wpisów
+        m_table->removeRow(0);
+        --row;
+    }
+    m_entries.insert(m_entries.begin() + row, entry);
+
+    const int kind = static_cast<int>(event.kind);
+    const QString timeText = fromRecording
+                                 ? formatRecordingTime(entry.startNs)
+                                 : QDateTime::currentDateTime()
+                                       .addMSecs((event.startNs - latestFrameNs) / NS_PER_MS_ETV)
+                                       .toString(QStringLiteral("HH:mm:ss.zzz"));
+    m_table->insertRow(row);
+    const QString texts[COLUMN_COUNT_ETV] = {
+        timeText,
+        QString(),
+        QString::number(event.peak, 'f', 0) + QLatin1String(UNITS_ETV[kind]),
+        QString::number((event.endNs - event.startNs) / NS_PER_MS_ETV)
+    };
+    for (int column = 0; column < COLUMN_COUNT_ETV; ++column) {
+        auto *item = new QTableWidgetItem(texts[column]);
+        if (column != DETECTOR_COLUMN_ETV) {
+            item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+        }
+        m_table->setItem(row, column, item);
+    }
+    updateRowTexts(row);
+    m_table->scrollToItem(m_table->item(row, 0));
+}
+
+void EventTimelineView::updateRowTexts(int row) {
+    const Entry &entry = m_entries[row];
+    const QString detectorNames[EventDetector::KIND_COUNT] = {
+        tr("Acceleration threshold"), tr("Acceleration derivative"), tr("Rotation energy")
+    };
+    m_table->item(row, DETECTOR_COLUMN_ETV)->setText(detectorNames[static_cast<int>(entry.kind)]);
+    const QString toolTip = entry.fromRecording ? tr("Click to replay the recording from this event")
+                                                : tr("Live event - cannot be replayed");
+    for (int column = 0; column < COLUMN_COUNT_ETV; ++column) {
+        m_table->item(row, column)->setToolTip(toolTip);
+    }
+}
+
+void EventTimelineView::resetDetector() {
+    m_detector.reset();
+}
+
+void EventTimelineView::clear() {
+    m_entries.clear();
+    m_table->setRowCount(0);
+    updateCountLabel();
+}
+
+void EventTimelineView::applyLevels() {
+    QSettings settings;
+    settings.beginGroup(SETTINGS_GROUP_ETV);
+    for (int kind = 0; kind < EventDetector::KIND_COUNT; ++kind) {
+        const auto detectorKind = static_cast<EventDetector::Kind>(kind);
+        {
+            const QSignalBlocker blocker(m_offSpins[kind]); // Przycięcie wartości nie wywołuje ponownie applyLevels()
+            m_offSpins[kind]->setMaximum(m_onSpins[kind]->value()); // Próg wyłączenia nie większy niż włączenia
+        }
+        EventDetector::Level level;
+        level.enabled = m_enabledChecks[kind]->isChecked();
+        level.on = static_cast<float>(m_onSpins[kind]->value());
+        level.off = static_cast<float>(m_offSpins[kind]->value());
+        const EventDetector::Level &current = m_detector.level(detectorKind);
+        if (level.enabled == current.enabled && level.on == current.on && level.off == current.off) {
+            continue; // Bez przerywania zdarzeń detektorów, których progi się nie zmieniły
+        }
+        m_detector.setLevel(detectorKind, level);
+        const QString prefix = EventDetector::kindName(detectorKind) + QLatin1Char('/');
+        settings.setValue(prefix + QStringLiteral("enabled"), level.enabled);
+        settings.setValue(prefix + QStringLiteral("on"), level.on);
+        settings.setValue(prefix + QStringLiteral("off"), level.off);
+    }
+    settings.endGroup();
+}
+
+void EventTimelineView::selectEvent(int row) {
+    if (row >= 0 && static_cast<size_t>(row) < m_entries.size() && m_entries[row].fromRecording) {
+        emit eventSelected(m_entries[row].startNs);
+    }
+}
+
+void EventTimelineView::updateCountLabel() {
+    m_countLabel->setText(tr("%n event(s)", nullptr, static_cast<int>(m_entries.size())));
+}
+
+void EventTimelineView::retranslateUi() {
+    m_onLabel->setText(tr("Start above"));
+    m_offLabel->setText(tr("End below"));
+    m_enabledChecks[static_cast<int>(EventDetector::Kind::Threshold)]->setText(tr("Acceleration threshold (|a| - 1 g)"));
+    m_enabledChecks[static_cast<int>(EventDetector::Kind::Derivative)]->setText(tr("Acceleration derivative (jerk)"));
+    m_enabledChecks[static_cast<int>(EventDetector::Kind::Energy)]->setText(tr("Rotation energy (RMS |ω|)"));
+    m_clearButton->setText(tr("Clear"));
+    m_table->setHorizontalHeaderLabels({tr("Time"), tr("Detector"), tr("Peak"), tr("Duration [ms]")});
+    for (int row = 0; row < m_table->rowCount(); ++row) {
+        updateRowTexts(row);
+    }
+    updateCountLabel();
+}
@@ -0,0 +1,110 @@
+#ifndef EVENTTIMELINEVIEW_H
+#define EVENTTIMELINEVIEW_H
+
+/**
+ * @file EventTimelineView.h
+ * @brief Definicja klasy EventTimelineView - lista zdarzeń wykrytych w strumieniu IMU z przejściem do zdarzenia.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-18
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include "EventDetector.h"
+#include <QWidget>
+#include <deque>
+
+class QCheckBox;
+class QDoubleSpinBox;
+class QLabel;
+class QPushButton;
+class QTableWidget;
+
+/**
+ * @class EventTimelineView
+ * @brief Widget z progami detektorów `EventDetector` i chronologiczną listą wykrytych zdarzeń.
+ *
+ * @details
+ * Ramki trafiają do detektora zawsze (koszt stały), także gdy widok jest ukryty. Zdarzenia
+ * z odtwarzanego nagrania mają czas nagrania - kliknięcie takiego wiersza emituje
+ * `eventSelected()`, a okno główne przewija odtwarzanie do tej chwili. Wiersze są uporządkowane według
+ * początku zdarzenia - po przewinięciu zdarzenie trafia na swoje miejsce, a ponownie wykryte
+ * zdarzenia nie są dopisywane drugi raz. Progi są zapisywane w QSettings
+ * (`events/<detektor>/...`).
+ */
+class EventTimelineView : public QWidget {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Konstruktor - tworzy pola progów z zapamiętanymi wartościami i pustą listę zdarzeń.
+     * @param parent [in] Widget nadrzędny.
+     */
+    explicit EventTimelineView(QWidget *parent = nullptr);
+
+    /**
+     * @brief Przekazuje paczkę ramek do detektorów i dopisuje zakończone zdarzenia do listy.
+     * @param frames [in] Ramki IMU (żyroskop i akcelerometr na początku ramki, przed filtrowaniem widoku).
+     * @param timestampsNs [in] Czasy ramek [ns].
+     * @param count [in] Liczba ramek.
+     * @param fromRecording [in] Czy ramki pochodzą z odtwarzanego nagrania.
+     * @param recordingOffsetNs [in] Przesunięcie czasu ramki na czas nagrania (gdy `fromRecording`).
+     */
+    void addFrames(const float *const *frames, const qint64 *timestampsNs, int count, bool fromRecording,
+                   qint64 recordingOffsetNs);
+
+    /** @brief Przerywa bieżące zdarzenia (np. po zmianie urządzenia lub przewinięciu nagrania); lista pozostaje. */
+    void resetDetector();
+
+    /** @brief Usuwa wszystkie zdarzenia z listy (np. po wczytaniu innego nagrania). */
+    void clear();
+
+    /** @brief Aktualizuje teksty po zmianie języka. */
+    void retranslateUi();
+
+signals:
+    /**
+     * @brief Wybrano zdarzenie z nagrania.
+     * @param recordingTimeNs [in] Początek zdarzenia w czasie nagrania [ns].
+     */
+    void eventSelected(qint64 recordingTimeNs);
+
+private slots:
+    /** @brief Przepisuje progi z pól do detektora i zapisuje je w QSettings. */
+    void applyLevels();
+
+    /** @brief Emituje `eventSelected()` dla klikniętego wiersza zdarzenia z nagrania. */
+    void selectEvent(int row);
+
+private:
+    /** @brief Wpis listy - do wyboru zdarzenia i pomijania powtórzeń po przewinięciu nagrania. */
+    struct Entry {
+        EventDetector::Kind kind = EventDetector::Kind::Threshold; //!< Detektor.
+        bool fromRecording = false; //!< Czy zdarzenie ma czas nagrania.
+        qint64 startNs = 0; //!< Początek (czas nagrania lub czas ramki na żywo) [ns].
+        qint64 endNs = 0; //!< Koniec [ns].
+    };
+
+    /** @brief Wstawia zdarzenie w kolejności czasu (lub pomija powtórzenie z nagrania). */
+    void appendEvent(const EventDetector::Event &event, bool fromRecording, qint64 recordingOffsetNs,
+                     qint64 latestFrameNs);
+
+    /** @brief Ustawia teksty komórek wiersza zależne od języka. */
+    void updateRowTexts(int row);
+
+    /** @brief Odświeża etykietę z liczbą zdarzeń. */
+    void updateCountLabel();
+
+    EventDetector m_detector; //!< Detektory zdarzeń.
+    std::deque<Entry> m_entries; //!< Wpisy w kolejności wierszy tabeli (rosnąco wg `startNs`).
+    QCheckBox *m_enabledChecks[EventDetector::KIND_COUNT]; //!< Włączenie detektorów.
+    QDoubleSpinBox *m_onSpins[EventDetector::KIND_COUNT]; //!< Progi rozpoczęcia zdarzenia.
+    QDoubleSpinBox *m_offSpins[EventDetector::KIND_COUNT]; //!< Progi zakończenia zdarzenia.
+    QLabel *m_onLabel; //!< Nagłówek kolumny progów rozpoczęcia.
+    QLabel *m_offLabel; //!< Nagłówek kolumny progów zakończenia.
+    QLabel *m_countLabel; //!< Liczba zdarzeń na liście.
+    QPushButton *m_clearButton; //!< Czyszczenie listy.
+    QTableWidget *m_table; //!< Wiersz na zdarzenie: czas, detektor, wartość szczytowa, czas trwania.
+};
+
+#endif // EVENTTIMELINEVIEW_H
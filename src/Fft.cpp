@@ -0,0 +1,92 @@
+/**
+ * @file Fft.cpp
+ * @brief Implementacja klasy Fft.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-15
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include "Fft.h"
+#include "SimdSupport.h"
+#include <QtMath>
+#include <cmath>
+#include <utility>
+
+Fft::Fft(int size)
+    : m_size(MIN_SIZE) {
+    while (m_size < size) {
+        m_size *= 2;
+    }
+
+    int bits = 0;
+    while ((1 << bits) < m_size) {
+        ++bits;
+    }
+    for (int i = 0; i < m_size; ++i) {
+        int reversed = 0;
+        for (int bit = 0; bit < bits; ++bit) {
+            reversed |= ((i >> bit) & 1) << (bits - 1 - bit);
+        }
+        if (i < reversed) {
+            m_bitReverse.append(i);
+            m_bitReverse.append(reversed);
+        }
+    }
+
+    // Etap z blokami długości 2 * half: w_j = e^{-i pi j / half}, j < half; łącznie N - 1 czynników
+    m_twiddleRe.resize(m_size - 1);
+    m_twiddleIm.resize(m_size - 1);
+    for (int half = 1; half < m_size; half *= 2) {
+        for (int j = 0; j < half; ++j) {
+            const double angle = -M_PI * j / half;
+            m_twiddleRe[half - 1 + j] = static_cast<float>(std::cos(angle));
+            m_twiddleIm[half - 1 + j] = static_cast<float>(std::sin(angle));
+        }
+    }
+}
+
+void Fft::forward(float *re, float *im) const {
+    for (int i = 0; i < m_bitReverse.size(); i += 2) {
+        const int a = m_bitReverse[i];
+        const int b = m_bitReverse[i + 1];
+        std::swap(re[a], re[b]);
+        std::swap(im[a], im[b]);
+    }
+
+    for (int half = 1; half < m_size; half *= 2) {
+        const float *wRe = m_twiddleRe.constData() + half - 1;
+        const float *wIm = m_twiddleIm.constData() + half - 1;
+        for (int block = 0; block < m_size; block += 2 * half) {
+            float *aRe = re + block;
+            float *aIm = im + block;
+            float *bRe = aRe + half;
+            float *bIm = aIm + half;
+            int j = 0;
+            if (half >= SimdFloat4::LANES) { // half to potęga dwójki - pętla wektorowa bez reszty
+                for (; j < half; j += SimdFloat4::LANES) {
+                    const SimdFloat4 twRe = SimdFloat4::load(wRe + j);
+                    const SimdFloat4 twIm = SimdFloat4::load(wIm + j);
+                    const SimdFloat4 xRe = SimdFloat4::load(bRe + j);
+                    const SimdFloat4 xIm = SimdFloat4::load(bIm + j);
+                    const SimdFloat4 tRe = twRe * xRe - twIm * xIm;
+                    const SimdFloat4 tIm = SimdFloat4::mulAdd(twRe, xIm, twIm * xRe);
+                    const SimdFloat4 uRe = SimdFloat4::load(aRe + j);
+                    const SimdFloat4 uIm = SimdFloat4::load(aIm + j);
+                    (uRe - tRe).store(bRe + j);
+                    (uIm - tIm).store(bIm + j);
+                    (uRe + tRe).store(aRe + j);
+                    (uIm + tIm).store(aIm + j);
+                }
+            }
+            for (; j < half; ++j) {
+                const float tRe = wRe[j] * bRe[j] - wIm[j] * bIm[j];
+                const float tIm = wRe[j] * bIm[j] + wIm[j] * bRe[j];
+                bRe[j] = aRe[j] - tRe;
+                bIm[j] = aIm[j] - tIm;
+                aRe[j] += tRe;
+                aIm[j] += tIm;
+            }
+        }
+    }
+}
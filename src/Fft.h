@@ -0,0 +1,53 @@
+#ifndef FFT_H
+#define FFT_H
+
+/**
+ * @file Fft.h
+ * @brief Definicja klasy Fft - zespolona FFT radix-2 z motylkami wektorowymi (SimdFloat4).
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-15
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include <QVector>
+
+/**
+ * @class Fft
+ * @brief Szybka transformata Fouriera o stałym rozmiarze (potęga dwójki), w miejscu.
+ *
+ * @details
+ * Algorytm Cooleya-Tukeya z podziałem w czasie: permutacja odwracająca bity, a następnie
+ * `log2(N)` etapów motylków. Części rzeczywiste i urojone są w osobnych tablicach, a czynniki
+ * obrotu każdego etapu leżą w pamięci kolejno, więc etapy o co najmniej 4 motylkach w bloku
+ * liczą `SimdFloat4::LANES` motylków naraz. Tablice permutacji i czynników obrotu są wyznaczane
+ * raz, w konstruktorze.
+ */
+class Fft {
+public:
+    static constexpr int MIN_SIZE = 4; //!< Najmniejszy obsługiwany rozmiar.
+
+    /**
+     * @brief Przygotowuje transformatę danego rozmiaru.
+     * @param size [in] Liczba próbek - potęga dwójki, co najmniej `MIN_SIZE` (inne wartości są zaokrąglane w górę).
+     */
+    explicit Fft(int size);
+
+    /** @brief Zwraca rozmiar transformaty. */
+    int size() const { return m_size; }
+
+    /**
+     * @brief Liczy transformatę w przód (`X[k] = sum x[n] e^{-2 pi i k n / N}`) w miejscu.
+     * @param re [in,out] Części rzeczywiste (`size()` wartości).
+     * @param im [in,out] Części urojone (`size()` wartości).
+     */
+    void forward(float *re, float *im) const;
+
+private:
+    int m_size; //!< Rozmiar transformaty.
+    QVector<int> m_bitReverse; //!< Pary indeksów do zamiany (i, j), i < j - permutacja odwracająca bity.
+    QVector<float> m_twiddleRe; //!< Czynniki obrotu etapów (etap o `half` motylkach od indeksu `half - 1`).
+    QVector<float> m_twiddleIm; //!< Części urojone czynników obrotu.
+};
+
+#endif // FFT_H
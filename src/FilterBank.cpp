@@ -0,0 +1,233 @@
+/**
+ * @file FilterBank.cpp
+ * @brief Implementacja klasy FilterBank.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-14
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include "FilterBank.h"
+#include <QSettings>
+#include <QStringList>
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+const QString SETTINGS_GROUP_FB = QStringLiteral("filters");
+constexpr float MIN_SAMPLE_RATE_HZ_FB = 1.0f;
+constexpr float MAX_FREQUENCY_RATIO_FB = 0.49f; // Częstotliwość stopnia poniżej Nyquista
+constexpr float MIN_Q_FB = 0.1f;
+constexpr int MAX_AVERAGE_LENGTH_FB = 1024;
+
+// Nazwy w QSettings w kolejności wartości FilterBank::StageType
+const QStringList STAGE_TYPE_NAMES_FB = {
+    QStringLiteral("lowpass"), QStringLiteral("highpass"), QStringLiteral("notch"), QStringLiteral("average")
+};
+
+void FilterBank::configure(const QVector<Stage> &stages, float sampleRateHz) {
+    m_sampleRateHz = qMax(MIN_SAMPLE_RATE_HZ_FB, sampleRateHz);
+    m_stages = stages;
+    m_states.clear();
+    m_states.resize(m_stages.size());
+    for (int i = 0; i < m_stages.size(); ++i) {
+        Stage &stage = m_stages[i];
+        StageState &state = m_states[i];
+        state.type = stage.type;
+        if (stage.type == StageType::MovingAverage) {
+            stage.length = qBound(1, stage.length, MAX_AVERAGE_LENGTH_FB);
+            state.length = stage.length;
+            state.history.resize(stage.length * PADDED_CHANNELS);
+        } else {
+            stage.frequencyHz = qBound(0.001f * m_sampleRateHz, stage.frequencyHz,
+                                       MAX_FREQUENCY_RATIO_FB * m_sampleRateHz);
+            stage.q = qMax(MIN_Q_FB, stage.q);
+            designBiquad(stage, state);
+        }
+    }
+    m_primed = false;
+}
+
+void FilterBank::designBiquad(const Stage &stage, StageState &state) const {
+    const double w0 = 2.0 * M_PI * stage.frequencyHz / m_sampleRateHz;
+    const double cosW0 = std::cos(w0);
+    const double alpha = std::sin(w0) / (2.0 * stage.q);
+    double b0 = 1.0, b1 = 0.0, b2 = 0.0;
+    switch (stage.type) {
+    case StageType::LowPass:
+        b0 = b2 = (1.0 - cosW0) / 2.0;
+        b1 = 1.0 - cosW0;
+        break;
+    case StageType::HighPass:
+        b0 = b2 = (1.0 + cosW0) / 2.0;
+        b1 = -(1.0 + cosW0);
+        break;
+    case StageType::Notch:
+        b0 = b2 = 1.0;
+        b1 = -2.0 * cosW0;
+        break;
+    case StageType::MovingAverage:
+        break;
+    }
+    const double a0 = 1.0 + alpha;
+    state.b0 = static_cast<float>(b0 / a0);
+    state.b1 = static_cast<float>(b1 / a0);
+    state.b2 = static_cast<float>(b2 / a0);
+    state.a1 = static_cast<float>(-2.0 * cosW0 / a0);
+    state.a2 = static_cast<float>((1.0 - alpha) / a0);
+}
+
+void FilterBank::prime(StageState &state, const float *x) {
+    if (state.type == StageType::MovingAverage) {
+        for (int slot = 0; slot < state.length; ++slot) {
+            std::copy(x, x + PADDED_CHANNELS, state.history.data() + slot * PADDED_CHANNELS);
+        }
+        for (int channel = 0; channel < PADDED_CHANNELS; ++channel) {
+            state.sum[channel] = x[channel] * state.length;
+        }
+        state.next = 0;
+        return;
+    }
+    // Stan ustalony dla stałego wejścia: y = H(1) * x
+    const float dcGain = (state.b0 + state.b1 + state.b2) / (1.0f + state.a1 + state.a2);
+    for (int channel = 0; channel < PADDED_CHANNELS; ++channel) {
+        const float y = dcGain * x[channel];
+        state.z1[channel] = y - state.b0 * x[channel];
+        state.z2[channel] = state.b2 * x[channel] - state.a2 * y;
+    }
+}
+
+void FilterBank::process(const float *const *input, float *const *output, int count) {
+    if (m_states.isEmpty()) {
+        for (int i = 0; i < count; ++i) {
+            if (output[i] != input[i]) {
+                std::copy(input[i], input[i] + CHANNELS, output[i]);
+            }
+        }
+        return;
+    }
+
+    for (int i = 0; i < count; ++i) {
+        SimdFloat4 x[VECTORS];
+        for (int v = 0; v < VECTORS; ++v) {
+            x[v] = SimdFloat4::load(input[i] + v * SimdFloat4::LANES);
+        }
+        for (StageState &state: m_states) {
+            if (!m_primed) {
+                float values[PADDED_CHANNELS];
+                for (int v = 0; v < VECTORS; ++v) {
+                    x[v].store(values + v * SimdFloat4::LANES);
+                }
+                prime(state, values);
+            }
+            if (state.type == StageType::MovingAverage) {
+                float *slot = state.history.data() + state.next * PADDED_CHANNELS;
+                const SimdFloat4 inverseLength = SimdFloat4::broadcast(1.0f / state.length);
+                for (int v = 0; v < VECTORS; ++v) {
+                    const int offset = v * SimdFloat4::LANES;
+                    const SimdFloat4 sum = SimdFloat4::load(state.sum + offset) + x[v]
+                                           - SimdFloat4::load(slot + offset);
+                    sum.store(state.sum + offset);
+                    x[v].store(slot + offset);
+                    x[v] = sum * inverseLength;
+                }
+                if (++state.next == state.length) {
+                    state.next = 0;
+                    // Raz na obieg bufora suma od nowa - błąd zaokrągleń się nie kumuluje
+                    std::fill(std::begin(state.sum), std::end(state.sum), 0.0f);
+                    for (int slotIndex = 0; slotIndex < state.length; ++slotIndex) {
+                        const float *values = state.history.constData() + slotIndex * PADDED_CHANNELS;
+                        for (int channel = 0; channel < PADDED_CHANNELS; ++channel) {
+                            state.sum[channel] += values[channel];
+                        }
+                    }
+                }
+                continue;
+            }
+
+            const SimdFloat4 b0 = SimdFloat4::broadcast(state.b0);
+            const SimdFloat4 b1 = SimdFloat4::broadcast(state.b1);
+            const SimdFloat4 b2 = SimdFloat4::broadcast(state.b2);
+            const SimdFloat4 a1 = SimdFloat4::broadcast(state.a1);
+            const SimdFloat4 a2 = SimdFloat4::broadcast(state.a2);
+            for (int v = 0; v < VECTORS; ++v) {
+                const int offset = v * SimdFloat4::LANES;
+                const SimdFloat4 z1 = SimdFloat4::load(state.z1 + offset);
+                const SimdFloat4 z2 = SimdFloat4::load(state.z2 + offset);
+                const SimdFloat4 y = SimdFloat4::mulAdd(b0, x[v], z1); // Postać transponowana II
+                (SimdFloat4::mulAdd(b1, x[v], z2) - a1 * y).store(state.z1 + offset);
+                (b2 * x[v] - a2 * y).store(state.z2 + offset);
+                x[v] = y;
+            }
+        }
+        m_primed = true;
+
+        // Kanały 0-7 pełnymi wektorami, kanał 8 z ostatniego wektora (pozostałe pasy to dopełnienie)
+        float *target = output[i];
+        x[0].store(target);
+        x[1].store(target + SimdFloat4::LANES);
+        float tail[SimdFloat4::LANES];
+        x[2].store(tail);
+        target[2 * SimdFloat4::LANES] = tail[0];
+    }
+}
+
+void FilterBank::reset() {
+    for (StageState &state: m_states) {
+        std::fill(std::begin(state.z1), std::end(state.z1), 0.0f);
+        std::fill(std::begin(state.z2), std::end(state.z2), 0.0f);
+        std::fill(std::begin(state.sum), std::end(state.sum), 0.0f);
+        state.next = 0;
+    }
+    m_primed = false;
+}
+
+QString FilterBank::typeName(StageType type) {
+    return STAGE_TYPE_NAMES_FB.value(static_cast<int>(type));
+}
+
+bool FilterBank::loadSettings() {
+    QSettings settings;
+    settings.beginGroup(SETTINGS_GROUP_FB);
+    const bool exists = settings.contains(QStringLiteral("sampleRate"));
+    const float sampleRateHz = settings.value(QStringLiteral("sampleRate"), DEFAULT_SAMPLE_RATE_HZ).toFloat();
+    QVector<Stage> stages;
+    const int count = settings.beginReadArray(QStringLiteral("stages"));
+    for (int i = 0; i < count; ++i) {
+        settings.setArrayIndex(i);
+        const int typeIndex = STAGE_TYPE_NAMES_FB.indexOf(settings.value(QStringLiteral("type")).toString());
+        if (typeIndex < 0) {
+            continue; // Nieznany rodzaj (np. z nowszej wersji) - pomijany
+        }
+        Stage stage;
+        stage.type = static_cast<StageType>(typeIndex);
+        stage.frequencyHz = settings.value(QStringLiteral("frequency"), stage.frequencyHz).toFloat();
+        stage.q = settings.value(QStringLiteral("q"), stage.q).toFloat();
+        stage.length = settings.value(QStringLiteral("length"), stage.length).toInt();
+        stages.append(stage);
+    }
+    settings.endArray();
+    configure(stages, sampleRateHz);
+    return exists;
+}
+
+void FilterBank::saveSettings() const {
+    QSettings settings;
+    settings.beginGroup(SETTINGS_GROUP_FB);
+    settings.setValue(QStringLiteral("sampleRate"), m_sampleRateHz);
+    settings.remove(QStringLiteral("stages")); // Bez pozostałości dłuższego łańcucha
+    settings.beginWriteArray(QStringLiteral("stages"), static_cast<int>(m_stages.size()));
+    for (int i = 0; i < m_stages.size(); ++i) {
+        const Stage &stage = m_stages[i];
+        settings.setArrayIndex(i);
+        settings.setValue(QStringLiteral("type"), typeName(stage.type));
+        if (stage.type == StageType::MovingAverage) {
+            settings.setValue(QStringLiteral("length"), stage.length);
+        } else {
+            settings.setValue(QStringLiteral("frequency"), stage.frequencyHz);
+            settings.setValue(QStringLiteral("q"), stage.q);
+        }
+    }
+    settings.endArray();
+}
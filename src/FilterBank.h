@@ -0,0 +1,143 @@
+#ifndef FILTERBANK_H
+#define FILTERBANK_H
+
+/**
+ * @file FilterBank.h
+ * @brief Definicja klasy FilterBank - łańcuch filtrów IIR/FIR dla wszystkich osi IMU naraz (SimdFloat4).
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-14
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include "SimdSupport.h"
+#include <QString>
+#include <QVector>
+
+/**
+ * @class FilterBank
+ * @brief Filtruje 9 kanałów IMU (żyroskop, akcelerometr, magnetometr) łańcuchem stopni biquad i średniej ruchomej.
+ *
+ * @details
+ * Każdy stopień działa na wszystkich kanałach jednocześnie: 9 kanałów ramki mieści się w trzech
+ * wektorach `SimdFloat4` (ostatni wektor ma 3 nieużywane pasy), więc jeden krok filtru to kilka
+ * operacji wektorowych zamiast pętli po kanałach. Stopnie:
+ * - dolno-, górnoprzepustowy i zaporowy (notch) - biquady wg "Audio EQ Cookbook" (R. Bristow-Johnson),
+ *   w postaci transponowanej II,
+ * - średnia ruchoma `length` próbek - suma bieżąca w buforze kołowym (przeliczana co obieg bufora).
+ *
+ * Pierwsza ramka po `configure()` lub `reset()` ustawia stan stopni jak po długim podawaniu stałej
+ * wartości, więc wykres nie zaczyna się od skoku od zera (np. 1000 mg akcelerometru Z).
+ * Ustawienia łańcucha są zapisywane w QSettings (`saveSettings()`, `loadSettings()`).
+ */
+class FilterBank {
+public:
+    static constexpr int CHANNELS = 9; //!< Filtrowane kanały: żyroskop X-Z, akcelerometr X-Z, magnetometr X-Z.
+    static constexpr int FRAME_STRIDE = 12; //!< Minimalna długość ramki wejściowej (wczytywane są pełne wektory).
+    static constexpr float DEFAULT_SAMPLE_RATE_HZ = 100.0f; //!< Domyślna częstotliwość próbkowania.
+
+    /**
+     * @enum StageType
+     * @brief Rodzaj stopnia filtru.
+     */
+    enum class StageType {
+        LowPass, //!< Dolnoprzepustowy biquad (`frequencyHz`, `q`).
+        HighPass, //!< Górnoprzepustowy biquad (`frequencyHz`, `q`).
+        Notch, //!< Zaporowy biquad (`frequencyHz`, `q`).
+        MovingAverage //!< Średnia ruchoma `length` próbek.
+    };
+
+    /**
+     * @struct Stage
+     * @brief Parametry jednego stopnia łańcucha.
+     */
+    struct Stage {
+        StageType type = StageType::LowPass; //!< Rodzaj stopnia.
+        float frequencyHz = 10.0f; //!< Częstotliwość graniczna lub środkowa [Hz] (biquady).
+        float q = 0.7071f; //!< Dobroć (biquady); 0,7071 - charakterystyka Butterwortha.
+        int length = 8; //!< Długość okna [próbki] (średnia ruchoma).
+    };
+
+    /**
+     * @brief Ustawia łańcuch stopni i częstotliwość próbkowania; zeruje stan filtrów.
+     * @param stages [in] Stopnie w kolejności przetwarzania (pusty - filtrowanie wyłączone).
+     * @param sampleRateHz [in] Częstotliwość próbkowania ramek [Hz].
+     */
+    void configure(const QVector<Stage> &stages, float sampleRateHz);
+
+    /**
+     * @brief Filtruje paczkę ramek.
+     * @param input [in] Ramki wejściowe - co najmniej `FRAME_STRIDE` wartości każda, kanały na początku.
+     * @param output [out] Ramki wyjściowe - zapisywane są tylko kanały `0..CHANNELS-1`; mogą być tymi samymi
+     * tablicami co `input`.
+     * @param count [in] Liczba ramek.
+     */
+    void process(const float *const *input, float *const *output, int count);
+
+    /** @brief Zeruje stan filtrów (następna ramka ustawi go od nowa). */
+    void reset();
+
+    /** @brief Informuje, czy łańcuch jest pusty (filtrowanie wyłączone). */
+    bool isEmpty() const { return m_stages.isEmpty(); }
+
+    /** @brief Zwraca stopnie łańcucha. */
+    const QVector<Stage> &stages() const { return m_stages; }
+
+    /** @brief Zwraca częstotliwość próbkowania [Hz]. */
+    float sampleRate() const { return m_sampleRateHz; }
+
+    /**
+     * @brief Zwraca nazwę rodzaju stopnia używaną w QSettings.
+     * @param type [in] Rodzaj stopnia.
+     */
+    static QString typeName(StageType type);
+
+    /**
+     * @brief Wczytuje łańcuch z QSettings (grupa `filters`) i konfiguruje filtry.
+     * @return `true`, jeśli zapisane ustawienia istniały.
+     */
+    bool loadSettings();
+
+    /** @brief Zapisuje łańcuch i częstotliwość próbkowania w QSettings (grupa `filters`). */
+    void saveSettings() const;
+
+private:
+    static constexpr int VECTORS = 3; //!< Wektory `SimdFloat4` na ramkę.
+    static constexpr int PADDED_CHANNELS = VECTORS * SimdFloat4::LANES; //!< Kanały z pasami dopełnienia.
+
+    /**
+     * @struct StageState
+     * @brief Współczynniki i stan jednego stopnia dla wszystkich kanałów.
+     */
+    struct StageState {
+        StageType type = StageType::LowPass; //!< Rodzaj stopnia.
+        float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f, a1 = 0.0f, a2 = 0.0f; //!< Współczynniki biquadu (a0 = 1).
+        float z1[PADDED_CHANNELS] = {}; //!< Pierwszy element opóźniający biquadu.
+        float z2[PADDED_CHANNELS] = {}; //!< Drugi element opóźniający biquadu.
+        int length = 1; //!< Długość okna średniej ruchomej.
+        int next = 0; //!< Pozycja zapisu w buforze średniej.
+        float sum[PADDED_CHANNELS] = {}; //!< Suma okna średniej.
+        QVector<float> history; //!< Bufor kołowy średniej (`length` x `PADDED_CHANNELS`).
+    };
+
+    /**
+     * @brief Wyznacza współczynniki biquadu stopnia.
+     * @param stage [in] Parametry stopnia.
+     * @param state [out] Stan z ustawionymi współczynnikami.
+     */
+    void designBiquad(const Stage &stage, StageState &state) const;
+
+    /**
+     * @brief Ustawia stan stopnia jak po długim podawaniu wektora `x`.
+     * @param state [in,out] Stan stopnia.
+     * @param x [in] Wartości wejściowe stopnia (`PADDED_CHANNELS`).
+     */
+    static void prime(StageState &state, const float *x);
+
+    QVector<Stage> m_stages; //!< Bieżący łańcuch.
+    QVector<StageState> m_states; //!< Stan stopni (w kolejności łańcucha).
+    float m_sampleRateHz = DEFAULT_SAMPLE_RATE_HZ; //!< Częstotliwość próbkowania [Hz].
+    bool m_primed = false; //!< Czy stan został ustawiony pierwszą ramką.
+};
+
+#endif // FILTERBANK_H
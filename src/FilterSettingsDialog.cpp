@@ -0,0 +1,173 @@
+/**
+ * @file FilterSettingsDialog.cpp
+ * @brief Implementacja klasy FilterSettingsDialog.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-14
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include "FilterSettingsDialog.h"
+#include <QCheckBox>
+#include <QDialogButtonBox>
+#include <QDoubleSpinBox>
+#include <QFormLayout>
+#include <QHBoxLayout>
+#include <QSpinBox>
+#include <QVBoxLayout>
+
+constexpr double MIN_SAMPLE_RATE_HZ_FSD = 1.0;
+constexpr double MAX_SAMPLE_RATE_HZ_FSD = 10000.0;
+constexpr double MIN_FREQUENCY_HZ_FSD = 0.01;
+constexpr int MAX_AVERAGE_LENGTH_FSD = 1024;
+constexpr float BUTTERWORTH_Q_FSD = 0.7071f;
+
+/**
+ * @brief Tworzy pole częstotliwości [Hz] z dwoma miejscami po przecinku.
+ */
+static QDoubleSpinBox *createFrequencySpin(QWidget *parent, double value) {
+    auto *spin = new QDoubleSpinBox(parent);
+    spin->setRange(MIN_FREQUENCY_HZ_FSD, MAX_SAMPLE_RATE_HZ_FSD / 2.0);
+    spin->setDecimals(2);
+    spin->setSuffix(QStringLiteral(" Hz"));
+    spin->setValue(value);
+    return spin;
+}
+
+FilterSettingsDialog::FilterSettingsDialog(QWidget *parent)
+    : QDialog(parent),
+      m_sampleRateSpin(new QDoubleSpinBox(this)),
+      m_highPassCheck(new QCheckBox(tr("High-pass"), this)),
+      m_highPassSpin(createFrequencySpin(this, 0.5)),
+      m_notchCheck(new QCheckBox(tr("Notch"), this)),
+      m_notchSpin(createFrequencySpin(this, 50.0)),
+      m_notchQSpin(new QDoubleSpinBox(this)),
+      m_lowPassCheck(new QCheckBox(tr("Low-pass"), this)),
+      m_lowPassSpin(createFrequencySpin(this, 10.0)),
+      m_averageCheck(new QCheckBox(tr("Moving average"), this)),
+      m_averageSpin(new QSpinBox(this)),
+      m_rawTraceCheck(new QCheckBox(tr("Show raw traces on charts"), this)) {
+    setWindowTitle(tr("Sensor Filters"));
+
+    m_sampleRateSpin->setRange(MIN_SAMPLE_RATE_HZ_FSD, MAX_SAMPLE_RATE_HZ_FSD);
+    m_sampleRateSpin->setDecimals(1);
+    m_sampleRateSpin->setSuffix(QStringLiteral(" Hz"));
+    m_notchQSpin->setRange(0.1, 100.0);
+    m_notchQSpin->setDecimals(2);
+    m_notchQSpin->setPrefix(QStringLiteral("Q "));
+    m_notchQSpin->setValue(5.0);
+    m_averageSpin->setRange(1, MAX_AVERAGE_LENGTH_FSD);
+    m_averageSpin->setSuffix(tr(" samples"));
+    m_averageSpin->setValue(8);
+
+    auto *formLayout = new QFormLayout();
+    formLayout->addRow(tr("Sample rate:"), m_sampleRateSpin);
+    formLayout->addRow(m_highPassCheck, m_highPassSpin);
+    auto *notchLayout = new QHBoxLayout();
+    notchLayout->addWidget(m_notchSpin);
+    notchLayout->addWidget(m_notchQSpin);
+    formLayout->addRow(m_notchCheck, notchLayout);
+    formLayout->addRow(m_lowPassCheck, m_lowPassSpin);
+    formLayout->addRow(m_averageCheck, m_averageSpin);
+
+    // Pola parametrów aktywne tylko dla włączonych stopni
+    const QList<QPair<QCheckBox *, QList<QWidget *>>> stageFields = {
+        {m_highPassCheck, {m_highPassSpin}},
+        {m_notchCheck, {m_notchSpin, m_notchQSpin}},
+        {m_lowPassCheck, {m_lowPassSpin}},
+        {m_averageCheck, {m_averageSpin}}
+    };
+    for (const auto &[check, fields]: stageFields) {
+        for (QWidget *field: fields) {
+            field->setEnabled(false);
+            connect(check, &QCheckBox::toggled, field, &QWidget::setEnabled);
+        }
+    }
+
+    auto *buttons = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel, this);
+    connect(buttons, &QDialogButtonBox::accepted, this, &QDialog::accept);
+    connect(buttons, &QDialogButtonBox::rejected, this, &QDialog::reject);
+
+    auto *mainLayout = new QVBoxLayout(this);
+    mainLayout->addLayout(formLayout);
+    mainLayout->addWidget(m_rawTraceCheck);
+    mainLayout->addWidget(buttons);
+}
+
+void FilterSettingsDialog::setStages(const QVector<FilterBank::Stage> &stages, float sampleRateHz) {
+    m_sampleRateSpin->setValue(sampleRateHz);
+    m_highPassCheck->setChecked(false);
+    m_notchCheck->setChecked(false);
+    m_lowPassCheck->setChecked(false);
+    m_averageCheck->setChecked(false);
+    for (const FilterBank::Stage &stage: stages) {
+        switch (stage.type) {
+        case FilterBank::StageType::HighPass:
+            if (!m_highPassCheck->isChecked()) {
+                m_highPassCheck->setChecked(true);
+                m_highPassSpin->setValue(stage.frequencyHz);
+            }
+            break;
+        case FilterBank::StageType::Notch:
+            if (!m_notchCheck->isChecked()) {
+                m_notchCheck->setChecked(true);
+                m_notchSpin->setValue(stage.frequencyHz);
+                m_notchQSpin->setValue(stage.q);
+            }
+            break;
+        case FilterBank::StageType::LowPass:
+            if (!m_lowPassCheck->isChecked()) {
+                m_lowPassCheck->setChecked(true);
+                m_lowPassSpin->setValue(stage.frequencyHz);
+            }
+            break;
+        case FilterBank::StageType::MovingAverage:
+            if (!m_averageCheck->isChecked()) {
+                m_averageCheck->setChecked(true);
+                m_averageSpin->setValue(stage.length);
+            }
+            break;
+        }
+    }
+}
+
+QVector<FilterBank::Stage> FilterSettingsDialog::stages() const {
+    QVector<FilterBank::Stage> result;
+    FilterBank::Stage stage;
+    if (m_highPassCheck->isChecked()) {
+        stage.type = FilterBank::StageType::HighPass;
+        stage.frequencyHz = static_cast<float>(m_highPassSpin->value());
+        stage.q = BUTTERWORTH_Q_FSD;
+        result.append(stage);
+    }
+    if (m_notchCheck->isChecked()) {
+        stage.type = FilterBank::StageType::Notch;
+        stage.frequencyHz = static_cast<float>(m_notchSpin->value());
+        stage.q = static_cast<float>(m_notchQSpin->value());
+        result.append(stage);
+    }
+    if (m_lowPassCheck->isChecked()) {
+        stage.type = FilterBank::StageType::LowPass;
+        stage.frequencyHz = static_cast<float>(m_lowPassSpin->value());
+        stage.q = BUTTERWORTH_Q_FSD;
+        result.append(stage);
+    }
+    if (m_averageCheck->isChecked()) {
+        stage.type = FilterBank::StageType::MovingAverage;
+        stage.length = m_averageSpin->value();
+        result.append(stage);
+    }
+    return result;
+}
+
+float FilterSettingsDialog::sampleRate() const {
+    return static_cast<float>(m_sampleRateSpin->value());
+}
+
+void FilterSettingsDialog::setRawTraceVisible(bool visible) {
+    m_rawTraceCheck->setChecked(visible);
+}
+
+bool FilterSettingsDialog::rawTraceVisible() const {
+    return m_rawTraceCheck->isChecked();
+}
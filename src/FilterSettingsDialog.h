@@ -0,0 +1,75 @@
+#ifndef FILTERSETTINGSDIALOG_H
+#define FILTERSETTINGSDIALOG_H
+
+/**
+ * @file FilterSettingsDialog.h
+ * @brief Definicja klasy FilterSettingsDialog - okno konfiguracji łańcucha filtrów `FilterBank`.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-14
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include <QDialog>
+#include "FilterBank.h"
+
+class QCheckBox;
+class QDoubleSpinBox;
+class QSpinBox;
+
+/**
+ * @class FilterSettingsDialog
+ * @brief Okno wyboru stopni filtru kanałów IMU (Sensor > Filters...).
+ *
+ * @details
+ * Łańcuch ma stałą kolejność: górnoprzepustowy, zaporowy, dolnoprzepustowy, średnia ruchoma;
+ * każdy stopień można włączyć osobno. Okno pozwala też pokazać na wykresach przebiegi surowe
+ * pod przefiltrowanymi.
+ */
+class FilterSettingsDialog : public QDialog {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Konstruktor klasy FilterSettingsDialog.
+     * @param parent [in] Okno nadrzędne.
+     */
+    explicit FilterSettingsDialog(QWidget *parent = nullptr);
+
+    /**
+     * @brief Wypełnia pola bieżącym łańcuchem (pierwszy stopień każdego rodzaju).
+     * @param stages [in] Stopnie łańcucha.
+     * @param sampleRateHz [in] Częstotliwość próbkowania [Hz].
+     */
+    void setStages(const QVector<FilterBank::Stage> &stages, float sampleRateHz);
+
+    /** @brief Zwraca łańcuch włączonych stopni w kolejności przetwarzania. */
+    QVector<FilterBank::Stage> stages() const;
+
+    /** @brief Zwraca częstotliwość próbkowania [Hz]. */
+    float sampleRate() const;
+
+    /**
+     * @brief Ustawia pole wyboru przebiegów surowych.
+     * @param visible [in] Czy przebiegi surowe są pokazywane.
+     */
+    void setRawTraceVisible(bool visible);
+
+    /** @brief Informuje, czy wybrano pokazywanie przebiegów surowych. */
+    bool rawTraceVisible() const;
+
+private:
+    QDoubleSpinBox *m_sampleRateSpin; //!< Częstotliwość próbkowania [Hz].
+    QCheckBox *m_highPassCheck; //!< Włączenie stopnia górnoprzepustowego.
+    QDoubleSpinBox *m_highPassSpin; //!< Częstotliwość graniczna filtru górnoprzepustowego [Hz].
+    QCheckBox *m_notchCheck; //!< Włączenie stopnia zaporowego.
+    QDoubleSpinBox *m_notchSpin; //!< Częstotliwość środkowa filtru zaporowego [Hz].
+    QDoubleSpinBox *m_notchQSpin; //!< Dobroć filtru zaporowego.
+    QCheckBox *m_lowPassCheck; //!< Włączenie stopnia dolnoprzepustowego.
+    QDoubleSpinBox *m_lowPassSpin; //!< Częstotliwość graniczna filtru dolnoprzepustowego [Hz].
+    QCheckBox *m_averageCheck; //!< Włączenie średniej ruchomej.
+    QSpinBox *m_averageSpin; //!< Długość okna średniej [próbki].
+    QCheckBox *m_rawTraceCheck; //!< Pokazywanie przebiegów surowych.
+};
+
+#endif // FILTERSETTINGSDIALOG_H
@@ -0,0 +1,149 @@
+/**
+ * @file FrameDiagnostics.cpp
+ * @brief Implementacja klasy FrameDiagnostics.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-01
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include "FrameDiagnostics.h"
+#include "PerfCounters.h"
+#include <QTimer>
+#include <QDebug>
+
+/**
+ * @brief Skraca linię do długości akceptowalnej w logu.
+ */
+static QByteArray abbreviated(const QByteArray &line) {
+    if (line.size() <= FrameDiagnostics::MAX_LOGGED_LINE_LENGTH) {
+        return line;
+    }
+    return line.left(FrameDiagnostics::MAX_LOGGED_LINE_LENGTH) + "...";
+}
+
+FrameDiagnostics::FrameDiagnostics(QObject *parent)
+    : QObject(parent),
+      m_summaryTimer(new QTimer(this)) {
+    m_summaryTimer->setSingleShot(true);
+    m_summaryTimer->setInterval(SUMMARY_INTERVAL_MS);
+    connect(m_summaryTimer, &QTimer::timeout, this, &FrameDiagnostics::flushSummary);
+}
+
+void FrameDiagnostics::record(FrameParser::Status status, const QByteArray &line,
+                              const FrameParser::CrcCheck &crcCheck) {
+    if (status == FrameParser::Status::Ok) {
+        return;
+    }
+    const bool crcError = status == FrameParser::Status::MissingCrcSeparator ||
+                          status == FrameParser::Status::InvalidCrcFormat ||
+                          status == FrameParser::Status::CrcMismatch;
+    if (crcError) {
+        PerfCounters::addCrcFailure();
+    } else {
+        PerfCounters::addParseFailure();
+    }
+
+    Category &category = m_categories[static_cast<int>(status)];
+    ++category.total;
+    ++category.inWindow;
+    if (category.detailedBudget > 0) {
+        --category.detailedBudget;
+        logDetailed(status, line, crcCheck);
+        if (category.detailedBudget == 0) {
+            qWarning().noquote() << QStringLiteral("Further '%1' errors will be summarized once per second.")
+                    .arg(categoryName(status));
+        }
+    } else {
+        ++category.suppressed;
+    }
+
+    if (!m_summaryTimer->isActive()) {
+        m_windowTimer.start();
+        m_summaryTimer->start();
+    }
+}
+
+void FrameDiagnostics::logDetailed(FrameParser::Status status, const QByteArray &line,
+                                   const FrameParser::CrcCheck &crcCheck) {
+    switch (status) {
+        case FrameParser::Status::MissingCrcSeparator:
+            qWarning() << "Received line without CRC separator ('*'):" << abbreviated(line);
+            break;
+        case FrameParser::Status::InvalidCrcFormat:
+            qWarning() << "Failed to convert received CRC from hex:" << abbreviated(crcCheck.receivedCrcHex)
+                       << "in line:" << abbreviated(line);
+            break;
+        case FrameParser::Status::CrcMismatch:
+            qWarning() << "Checksum Mismatch! Received CRC:" << crcCheck.receivedCrcHex
+                       << "Calculated CRC:" << QString::number(crcCheck.calculatedCrc, 16).toUpper().rightJustified(4, '0')
+                       << "Line:" << abbreviated(line);
+            break;
+        case FrameParser::Status::InvalidValue:
+            qWarning() << "Failed to convert value to float in line:" << abbreviated(line);
+            break;
+        case FrameParser::Status::WrongFieldCount:
+            qWarning() << "Received line with incorrect value count after CRC check. Count:"
+                       << crcCheck.payload.count(',') + 1 << "Line:" << abbreviated(line);
+            break;
+        case FrameParser::Status::Ok:
+            break;
+    }
+}
+
+void FrameDiagnostics::flushSummary() {
+    const double windowSeconds = qMax<qint64>(1, m_windowTimer.elapsed()) / 1000.0;
+    bool anyErrors = false;
+    for (int i = 0; i < CATEGORY_COUNT; ++i) {
+        Category &category = m_categories[i];
+        if (category.suppressed > 0) {
+            qWarning().noquote() << QStringLiteral("%1: %2 errors in the last %3 s (%4 not logged), %5 total")
+                    .arg(categoryName(static_cast<FrameParser::Status>(i)))
+                    .arg(category.inWindow)
+                    .arg(windowSeconds, 0, 'f', 1)
+                    .arg(category.suppressed)
+                    .arg(category.total);
+        }
+        if (category.inWindow == 0) {
+            category.detailedBudget = DETAILED_LOG_BUDGET; // Kategoria ucichła - odnów szczegółowe logowanie
+        } else {
+            anyErrors = true;
+        }
+        category.inWindow = 0;
+        category.suppressed = 0;
+    }
+    if (anyErrors) {
+        // Kolejne okno, aby sprawdzić, czy błędy ustały i można odnowić limity
+        m_windowTimer.start();
+        m_summaryTimer->start();
+    }
+}
+
+quint64 FrameDiagnostics::count(FrameParser::Status status) const {
+    return m_categories[static_cast<int>(status)].total;
+}
+
+quint64 FrameDiagnostics::totalCount() const {
+    quint64 total = 0;
+    for (const Category &category: m_categories) {
+        total += category.total;
+    }
+    return total;
+}
+
+void FrameDiagnostics::reset() {
+    m_categories.fill(Category());
+    m_summaryTimer->stop();
+}
+
+QString FrameDiagnostics::categoryName(FrameParser::Status status) {
+    switch (status) {
+        case FrameParser::Status::Ok: return QStringLiteral("ok");
+        case FrameParser::Status::MissingCrcSeparator: return QStringLiteral("missing CRC separator");
+        case FrameParser::Status::InvalidCrcFormat: return QStringLiteral("invalid CRC format");
+        case FrameParser::Status::CrcMismatch: return QStringLiteral("CRC mismatch");
+        case FrameParser::Status::InvalidValue: return QStringLiteral("invalid value");
+        case FrameParser::Status::WrongFieldCount: return QStringLiteral("wrong field count");
+    }
+    return QStringLiteral("unknown");
+}
@@ -0,0 +1,104 @@
+#ifndef FRAMEDIAGNOSTICS_H
+#define FRAMEDIAGNOSTICS_H
+
+/**
+ * @file FrameDiagnostics.h
+ * @brief Definicja klasy FrameDiagnostics - liczniki błędnych ramek i ograniczone logowanie.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-01
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <array>
+#include "FrameParser.h"
+
+class QTimer;
+
+/**
+ * @class FrameDiagnostics
+ * @brief Zlicza odrzucone ramki według kategorii i ogranicza liczbę komunikatów w logu.
+ *
+ * @details
+ * Dla każdej kategorii błędu (`FrameParser::Status`) pierwsze `DETAILED_LOG_BUDGET` zdarzeń jest
+ * logowanych szczegółowo (z linią skróconą do `MAX_LOGGED_LINE_LENGTH` znaków). Kolejne są tylko
+ * zliczane, a raz na sekundę logowane jest jedno podsumowanie liczby pominiętych komunikatów.
+ * Limit szczegółowych komunikatów kategorii odnawia się po pełnej sekundzie bez błędów tej kategorii.
+ *
+ * Dzięki temu zaszumione łącze generujące setki błędnych ramek na sekundę nie blokuje wątku GUI
+ * formatowaniem komunikatów. Łączne liczniki są dostępne przez `count()`.
+ */
+class FrameDiagnostics : public QObject {
+    Q_OBJECT
+
+public:
+    static constexpr int DETAILED_LOG_BUDGET = 5; //!< Szczegółowe komunikaty na kategorię przed ograniczeniem.
+    static constexpr int SUMMARY_INTERVAL_MS = 1000; //!< Okres podsumowań pominiętych komunikatów.
+    static constexpr int MAX_LOGGED_LINE_LENGTH = 80; //!< Maksymalna długość linii w komunikacie.
+
+    /**
+     * @brief Konstruktor klasy FrameDiagnostics.
+     * @param parent [in] Obiekt nadrzędny.
+     */
+    explicit FrameDiagnostics(QObject *parent = nullptr);
+
+    /**
+     * @brief Rejestruje odrzuconą linię.
+     * @details Zwiększa licznik kategorii (oraz `PerfCounters`) i - jeśli limit na to pozwala -
+     * loguje szczegóły. Formatowanie komunikatu odbywa się tylko wtedy, gdy jest on logowany.
+     * @param status [in] Kategoria błędu (różna od `FrameParser::Status::Ok`).
+     * @param line [in] Odrzucona linia.
+     * @param crcCheck [in] Szczegóły weryfikacji CRC (dla błędów sumy kontrolnej).
+     */
+    void record(FrameParser::Status status, const QByteArray &line, const FrameParser::CrcCheck &crcCheck);
+
+    /**
+     * @brief Zwraca łączną liczbę linii odrzuconych w danej kategorii.
+     * @param status [in] Kategoria błędu.
+     */
+    quint64 count(FrameParser::Status status) const;
+
+    /**
+     * @brief Zwraca łączną liczbę odrzuconych linii we wszystkich kategoriach.
+     */
+    quint64 totalCount() const;
+
+    /**
+     * @brief Zeruje liczniki i limity komunikatów.
+     */
+    void reset();
+
+    /**
+     * @brief Zwraca nazwę kategorii błędu używaną w logach.
+     * @param status [in] Kategoria błędu.
+     */
+    static QString categoryName(FrameParser::Status status);
+
+private slots:
+    /** @brief Loguje podsumowanie pominiętych komunikatów i odnawia limity kategorii bez błędów. */
+    void flushSummary();
+
+private:
+    static constexpr int CATEGORY_COUNT = static_cast<int>(FrameParser::Status::WrongFieldCount) + 1;
+
+    /**
+     * @brief Stan jednej kategorii błędów.
+     */
+    struct Category {
+        quint64 total = 0; //!< Łączna liczba zdarzeń.
+        quint64 inWindow = 0; //!< Zdarzenia w bieżącym oknie podsumowania.
+        quint64 suppressed = 0; //!< Zdarzenia niezalogowane w bieżącym oknie.
+        int detailedBudget = DETAILED_LOG_BUDGET; //!< Pozostałe szczegółowe komunikaty.
+    };
+
+    /** @brief Loguje szczegóły jednego zdarzenia. */
+    static void logDetailed(FrameParser::Status status, const QByteArray &line, const FrameParser::CrcCheck &crcCheck);
+
+    std::array<Category, CATEGORY_COUNT> m_categories; //!< Stan kategorii indeksowany przez `FrameParser::Status`.
+    QTimer *m_summaryTimer; //!< Jednorazowy timer okna podsumowania.
+    QElapsedTimer m_windowTimer; //!< Rzeczywisty czas trwania okna.
+};
+
+#endif // FRAMEDIAGNOSTICS_H
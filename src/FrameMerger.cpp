@@ -0,0 +1,50 @@
+/**
+ * @file FrameMerger.cpp
+ * @brief Implementacja klasy FrameMerger.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-04
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include "FrameMerger.h"
+
+void FrameMerger::addDevice(int deviceId) {
+    m_queues.try_emplace(deviceId);
+}
+
+void FrameMerger::removeDevice(int deviceId) {
+    const auto it = m_queues.find(deviceId);
+    if (it != m_queues.end()) {
+        m_pending -= static_cast<qsizetype>(it->second.size());
+        m_queues.erase(it);
+    }
+}
+
+void FrameMerger::push(const SensorFrame &frame) {
+    m_queues[frame.deviceId].push_back(frame);
+    ++m_pending;
+}
+
+void FrameMerger::popReady(qint64 nowNs, QVector<SensorFrame> &out) {
+    const qint64 watermarkNs = nowNs - m_reorderWindowNs;
+    while (m_pending > 0) {
+        std::deque<SensorFrame> *oldest = nullptr;
+        bool allDevicesWaiting = true; // Czy każde urządzenie ma coś w kolejce
+        for (auto &[deviceId, queue]: m_queues) {
+            if (queue.empty()) {
+                allDevicesWaiting = false;
+                continue;
+            }
+            if (!oldest || queue.front().hostTimestampNs < oldest->front().hostTimestampNs) {
+                oldest = &queue;
+            }
+        }
+        if (!oldest || (!allDevicesWaiting && oldest->front().hostTimestampNs > watermarkNs)) {
+            return; // Któreś urządzenie może jeszcze dostarczyć wcześniejszą ramkę
+        }
+        out.append(std::move(oldest->front()));
+        oldest->pop_front();
+        --m_pending;
+    }
+}
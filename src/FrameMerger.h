@@ -0,0 +1,77 @@
+#ifndef FRAMEMERGER_H
+#define FRAMEMERGER_H
+
+/**
+ * @file FrameMerger.h
+ * @brief Definicja klasy FrameMerger - scalanie strumieni ramek wielu urządzeń w jeden strumień uporządkowany w czasie.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-04
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include <QVector>
+#include <deque>
+#include <map>
+#include "SensorFrame.h"
+
+/**
+ * @class FrameMerger
+ * @brief Scalanie k-drożne kolejek ramek poszczególnych urządzeń wg `SensorFrame::hostTimestampNs`.
+ *
+ * @details
+ * Ramki jednego urządzenia mają niemalejące znaczniki czasu (`ReceiveClock`), więc każde urządzenie
+ * ma własną kolejkę FIFO. Najstarsza ramka spośród czół kolejek może zostać wydana, gdy:
+ * - każde inne zarejestrowane urządzenie ma w kolejce ramkę nie starszą od niej (nic wcześniejszego
+ *   już nie nadejdzie), albo
+ * - jest starsza niż `reorderWindowNs` względem bieżącego czasu (urządzenie milczy - nie można
+ *   czekać na nie w nieskończoność).
+ *
+ * Wybór czoła jest liniowy względem liczby urządzeń (typowo 1-8), a koszt na ramkę nie zależy
+ * od długości kolejek.
+ */
+class FrameMerger {
+public:
+    static constexpr qint64 DEFAULT_REORDER_WINDOW_NS = 20000000; //!< Domyślne okno oczekiwania (20 ms).
+
+    /**
+     * @brief Ustawia maksymalny czas oczekiwania na ramki wolniejszych urządzeń.
+     * @param windowNs [in] Okno w nanosekundach (większe - dokładniejsze porządkowanie, większe opóźnienie).
+     */
+    void setReorderWindowNs(qint64 windowNs) { m_reorderWindowNs = qMax<qint64>(0, windowNs); }
+
+    /**
+     * @brief Rejestruje urządzenie (pusta kolejka wstrzymuje wydawanie ramek innych urządzeń do upływu okna).
+     * @param deviceId [in] Identyfikator urządzenia.
+     */
+    void addDevice(int deviceId);
+
+    /**
+     * @brief Wyrejestrowuje urządzenie i odrzuca jego oczekujące ramki.
+     * @param deviceId [in] Identyfikator urządzenia.
+     */
+    void removeDevice(int deviceId);
+
+    /**
+     * @brief Dodaje ramkę do kolejki urządzenia `frame.deviceId` (rejestrując je w razie potrzeby).
+     * @param frame [in] Ramka.
+     */
+    void push(const SensorFrame &frame);
+
+    /**
+     * @brief Wydaje ramki gotowe do przekazania, w kolejności znaczników czasu.
+     * @param nowNs [in] Bieżący czas (`LatencyTracer::nowNs()`).
+     * @param out [out] Wektor, do którego dopisywane są ramki.
+     */
+    void popReady(qint64 nowNs, QVector<SensorFrame> &out);
+
+    /** @brief Zwraca łączną liczbę oczekujących ramek. */
+    qsizetype pendingFrames() const { return m_pending; }
+
+private:
+    std::map<int, std::deque<SensorFrame>> m_queues; //!< Kolejki ramek wg identyfikatora urządzenia.
+    qint64 m_reorderWindowNs = DEFAULT_REORDER_WINDOW_NS; //!< Okno oczekiwania na wolniejsze urządzenia.
+    qsizetype m_pending = 0; //!< Łączna liczba ramek w kolejkach.
+};
+
+#endif // FRAMEMERGER_H
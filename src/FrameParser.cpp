@@ -0,0 +1,99 @@
+/**
+ * @file FrameParser.cpp
+ * @brief Implementacja klasy FrameParser.
+ * @author Mateusz Wojtaszek
+ * @date 2025-05-30
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include "FrameParser.h"
+#include <QList>
+
+void FrameParser::append(const QByteArray &chunk) {
+    m_buffer.append(chunk);
+}
+
+bool FrameParser::takeLine(QByteArray &line) {
+    while (true) {
+        const qsizetype endOfLineIndex = m_buffer.indexOf('\n', m_readOffset);
+        if (endOfLineIndex < 0) {
+            // Brak pełnej linii - usuń przetworzoną część bufora jednym wywołaniem
+            m_buffer.remove(0, m_readOffset);
+            m_discardedBytes += m_readOffset;
+            m_readOffset = 0;
+            return false;
+        }
+        line = m_buffer.mid(m_readOffset, endOfLineIndex - m_readOffset).trimmed();
+        m_readOffset = endOfLineIndex + 1;
+        m_lastLineEndOffset = m_discardedBytes + m_readOffset;
+        if (!line.isEmpty()) {
+            return true;
+        }
+    }
+}
+
+void FrameParser::clear() {
+    m_buffer.clear();
+    m_readOffset = 0;
+    m_discardedBytes = 0;
+    m_lastLineEndOffset = 0;
+}
+
+qsizetype FrameParser::pendingBytes() const {
+    return m_buffer.size() - m_readOffset;
+}
+
+FrameParser::Status FrameParser::verifyCrc(const QByteArray &line, CrcCheck &check) {
+    const qsizetype checksumSeparatorIndex = line.lastIndexOf('*');
+    if (checksumSeparatorIndex == -1) {
+        return Status::MissingCrcSeparator;
+    }
+
+    check.payload = line.left(checksumSeparatorIndex);
+    check.receivedCrcHex = line.mid(checksumSeparatorIndex + 1);
+    check.calculatedCrc = calculateCrc16(check.payload);
+    bool conversionOk = false;
+    check.receivedCrc = check.receivedCrcHex.toUShort(&conversionOk, 16);
+    if (!conversionOk) {
+        return Status::InvalidCrcFormat;
+    }
+    return check.calculatedCrc == check.receivedCrc ? Status::Ok : Status::CrcMismatch;
+}
+
+FrameParser::Status FrameParser::parseCsv(const QByteArray &payload, int minCount, int maxCount,
+                                          QVector<float> &values) {
+    const QList<QByteArray> fields = payload.split(',');
+    if (fields.size() < minCount || fields.size() > maxCount) {
+        return Status::WrongFieldCount;
+    }
+    values.resize(0);
+    values.reserve(fields.size());
+    for (const QByteArray &field: fields) {
+        bool ok = false;
+        const float value = field.toFloat(&ok);
+        if (!ok) {
+            return Status::InvalidValue;
+        }
+        values.append(value);
+    }
+    return Status::Ok;
+}
+
+uint16_t FrameParser::calculateCrc16(const QByteArray &data) {
+    uint16_t crc = 0xFFFF;
+    const char *bytes = data.constData();
+    const qsizetype len = data.length();
+
+    for (qsizetype i = 0; i < len; ++i) {
+        crc ^= (static_cast<uint16_t>(static_cast<unsigned char>(bytes[i])) << 8);
+        for (int j = 0; j < 8; ++j) {
+            if (crc & 0x8000) {
+                crc = (crc << 1) ^ 0x1021;
+            } else {
+                crc <<= 1;
+            }
+        }
+    }
+    return crc;
+}
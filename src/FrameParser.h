@@ -0,0 +1,136 @@
+#ifndef FRAMEPARSER_H
+#define FRAMEPARSER_H
+
+/**
+ * @file FrameParser.h
+ * @brief Definicja klasy FrameParser - wydzielanie linii, weryfikacja CRC-16 i parsowanie CSV ramek telemetrycznych.
+ * @author Mateusz Wojtaszek
+ * @date 2025-05-30
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ *
+ * @details Oczekiwany format ramki danych: `CSV_PAYLOAD*CRC16_HEX\r\n`.
+ */
+
+#include <QByteArray>
+#include <QVector>
+#include <cstdint>
+
+/**
+ * @class FrameParser
+ * @brief Bezstanowe (poza buforem linii) przetwarzanie strumienia ramek `CSV*CRC16`.
+ *
+ * @details
+ * Logika wydzielona z `SerialPortHandler`, aby mogła być używana niezależnie od `QSerialPort`
+ * (benchmarki, inne źródła danych). Przetwarzanie odbywa się w trzech krokach:
+ * 1. `append()` + `takeLine()` - składanie porcji bajtów i wydzielanie kompletnych linii,
+ * 2. `verifyCrc()` - oddzielenie ładunku od sumy kontrolnej i jej weryfikacja,
+ * 3. `parseCsv()` - zamiana ładunku na wektor liczb zmiennoprzecinkowych.
+ *
+ * Funkcje weryfikujące nie logują błędów - zwracają `Status`, a o sposobie raportowania
+ * decyduje wywołujący.
+ */
+class FrameParser {
+public:
+    /**
+     * @enum Status
+     * @brief Wynik weryfikacji lub parsowania linii.
+     */
+    enum class Status {
+        Ok, //!< Linia poprawna.
+        MissingCrcSeparator, //!< Brak separatora `*`.
+        InvalidCrcFormat, //!< Suma kontrolna nie jest liczbą szesnastkową.
+        CrcMismatch, //!< Suma kontrolna nie zgadza się z ładunkiem.
+        InvalidValue, //!< Pole CSV nie jest liczbą.
+        WrongFieldCount //!< Nieoczekiwana liczba pól CSV.
+    };
+
+    /**
+     * @struct CrcCheck
+     * @brief Szczegóły weryfikacji sumy kontrolnej (do diagnostyki).
+     */
+    struct CrcCheck {
+        QByteArray payload; //!< Ładunek CSV (bez `*CRC`).
+        QByteArray receivedCrcHex; //!< Suma kontrolna w postaci tekstowej.
+        uint16_t receivedCrc = 0; //!< Odebrana suma kontrolna.
+        uint16_t calculatedCrc = 0; //!< Suma kontrolna obliczona z ładunku.
+    };
+
+    /**
+     * @brief Dołącza porcję odebranych bajtów do bufora linii.
+     * @param chunk [in] Odebrane bajty.
+     */
+    void append(const QByteArray &chunk);
+
+    /**
+     * @brief Wydziela kolejną kompletną, niepustą linię (bez białych znaków na końcach).
+     * @param line [out] Wydzielona linia.
+     * @return `true`, jeśli linia była dostępna.
+     */
+    bool takeLine(QByteArray &line);
+
+    /** @brief Usuwa niekompletne dane z bufora. */
+    void clear();
+
+    /**
+     * @brief Zwraca liczbę bajtów oczekujących w buforze (niepełna linia).
+     */
+    qsizetype pendingBytes() const;
+
+    /**
+     * @brief Zwraca łączną liczbę bajtów przekazanych do `append()` od utworzenia lub `clear()`.
+     * @details Jest to pozycja w strumieniu tuż za ostatnim odebranym bajtem.
+     */
+    qint64 receivedBytes() const { return m_discardedBytes + m_buffer.size(); }
+
+    /**
+     * @brief Zwraca pozycję w strumieniu tuż za znakiem końca linii ostatnio wydzielonej przez `takeLine()`.
+     * @details Pozwala powiązać linię z porcją danych, w której dotarł jej koniec (np. do interpolacji
+     * czasu odbioru).
+     */
+    qint64 lastLineEndOffset() const { return m_lastLineEndOffset; }
+
+    /**
+     * @brief Oddziela ładunek od sumy kontrolnej i weryfikuje ją.
+     * @param line [in] Linia w formacie `CSV_PAYLOAD*CRC16_HEX`.
+     * @param check [out] Ładunek oraz sumy kontrolne.
+     * @return `Status::Ok` albo rodzaj błędu sumy kontrolnej.
+     */
+    static Status verifyCrc(const QByteArray &line, CrcCheck &check);
+
+    /**
+     * @brief Parsuje ładunek CSV do wektora liczb.
+     * @param payload [in] Ładunek CSV.
+     * @param expectedCount [in] Oczekiwana liczba pól.
+     * @param values [out] Sparsowane wartości (nadpisywane).
+     * @return `Status::Ok`, `Status::WrongFieldCount` lub `Status::InvalidValue`.
+     */
+    static Status parseCsv(const QByteArray &payload, int expectedCount, QVector<float> &values) {
+        return parseCsv(payload, expectedCount, expectedCount, values);
+    }
+
+    /**
+     * @brief Parsuje ładunek CSV o zmiennej liczbie pól (np. z opcjonalnymi polami na końcu).
+     * @param payload [in] Ładunek CSV.
+     * @param minCount [in] Najmniejsza akceptowana liczba pól.
+     * @param maxCount [in] Największa akceptowana liczba pól.
+     * @param values [out] Sparsowane wartości (nadpisywane).
+     * @return `Status::Ok`, `Status::WrongFieldCount` lub `Status::InvalidValue`.
+     */
+    static Status parseCsv(const QByteArray &payload, int minCount, int maxCount, QVector<float> &values);
+
+    /**
+     * @brief Oblicza sumę kontrolną CRC-16/CCITT-FALSE.
+     * @param data Dane wejściowe.
+     * @return 16-bitowa suma kontrolna CRC.
+     */
+    static uint16_t calculateCrc16(const QByteArray &data);
+
+private:
+    QByteArray m_buffer; //!< Bajty oczekujące na znak końca linii.
+    qsizetype m_readOffset = 0; //!< Początek nieprzetworzonych danych w buforze.
+    qint64 m_discardedBytes = 0; //!< Bajty usunięte już z początku bufora (pozycja bufora w strumieniu).
+    qint64 m_lastLineEndOffset = 0; //!< Pozycja w strumieniu za końcem ostatniej wydzielonej linii.
+};
+
+#endif // FRAMEPARSER_H
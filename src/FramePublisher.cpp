@@ -0,0 +1,145 @@
+/**
+ * @file FramePublisher.cpp
+ * @brief Implementacja klasy FramePublisher.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-06
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include "FramePublisher.h"
+#include "FrameWireFormat.h"
+#include "LatencyTracer.h"
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QDebug>
+
+constexpr qint64 NS_PER_MS_FP = 1000000;
+constexpr int ENCODED_FRAME_BYTES_FP = FrameWireFormat::RECORD_HEADER_BYTES + 14 * sizeof(float); // Ramka IMU + GPS
+
+FramePublisher::FramePublisher(QObject *parent)
+    : QObject(parent),
+      m_server(new QLocalServer(this)) {
+    connect(m_server, &QLocalServer::newConnection, this, &FramePublisher::acceptClients);
+}
+
+FramePublisher::~FramePublisher() {
+    stop();
+}
+
+bool FramePublisher::start(const QString &serverName, QString *errorString) {
+    stop();
+    // Tylko bieżący użytkownik - strumień zawiera pozycję GPS
+    m_server->setSocketOptions(QLocalServer::UserAccessOption);
+    if (!m_server->listen(serverName)) {
+        // Pozostałość po procesie, który nie zamknął serwera (plik gniazda w systemach Unix)
+        if (m_server->serverError() == QAbstractSocket::AddressInUseError && QLocalServer::removeServer(serverName)) {
+            m_server->listen(serverName);
+        }
+    }
+    if (!m_server->isListening()) {
+        if (errorString) {
+            *errorString = m_server->errorString();
+        }
+        qWarning() << "Failed to start frame publisher" << serverName << "Error:" << m_server->errorString();
+        return false;
+    }
+    m_framesPublished = 0;
+    m_framesDropped = 0;
+    m_clientsDisconnected = 0;
+    qInfo() << "Publishing frames on local socket" << m_server->fullServerName();
+    return true;
+}
+
+void FramePublisher::stop() {
+    const QList<QLocalSocket *> sockets = m_clients.keys();
+    for (QLocalSocket *socket: sockets) {
+        removeClient(socket);
+    }
+    if (m_server->isListening()) {
+        m_server->close();
+        qInfo() << "Frame publisher stopped.";
+    }
+}
+
+bool FramePublisher::isListening() const {
+    return m_server->isListening();
+}
+
+QString FramePublisher::fullServerName() const {
+    return m_server->fullServerName();
+}
+
+FramePublisher::Stats FramePublisher::stats() const {
+    Stats stats;
+    stats.clients = static_cast<int>(m_clients.size());
+    stats.framesPublished = m_framesPublished;
+    stats.framesDropped = m_framesDropped;
+    stats.clientsDisconnected = m_clientsDisconnected;
+    return stats;
+}
+
+void FramePublisher::publish(const QVector<SensorFrame> &frames) {
+    m_framesPublished += static_cast<quint64>(frames.size());
+    if (m_clients.isEmpty() || frames.isEmpty()) {
+        return; // Bez klientów publikacja nic nie kosztuje
+    }
+
+    // Jedno kodowanie dla wszystkich klientów; pojemność bufora zachowana między paczkami
+    m_encoded.clear();
+    m_encoded.reserve(frames.size() * ENCODED_FRAME_BYTES_FP);
+    for (const SensorFrame &frame: frames) {
+        FrameWireFormat::appendFrame(m_encoded, frame);
+    }
+
+    const qint64 nowNs = LatencyTracer::nowNs();
+    QList<QLocalSocket *> slowClients;
+    for (auto it = m_clients.begin(); it != m_clients.end(); ++it) {
+        QLocalSocket *socket = it.key();
+        Client &client = it.value();
+        if (socket->bytesToWrite() + m_encoded.size() > MAX_CLIENT_QUEUE_BYTES) {
+            // Kolejka pełna - pomiń całą paczkę, aby nie przerwać rekordu
+            client.droppedFrames += static_cast<quint32>(frames.size());
+            m_framesDropped += static_cast<quint64>(frames.size());
+            if (client.overflowSinceNs == 0) {
+                client.overflowSinceNs = nowNs;
+            } else if (nowNs - client.overflowSinceNs > SLOW_CLIENT_TIMEOUT_MS * NS_PER_MS_FP) {
+                slowClients.append(socket);
+            }
+            continue;
+        }
+        if (client.droppedFrames > 0) {
+            QByteArray overflow;
+            FrameWireFormat::appendOverflow(overflow, client.droppedFrames, nowNs);
+            socket->write(overflow);
+            client.droppedFrames = 0;
+        }
+        client.overflowSinceNs = 0;
+        socket->write(m_encoded);
+    }
+
+    for (QLocalSocket *socket: std::as_const(slowClients)) {
+        qWarning() << "Disconnecting frame subscriber that stopped reading for" << SLOW_CLIENT_TIMEOUT_MS << "ms.";
+        ++m_clientsDisconnected;
+        removeClient(socket);
+    }
+}
+
+void FramePublisher::acceptClients() {
+    while (QLocalSocket *socket = m_server->nextPendingConnection()) {
+        m_clients.insert(socket, Client{});
+        connect(socket, &QLocalSocket::disconnected, this, [this, socket] { removeClient(socket); });
+        socket->write(FrameWireFormat::greeting());
+        qInfo() << "Frame subscriber connected -" << m_clients.size() << "client(s).";
+    }
+}
+
+void FramePublisher::removeClient(QLocalSocket *socket) {
+    if (!m_clients.remove(socket)) {
+        return;
+    }
+    socket->disconnect(this);
+    socket->abort();
+    socket->deleteLater();
+    qInfo() << "Frame subscriber disconnected -" << m_clients.size() << "client(s) left.";
+}
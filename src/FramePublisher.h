@@ -0,0 +1,120 @@
+#ifndef FRAMEPUBLISHER_H
+#define FRAMEPUBLISHER_H
+
+/**
+ * @file FramePublisher.h
+ * @brief Definicja klasy FramePublisher - udostępnianie zdekodowanych ramek innym procesom przez gniazdo lokalne.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-06
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include <QObject>
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include "SensorFrame.h"
+
+class QLocalServer;
+class QLocalSocket;
+
+/**
+ * @class FramePublisher
+ * @brief Serwer `QLocalServer` (gniazdo domeny Unix / nazwany potok) rozsyłający ramki wielu klientom.
+ *
+ * @details
+ * Każda paczka ramek jest kodowana raz (`FrameWireFormat`) i dopisywana do kolejek wszystkich
+ * klientów - koszt publikacji nie zależy od liczby klientów poza samym zapisem do gniazda.
+ * Kolejką klienta jest bufor zapisu jego gniazda, ograniczony do `MAX_CLIENT_QUEUE_BYTES`:
+ * - paczka, która by go przepełniła, jest dla tego klienta pomijana w całości (strumień pozostaje
+ *   spójny - klient traci najnowsze ramki, a nie fragmenty rekordów),
+ * - po opróżnieniu kolejki klient otrzymuje rekord `Overflow` z liczbą pominiętych ramek,
+ * - klient, który nie odbiera niczego przez `SLOW_CLIENT_TIMEOUT_MS`, jest rozłączany.
+ *
+ * Wolny klient nie spowalnia więc ani źródeł danych, ani pozostałych klientów.
+ */
+class FramePublisher : public QObject {
+    Q_OBJECT
+
+public:
+    static constexpr char DEFAULT_SERVER_NAME[] = "orienta-frames"; //!< Domyślna nazwa serwera.
+    static constexpr qint64 MAX_CLIENT_QUEUE_BYTES = 256 * 1024; //!< Limit danych oczekujących dla klienta.
+    static constexpr int SLOW_CLIENT_TIMEOUT_MS = 5000; //!< Czas ciągłego przepełnienia, po którym klient jest rozłączany.
+
+    /**
+     * @struct Stats
+     * @brief Liczniki serwera od uruchomienia.
+     */
+    struct Stats {
+        int clients = 0; //!< Podłączeni klienci.
+        quint64 framesPublished = 0; //!< Ramki przekazane do publikacji.
+        quint64 framesDropped = 0; //!< Ramki pominięte dla wolnych klientów (suma po klientach).
+        quint64 clientsDisconnected = 0; //!< Klienci rozłączeni z powodu braku odbioru.
+    };
+
+    /**
+     * @brief Konstruktor klasy FramePublisher.
+     * @param parent [in] Obiekt nadrzędny.
+     */
+    explicit FramePublisher(QObject *parent = nullptr);
+
+    /**
+     * @brief Destruktor - zamyka serwer i rozłącza klientów.
+     */
+    ~FramePublisher() override;
+
+    /**
+     * @brief Uruchamia serwer.
+     * @param serverName [in] Nazwa gniazda (np. `orienta-frames`; w systemach Unix plik w katalogu tymczasowym).
+     * @param errorString [out] Opcjonalnie: opis błędu.
+     * @return `true`, jeśli serwer nasłuchuje.
+     */
+    bool start(const QString &serverName, QString *errorString = nullptr);
+
+    /** @brief Zatrzymuje serwer i rozłącza klientów. */
+    void stop();
+
+    /** @brief Informuje, czy serwer nasłuchuje. */
+    bool isListening() const;
+
+    /** @brief Zwraca pełną nazwę gniazda serwera (ścieżka w systemach Unix). */
+    QString fullServerName() const;
+
+    /** @brief Zwraca liczniki serwera. */
+    Stats stats() const;
+
+    /**
+     * @brief Publikuje paczkę ramek wszystkim klientom.
+     * @param frames [in] Ramki (uporządkowane wg czasu odbioru).
+     */
+    void publish(const QVector<SensorFrame> &frames);
+
+private:
+    /**
+     * @brief Stan jednego klienta.
+     */
+    struct Client {
+        quint32 droppedFrames = 0; //!< Ramki pominięte od ostatniego rekordu `Overflow`.
+        qint64 overflowSinceNs = 0; //!< Początek bieżącego przepełnienia; 0 - brak.
+    };
+
+    /** @brief Przyjmuje oczekujące połączenia. */
+    void acceptClients();
+
+    /**
+     * @brief Usuwa klienta.
+     * @param socket [in] Gniazdo klienta.
+     */
+    void removeClient(QLocalSocket *socket);
+
+    QLocalServer *m_server; //!< Serwer gniazda lokalnego.
+    QHash<QLocalSocket *, Client> m_clients; //!< Podłączeni klienci.
+    QByteArray m_encoded; //!< Bufor zakodowanej paczki wielokrotnego użytku.
+    quint64 m_framesPublished = 0; //!< Ramki przekazane do publikacji.
+    quint64 m_framesDropped = 0; //!< Ramki pominięte dla wolnych klientów.
+    quint64 m_clientsDisconnected = 0; //!< Klienci rozłączeni z powodu braku odbioru.
+};
+
+#endif // FRAMEPUBLISHER_H
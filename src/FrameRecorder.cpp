@@ -0,0 +1,59 @@
+/**
+ * @file FrameRecorder.cpp
+ * @brief Implementacja klasy FrameRecorder.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-03
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include "FrameRecorder.h"
+#include <QDebug>
+
+constexpr double NS_PER_MS_FR = 1.0e6;
+
+bool FrameRecorder::open(const QString &filePath) {
+    close();
+    m_file.setFileName(filePath);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        qWarning() << "Failed to open recording file:" << filePath << "Error:" << m_file.errorString();
+        return false;
+    }
+    m_originNs = 0;
+    m_framesWritten = 0;
+    m_file.write("# GYRO_X,GYRO_Y,GYRO_Z,ACC_X,ACC_Y,ACC_Z,MAG_X,MAG_Y,MAG_Z,ROLL,PITCH,YAW,T_MS\n");
+    qInfo() << "Recording frames to" << filePath;
+    return true;
+}
+
+void FrameRecorder::close() {
+    if (m_file.isOpen()) {
+        m_file.close();
+        qInfo() << "Recording closed after" << m_framesWritten << "frames:" << m_file.fileName();
+    }
+}
+
+void FrameRecorder::write(const SensorFrame &frame) {
+    if (!m_file.isOpen() || frame.values.size() < IMU_VALUE_COUNT) {
+        return;
+    }
+    if (m_originNs == 0) {
+        m_originNs = frame.hostTimestampNs;
+    }
+    QByteArray line;
+    line.reserve(128);
+    for (int i = 0; i < IMU_VALUE_COUNT; ++i) {
+        line += QByteArray::number(frame.values[i], 'g', 7); // Pełna precyzja float
+        line += ',';
+    }
+    line += QByteArray::number((frame.hostTimestampNs - m_originNs) / NS_PER_MS_FR, 'f', 3);
+    line += '\n';
+    m_file.write(line);
+    ++m_framesWritten;
+}
+
+void FrameRecorder::writeGap(int lostFrames) {
+    if (m_file.isOpen()) {
+        m_file.write(QByteArray(GAP_MARKER) + ',' + QByteArray::number(lostFrames) + '\n');
+    }
+}
@@ -0,0 +1,70 @@
+#ifndef FRAMERECORDER_H
+#define FRAMERECORDER_H
+
+/**
+ * @file FrameRecorder.h
+ * @brief Definicja klasy FrameRecorder - zapis odebranych ramek do pliku symulacyjnego z czasem odbioru.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-03
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include <QFile>
+#include <QString>
+#include "SensorFrame.h"
+
+/**
+ * @class FrameRecorder
+ * @brief Zapisuje ramki w formacie plików `simulation_data*.log` uzupełnionym o czas odbioru.
+ *
+ * @details
+ * Każdy wiersz zawiera 12 wartości IMU i - jako 13. kolumnę - czas odbioru ramki w milisekundach
+ * od pierwszej zapisanej ramki (`SensorFrame::hostTimestampNs`). Odtwarzanie w trybie symulacji
+ * używa tej kolumny zamiast stałego kroku, więc zachowuje rzeczywisty rytm (i nieregularności)
+ * nagrania. Luki w numerach sekwencyjnych zapisywane są jako komentarz `# gap,N` przed ramką.
+ * Pliki bez 13. kolumny pozostają poprawnymi danymi symulacyjnymi.
+ */
+class FrameRecorder {
+public:
+    static constexpr int IMU_VALUE_COUNT = 12; //!< Liczba zapisywanych wartości IMU.
+    static constexpr char GAP_MARKER[] = "# gap"; //!< Początek wiersza oznaczającego lukę w danych.
+
+    /**
+     * @brief Otwiera (nadpisuje) plik nagrania i zapisuje nagłówek.
+     * @param filePath [in] Ścieżka pliku.
+     * @return `true`, jeśli plik został otwarty.
+     */
+    bool open(const QString &filePath);
+
+    /** @brief Zamyka plik nagrania. */
+    void close();
+
+    /** @brief Informuje, czy nagrywanie trwa. */
+    bool isOpen() const { return m_file.isOpen(); }
+
+    /**
+     * @brief Zapisuje ramkę (pierwsze 12 wartości i czas odbioru).
+     * @param frame [in] Ramka z co najmniej 12 wartościami.
+     */
+    void write(const SensorFrame &frame);
+
+    /**
+     * @brief Zaznacza w nagraniu lukę przed następną ramką.
+     * @param lostFrames [in] Liczba utraconych ramek.
+     */
+    void writeGap(int lostFrames);
+
+    /** @brief Zwraca liczbę ramek zapisanych od otwarcia pliku. */
+    quint64 framesWritten() const { return m_framesWritten; }
+
+    /** @brief Zwraca opis ostatniego błędu pliku. */
+    QString errorString() const { return m_file.errorString(); }
+
+private:
+    QFile m_file; //!< Plik nagrania.
+    qint64 m_originNs = 0; //!< Czas odbioru pierwszej ramki; 0 - brak.
+    quint64 m_framesWritten = 0; //!< Liczba zapisanych ramek.
+};
+
+#endif // FRAMERECORDER_H
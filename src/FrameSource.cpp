@@ -0,0 +1,106 @@
+/**
+ * @file FrameSource.cpp
+ * @brief Implementacja klasy FrameSource.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-05
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include "FrameSource.h"
+#include "FrameDiagnostics.h"
+#include "LatencyTracer.h"
+#include "PerfCounters.h"
+#include <QDebug>
+
+FrameSource::FrameSource(QObject *parent)
+    : QObject(parent),
+      diagnostics(new FrameDiagnostics(this)) {
+}
+
+void FrameSource::resetDecoder(qint32 baudRate) {
+    parser.clear();
+    sequenceTracker.reset(); // Nowe połączenie - numeracja urządzenia zaczyna się od nowa
+    receiveClock.reset();
+    receiveClock.setBaudRate(baudRate);
+    timingStats.reset();
+}
+
+void FrameSource::ingest(const QByteArray &chunk, qint64 receivedNs) {
+    if (chunk.isEmpty()) {
+        return;
+    }
+    parser.append(chunk);
+    receiveClock.chunkReceived(receivedNs, parser.receivedBytes(), chunk.size());
+
+    QByteArray line;
+    while (parser.takeLine(line)) {
+        // Czas odbioru ramki interpolowany wg pozycji końca linii w porcji - jest też początkiem pomiaru opóźnień
+        // Znaczniki niezależne od bieżącej ramki LatencyTracer - źródło może być obsługiwane w wątku I/O
+        SensorFrame frame;
+        frame.deviceId = m_deviceId;
+        frame.hostTimestampNs = receiveClock.timestampFor(parser.lastLineEndOffset());
+        const qint64 lineTakenNs = LatencyTracer::markDetached(LatencyTracer::Stage::ReadyRead,
+                                                               frame.hostTimestampNs, frame.hostTimestampNs);
+
+        FrameParser::CrcCheck crcCheck;
+        const FrameParser::Status crcStatus = FrameParser::verifyCrc(line, crcCheck);
+        if (crcStatus != FrameParser::Status::Ok) {
+            diagnostics->record(crcStatus, line, crcCheck);
+            continue;
+        }
+        LatencyTracer::markDetached(LatencyTracer::Stage::CrcValidated, frame.hostTimestampNs, lineTakenNs);
+
+        const FrameParser::Status parseStatus = FrameParser::parseCsv(crcCheck.payload, EXPECTED_VALUE_COUNT,
+                                                                      SEQUENCED_VALUE_COUNT, frame.values);
+        if (parseStatus != FrameParser::Status::Ok) {
+            diagnostics->record(parseStatus, line, crcCheck);
+            continue;
+        }
+        if (frame.values.size() == SEQUENCED_VALUE_COUNT && !acceptSequence(frame, line, crcCheck)) {
+            continue;
+        }
+        timingStats.observe(frame.hostTimestampNs);
+        PerfCounters::addFrameReceived();
+        PerfCounters::setFrameInterval(static_cast<qint64>(timingStats.meanIntervalUs() * 1000.0),
+                                       static_cast<qint64>(timingStats.jitterUs() * 1000.0));
+        emit frameReceived(frame); // 14 wartości i czas odbioru
+    }
+    PerfCounters::setQueueDepth(parser.pendingBytes()); // Niepełna linia oczekująca na kolejną porcję
+}
+
+bool FrameSource::acceptSequence(SensorFrame &frame, const QByteArray &line,
+                                 const FrameParser::CrcCheck &crcCheck) {
+    const float sequenceValue = frame.values.takeLast();
+    // Numer 16-bitowy jest dokładnie reprezentowalny jako float; inne wartości to błąd ramki
+    if (sequenceValue < 0.0f || sequenceValue >= static_cast<float>(SequenceTracker::SEQUENCE_MODULUS) ||
+        sequenceValue != static_cast<float>(static_cast<quint32>(sequenceValue))) {
+        diagnostics->record(FrameParser::Status::InvalidValue, line, crcCheck);
+        return false;
+    }
+
+    quint32 lostFrames = 0;
+    switch (sequenceTracker.observe(static_cast<quint32>(sequenceValue), &lostFrames)) {
+        case SequenceTracker::Event::Gap:
+            PerfCounters::addFramesLost(lostFrames);
+            LatencyTracer::markSequenceGap(lostFrames);
+            timingStats.markDiscontinuity(); // Odstęp przez lukę nie jest jitterem łącza
+            frame.lostFramesBefore = static_cast<int>(lostFrames);
+            emit sequenceGap(static_cast<int>(lostFrames));
+            return true;
+        case SequenceTracker::Event::Duplicate:
+            PerfCounters::addDuplicateFrame();
+            return false;
+        case SequenceTracker::Event::Late:
+            // Widoki są już dalej w czasie - ramka jest tylko liczona
+            PerfCounters::addLateFrame();
+            return false;
+        case SequenceTracker::Event::Restart:
+            qInfo() << "Frame sequence counter restarted at" << static_cast<quint32>(sequenceValue);
+            return true;
+        case SequenceTracker::Event::First:
+        case SequenceTracker::Event::InOrder:
+            return true;
+    }
+    return true;
+}
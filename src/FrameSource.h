@@ -0,0 +1,170 @@
+#ifndef FRAMESOURCE_H
+#define FRAMESOURCE_H
+
+/**
+ * @file FrameSource.h
+ * @brief Definicja klasy FrameSource - wspólna podstawa źródeł ramek telemetrycznych (port szeregowy, sieć).
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-05
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ *
+ * @details Oczekiwany format ramki danych: `CSV_PAYLOAD*CRC16_HEX\r\n`, gdzie CSV_PAYLOAD to
+ * 12 wartości IMU, 2 wartości GPS (LAT, LON) i opcjonalnie numer sekwencyjny ramki (SEQ).
+ */
+
+#include <QObject>
+#include <QByteArray>
+#include <QString>
+#include "FrameParser.h"
+#include "SequenceTracker.h"
+#include "ReceiveClock.h"
+#include "FrameTimingStats.h"
+#include "SensorFrame.h"
+
+class FrameDiagnostics;
+
+/**
+ * @class FrameSource
+ * @brief Abstrakcyjne źródło ramek: przekazuje odebrane bajty przez wspólną ścieżkę dekodowania.
+ *
+ * @details
+ * Klasy pochodne odpowiadają wyłącznie za transport (otwarcie, odczyt porcji bajtów, błędy)
+ * i przekazują każdą odebraną porcję do `ingest()`. Wydzielanie linii, weryfikacja CRC, parsowanie
+ * CSV, numery sekwencyjne, znaczniki czasu odbioru i diagnostyka błędnych ramek są wspólne, więc
+ * ramka z portu szeregowego i z sieci przechodzi dokładnie tę samą drogę.
+ */
+class FrameSource : public QObject {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Konstruktor klasy FrameSource.
+     * @param parent [in] Obiekt nadrzędny.
+     */
+    explicit FrameSource(QObject *parent = nullptr);
+
+    /**
+     * @brief Zamyka źródło (port, gniazdo).
+     */
+    virtual void close() = 0;
+
+    /**
+     * @brief Informuje, czy źródło jest otwarte.
+     */
+    virtual bool isOpen() const = 0;
+
+    /**
+     * @brief Zwraca nazwę źródła do wyświetlenia (np. `ttyUSB0`, `udp://:5005`).
+     */
+    virtual QString sourceName() const = 0;
+
+    /**
+     * @brief Zwraca opis ostatniego błędu transportu.
+     */
+    virtual QString getLastError() const = 0;
+
+    /**
+     * @brief Zwraca liczniki odrzuconych ramek według kategorii błędu.
+     * @return Wskaźnik na obiekt diagnostyki (własność FrameSource).
+     */
+    const FrameDiagnostics *frameDiagnostics() const { return diagnostics; }
+
+    /**
+     * @brief Zwraca statystyki numerów sekwencyjnych od otwarcia źródła.
+     * @details Dla urządzeń wysyłających ramki bez numeru sekwencyjnego wszystkie liczniki pozostają zerowe.
+     */
+    const SequenceTracker::Stats &sequenceStats() const { return sequenceTracker.stats(); }
+
+    /**
+     * @brief Zwraca statystyki odstępów między znacznikami czasu odebranych ramek od otwarcia źródła.
+     */
+    const FrameTimingStats &frameTimingStats() const { return timingStats; }
+
+    /**
+     * @brief Ustawia identyfikator urządzenia wpisywany do każdej ramki (`SensorFrame::deviceId`).
+     * @param deviceId [in] Identyfikator nadany przez `DeviceManager`.
+     */
+    void setDeviceId(int deviceId) { m_deviceId = deviceId; }
+
+    /** @brief Zwraca identyfikator urządzenia. */
+    int deviceId() const { return m_deviceId; }
+
+signals:
+    /**
+     * @brief Emitowany, gdy kompletna linia danych została odebrana, zweryfikowana przez CRC i pomyślnie sparsowana.
+     *
+     * @details Oczekiwany format ładunku danych CSV to:
+     * GYRO_X, GYRO_Y, GYRO_Z, ACC_X, ACC_Y, ACC_Z, MAG_X, MAG_Y, MAG_Z, ROLL, PITCH, YAW, GPS_LAT, GPS_LON[, SEQ].
+     * Sygnał ten dostarcza sparsowane dane jako wektor liczb zmiennoprzecinkowych wraz z monotonicznym
+     * czasem odbioru (interpolowanym wewnątrz porcji danych przez `ReceiveClock`). Opcjonalny numer
+     * sekwencyjny SEQ nie jest przekazywany - ramki zdublowane i spóźnione nie są emitowane wcale,
+     * a o brakujących ramkach informuje wcześniej sygnał `sequenceGap()` i pole `SensorFrame::lostFramesBefore`.
+     * @param frame [out] Ramka: 14 sparsowanych wartości (12 IMU + 2 GPS) i czas odbioru.
+     */
+    void frameReceived(const SensorFrame &frame);
+
+    /**
+     * @brief Emitowany przed ramką, przed którą brakuje ramek według numerów sekwencyjnych.
+     * @details Odbiorcy (np. wykresy) powinni zaznaczyć przerwę zamiast łączyć sąsiednie próbki.
+     * @param lostFrames [out] Liczba brakujących ramek.
+     */
+    void sequenceGap(int lostFrames);
+
+    /**
+     * @brief Emitowany, gdy wystąpi błąd transportu.
+     * @param errorString [out] Opis błędu.
+     */
+    void errorOccurred(const QString &errorString);
+
+protected:
+    /**
+     * @brief Przygotowuje dekodowanie nowego połączenia (bufor linii, numeracja, zegar odbioru, statystyki).
+     * @param baudRate [in] Prędkość łącza dla `ReceiveClock`; 0 - nieznana (źródła sieciowe).
+     */
+    void resetDecoder(qint32 baudRate);
+
+    /**
+     * @brief Odrzuca niekompletną linię (np. po zamknięciu źródła).
+     */
+    void discardPartialLine() { parser.clear(); }
+
+    /**
+     * @brief Dekoduje porcję odebranych bajtów i emituje `frameReceived()` dla każdej poprawnej ramki.
+     * @param chunk [in] Odebrane bajty (fragment strumienia lub cały datagram).
+     * @param receivedNs [in] Czas odczytu porcji (`LatencyTracer::nowNs()`).
+     */
+    void ingest(const QByteArray &chunk, qint64 receivedNs);
+
+private:
+    /**
+     * @brief Zdejmuje numer sekwencyjny z końca ramki i klasyfikuje ją.
+     * @param frame [in,out] Ramka; numer sekwencyjny jest usuwany z wartości, a luka zapisywana w `lostFramesBefore`.
+     * @param line [in] Linia ramki (do diagnostyki).
+     * @param crcCheck [in] Szczegóły weryfikacji CRC (do diagnostyki).
+     * @return `true`, jeśli ramkę należy przekazać dalej; `false` dla duplikatów, ramek spóźnionych
+     * i niepoprawnych numerów.
+     */
+    bool acceptSequence(SensorFrame &frame, const QByteArray &line, const FrameParser::CrcCheck &crcCheck);
+
+    FrameParser parser;              ///< Bufor linii, weryfikacja CRC i parsowanie CSV.
+    FrameDiagnostics *diagnostics;   ///< Liczniki błędnych ramek i ograniczone logowanie.
+    SequenceTracker sequenceTracker; ///< Wykrywanie luk, duplikatów i zmian kolejności ramek.
+    ReceiveClock receiveClock;       ///< Interpolacja czasu odbioru linii wewnątrz porcji danych.
+    FrameTimingStats timingStats;    ///< Odstępy i jitter czasów odbioru ramek.
+    int m_deviceId = 0;              ///< Identyfikator urządzenia w ramkach.
+
+    /**
+     * @var EXPECTED_VALUE_COUNT
+     * @brief Definiuje oczekiwaną liczbę wartości w ładunku CSV (12 IMU + 2 GPS = 14).
+     */
+    static constexpr int EXPECTED_VALUE_COUNT = 14;
+
+    /**
+     * @var SEQUENCED_VALUE_COUNT
+     * @brief Liczba wartości w ładunku CSV z opcjonalnym numerem sekwencyjnym (14 + SEQ = 15).
+     */
+    static constexpr int SEQUENCED_VALUE_COUNT = 15;
+};
+
+#endif // FRAMESOURCE_H
@@ -0,0 +1,41 @@
+/**
+ * @file FrameTimingStats.cpp
+ * @brief Implementacja klasy FrameTimingStats.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-03
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include "FrameTimingStats.h"
+#include <cmath>
+
+void FrameTimingStats::observe(qint64 timestampNs) {
+    if (m_lastTimestampNs > 0) {
+        const qint64 intervalNs = timestampNs - m_lastTimestampNs;
+        ++m_count;
+        const double delta = static_cast<double>(intervalNs) - m_meanNs;
+        m_meanNs += delta / static_cast<double>(m_count);
+        m_m2 += delta * (static_cast<double>(intervalNs) - m_meanNs);
+        m_minNs = m_count == 1 ? intervalNs : qMin(m_minNs, intervalNs);
+        m_maxNs = m_count == 1 ? intervalNs : qMax(m_maxNs, intervalNs);
+    }
+    m_lastTimestampNs = timestampNs;
+}
+
+double FrameTimingStats::jitterUs() const {
+    return m_count > 1 ? std::sqrt(m_m2 / static_cast<double>(m_count - 1)) / 1000.0 : 0.0;
+}
+
+QString FrameTimingStats::summaryText() const {
+    return QStringLiteral("Frame interval: n=%1, mean=%2 us, jitter=%3 us, min=%4 us, max=%5 us")
+            .arg(m_count)
+            .arg(meanIntervalUs(), 0, 'f', 1)
+            .arg(jitterUs(), 0, 'f', 1)
+            .arg(minIntervalUs(), 0, 'f', 1)
+            .arg(maxIntervalUs(), 0, 'f', 1);
+}
+
+void FrameTimingStats::reset() {
+    *this = FrameTimingStats();
+}
@@ -0,0 +1,69 @@
+#ifndef FRAMETIMINGSTATS_H
+#define FRAMETIMINGSTATS_H
+
+/**
+ * @file FrameTimingStats.h
+ * @brief Definicja klasy FrameTimingStats - statystyki odstępów między znacznikami czasu ramek.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-03
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include <QtGlobal>
+#include <QString>
+
+/**
+ * @class FrameTimingStats
+ * @brief Przyrostowe statystyki odstępów między kolejnymi ramkami (średnia, jitter, minimum, maksimum).
+ *
+ * @details
+ * Odstępy liczone są ze znaczników `SensorFrame::hostTimestampNs`. Średnia i odchylenie standardowe
+ * (jitter) są aktualizowane algorytmem Welforda w O(1) na ramkę, bez przechowywania historii.
+ */
+class FrameTimingStats {
+public:
+    /**
+     * @brief Dodaje znacznik czasu kolejnej ramki.
+     * @param timestampNs [in] Czas odbioru ramki [ns].
+     */
+    void observe(qint64 timestampNs);
+
+    /**
+     * @brief Zaznacza przerwę w danych (utracone ramki) - kolejny odstęp nie jest liczony.
+     */
+    void markDiscontinuity() { m_lastTimestampNs = 0; }
+
+    /** @brief Zwraca liczbę zmierzonych odstępów. */
+    quint64 intervalCount() const { return m_count; }
+
+    /** @brief Zwraca średni odstęp między ramkami [µs]. */
+    double meanIntervalUs() const { return m_meanNs / 1000.0; }
+
+    /** @brief Zwraca odchylenie standardowe odstępu (jitter) [µs]. */
+    double jitterUs() const;
+
+    /** @brief Zwraca najkrótszy odstęp [µs]. */
+    double minIntervalUs() const { return m_count > 0 ? m_minNs / 1000.0 : 0.0; }
+
+    /** @brief Zwraca najdłuższy odstęp [µs]. */
+    double maxIntervalUs() const { return m_maxNs / 1000.0; }
+
+    /**
+     * @brief Zwraca czytelne podsumowanie statystyk (jeden wiersz).
+     */
+    QString summaryText() const;
+
+    /** @brief Zeruje statystyki. */
+    void reset();
+
+private:
+    qint64 m_lastTimestampNs = 0; //!< Znacznik poprzedniej ramki; 0 - brak.
+    quint64 m_count = 0; //!< Liczba odstępów.
+    double m_meanNs = 0.0; //!< Średni odstęp [ns].
+    double m_m2 = 0.0; //!< Suma kwadratów odchyleń (Welford).
+    qint64 m_minNs = 0; //!< Najkrótszy odstęp [ns].
+    qint64 m_maxNs = 0; //!< Najdłuższy odstęp [ns].
+};
+
+#endif // FRAMETIMINGSTATS_H
@@ -0,0 +1,114 @@
+/**
+ * @file FrameWireFormat.cpp
+ * @brief Implementacja klasy FrameWireFormat.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-06
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include "FrameWireFormat.h"
+#include <QtEndian>
+#include <cstring>
+
+constexpr int MAGIC_BYTES_FWF = 4;
+constexpr int OVERFLOW_PAYLOAD_BYTES_FWF = 4;
+
+namespace {
+/**
+ * @brief Dopisuje liczbę w kolejności little-endian.
+ */
+template<typename T>
+void appendLittleEndian(QByteArray &out, T value) {
+    const T encoded = qToLittleEndian(value);
+    out.append(reinterpret_cast<const char *>(&encoded), sizeof(T));
+}
+
+/**
+ * @brief Dopisuje nagłówek rekordu.
+ */
+void appendHeader(QByteArray &out, quint16 recordBytes, FrameWireFormat::RecordType type, quint8 valueCount,
+                  quint16 deviceId, quint16 lostFramesBefore, qint64 timestampNs) {
+    appendLittleEndian<quint16>(out, recordBytes);
+    out.append(static_cast<char>(type));
+    out.append(static_cast<char>(valueCount));
+    appendLittleEndian<quint16>(out, deviceId);
+    appendLittleEndian<quint16>(out, lostFramesBefore);
+    appendLittleEndian<qint64>(out, timestampNs);
+}
+} // namespace
+
+QByteArray FrameWireFormat::greeting() {
+    QByteArray out(MAGIC, MAGIC_BYTES_FWF);
+    appendLittleEndian<quint16>(out, VERSION);
+    appendLittleEndian<quint16>(out, RECORD_HEADER_BYTES);
+    return out;
+}
+
+bool FrameWireFormat::checkGreeting(const QByteArray &data) {
+    if (data.size() < GREETING_BYTES || std::memcmp(data.constData(), MAGIC, MAGIC_BYTES_FWF) != 0) {
+        return false;
+    }
+    const auto version = qFromLittleEndian<quint16>(data.constData() + MAGIC_BYTES_FWF);
+    const auto headerBytes = qFromLittleEndian<quint16>(data.constData() + MAGIC_BYTES_FWF + 2);
+    return version == VERSION && headerBytes == RECORD_HEADER_BYTES;
+}
+
+void FrameWireFormat::appendFrame(QByteArray &out, const SensorFrame &frame) {
+    const auto valueCount = static_cast<quint8>(qMin<qsizetype>(frame.values.size(), MAX_VALUE_COUNT));
+    const auto recordBytes = static_cast<quint16>(RECORD_HEADER_BYTES + valueCount * sizeof(float));
+    appendHeader(out, recordBytes, RecordType::Frame, valueCount, static_cast<quint16>(frame.deviceId),
+                 static_cast<quint16>(qBound(0, frame.lostFramesBefore, 0xFFFF)), frame.hostTimestampNs);
+    for (int i = 0; i < valueCount; ++i) {
+        quint32 bits;
+        std::memcpy(&bits, &frame.values[i], sizeof(bits)); // IEEE 754 przesyłane bitowo
+        appendLittleEndian<quint32>(out, bits);
+    }
+}
+
+void FrameWireFormat::appendOverflow(QByteArray &out, quint32 droppedFrames, qint64 timestampNs) {
+    appendHeader(out, RECORD_HEADER_BYTES + OVERFLOW_PAYLOAD_BYTES_FWF, RecordType::Overflow, 0, 0, 0, timestampNs);
+    appendLittleEndian<quint32>(out, droppedFrames);
+}
+
+FrameWireFormat::DecodeStatus FrameWireFormat::decodeRecord(const char *data, qsizetype size, RecordType &type,
+                                                            SensorFrame &frame, quint32 &droppedFrames,
+                                                            qsizetype &recordBytes) {
+    if (size < RECORD_HEADER_BYTES) {
+        return DecodeStatus::Incomplete;
+    }
+    recordBytes = qFromLittleEndian<quint16>(data);
+    const auto rawType = static_cast<quint8>(data[2]);
+    const auto valueCount = static_cast<quint8>(data[3]);
+    if (rawType == static_cast<quint8>(RecordType::Frame)) {
+        if (recordBytes != RECORD_HEADER_BYTES + valueCount * static_cast<qsizetype>(sizeof(float))) {
+            return DecodeStatus::Invalid;
+        }
+    } else if (rawType == static_cast<quint8>(RecordType::Overflow)) {
+        if (recordBytes != RECORD_HEADER_BYTES + OVERFLOW_PAYLOAD_BYTES_FWF) {
+            return DecodeStatus::Invalid;
+        }
+    } else {
+        return DecodeStatus::Invalid;
+    }
+    if (size < recordBytes) {
+        return DecodeStatus::Incomplete;
+    }
+
+    type = static_cast<RecordType>(rawType);
+    frame.deviceId = qFromLittleEndian<quint16>(data + 4);
+    frame.lostFramesBefore = qFromLittleEndian<quint16>(data + 6);
+    frame.hostTimestampNs = qFromLittleEndian<qint64>(data + 8);
+    const char *payload = data + RECORD_HEADER_BYTES;
+    if (type == RecordType::Overflow) {
+        droppedFrames = qFromLittleEndian<quint32>(payload);
+        frame.values.clear();
+        return DecodeStatus::Ok;
+    }
+    frame.values.resize(valueCount);
+    for (int i = 0; i < valueCount; ++i) {
+        const quint32 bits = qFromLittleEndian<quint32>(payload + i * sizeof(float));
+        std::memcpy(&frame.values[i], &bits, sizeof(bits));
+    }
+    return DecodeStatus::Ok;
+}
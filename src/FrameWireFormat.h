@@ -0,0 +1,108 @@
+#ifndef FRAMEWIREFORMAT_H
+#define FRAMEWIREFORMAT_H
+
+/**
+ * @file FrameWireFormat.h
+ * @brief Definicja klasy FrameWireFormat - zwarty format binarny ramek publikowanych innym procesom.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-06
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include <QByteArray>
+#include <QtGlobal>
+#include "SensorFrame.h"
+
+/**
+ * @class FrameWireFormat
+ * @brief Kodowanie i dekodowanie strumienia ramek `FramePublisher` (gniazdo lokalne).
+ *
+ * @details
+ * Po połączeniu serwer wysyła powitanie (`GREETING_BYTES`): `ORFR`, wersja (u16), rozmiar nagłówka
+ * rekordu (u16). Dalej następują rekordy; wszystkie liczby są little-endian:
+ *
+ * | Pole              | Typ        | Opis                                                        |
+ * |-------------------|------------|-------------------------------------------------------------|
+ * | recordBytes       | u16        | Rozmiar całego rekordu (z nagłówkiem)                        |
+ * | type              | u8         | `RecordType`                                                |
+ * | valueCount        | u8         | Liczba wartości `float` (0 dla `Overflow`)                   |
+ * | deviceId          | u16        | `SensorFrame::deviceId`                                     |
+ * | lostFramesBefore  | u16        | Luka w numeracji przed ramką (nasycane do 65535)             |
+ * | hostTimestampNs   | i64        | Monotoniczny czas odbioru przez hosta                        |
+ * | values / dropped  | f32[n]/u32 | Wartości ramki albo liczba ramek pominiętych dla klienta     |
+ *
+ * Ramka 14-wartościowa zajmuje 72 bajty (wobec ~110 bajtów linii `CSV*CRC16`) i nie wymaga
+ * parsowania tekstu po stronie odbiorcy.
+ */
+class FrameWireFormat {
+public:
+    static constexpr char MAGIC[] = "ORFR"; //!< Początek powitania (bez kończącego zera).
+    static constexpr quint16 VERSION = 1; //!< Wersja formatu.
+    static constexpr int GREETING_BYTES = 8; //!< Rozmiar powitania.
+    static constexpr int RECORD_HEADER_BYTES = 16; //!< Rozmiar nagłówka rekordu.
+    static constexpr int MAX_VALUE_COUNT = 255; //!< Największa liczba wartości w rekordzie.
+
+    /**
+     * @enum RecordType
+     * @brief Rodzaj rekordu.
+     */
+    enum class RecordType : quint8 {
+        Frame = 1, //!< Ramka telemetryczna.
+        Overflow = 2 //!< Serwer pominął ramki, bo klient nie nadążał z odbiorem.
+    };
+
+    /**
+     * @brief Wynik dekodowania rekordu.
+     */
+    enum class DecodeStatus {
+        Ok, //!< Rekord zdekodowany.
+        Incomplete, //!< Za mało danych - należy poczekać na kolejne bajty.
+        Invalid //!< Dane nie są poprawnym rekordem (utrata synchronizacji).
+    };
+
+    /**
+     * @brief Zwraca powitanie wysyłane nowemu klientowi.
+     */
+    static QByteArray greeting();
+
+    /**
+     * @brief Sprawdza powitanie serwera.
+     * @param data [in] Pierwsze bajty strumienia (co najmniej `GREETING_BYTES`).
+     * @return `true`, jeśli format i wersja są obsługiwane.
+     */
+    static bool checkGreeting(const QByteArray &data);
+
+    /**
+     * @brief Dopisuje rekord ramki.
+     * @param out [in,out] Bufor wyjściowy.
+     * @param frame [in] Ramka (nadmiarowe wartości ponad `MAX_VALUE_COUNT` są pomijane).
+     */
+    static void appendFrame(QByteArray &out, const SensorFrame &frame);
+
+    /**
+     * @brief Dopisuje rekord informujący o ramkach pominiętych dla klienta.
+     * @param out [in,out] Bufor wyjściowy.
+     * @param droppedFrames [in] Liczba pominiętych ramek.
+     * @param timestampNs [in] Czas zdarzenia (`LatencyTracer::nowNs()`).
+     */
+    static void appendOverflow(QByteArray &out, quint32 droppedFrames, qint64 timestampNs);
+
+    /**
+     * @brief Dekoduje rekord z początku bufora.
+     * @param data [in] Wskaźnik na dane.
+     * @param size [in] Liczba dostępnych bajtów.
+     * @param type [out] Rodzaj rekordu.
+     * @param frame [out] Ramka (dla `RecordType::Frame`; czas także dla `Overflow`).
+     * @param droppedFrames [out] Liczba pominiętych ramek (dla `RecordType::Overflow`).
+     * @param recordBytes [out] Rozmiar zdekodowanego rekordu.
+     * @return Status dekodowania.
+     */
+    static DecodeStatus decodeRecord(const char *data, qsizetype size, RecordType &type, SensorFrame &frame,
+                                     quint32 &droppedFrames, qsizetype &recordBytes);
+
+private:
+    FrameWireFormat() = delete;
+};
+
+#endif // FRAMEWIREFORMAT_H
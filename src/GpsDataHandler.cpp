@@ -8,23 +8,162 @@
  */
 
 #include "GpsDataHandler.h"
+#include "GpsMapBridge.h"
+#include "NativeMapWidget.h"
+#include "ProcessStats.h"
 #include <QVBoxLayout>
+#include <QFile>
+#include <QSettings>
+#include <QEvent>
+#include <QTimer>
+#include <optional>
+#include <QDebug>
+#ifdef ORIENTA_WEBENGINE_MAP
+#include "MapTileSchemeHandler.h"
 #include <QWebEngineView>
-#include <QWebEnginePage> // Potrzebne dla page()->runJavaScript()
+#include <QWebEnginePage>
+#include <QWebEngineProfile>
+#include <QWebChannel>
+#endif
+
+const QString BACKEND_SETTINGS_KEY_GDH = "map/backend";
+const QString BACKEND_NAME_WEBENGINE_GDH = "webengine";
+const QString BACKEND_NAME_NATIVE_GDH = "native";
+
+// Zaplecze wymuszone na czas działania programu (np. opcją --map-backend)
+static std::optional<GPSDataHandler::MapBackend> backendOverride;
+
+#ifdef ORIENTA_WEBENGINE_MAP
+// Skrypt klienta QWebChannel dostarczany w zasobach modułu Qt WebChannel
+const QString WEB_CHANNEL_SCRIPT_RESOURCE_GDH = ":/qtwebchannel/qwebchannel.js";
+
+// Leaflet osadzony w zasobach aplikacji (serwowany przez MapTileSchemeHandler) lub z CDN jako rezerwa
+const QString LEAFLET_LOCAL_BASE_GDH = "orienta://lib/";
+const QString LEAFLET_CDN_BASE_GDH = "https://unpkg.com/leaflet@1.9.3/dist/";
+// Adres bazowy strony - ten sam schemat co kafelki i biblioteka
+const QUrl MAP_PAGE_BASE_URL_GDH = QUrl("orienta://app/");
+
+/**
+ * @brief Wczytuje treść skryptu qwebchannel.js z zasobów Qt.
+ * @details Skrypt jest osadzany bezpośrednio w HTML, dzięki czemu strona ładowana przez `setHtml()`
+ * nie musi odwoływać się do schematu `qrc:` z pustego źródła.
+ * @return Treść skryptu lub pusty QString, jeśli zasób jest niedostępny.
+ */
+static QString loadWebChannelScript() {
+    QFile scriptFile(WEB_CHANNEL_SCRIPT_RESOURCE_GDH);
+    if (!scriptFile.open(QIODevice::ReadOnly)) {
+        qWarning() << "Failed to load QWebChannel client script from" << WEB_CHANNEL_SCRIPT_RESOURCE_GDH;
+        return QString();
+    }
+    return QString::fromUtf8(scriptFile.readAll());
+}
+#endif
+
+/***************************************************************************/
+/**
+ * @details Implementacja konstruktora. Mierzy stan pamięci przed utworzeniem mapy,
+ * konfiguruje layout i tworzy widok wybranego zaplecza. Zaplecze `WebEngine` tworzy
+ * QWebEngineView, ustawia jego politykę rozmiaru, rejestruje obiekt `GpsMapBridge` w `QWebChannel` strony,
+ * a następnie osadza i ładuje kod HTML/JavaScript zawierający mapę Leaflet.
+ * Konfiguruje również QVBoxLayout do zarządzania widokiem mapy w widgecie.
+ * Kod JavaScript podłącza się do sygnałów mostu i po inicjalizacji wywołuje
+ * `bridge.pageReady()`.
+ */
+GPSDataHandler::GPSDataHandler(QWidget *parent, MapBackend backend)
+    : QWidget(parent),
+      m_backend(isBackendAvailable(backend) ? backend : MapBackend::Native),
+      mapView(nullptr),
+      mapBridge(nullptr),
+      nativeMap(nullptr),
+      m_rssBeforeBytes(ProcessStats::residentSetSizeBytes()),
+      m_childRssBeforeBytes(ProcessStats::childrenResidentSetSizeBytes()),
+      m_startupReported(false) {
+    m_startupTimer.start();
+
+    // Konfiguracja layoutu dla widgetu GPSDataHandler
+    auto *layout = new QVBoxLayout(this);
+    layout->setContentsMargins(0, 0, 0, 0); // Usunięcie marginesów layoutu
+    setLayout(layout); // Ustawienie layoutu dla widgetu
+
+#ifdef ORIENTA_WEBENGINE_MAP
+    if (m_backend == MapBackend::WebEngine) {
+        setupWebEngineBackend();
+        return;
+    }
+#endif
+    setupNativeBackend();
+}
+
+GPSDataHandler::MapBackend GPSDataHandler::defaultBackend() {
+    if (backendOverride) {
+        return *backendOverride;
+    }
+    const QString name = QSettings().value(BACKEND_SETTINGS_KEY_GDH, BACKEND_NAME_WEBENGINE_GDH).toString();
+    return backendFromName(name);
+}
+
+bool GPSDataHandler::isBackendAvailable(MapBackend backend) {
+#ifdef ORIENTA_WEBENGINE_MAP
+    Q_UNUSED(backend);
+    return true;
+#else
+    return backend == MapBackend::Native;
+#endif
+}
+
+void GPSDataHandler::setBackendOverride(MapBackend backend) {
+    backendOverride = backend;
+}
+
+void GPSDataHandler::storeDefaultBackend(MapBackend backend) {
+    backendOverride.reset();
+    QSettings().setValue(BACKEND_SETTINGS_KEY_GDH, backendName(backend));
+}
+
+GPSDataHandler::MapBackend GPSDataHandler::backendFromName(const QString &name, bool *ok) {
+    const QString normalized = name.trimmed().toLower();
+    const MapBackend backend = normalized == BACKEND_NAME_NATIVE_GDH ? MapBackend::Native : MapBackend::WebEngine;
+    if (ok) {
+        *ok = (normalized == BACKEND_NAME_WEBENGINE_GDH || normalized == BACKEND_NAME_NATIVE_GDH) &&
+              isBackendAvailable(backend);
+    }
+    return isBackendAvailable(backend) ? backend : MapBackend::Native;
+}
+
+QString GPSDataHandler::backendName(MapBackend backend) {
+    return backend == MapBackend::Native ? BACKEND_NAME_NATIVE_GDH : BACKEND_NAME_WEBENGINE_GDH;
+}
 
 /***************************************************************************/
 /**
- * @details Implementacja konstruktora. Tworzy QWebEngineView, ustawia jego
- * politykę rozmiaru, a następnie osadza i ładuje kod HTML/JavaScript
- * zawierający mapę Leaflet. Konfiguruje również QVBoxLayout do zarządzania
- * widokiem mapy w widgecie. Kod JavaScript definiuje funkcję `updateMarker`,
- * która jest udostępniana globalnie (`window.updateMarker`) do komunikacji z C++.
+ * @details Natywna mapa nie ma etapu ładowania strony - za moment gotowości uznawane jest
+ * pierwsze odrysowanie widgetu, wykrywane przez filtr zdarzeń.
  */
-GPSDataHandler::GPSDataHandler(QWidget *parent)
-    : QWidget(parent) {
+void GPSDataHandler::setupNativeBackend() {
+    nativeMap = new NativeMapWidget(this);
+    nativeMap->installEventFilter(this);
+    layout()->addWidget(nativeMap);
+}
+
+#ifdef ORIENTA_WEBENGINE_MAP
+/***************************************************************************/
+/**
+ * @details Moment gotowości to zakończenie ładowania strony (`loadFinished`).
+ */
+void GPSDataHandler::setupWebEngineBackend() {
+    mapBridge = new GpsMapBridge(this);
+
+    // Kafelki i Leaflet serwowane lokalnie przez schemat orienta:
+    MapTileSchemeHandler::installOn(QWebEngineProfile::defaultProfile());
+
     mapView = new QWebEngineView(this);
     mapView->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
 
+    // Kanał komunikacyjny C++ <-> JavaScript
+    auto *channel = new QWebChannel(mapView->page());
+    channel->registerObject(QStringLiteral("bridge"), mapBridge);
+    mapView->page()->setWebChannel(channel);
+
     // Kod HTML i JavaScript dla mapy Leaflet osadzony jako C++ Raw String Literal
     QString mapHtml = R"(
         <!DOCTYPE html>
@@ -32,8 +171,9 @@ GPSDataHandler::GPSDataHandler(QWidget *parent)
         <head>
             <title>OpenStreetMap</title>
             <meta name="viewport" content="width=device-width, initial-scale=1.0">
-            <link rel="stylesheet" href="https://unpkg.com/leaflet@1.9.3/dist/leaflet.css" />
-            <script src="https://unpkg.com/leaflet@1.9.3/dist/leaflet.js"></script>
+            <link rel="stylesheet" href="%2leaflet.css" />
+            <script src="%2leaflet.js"></script>
+            <script>%1</script>
             <style>
                 html, body, #map {
                     height: 100%;
@@ -51,48 +191,161 @@ GPSDataHandler::GPSDataHandler(QWidget *parent)
                 // Inicjalizacja mapy Leaflet, początkowy widok ustawiony na [0, 0]
                 var map = L.map('map').setView([0, 0], 15); // Początkowy zoom ustawiony na 15
 
-                // Dodanie warstwy kafelków OpenStreetMap
-                L.tileLayer('https://{s}.tile.openstreetmap.org/{z}/{x}/{y}.png', {
+                // Dodanie warstwy kafelków OpenStreetMap (lokalny cache przez schemat orienta:)
+                L.tileLayer('orienta://tiles/{z}/{x}/{y}.png', {
                     maxZoom: 19,
                     attribution: '© OpenStreetMap contributors'
                 }).addTo(map);
 
                 // Utworzenie markera na początkowej pozycji [0, 0]
                 var marker = L.marker([0, 0]).addTo(map);
+                // Uproszczona trasa (wierzchołki zatwierdzone w C++) i odcinek do bieżącej pozycji
+                var MAX_TRACK_VERTICES = %3;
+                var TRACK_TRIM_FRACTION = 0.9;
+                var trackVertices = [];
+                var track = L.polyline([], { color: 'blue', weight: 3 }).addTo(map);
+                var trackTail = L.polyline([], { color: 'blue', weight: 3, dashArray: '4 4' }).addTo(map);
+                var hasFix = false;
+
+                function updateTail(position) {
+                    if (trackVertices.length > 0) {
+                        trackTail.setLatLngs([trackVertices[trackVertices.length - 1], position]);
+                    }
+                }
 
                 function updateMarker(lat, lon) {
-                    console.log("📍 updateMarker:", lat, lon); // Logowanie do konsoli przeglądarki
-                    marker.setLatLng([lat, lon]);          // Ustawienie nowej pozycji markera
-                    map.setView([lat, lon], map.getZoom()); // Ustawienie widoku mapy na nową pozycję (z zachowaniem zooma)
+                    var position = L.latLng(lat, lon);
+                    marker.setLatLng(position);
+                    updateTail(position);
+                    if (!hasFix) {
+                        map.setView(position, map.getZoom());
+                        hasFix = true;
+                    } else if (!map.getBounds().pad(-0.2).contains(position)) {
+                        // Przesuwaj mapę tylko, gdy marker zbliża się do krawędzi widoku
+                        map.panTo(position, { animate: false });
+                    }
+                }
+
+                function appendTrackPoints(points) {
+                    if (trackVertices.length + points.length > MAX_TRACK_VERTICES) {
+                        // Ogranicz pamięć strony - usuń najstarsze wierzchołki z zapasem (TRACK_TRIM_FRACTION),
+                        // aby pełna przebudowa linii nie powtarzała się przy każdej paczce
+                        for (var j = 0; j < points.length; ++j) {
+                            trackVertices.push(L.latLng(points[j][0], points[j][1]));
+                        }
+                        var keep = Math.floor(MAX_TRACK_VERTICES * TRACK_TRIM_FRACTION);
+                        trackVertices.splice(0, Math.max(0, trackVertices.length - keep));
+                        track.setLatLngs(trackVertices);
+                    } else {
+                        // Zwykła ścieżka: tylko nowe wierzchołki, bez przekazywania całej trasy
+                        for (var i = 0; i < points.length; ++i) {
+                            var vertex = L.latLng(points[i][0], points[i][1]);
+                            trackVertices.push(vertex);
+                            track.addLatLng(vertex);
+                        }
+                    }
+                    updateTail(marker.getLatLng());
                 }
 
-                // Udostępnienie funkcji updateMarker globalnie w oknie przeglądarki
-                window.updateMarker = updateMarker;
+                function clearTrack() {
+                    trackVertices = [];
+                    track.setLatLngs([]);
+                    trackTail.setLatLngs([]);
+                    hasFix = false;
+                }
+
+                new QWebChannel(qt.webChannelTransport, function (channel) {
+                    var bridge = channel.objects.bridge;
+                    bridge.positionChanged.connect(updateMarker);
+                    bridge.trackPointsAppended.connect(appendTrackPoints);
+                    bridge.trackCleared.connect(clearTrack);
+                    bridge.pageReady();
+                });
             </script>
         </body>
         </html>
     )";
 
-    // Ustawienie zawartości HTML w QWebEngineView
-    mapView->setHtml(mapHtml);
+    const QString leafletBase = MapTileSchemeHandler::hasEmbeddedLeaflet() ? LEAFLET_LOCAL_BASE_GDH
+                                                                            : LEAFLET_CDN_BASE_GDH;
+    if (leafletBase == LEAFLET_CDN_BASE_GDH) {
+        qWarning() << "Leaflet is not embedded in application resources; loading it from" << LEAFLET_CDN_BASE_GDH;
+    }
 
-    // Konfiguracja layoutu dla widgetu GPSDataHandler
-    auto *layout = new QVBoxLayout(this);
-    layout->addWidget(mapView); // Dodanie widoku mapy do layoutu
-    layout->setContentsMargins(0, 0, 0, 0); // Usunięcie marginesów layoutu
-    setLayout(layout); // Ustawienie layoutu dla widgetu
+    // Ustawienie zawartości HTML w QWebEngineView (z osadzonym klientem QWebChannel)
+    mapView->setHtml(mapHtml.arg(loadWebChannelScript(), leafletBase,
+                                 QString::number(GpsMapBridge::MAX_TRACK_VERTICES)),
+                     MAP_PAGE_BASE_URL_GDH);
+
+    connect(mapView, &QWebEngineView::loadFinished, this, [this](bool ok) {
+        if (!ok) {
+            qWarning() << "GPS map page failed to load.";
+        }
+        reportStartup();
+    });
+
+    layout()->addWidget(mapView); // Dodanie widoku mapy do layoutu
+}
+#endif
+
+bool GPSDataHandler::eventFilter(QObject *watched, QEvent *event) {
+    if (watched == nativeMap && event->type() == QEvent::Paint && !m_startupReported) {
+        // Raport po zakończeniu bieżącego odrysowania
+        QTimer::singleShot(0, this, &GPSDataHandler::reportStartup);
+    }
+    return QWidget::eventFilter(watched, event);
+}
+
+void GPSDataHandler::reportStartup() {
+    if (m_startupReported) {
+        return;
+    }
+    m_startupReported = true;
+    const qint64 startupMs = m_startupTimer.elapsed();
+    const double rssDeltaMb = (ProcessStats::residentSetSizeBytes() - m_rssBeforeBytes) / (1024.0 * 1024.0);
+    const double childRssDeltaMb = (ProcessStats::childrenResidentSetSizeBytes() - m_childRssBeforeBytes)
+                                   / (1024.0 * 1024.0);
+    const QString report = tr("Map backend: %1, ready in %2 ms, RSS +%3 MB, child processes +%4 MB")
+            .arg(backendName(m_backend))
+            .arg(startupMs)
+            .arg(rssDeltaMb, 0, 'f', 1)
+            .arg(childRssDeltaMb, 0, 'f', 1);
+    qInfo().noquote() << report;
+    emit mapReady(report);
 }
 
 /***************************************************************************/
 /**
- * @details Implementacja wykorzystuje metodę `page()->runJavaScript()` obiektu
- * QWebEngineView do asynchronicznego wykonania kodu JavaScript w kontekście
- * załadowanej strony HTML. Formatowany string z wywołaniem funkcji `updateMarker`
- * jest przekazywany jako argument.
+ * @details Pozycja trafia do bufora `GpsMapBridge`, który wysyła do strony tylko
+ * najnowszy stan (i zebrane punkty trasy) z ograniczoną częstotliwością. W zapleczu
+ * natywnym pozycja trafia bezpośrednio do `NativeMapWidget`, który sam ogranicza odświeżanie.
  */
 void GPSDataHandler::updateMarker(float latitude, float longitude) {
-    // Przygotowanie kodu JavaScript do wykonania
-    QString jsCode = QString("updateMarker(%1, %2);").arg(latitude).arg(longitude);
-    // Wykonanie kodu JavaScript na stronie załadowanej w mapView
-    mapView->page()->runJavaScript(jsCode);
+    if (nativeMap) {
+        nativeMap->setMarkerPosition(static_cast<double>(latitude), static_cast<double>(longitude));
+    } else {
+        mapBridge->setPosition(static_cast<double>(latitude), static_cast<double>(longitude));
+    }
+}
+
+void GPSDataHandler::setMapUpdateInterval(int intervalMs) {
+    if (mapBridge) {
+        mapBridge->setUpdateInterval(intervalMs); // Mapa natywna ma własny limit odświeżania
+    }
+}
+
+void GPSDataHandler::setTrackTolerance(double toleranceMeters) {
+    if (nativeMap) {
+        nativeMap->setTrackTolerance(toleranceMeters);
+    } else {
+        mapBridge->setTrackTolerance(toleranceMeters);
+    }
+}
+
+void GPSDataHandler::clearTrack() {
+    if (nativeMap) {
+        nativeMap->clearTrack();
+    } else {
+        mapBridge->clearTrack();
+    }
 }
@@ -14,7 +14,11 @@
  */
 
 #include <QWidget>
-#include <QWebEngineView>
+#include <QElapsedTimer>
+
+class GpsMapBridge;
+class NativeMapWidget;
+class QWebEngineView;
 
 /**
  * @class GPSDataHandler
@@ -24,22 +28,28 @@
  * Klasa `GPSDataHandler` dziedziczy po `QWidget` i integruje `QWebEngineView`
  * w celu renderowania mapy opartej na OpenStreetMap z wykorzystaniem biblioteki Leaflet.
  * Umożliwia dynamiczną aktualizację pozycji markera na mapie, odzwierciedlając
- * bieżące współrzędne GPS. Logika mapy (HTML, CSS, JavaScript) jest osadzona
- * bezpośrednio w kodzie C++.
+ * bieżące współrzędne GPS, oraz rysuje przyrostowo upraszczaną trasę. Logika mapy
+ * (HTML, CSS, JavaScript) jest osadzona bezpośrednio w kodzie C++.
+ *
+ * Na urządzeniach z małą ilością pamięci można zamiast QWebEngine użyć natywnego
+ * zaplecza `NativeMapWidget` (zob. `MapBackend`), wybieranego w QSettings (`map/backend`),
+ * opcją `--map-backend` lub z menu Ustawienia. Przy budowie z `-DORIENTA_WEBENGINE_MAP=OFF` dostępne
+ * jest tylko zaplecze natywne, a aplikacja nie linkuje QtWebEngine.
  *
  * @author Twoje Imię/Nazwa Zespołu (jeśli jesteś głównym autorem klasy)
  * @date 2024-05-17 - Utworzenie klasy.
  * @date 2024-05-18 - Dodano obsługę dynamicznej aktualizacji markera.
  *
  * @note
- * Do poprawnego działania wymagane jest połączenie z internetem w celu załadowania
- * kafelków mapy OpenStreetMap oraz biblioteki Leaflet.
+ * Kafelki mapy oraz biblioteka Leaflet są serwowane lokalnie przez `MapTileSchemeHandler`
+ * (schemat `orienta:`), więc mapa działa bez dostępu do sieci w obszarze pokrytym przez cache.
  *
  * @warning
- * W przypadku braku dostępu do zasobów Leaflet (np. z powodu problemów z siecią lub
- * zmian w API unpkg), funkcjonalność mapy może być ograniczona lub niedostępna.
+ * Jeśli Leaflet nie został osadzony w zasobach podczas budowania, jest ładowany z unpkg.com
+ * i wtedy wymaga połączenia z internetem.
  *
  * @see SensorGraph (jeśli istnieje powiązana klasa do wyświetlania innych danych)
+ * @see MapTileSchemeHandler
  * @see https://leafletjs.com/ (Oficjalna dokumentacja biblioteki Leaflet)
  *
  * @example GpsDataHandler_Usage.cpp
@@ -48,34 +58,139 @@ class GPSDataHandler : public QWidget {
     Q_OBJECT
 
 public:
+    /**
+     * @enum MapBackend
+     * @brief Sposób renderowania mapy.
+     */
+    enum class MapBackend {
+        WebEngine, //!< Leaflet w `QWebEngineView` (pełna funkcjonalność, osobne procesy Chromium).
+        Native //!< `NativeMapWidget` rysowany przez QPainter (mały narzut pamięci i czasu startu).
+    };
+
     /**
      * @brief Konstruktor klasy GPSDataHandler.
      *
      * @details
-     * Inicjalizuje nowy widget `GPSDataHandler`. Tworzy wewnętrzny obiekt
-     * `QWebEngineView`, ładuje do niego stronę HTML z mapą Leaflet i konfiguruje
-     * niezbędne layouty. Mapa jest gotowa do interakcji po zakończeniu
-     * konstruktora.
+     * Inicjalizuje nowy widget `GPSDataHandler` z wybranym zapleczem mapy. Dla `WebEngine`
+     * tworzy `QWebEngineView` i ładuje do niego stronę HTML z mapą Leaflet, dla `Native`
+     * tworzy `NativeMapWidget`. Po wyświetleniu mapy emitowany jest sygnał `mapReady()`
+     * z czasem uruchomienia i przyrostem zużycia pamięci.
      * @param parent [in] Wskaźnik na widget nadrzędny. Domyślnie `nullptr`.
+     * @param backend [in] Zaplecze mapy. Domyślnie wartość z `defaultBackend()`; niedostępne
+     * zaplecze jest zastępowane przez `MapBackend::Native`.
+     */
+    explicit GPSDataHandler(QWidget *parent = nullptr, MapBackend backend = defaultBackend());
+
+    /**
+     * @brief Zwraca domyślne zaplecze mapy.
+     * @details Kolejność: wartość ustawiona przez `setBackendOverride()` (np. z wiersza poleceń),
+     * następnie klucz `map/backend` w QSettings, w przeciwnym razie `MapBackend::WebEngine`.
+     * Zaplecze niedostępne w tej kompilacji jest zastępowane przez `MapBackend::Native`.
+     * @return Domyślne zaplecze mapy.
+     */
+    static MapBackend defaultBackend();
+
+    /**
+     * @brief Sprawdza, czy zaplecze mapy zostało wkompilowane w aplikację.
+     * @param backend [in] Zaplecze mapy.
+     * @return `false` dla `MapBackend::WebEngine` w kompilacji bez `ORIENTA_WEBENGINE_MAP`.
+     */
+    static bool isBackendAvailable(MapBackend backend);
+
+    /**
+     * @brief Ustawia zaplecze mapy obowiązujące do końca działania programu (bez zapisu w QSettings).
+     * @param backend [in] Wybrane zaplecze mapy.
+     */
+    static void setBackendOverride(MapBackend backend);
+
+    /**
+     * @brief Zapisuje wybrane zaplecze mapy w QSettings i usuwa ewentualne nadpisanie.
+     * @param backend [in] Wybrane zaplecze mapy.
+     */
+    static void storeDefaultBackend(MapBackend backend);
+
+    /**
+     * @brief Zamienia nazwę zaplecza (`webengine` lub `native`) na wartość wyliczeniową.
+     * @param name [in] Nazwa zaplecza (wielkość liter nie ma znaczenia).
+     * @param ok [out] Opcjonalnie ustawiane na `true`, jeśli nazwa jest poprawna, a zaplecze dostępne.
+     * @return Zaplecze mapy; dla niepoprawnej nazwy `MapBackend::WebEngine` (lub `MapBackend::Native`,
+     * gdy WebEngine nie jest wkompilowany).
      */
-    explicit GPSDataHandler(QWidget *parent = nullptr);
+    static MapBackend backendFromName(const QString &name, bool *ok = nullptr);
+
+    /**
+     * @brief Zwraca nazwę zaplecza mapy używaną w QSettings i wierszu poleceń.
+     * @param backend [in] Zaplecze mapy.
+     * @return `webengine` lub `native`.
+     */
+    static QString backendName(MapBackend backend);
+
+    /**
+     * @brief Zwraca zaplecze mapy używane przez ten widget.
+     */
+    MapBackend backend() const { return m_backend; }
 
     /**
      * @brief Aktualizuje pozycję markera na wyświetlanej mapie.
      *
      * @details
-     * Wywołuje funkcję JavaScript `updateMarker(lat, lon)` zdefiniowaną
-     * w osadzonym kodzie HTML. Przekazuje nowe współrzędne geograficzne,
-     * co powoduje przesunięcie markera oraz wycentrowanie mapy na nowej pozycji.
+     * Przekazuje nowe współrzędne do `GpsMapBridge`, który buforuje je i wysyła do strony
+     * przez `QWebChannel` z ograniczoną częstotliwością (domyślnie 10 Hz). Pozycje niezmienione
+     * są pomijane. Mapa przesuwa się tylko, gdy marker zbliża się do krawędzi widoku.
      * @param latitude [in] Nowa szerokość geograficzna (w stopniach dziesiętnych).
      * @param longitude [in] Nowa długość geograficzna (w stopniach dziesiętnych).
      *
-     * @note Ta operacja jest asynchroniczna; JavaScript jest wykonywany w osobnym wątku silnika web.
+     * @note Wywołanie jest tanie i może być wykonywane przy każdej ramce danych.
      */
     void updateMarker(float latitude, float longitude);
 
+    /**
+     * @brief Ustawia minimalny odstęp między aktualizacjami mapy.
+     * @param intervalMs [in] Odstęp w milisekundach.
+     */
+    void setMapUpdateInterval(int intervalMs);
+
+    /**
+     * @brief Ustawia tolerancję przyrostowego upraszczania trasy.
+     * @details Większa tolerancja oznacza mniej wierzchołków trasy na mapie.
+     * @param toleranceMeters [in] Maksymalne odchylenie uproszczonej trasy od rzeczywistej [m].
+     */
+    void setTrackTolerance(double toleranceMeters);
+
+    /**
+     * @brief Usuwa trasę wyświetlaną na mapie.
+     */
+    void clearTrack();
+
+signals:
+    /**
+     * @brief Emitowany jednokrotnie, gdy mapa zostanie wyświetlona.
+     * @param report [in] Opis zaplecza, czasu uruchomienia i przyrostu pamięci (RSS).
+     */
+    void mapReady(const QString &report);
+
+protected:
+    /** @brief Wykrywa pierwsze odrysowanie mapy natywnej. */
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
 private:
-    QWebEngineView *mapView; //!< Wskaźnik na obiekt QWebEngineView, który renderuje mapę.
+    /** @brief Tworzy widok Leaflet w `QWebEngineView` wraz z mostem `QWebChannel`. */
+    void setupWebEngineBackend();
+
+    /** @brief Tworzy natywny widok mapy `NativeMapWidget`. */
+    void setupNativeBackend();
+
+    /** @brief Mierzy czas uruchomienia i przyrost pamięci, a następnie emituje `mapReady()`. */
+    void reportStartup();
+
+    MapBackend m_backend; //!< Zaplecze mapy używane przez widget.
+    QWebEngineView *mapView; //!< Wskaźnik na obiekt QWebEngineView, który renderuje mapę (tylko WebEngine).
+    GpsMapBridge *mapBridge; //!< Most QWebChannel buforujący aktualizacje pozycji (tylko WebEngine).
+    NativeMapWidget *nativeMap; //!< Natywny widok mapy (tylko Native).
+    QElapsedTimer m_startupTimer; //!< Czas od rozpoczęcia konstrukcji do wyświetlenia mapy.
+    qint64 m_rssBeforeBytes; //!< RSS procesu przed utworzeniem mapy.
+    qint64 m_childRssBeforeBytes; //!< RSS procesów potomnych przed utworzeniem mapy.
+    bool m_startupReported; //!< Czy raport uruchomienia został już wysłany.
 };
 
 #endif // GPSDATAHANDLER_H
@@ -0,0 +1,104 @@
+/**
+ * @file GpsMapBridge.cpp
+ * @brief Implementacja klasy GpsMapBridge.
+ * @author Mateusz Wojtaszek
+ * @date 2025-05-24
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include "GpsMapBridge.h"
+#include <QTimer>
+#include <QtMath>
+
+// Domyślna maksymalna częstotliwość wysyłek do strony: 10 Hz
+constexpr int DEFAULT_UPDATE_INTERVAL_MS_GMB = 100;
+constexpr int MIN_UPDATE_INTERVAL_MS_GMB = 16;
+// Różnica współrzędnych uznawana za brak ruchu (~1 cm)
+constexpr double POSITION_EPSILON_DEG_GMB = 1e-7;
+// Górny limit wierzchołków buforowanych, zanim strona będzie gotowa
+constexpr int MAX_PENDING_TRACK_POINTS_GMB = 10000;
+
+GpsMapBridge::GpsMapBridge(QObject *parent)
+    : QObject(parent),
+      m_flushTimer(new QTimer(this)),
+      m_pageReady(false),
+      m_hasPendingPosition(false),
+      m_hasLastPosition(false),
+      m_lastLatitude(0.0),
+      m_lastLongitude(0.0) {
+    m_flushTimer->setSingleShot(true);
+    m_flushTimer->setInterval(DEFAULT_UPDATE_INTERVAL_MS_GMB);
+    connect(m_flushTimer, &QTimer::timeout, this, &GpsMapBridge::flush);
+}
+
+void GpsMapBridge::setPosition(double latitude, double longitude) {
+    if (m_hasLastPosition &&
+        qAbs(latitude - m_lastLatitude) < POSITION_EPSILON_DEG_GMB &&
+        qAbs(longitude - m_lastLongitude) < POSITION_EPSILON_DEG_GMB) {
+        return; // Pozycja niezmieniona - nic do wysłania
+    }
+
+    m_lastLatitude = latitude;
+    m_lastLongitude = longitude;
+    m_hasLastPosition = true;
+    m_hasPendingPosition = true;
+
+    m_trackSimplifier.addPoint(latitude, longitude);
+    const QVector<TrackSimplifier::Point> newVertices = m_trackSimplifier.takeCommitted();
+    for (const TrackSimplifier::Point &vertex: newVertices) {
+        m_pendingTrackPoints.append(QVariant(QVariantList{vertex.latitude, vertex.longitude}));
+    }
+    const qsizetype excess = m_pendingTrackPoints.size() - MAX_PENDING_TRACK_POINTS_GMB;
+    if (excess > 0) {
+        m_pendingTrackPoints.remove(0, excess); // Najstarsze punkty usuwane jednym przesunięciem
+    }
+
+    scheduleFlush();
+}
+
+void GpsMapBridge::setUpdateInterval(int intervalMs) {
+    m_flushTimer->setInterval(qMax(MIN_UPDATE_INTERVAL_MS_GMB, intervalMs));
+}
+
+int GpsMapBridge::updateInterval() const {
+    return m_flushTimer->interval();
+}
+
+void GpsMapBridge::setTrackTolerance(double toleranceMeters) {
+    m_trackSimplifier.setTolerance(toleranceMeters);
+}
+
+void GpsMapBridge::clearTrack() {
+    m_trackSimplifier.reset();
+    m_pendingTrackPoints.clear();
+    m_hasLastPosition = false;
+    if (m_pageReady) {
+        emit trackCleared();
+    }
+}
+
+void GpsMapBridge::pageReady() {
+    m_pageReady = true;
+    flush(); // Wyślij od razu to, co zebrało się podczas ładowania strony
+}
+
+void GpsMapBridge::scheduleFlush() {
+    if (m_pageReady && !m_flushTimer->isActive()) {
+        m_flushTimer->start();
+    }
+}
+
+void GpsMapBridge::flush() {
+    if (!m_pageReady) {
+        return;
+    }
+    if (!m_pendingTrackPoints.isEmpty()) {
+        emit trackPointsAppended(m_pendingTrackPoints);
+        m_pendingTrackPoints.clear();
+    }
+    if (m_hasPendingPosition) {
+        emit positionChanged(m_lastLatitude, m_lastLongitude);
+        m_hasPendingPosition = false;
+    }
+}
@@ -0,0 +1,127 @@
+#ifndef GPSMAPBRIDGE_H
+#define GPSMAPBRIDGE_H
+
+/**
+ * @file GpsMapBridge.h
+ * @brief Definicja klasy GpsMapBridge, pośredniczącej między C++ a stroną mapy przez QWebChannel.
+ * @author Mateusz Wojtaszek
+ * @date 2025-05-24
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include <QObject>
+#include <QVariantList>
+#include "TrackSimplifier.h"
+
+class QTimer;
+
+/**
+ * @class GpsMapBridge
+ * @brief Obiekt udostępniany stronie Leaflet przez `QWebChannel`, zbierający aktualizacje pozycji GPS.
+ *
+ * @details
+ * Zamiast wywoływać `runJavaScript` przy każdej ramce z portu szeregowego (co oznacza komunikację
+ * IPC z procesem renderera przy 100+ Hz), pozycje są buforowane po stronie C++ i wysyłane do strony
+ * paczkami, nie częściej niż co `updateInterval()` ms. Wysyłana jest tylko najnowsza pozycja markera
+ * oraz nowe wierzchołki trasy. Pozycje identyczne z poprzednią są pomijane.
+ *
+ * Trasa jest upraszczana przyrostowo przez `TrackSimplifier`, więc do strony trafiają wyłącznie
+ * zatwierdzone wierzchołki (delty), a odcinek od ostatniego wierzchołka do markera rysowany jest
+ * po stronie JavaScript. Strona przechowuje co najwyżej `MAX_TRACK_VERTICES` wierzchołków.
+ *
+ * Strona wywołuje slot `pageReady()` po podłączeniu się do kanału; wcześniejsze aktualizacje
+ * pozostają w buforze.
+ *
+ * @see GPSDataHandler
+ */
+class GpsMapBridge : public QObject {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Konstruktor klasy GpsMapBridge.
+     * @param parent [in] Wskaźnik na obiekt nadrzędny. Domyślnie `nullptr`.
+     */
+    explicit GpsMapBridge(QObject *parent = nullptr);
+
+    /**
+     * @brief Buforuje nową pozycję GPS do wysłania przy najbliższym opróżnieniu bufora.
+     * @details Pozycja niezmieniona względem poprzedniej jest ignorowana. Jeśli timer wysyłki
+     * nie jest aktywny, zostaje uruchomiony - dzięki temu przy braku danych nie ma żadnych wybudzeń.
+     * @param latitude [in] Szerokość geograficzna w stopniach dziesiętnych.
+     * @param longitude [in] Długość geograficzna w stopniach dziesiętnych.
+     */
+    void setPosition(double latitude, double longitude);
+
+    /**
+     * @brief Ustawia minimalny odstęp między kolejnymi wysyłkami do strony.
+     * @param intervalMs [in] Odstęp w milisekundach (minimum 16 ms).
+     */
+    void setUpdateInterval(int intervalMs);
+
+    /**
+     * @brief Zwraca minimalny odstęp między kolejnymi wysyłkami do strony.
+     * @return Odstęp w milisekundach.
+     */
+    int updateInterval() const;
+
+    /**
+     * @brief Ustawia tolerancję upraszczania trasy.
+     * @param toleranceMeters [in] Maksymalne odchylenie uproszczonej trasy od rzeczywistej [m].
+     */
+    void setTrackTolerance(double toleranceMeters);
+
+    /**
+     * @brief Usuwa dotychczasową trasę (po stronie C++ i na stronie).
+     */
+    void clearTrack();
+
+    /** @brief Maksymalna liczba wierzchołków trasy przechowywanych przez stronę. */
+    static constexpr int MAX_TRACK_VERTICES = 20000;
+
+public slots:
+    /**
+     * @brief Slot wywoływany z JavaScriptu, gdy strona jest gotowa do odbioru danych.
+     * @details Od tego momentu zbuforowane dane są wysyłane do strony.
+     */
+    void pageReady();
+
+signals:
+    /**
+     * @brief Emitowany z nową pozycją markera (odbierany po stronie JavaScript).
+     * @param latitude [out] Szerokość geograficzna.
+     * @param longitude [out] Długość geograficzna.
+     */
+    void positionChanged(double latitude, double longitude);
+
+    /**
+     * @brief Emitowany z paczką nowych punktów trasy (odbierany po stronie JavaScript).
+     * @param points [out] Lista par `[lat, lon]` w kolejności chronologicznej.
+     */
+    void trackPointsAppended(const QVariantList &points);
+
+    /**
+     * @brief Emitowany po wyczyszczeniu trasy (odbierany po stronie JavaScript).
+     */
+    void trackCleared();
+
+private slots:
+    /** @brief Wysyła zbuforowaną pozycję i punkty trasy do strony. */
+    void flush();
+
+private:
+    /** @brief Uruchamia jednorazowy timer wysyłki, jeśli strona jest gotowa i timer nie działa. */
+    void scheduleFlush();
+
+    QTimer *m_flushTimer; //!< Jednorazowy timer ograniczający częstotliwość wysyłek.
+    bool m_pageReady; //!< Czy strona podłączyła się do kanału.
+    bool m_hasPendingPosition; //!< Czy istnieje pozycja oczekująca na wysłanie.
+    bool m_hasLastPosition; //!< Czy odebrano już jakąkolwiek pozycję.
+    double m_lastLatitude; //!< Ostatnia przyjęta szerokość geograficzna.
+    double m_lastLongitude; //!< Ostatnia przyjęta długość geograficzna.
+    TrackSimplifier m_trackSimplifier; //!< Przyrostowe upraszczanie trasy.
+    QVariantList m_pendingTrackPoints; //!< Wierzchołki trasy zatwierdzone od ostatniej wysyłki.
+};
+
+#endif // GPSMAPBRIDGE_H
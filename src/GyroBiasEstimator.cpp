@@ -0,0 +1,99 @@
+/**
+ * @file GyroBiasEstimator.cpp
+ * @brief Implementacja klasy GyroBiasEstimator.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-13
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include "GyroBiasEstimator.h"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+constexpr double ONE_G_MG_GBE = 1000.0;
+
+void GyroBiasEstimator::addSample(const float *frame) {
+    float *slot = m_window[m_next];
+    for (int channel = 0; channel < CHANNELS; ++channel) {
+        const double value = frame[channel];
+        if (m_count == WINDOW_SIZE) {
+            const double dropped = slot[channel]; // Próbka wypadająca z okna
+            m_sum[channel] -= dropped;
+            m_sumSquares[channel] -= dropped * dropped;
+        }
+        m_sum[channel] += value;
+        m_sumSquares[channel] += value * value;
+        slot[channel] = frame[channel];
+    }
+    if (m_count < WINDOW_SIZE) {
+        ++m_count;
+    }
+    if (++m_next == WINDOW_SIZE) {
+        m_next = 0;
+        recomputeSums(); // Raz na obieg bufora - koszt zamortyzowany O(1)
+    }
+
+    m_stationary = false;
+    if (m_count < WINDOW_SIZE) {
+        m_stationaryFrames = 0;
+        return;
+    }
+    double mean[CHANNELS];
+    for (int channel = 0; channel < CHANNELS; ++channel) {
+        mean[channel] = m_sum[channel] / WINDOW_SIZE;
+        const double variance = m_sumSquares[channel] / WINDOW_SIZE - mean[channel] * mean[channel];
+        const double threshold = channel < 3 ? GYRO_VARIANCE_THRESHOLD : ACC_VARIANCE_THRESHOLD;
+        if (variance > threshold) {
+            m_stationaryFrames = 0;
+            return;
+        }
+    }
+    // Stałe przyspieszenie liniowe (np. jazda po łuku) daje małą wariancję, ale moduł różny od 1 g
+    const double accNorm = std::sqrt(mean[3] * mean[3] + mean[4] * mean[4] + mean[5] * mean[5]);
+    if (std::abs(accNorm - ONE_G_MG_GBE) > ACC_NORM_TOLERANCE_MG ||
+        mean[0] * mean[0] + mean[1] * mean[1] + mean[2] * mean[2] > double(MAX_BIAS_DPS) * MAX_BIAS_DPS) {
+        m_stationaryFrames = 0;
+        return; // Stały obrót lub przyspieszenie, nie dryf
+    }
+    m_stationary = true;
+    if (m_stationaryFrames < MIN_STATIONARY_FRAMES) {
+        ++m_stationaryFrames;
+        return; // Krótka pauza w ruchu - jeszcze bez aktualizacji
+    }
+    const float weight = m_hasEstimate ? BIAS_SMOOTHING : 1.0f;
+    for (int axis = 0; axis < 3; ++axis) {
+        m_bias[axis] += weight * (static_cast<float>(mean[axis]) - m_bias[axis]);
+    }
+    m_hasEstimate = true;
+}
+
+void GyroBiasEstimator::apply(float *gyro) const {
+    gyro[0] -= m_bias[0];
+    gyro[1] -= m_bias[1];
+    gyro[2] -= m_bias[2];
+}
+
+void GyroBiasEstimator::reset() {
+    std::fill(std::begin(m_sum), std::end(m_sum), 0.0);
+    std::fill(std::begin(m_sumSquares), std::end(m_sumSquares), 0.0);
+    std::fill(std::begin(m_bias), std::end(m_bias), 0.0f);
+    m_next = 0;
+    m_count = 0;
+    m_stationaryFrames = 0;
+    m_stationary = false;
+    m_hasEstimate = false;
+}
+
+void GyroBiasEstimator::recomputeSums() {
+    std::fill(std::begin(m_sum), std::end(m_sum), 0.0);
+    std::fill(std::begin(m_sumSquares), std::end(m_sumSquares), 0.0);
+    for (int i = 0; i < m_count; ++i) {
+        for (int channel = 0; channel < CHANNELS; ++channel) {
+            const double value = m_window[i][channel];
+            m_sum[channel] += value;
+            m_sumSquares[channel] += value * value;
+        }
+    }
+}
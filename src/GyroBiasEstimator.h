@@ -0,0 +1,83 @@
+#ifndef GYROBIASESTIMATOR_H
+#define GYROBIASESTIMATOR_H
+
+/**
+ * @file GyroBiasEstimator.h
+ * @brief Definicja klasy GyroBiasEstimator - wykrywanie spoczynku i estymacja dryfu żyroskopu na bieżąco.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-13
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include <QtGlobal>
+
+/**
+ * @class GyroBiasEstimator
+ * @brief Wykrywa okresy spoczynku czujnika i wyznacza w nich przesunięcie zera (bias) żyroskopu.
+ *
+ * @details
+ * Detektor liczy wariancję każdej osi żyroskopu i akcelerometru w przesuwnym oknie `WINDOW_SIZE`
+ * ostatnich ramek. Sumy i sumy kwadratów są aktualizowane przyrostowo (dodanie nowej próbki, odjęcie
+ * wypadającej z okna), więc koszt ramki jest stały; przy każdym obiegu bufora sumy są liczone od nowa,
+ * aby błędy zaokrągleń się nie kumulowały.
+ *
+ * Czujnik jest w spoczynku, gdy okno jest pełne, wariancje wszystkich osi są poniżej progów, moduł średniego
+ * przyspieszenia jest bliski 1 g (`ACC_NORM_TOLERANCE_MG`), a średnia prędkość kątowa jest mała
+ * (`MAX_BIAS_DPS` - powolny obrót ze stałą prędkością to nie dryf). Bias jest aktualizowany dopiero,
+ * gdy spoczynek trwa co najmniej `MIN_STATIONARY_FRAMES` ramek. Pierwsza aktualizacja ustawia bias
+ * na średnią okna, kolejne wygładzają go wykładniczo (`BIAS_SMOOTHING`).
+ * Bias jest utrzymywany także podczas ruchu; `apply()` odejmuje go od odczytu w miejscu.
+ */
+class GyroBiasEstimator {
+public:
+    static constexpr int WINDOW_SIZE = 64; //!< Długość okna detektora spoczynku [ramki] (ok. 0,6 s przy 100 Hz).
+    static constexpr float GYRO_VARIANCE_THRESHOLD = 0.25f; //!< Maksymalna wariancja osi żyroskopu w spoczynku [dps²].
+    static constexpr float ACC_VARIANCE_THRESHOLD = 100.0f; //!< Maksymalna wariancja osi akcelerometru w spoczynku [mg²].
+    static constexpr float ACC_NORM_TOLERANCE_MG = 50.0f; //!< Dopuszczalne odchylenie modułu średniego przyspieszenia od 1 g [mg].
+    static constexpr float MAX_BIAS_DPS = 0.5f; //!< Maksymalny moduł średniej prędkości kątowej uznawanej za dryf [dps].
+    static constexpr int MIN_STATIONARY_FRAMES = 100; //!< Czas spoczynku przed aktualizacją biasu [ramki] (ok. 1 s przy 100 Hz).
+    static constexpr float BIAS_SMOOTHING = 0.01f; //!< Waga średniej okna przy aktualizacji biasu (na ramkę).
+
+    /**
+     * @brief Dodaje ramkę IMU do okna detektora i - w spoczynku - aktualizuje bias.
+     * @param frame [in] Co najmniej 6 surowych wartości ramki IMU (żyroskop X-Z [dps], akcelerometr X-Z [mg]).
+     */
+    void addSample(const float *frame);
+
+    /**
+     * @brief Odejmuje bieżący bias od odczytu żyroskopu (bez estymaty nic nie zmienia).
+     * @param gyro [in,out] Trzy wartości żyroskopu (X, Y, Z) [dps].
+     */
+    void apply(float *gyro) const;
+
+    /** @brief Zeruje okno detektora i bias (np. po zmianie urządzenia). */
+    void reset();
+
+    /** @brief Zwraca bieżący bias osi X, Y, Z [dps]. */
+    const float *bias() const { return m_bias; }
+
+    /** @brief Informuje, czy ostatnie okno ramek uznano za spoczynek (bias może nie być jeszcze aktualizowany). */
+    bool isStationary() const { return m_stationary; }
+
+    /** @brief Informuje, czy bias został już wyznaczony (był co najmniej jeden spoczynek). */
+    bool hasEstimate() const { return m_hasEstimate; }
+
+private:
+    static constexpr int CHANNELS = 6; //!< Żyroskop X-Z i akcelerometr X-Z.
+
+    /** @brief Przelicza sumy okna od nowa (usuwa błąd zaokrągleń sum przyrostowych). */
+    void recomputeSums();
+
+    float m_window[WINDOW_SIZE][CHANNELS] = {}; //!< Bufor kołowy ostatnich próbek.
+    double m_sum[CHANNELS] = {}; //!< Sumy kanałów w oknie.
+    double m_sumSquares[CHANNELS] = {}; //!< Sumy kwadratów kanałów w oknie.
+    int m_next = 0; //!< Indeks, pod który trafi następna próbka.
+    int m_count = 0; //!< Liczba próbek w oknie (do `WINDOW_SIZE`).
+    float m_bias[3] = {}; //!< Bieżący bias żyroskopu [dps].
+    int m_stationaryFrames = 0; //!< Liczba kolejnych ramek uznanych za spoczynek.
+    bool m_stationary = false; //!< Wynik detektora dla ostatniego okna.
+    bool m_hasEstimate = false; //!< Bias wyznaczony co najmniej raz.
+};
+
+#endif // GYROBIASESTIMATOR_H
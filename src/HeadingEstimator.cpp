@@ -0,0 +1,105 @@
+/**
+ * @file HeadingEstimator.cpp
+ * @brief Implementacja klasy HeadingEstimator.
+ * @details Dla znormalizowanego pionu `u` i pola `m`: składowa wzdłuż rzutu osi X to
+ * `mx - ux * (m·u)`, a prostopadła `u·(x × m) = uz * my - uy * mz` - oba wyrazy mają tę samą skalę,
+ * więc do `atan2` nie trzeba normalizować rzutów.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-11
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include "HeadingEstimator.h"
+#include "SimdSupport.h"
+#include <QtMath>
+#include <cmath>
+
+constexpr float MIN_NORM_SQUARED_HE = 1.0e-12f; // Poniżej - wektor uznawany za brak danych
+
+float HeadingEstimator::trueHeading(float magneticHeading) const {
+    float heading = std::fmod(magneticHeading + m_declination, 360.0f);
+    if (heading < 0.0f) {
+        heading += 360.0f;
+    }
+    return heading >= 360.0f ? 0.0f : heading;
+}
+
+float HeadingEstimator::headingFromComponents(float across, float along) {
+    if (across * across + along * along <= MIN_NORM_SQUARED_HE) {
+        return 0.0f;
+    }
+    float heading = qRadiansToDegrees(std::atan2(across, along));
+    if (heading < 0.0f) {
+        heading += 360.0f;
+    }
+    return heading >= 360.0f ? 0.0f : heading; // -0.00001° + 360 zaokrągla się do 360
+}
+
+float HeadingEstimator::magneticHeading(const float *frame) {
+    float ax = frame[ACC_X_INDEX];
+    float ay = frame[ACC_X_INDEX + 1];
+    float az = frame[ACC_X_INDEX + 2];
+    const float mx = frame[MAG_X_INDEX];
+    const float my = frame[MAG_X_INDEX + 1];
+    const float mz = frame[MAG_X_INDEX + 2];
+
+    const float accNormSquared = ax * ax + ay * ay + az * az;
+    if (accNormSquared <= MIN_NORM_SQUARED_HE) {
+        ax = ay = 0.0f; // Brak akcelerometru - czujnik traktowany jak leżący
+        az = 1.0f;
+    } else {
+        const float scale = 1.0f / std::sqrt(accNormSquared);
+        ax *= scale;
+        ay *= scale;
+        az *= scale;
+    }
+    const float vertical = mx * ax + my * ay + mz * az;
+    return headingFromComponents(az * my - ay * mz, mx - ax * vertical);
+}
+
+void HeadingEstimator::magneticHeadings(const float *const *frames, int count, float *headings) {
+    if (count <= 0) {
+        return;
+    }
+    // Tablice zaokrąglone do pełnych wektorów - ogon wypełniony zerami
+    const int paddedCount = (count + SimdFloat4::LANES - 1) / SimdFloat4::LANES * SimdFloat4::LANES;
+    QVector<float> *channels[] = {&m_ax, &m_ay, &m_az, &m_mx, &m_my, &m_mz};
+    for (QVector<float> *channel: channels) {
+        channel->resize(paddedCount);
+    }
+    m_across.resize(paddedCount);
+    m_along.resize(paddedCount);
+    for (int i = 0; i < paddedCount; ++i) {
+        const float *frame = i < count ? frames[i] : nullptr;
+        for (int axis = 0; axis < 3; ++axis) {
+            (*channels[axis])[i] = frame ? frame[ACC_X_INDEX + axis] : 0.0f;
+            (*channels[3 + axis])[i] = frame ? frame[MAG_X_INDEX + axis] : 0.0f;
+        }
+        if (m_ax[i] * m_ax[i] + m_ay[i] * m_ay[i] + m_az[i] * m_az[i] <= MIN_NORM_SQUARED_HE) {
+            m_az[i] = 1.0f; // Jak w magneticHeading() - bez rozgałęzień w jądrze
+        }
+    }
+
+    const SimdFloat4 minNorm = SimdFloat4::broadcast(MIN_NORM_SQUARED_HE);
+    for (int i = 0; i < paddedCount; i += SimdFloat4::LANES) {
+        SimdFloat4 ax = SimdFloat4::load(&m_ax[i]);
+        SimdFloat4 ay = SimdFloat4::load(&m_ay[i]);
+        SimdFloat4 az = SimdFloat4::load(&m_az[i]);
+        const SimdFloat4 accNormSquared = SimdFloat4::mulAdd(ax, ax, SimdFloat4::mulAdd(ay, ay, az * az));
+        const SimdFloat4 accScale = SimdFloat4::rsqrt(SimdFloat4::max(accNormSquared, minNorm));
+        ax = ax * accScale;
+        ay = ay * accScale;
+        az = az * accScale;
+
+        const SimdFloat4 mx = SimdFloat4::load(&m_mx[i]);
+        const SimdFloat4 my = SimdFloat4::load(&m_my[i]);
+        const SimdFloat4 mz = SimdFloat4::load(&m_mz[i]);
+        const SimdFloat4 vertical = SimdFloat4::mulAdd(mx, ax, SimdFloat4::mulAdd(my, ay, mz * az));
+        (az * my - ay * mz).store(&m_across[i]);
+        (mx - ax * vertical).store(&m_along[i]);
+    }
+    for (int i = 0; i < count; ++i) {
+        headings[i] = headingFromComponents(m_across[i], m_along[i]);
+    }
+}
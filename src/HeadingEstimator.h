@@ -0,0 +1,84 @@
+#ifndef HEADINGESTIMATOR_H
+#define HEADINGESTIMATOR_H
+
+/**
+ * @file HeadingEstimator.h
+ * @brief Definicja klasy HeadingEstimator - kurs kompasu z kompensacją przechyłu i deklinacją magnetyczną.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-11
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include <QVector>
+
+/**
+ * @class HeadingEstimator
+ * @brief Wyznacza kurs z magnetometru rzutowanego na płaszczyznę poziomą.
+ *
+ * @details
+ * Kierunek pionu jest brany z akcelerometru tej samej ramki (czujnik w spoczynku mierzy +1 g
+ * wzdłuż osi skierowanej w górę), więc kurs nie zmienia się przy pochyleniu i przechyleniu płytki.
+ * Składowa północna to rzut pola magnetycznego na płaszczyznę poziomą, a kurs - kąt między nią
+ * a rzutem osi X czujnika, mierzony zgodnie z ruchem wskazówek zegara. Dla leżącego czujnika
+ * wynik jest równy dotychczasowemu `atan2(magY, magX)`.
+ *
+ * `magneticHeadings()` przetwarza wiele ramek naraz (np. całe nagranie przy wczytaniu) - rzutowanie
+ * jest liczone jądrem wektorowym `SimdFloat4`, a `atan2` skalarnie. Deklinacja jest stałym
+ * przesunięciem, więc kursy magnetyczne nie wymagają przeliczenia po jej zmianie (`trueHeading()`).
+ */
+class HeadingEstimator {
+public:
+    static constexpr int ACC_X_INDEX = 3; //!< Indeks akcelerometru X w ramce IMU (kolejne: Y, Z).
+    static constexpr int MAG_X_INDEX = 6; //!< Indeks magnetometru X w ramce IMU.
+    static constexpr int MIN_FRAME_VALUES = 9; //!< Minimalna liczba wartości ramki.
+
+    /**
+     * @brief Ustawia deklinację magnetyczną.
+     * @param degrees [in] Deklinacja [°], dodatnia, gdy północ magnetyczna leży na wschód od geograficznej.
+     */
+    void setDeclination(float degrees) { m_declination = degrees; }
+
+    /** @brief Zwraca deklinację magnetyczną [°]. */
+    float declination() const { return m_declination; }
+
+    /**
+     * @brief Przelicza kurs magnetyczny na geograficzny (z deklinacją).
+     * @param magneticHeading [in] Kurs magnetyczny [°] (np. z `magneticHeading()` lub `AhrsFusion`).
+     * @return Kurs w zakresie [0, 360).
+     */
+    float trueHeading(float magneticHeading) const;
+
+    /**
+     * @brief Wyznacza kurs magnetyczny jednej ramki.
+     * @param frame [in] Wartości ramki IMU (co najmniej `MIN_FRAME_VALUES`).
+     * @return Kurs [0, 360); 0, gdy ramka nie zawiera pola magnetycznego.
+     */
+    static float magneticHeading(const float *frame);
+
+    /**
+     * @brief Wyznacza kursy magnetyczne paczki ramek (jądro wektorowe).
+     * @param frames [in] Wskaźniki na wartości ramek IMU.
+     * @param count [in] Liczba ramek.
+     * @param headings [out] Kursy [0, 360) (`count` elementów); wyniki równe `magneticHeading()`
+     * z dokładnością do zaokrągleń.
+     */
+    void magneticHeadings(const float *const *frames, int count, float *headings);
+
+private:
+    /**
+     * @brief Zamienia składowe poziome pola na kurs; 0, gdy pola brak.
+     * @param across [in] Składowa pola prostopadła do rzutu osi X (dodatnia na lewo od niej).
+     * @param along [in] Składowa pola wzdłuż rzutu osi X.
+     */
+    static float headingFromComponents(float across, float along);
+
+    float m_declination = 0.0f; //!< Deklinacja magnetyczna [°].
+
+    // Kanały paczki w układzie SoA (pojemność zachowywana między paczkami)
+    QVector<float> m_ax, m_ay, m_az; //!< Akcelerometr.
+    QVector<float> m_mx, m_my, m_mz; //!< Magnetometr.
+    QVector<float> m_across, m_along; //!< Składowe poziome pola (wynik jądra).
+};
+
+#endif // HEADINGESTIMATOR_H
@@ -12,6 +12,10 @@
 #include "ImuDataHandler.h"
 #include "SensorGraph.h"        // Wymagane dla wizualizacji wykresów
 #include "Compass2DRenderer.h"  // Wymagane dla wizualizacji kompasu 2D
+#include "LatencyTracer.h"
+#include "SpectrumView.h"
+#include "StatisticsView.h"
+#include "EventTimelineView.h"
 
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -26,6 +30,24 @@
 #include <QColor>
 #include <QVector3D>
 #include <QtMath>
+#include <QTimer>
+#include <QShowEvent>
+#include <algorithm>
+#include <cmath>
+
+// Indeksy dla danych IMU (wspólne dla pliku symulacyjnego i części IMU z portu)
+constexpr int GYRO_X_IDX_IDH = 0;
+constexpr int GYRO_Y_IDX_IDH = 1;
+constexpr int GYRO_Z_IDX_IDH = 2;
+constexpr int ACC_X_IDX_IDH = 3;
+constexpr int ACC_Y_IDX_IDH = 4;
+constexpr int ACC_Z_IDX_IDH = 5;
+constexpr int MAG_X_IDX_IDH = 6;
+constexpr int MAG_Y_IDX_IDH = 7;
+constexpr int MAG_Z_IDX_IDH = 8;
+constexpr int ROLL_IDX_IDH = 9;
+constexpr int PITCH_IDX_IDH = 10;
+constexpr int YAW_IDX_IDH = 11;
 
 // Inkluzje Qt3D dla modelu płytki
 #include <Qt3DCore/QEntity>
@@ -47,21 +69,32 @@ ImuDataHandler::ImuDataHandler(QWidget *parent)
       gyroXBar(nullptr), gyroYBar(nullptr), gyroZBar(nullptr),
       magXBar(nullptr), magYBar(nullptr), magZBar(nullptr),
       accGraph(nullptr), gyroGraph(nullptr), magGraph(nullptr),
+      m_spectrumView(nullptr),
+      m_statisticsView(nullptr),
+      m_eventsView(nullptr),
       stackedWidget(nullptr),
       visualizationPanelWidget(nullptr),
       view3DContainerWidget(nullptr),
+      m_view3DCreated(false),
       m_compass2DRenderer(nullptr),
       boardTransform(nullptr),
       m_currentDataButton(nullptr),
       m_graphButton(nullptr),
+      m_spectrumButton(nullptr),
+      m_statisticsButton(nullptr),
+      m_eventsButton(nullptr),
       m_accGroupBox(nullptr),
       m_gyroGroupBox(nullptr),
-      m_magGroupBox(nullptr) {
+      m_magGroupBox(nullptr),
+      m_magCalibrationBar(nullptr),
+      m_gyroBiasLabel(nullptr) {
     setupMainLayout();
     setRange(0, 0); // Ustawienie domyślnych zakresów (funkcja obecnie ignoruje argumenty)
 }
 
-void ImuDataHandler::updateData(const QVector<int> &acc, const QVector<int> &gyro, const QVector<int> &mag) {
+void ImuDataHandler::updateData(const QVector<int> &acc, const QVector<int> &gyro, const QVector<int> &mag,
+                                qint64 timestampNs, const QVector<int> &rawAcc, const QVector<int> &rawGyro,
+                                const QVector<int> &rawMag) {
     if (acc.size() == 3) {
         if (accXBar) accXBar->setValue(acc[0]);
         if (accYBar) accYBar->setValue(acc[1]);
@@ -69,7 +102,7 @@ void ImuDataHandler::updateData(const QVector<int> &acc, const QVector<int> &gyr
         if (accXBar) accXBar->setFormat(QString::number(acc[0]));
         if (accYBar) accYBar->setFormat(QString::number(acc[1]));
         if (accZBar) accZBar->setFormat(QString::number(acc[2]));
-        if (accGraph) accGraph->addData(acc);
+        if (accGraph) accGraph->addData(acc, timestampNs, rawAcc);
     } else if (!acc.isEmpty()) {
         // Log warning only if data was provided but was invalid
         qWarning() << "Accelerometer data size is not 3. Expected [X, Y, Z]. Received size:" << acc.size();
@@ -82,7 +115,7 @@ void ImuDataHandler::updateData(const QVector<int> &acc, const QVector<int> &gyr
         if (gyroXBar) gyroXBar->setFormat(QString::number(gyro[0]));
         if (gyroYBar) gyroYBar->setFormat(QString::number(gyro[1]));
         if (gyroZBar) gyroZBar->setFormat(QString::number(gyro[2]));
-        if (gyroGraph) gyroGraph->addData(gyro);
+        if (gyroGraph) gyroGraph->addData(gyro, timestampNs, rawGyro);
     } else if (!gyro.isEmpty()) {
         qWarning() << "Gyroscope data size is not 3. Expected [X, Y, Z]. Received size:" << gyro.size();
     }
@@ -94,7 +127,7 @@ void ImuDataHandler::updateData(const QVector<int> &acc, const QVector<int> &gyr
         if (magXBar) magXBar->setFormat(QString::number(mag[0]));
         if (magYBar) magYBar->setFormat(QString::number(mag[1]));
         if (magZBar) magZBar->setFormat(QString::number(mag[2]));
-        if (magGraph) magGraph->addData(mag);
+        if (magGraph) magGraph->addData(mag, timestampNs, rawMag);
     } else if (!mag.isEmpty()) {
         qWarning() << "Magnetometer data size is not 3. Expected [X, Y, Z]. Received size:" << mag.size();
     }
@@ -149,11 +182,9 @@ void ImuDataHandler::setRotation(float yaw, float pitch, float roll) {
     // Aktualnie używana (pitch, yaw, roll) w funkcji setRotation w klasie,
     // oznacza, że yaw jest drugim argumentem, więc odpowiada osi Y
     QQuaternion rotation = QQuaternion::fromEulerAngles(pitch, yaw, roll);
+    m_lastRotation = rotation; // Zapamiętaj na wypadek, gdyby model 3D jeszcze nie istniał
     if (boardTransform) {
         boardTransform->setRotation(rotation);
-    } else {
-        // qWarning() << "boardTransform is null in setRotation. Cannot set model rotation.";
-        // Opcjonalnie: można dodać logowanie, jeśli transformacja nie istnieje.
     }
 }
 
@@ -165,6 +196,130 @@ void ImuDataHandler::updateCompass(float heading) {
     }
 }
 
+void ImuDataHandler::setMagCalibrationStatus(float coverage, bool calibrated, float fitError) {
+    if (coverage == m_magCalibrationCoverage && calibrated == m_magCalibrated && fitError == m_magCalibrationFitError) {
+        return; // Wywoływane raz na paczkę ramek - tekst paska tylko po zmianie
+    }
+    m_magCalibrationCoverage = coverage;
+    m_magCalibrated = calibrated;
+    m_magCalibrationFitError = fitError;
+    updateMagCalibrationBar();
+}
+
+void ImuDataHandler::updateMagCalibrationBar() {
+    if (!m_magCalibrationBar) {
+        return;
+    }
+    const int percent = qRound(m_magCalibrationCoverage * 100.0f);
+    m_magCalibrationBar->setValue(percent);
+    m_magCalibrationBar->setFormat(m_magCalibrated ? tr("Calibrated - coverage %1%, fit error %2%")
+                                                         .arg(percent).arg(m_magCalibrationFitError * 100.0f, 0, 'f', 1)
+                                                   : tr("Calibrating - rotate the sensor (%1%)").arg(percent));
+}
+
+void ImuDataHandler::setGyroBiasStatus(bool stationary, const float *bias, bool corrected) {
+    int biasShown[3] = {};
+    if (bias) {
+        for (int axis = 0; axis < 3; ++axis) {
+            biasShown[axis] = qRound(bias[axis] * 100.0f);
+        }
+    }
+    if (stationary == m_gyroStationary && (bias != nullptr) == m_gyroBiasKnown && corrected == m_gyroBiasCorrected
+        && std::equal(biasShown, biasShown + 3, m_gyroBiasShown)) {
+        return; // Wywoływane raz na paczkę ramek - tekst etykiety tylko po zmianie
+    }
+    m_gyroStationary = stationary;
+    m_gyroBiasKnown = bias != nullptr;
+    m_gyroBiasCorrected = corrected;
+    std::copy(biasShown, biasShown + 3, m_gyroBiasShown);
+    updateGyroBiasLabel();
+}
+
+void ImuDataHandler::updateGyroBiasLabel() {
+    if (!m_gyroBiasLabel) {
+        return;
+    }
+    const QString state = m_gyroStationary ? tr("At rest") : tr("Moving");
+    if (!m_gyroBiasKnown) {
+        m_gyroBiasLabel->setText(tr("%1 - bias not estimated yet (keep the sensor still)").arg(state));
+        return;
+    }
+    const QString text = m_gyroBiasCorrected ? tr("%1 - bias removed: X %2, Y %3, Z %4 dps")
+                                             : tr("%1 - bias (not removed): X %2, Y %3, Z %4 dps");
+    m_gyroBiasLabel->setText(text.arg(state)
+                                 .arg(m_gyroBiasShown[0] / 100.0, 0, 'f', 2)
+                                 .arg(m_gyroBiasShown[1] / 100.0, 0, 'f', 2)
+                                 .arg(m_gyroBiasShown[2] / 100.0, 0, 'f', 2));
+}
+
+void ImuDataHandler::setRawTraceVisible(bool visible) {
+    m_rawTraceVisible = visible;
+    if (accGraph) accGraph->setRawTraceVisible(visible);
+    if (gyroGraph) gyroGraph->setRawTraceVisible(visible);
+    if (magGraph) magGraph->setRawTraceVisible(visible);
+}
+
+void ImuDataHandler::addSpectrumFrames(const float *const *frames, const qint64 *timestampsNs, int count) {
+    if (m_spectrumView && stackedWidget && stackedWidget->currentWidget() == m_spectrumView) {
+        m_spectrumView->addFrames(frames, timestampsNs, count);
+    }
+}
+
+void ImuDataHandler::addStatisticsFrames(const float *const *frames, const qint64 *timestampsNs, int count) {
+    if (m_statisticsView) m_statisticsView->addFrames(frames, timestampsNs, count);
+}
+
+void ImuDataHandler::resetStatistics() {
+    if (m_statisticsView) m_statisticsView->reset();
+}
+
+void ImuDataHandler::addEventFrames(const float *const *frames, const qint64 *timestampsNs, int count,
+                                    bool fromRecording, qint64 recordingOffsetNs) {
+    if (m_eventsView) m_eventsView->addFrames(frames, timestampsNs, count, fromRecording, recordingOffsetNs);
+}
+
+void ImuDataHandler::resetEventDetector() {
+    if (m_eventsView) m_eventsView->resetDetector();
+}
+
+void ImuDataHandler::clearEvents() {
+    if (m_eventsView) m_eventsView->clear();
+}
+
+void ImuDataHandler::markGap() {
+    if (accGraph) accGraph->markGap();
+    if (gyroGraph) gyroGraph->markGap();
+    if (magGraph) magGraph->markGap();
+    if (m_spectrumView) m_spectrumView->reset();
+}
+
+void ImuDataHandler::processFrame(const QVector<float> &imuData, qint64 timestampNs,
+                                  const AhrsFusion::EulerAngles *hostOrientation, const QVector<float> *rawImuData) {
+    QVector<int> gyro = { static_cast<int>(imuData[GYRO_X_IDX_IDH]), static_cast<int>(imuData[GYRO_Y_IDX_IDH]), static_cast<int>(imuData[GYRO_Z_IDX_IDH]) };
+    QVector<int> acc = { static_cast<int>(imuData[ACC_X_IDX_IDH]), static_cast<int>(imuData[ACC_Y_IDX_IDH]), static_cast<int>(imuData[ACC_Z_IDX_IDH]) };
+    QVector<int> mag = { static_cast<int>(imuData[MAG_X_IDX_IDH]), static_cast<int>(imuData[MAG_Y_IDX_IDH]), static_cast<int>(imuData[MAG_Z_IDX_IDH]) };
+    float roll = imuData[ROLL_IDX_IDH];
+    float pitch = imuData[PITCH_IDX_IDH];
+    float yaw = imuData[YAW_IDX_IDH];
+
+    if (rawImuData && m_rawTraceVisible) {
+        const QVector<float> &raw = *rawImuData;
+        updateData(acc, gyro, mag, timestampNs,
+                   {static_cast<int>(raw[ACC_X_IDX_IDH]), static_cast<int>(raw[ACC_Y_IDX_IDH]), static_cast<int>(raw[ACC_Z_IDX_IDH])},
+                   {static_cast<int>(raw[GYRO_X_IDX_IDH]), static_cast<int>(raw[GYRO_Y_IDX_IDH]), static_cast<int>(raw[GYRO_Z_IDX_IDH])},
+                   {static_cast<int>(raw[MAG_X_IDX_IDH]), static_cast<int>(raw[MAG_Y_IDX_IDH]), static_cast<int>(raw[MAG_Z_IDX_IDH])});
+    } else {
+        updateData(acc, gyro, mag, timestampNs);
+    }
+    LatencyTracer::mark(LatencyTracer::Stage::ChartsUpdated);
+    if (hostOrientation) {
+        setRotation(hostOrientation->yaw, hostOrientation->pitch, hostOrientation->roll);
+    } else {
+        setRotation(yaw, pitch, roll);
+    }
+    LatencyTracer::mark(LatencyTracer::Stage::View3DUpdated);
+}
+
 void ImuDataHandler::showCurrentData() {
     if (stackedWidget) stackedWidget->setCurrentIndex(0);
 }
@@ -173,6 +328,21 @@ void ImuDataHandler::showGraph() {
     if (stackedWidget) stackedWidget->setCurrentIndex(1);
 }
 
+void ImuDataHandler::showSpectrum() {
+    if (stackedWidget && m_spectrumView && stackedWidget->currentWidget() != m_spectrumView) {
+        m_spectrumView->reset(); // Bufor analizy sprzed ukrycia widoku nie jest ciągły z nowymi ramkami
+        stackedWidget->setCurrentIndex(2);
+    }
+}
+
+void ImuDataHandler::showStatistics() {
+    if (stackedWidget) stackedWidget->setCurrentIndex(3);
+}
+
+void ImuDataHandler::showEvents() {
+    if (stackedWidget) stackedWidget->setCurrentIndex(4);
+}
+
 void ImuDataHandler::setupMainLayout() {
     QVBoxLayout *mainLayout = new QVBoxLayout(this);
 
@@ -201,12 +371,21 @@ QWidget *ImuDataHandler::createButtonPanel() {
 
     m_currentDataButton = new QPushButton(tr("Current Data"), buttonPanel);
     m_graphButton = new QPushButton(tr("Graph"), buttonPanel);
+    m_spectrumButton = new QPushButton(tr("Spectrum"), buttonPanel);
+    m_statisticsButton = new QPushButton(tr("Statistics"), buttonPanel);
+    m_eventsButton = new QPushButton(tr("Events"), buttonPanel);
 
     buttonLayout->addWidget(m_currentDataButton);
     buttonLayout->addWidget(m_graphButton);
+    buttonLayout->addWidget(m_spectrumButton);
+    buttonLayout->addWidget(m_statisticsButton);
+    buttonLayout->addWidget(m_eventsButton);
 
     connect(m_currentDataButton, &QPushButton::clicked, this, &ImuDataHandler::showCurrentData);
     connect(m_graphButton, &QPushButton::clicked, this, &ImuDataHandler::showGraph);
+    connect(m_spectrumButton, &QPushButton::clicked, this, &ImuDataHandler::showSpectrum);
+    connect(m_statisticsButton, &QPushButton::clicked, this, &ImuDataHandler::showStatistics);
+    connect(m_eventsButton, &QPushButton::clicked, this, &ImuDataHandler::showEvents);
 
     buttonPanel->setLayout(buttonLayout);
     return buttonPanel;
@@ -223,6 +402,13 @@ QWidget *ImuDataHandler::createLeftPanel() {
     stackedWidget = new QStackedWidget(leftPanelWidget);
     stackedWidget->addWidget(barWidget);
     stackedWidget->addWidget(graphWidget);
+    m_spectrumView = new SpectrumView(stackedWidget);
+    stackedWidget->addWidget(m_spectrumView);
+    m_statisticsView = new StatisticsView(stackedWidget);
+    stackedWidget->addWidget(m_statisticsView);
+    m_eventsView = new EventTimelineView(stackedWidget);
+    stackedWidget->addWidget(m_eventsView);
+    connect(m_eventsView, &EventTimelineView::eventSelected, this, &ImuDataHandler::eventSelected);
 
     leftPanelLayout->addWidget(stackedWidget);
     leftPanelWidget->setLayout(leftPanelLayout);
@@ -284,6 +470,18 @@ QWidget *ImuDataHandler::createBarDisplayWidget() {
     addBarGroup("Gyroscope [dps]", m_gyroGroupBox, gyroXBar, gyroYBar, gyroZBar, 250);
     addBarGroup("Magnetometer [mG]", m_magGroupBox, magXBar, magYBar, magZBar, 1600);
 
+    // Stan detektora spoczynku i bias żyroskopu pod paskami osi
+    m_gyroBiasLabel = new QLabel(m_gyroGroupBox);
+    m_gyroGroupBox->layout()->addWidget(m_gyroBiasLabel);
+    updateGyroBiasLabel();
+
+    // Postęp kalibracji magnetometru (pokrycie kierunków) pod paskami osi
+    m_magCalibrationBar = new QProgressBar(m_magGroupBox);
+    m_magCalibrationBar->setRange(0, 100);
+    m_magCalibrationBar->setTextVisible(true);
+    m_magGroupBox->layout()->addWidget(m_magCalibrationBar);
+    updateMagCalibrationBar();
+
     barWidget->setLayout(barLayout);
     return barWidget;
 }
@@ -309,12 +507,32 @@ QWidget *ImuDataHandler::createGraphDisplayWidget() {
     return graphWidget;
 }
 
+void ImuDataHandler::showEvent(QShowEvent *event) {
+    QWidget::showEvent(event);
+    if (!m_view3DCreated) {
+        // Odrocz utworzenie Qt3D do następnej iteracji pętli zdarzeń, aby okno pojawiło się od razu
+        QTimer::singleShot(0, this, &ImuDataHandler::ensure3DView);
+    }
+}
+
+void ImuDataHandler::ensure3DView() {
+    if (m_view3DCreated || !view3DContainerWidget) {
+        return;
+    }
+    m_view3DCreated = true;
+    QWidget *view3D = create3DView();
+    if (view3D) {
+        view3DContainerWidget->layout()->addWidget(view3D);
+    }
+}
+
 void ImuDataHandler::setupVisualizationPanel() {
     if (!view3DContainerWidget) {
-        view3DContainerWidget = create3DView();
-        if (view3DContainerWidget) {
-            view3DContainerWidget->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
-        }
+        // Pusty kontener zastępczy - właściwy widok 3D powstaje w ensure3DView()
+        view3DContainerWidget = new QWidget(this);
+        auto *view3DLayout = new QVBoxLayout(view3DContainerWidget);
+        view3DLayout->setContentsMargins(0, 0, 0, 0);
+        view3DContainerWidget->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
     }
 
     if (!m_compass2DRenderer) {
@@ -345,7 +563,7 @@ void ImuDataHandler::setupVisualizationPanel() {
 QWidget *ImuDataHandler::create3DView() {
     Qt3DExtras::Qt3DWindow *view = new Qt3DExtras::Qt3DWindow();
     view->defaultFrameGraph()->setClearColor(QColor(QRgb(0x4d4d4f))); // Ciemnoszary kolor tła
-    QWidget *container = QWidget::createWindowContainer(view, this);
+    QWidget *container = QWidget::createWindowContainer(view, view3DContainerWidget);
     container->setFocusPolicy(Qt::StrongFocus);
     container->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
 
@@ -408,6 +626,8 @@ void ImuDataHandler::setupModelLoader3D(Qt3DCore::QEntity *rootEntity) {
                             // ale dodanie naszej transformacji daje pewniejszą kontrolę.
                             sceneRootEntity->addComponent(this->boardTransform);
                         }
+                        // Zastosuj orientację odebraną przed załadowaniem modelu
+                        this->boardTransform->setRotation(this->m_lastRotation);
                         // Przykładowe początkowe ustawienia transformacji, jeśli potrzebne
                         // this->boardTransform->setScale3D(QVector3D(0.05f, 0.05f, 0.05f));
                         // this->boardTransform->setRotationX(90);
@@ -433,6 +653,15 @@ void ImuDataHandler::retranslateUi() {
     if (m_graphButton) {
         m_graphButton->setText(tr("Graph"));
     }
+    if (m_spectrumButton) {
+        m_spectrumButton->setText(tr("Spectrum"));
+    }
+    if (m_statisticsButton) {
+        m_statisticsButton->setText(tr("Statistics"));
+    }
+    if (m_eventsButton) {
+        m_eventsButton->setText(tr("Events"));
+    }
 
     if (m_accGroupBox) {
         m_accGroupBox->setTitle(tr("Accelerometer [mg]"));
@@ -443,11 +672,16 @@ void ImuDataHandler::retranslateUi() {
     if (m_magGroupBox) {
         m_magGroupBox->setTitle(tr("Magnetometer [mG]"));
     }
+    updateMagCalibrationBar();
+    updateGyroBiasLabel();
 
     // Zakładając, że SensorGraph ma metodę retranslateUi do aktualizacji swojego tytułu
     if (accGraph) accGraph->retranslateUi();
     if (gyroGraph) gyroGraph->retranslateUi();
     if (magGraph) magGraph->retranslateUi();
+    if (m_spectrumView) m_spectrumView->retranslateUi();
+    if (m_statisticsView) m_statisticsView->retranslateUi();
+    if (m_eventsView) m_eventsView->retranslateUi();
 
     // Compass2DRenderer nie przechowuje tekstów do tłumaczenia, więc pomijam.
 }
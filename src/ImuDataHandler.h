@@ -27,14 +27,19 @@
 #include <QWidget>
 #include <QVector>
 #include <QQuaternion> // Dla QQuaternion w setRotation
+#include "AhrsFusion.h"
 
 // Forward declarations
 class QProgressBar;
+class QLabel;
 class QPushButton;
 class QStackedWidget;
 class QGroupBox;
 class SensorGraph;
 class Compass2DRenderer;
+class SpectrumView;
+class StatisticsView;
+class EventTimelineView;
 
 namespace Qt3DCore {
     class QEntity;
@@ -86,10 +91,15 @@ public:
      * @param acc [in] Wektor danych z akcelerometru [X, Y, Z], jednostki: $mg$.
      * @param gyro [in] Wektor danych z żyroskopu [X, Y, Z], jednostki: $dps$.
      * @param mag [in] Wektor danych z magnetometru [X, Y, Z], jednostki: $mG$.
+     * @param timestampNs [in] Monotoniczny czas odbioru próbki [ns] - położenie na osi czasu wykresów.
+     * @param rawAcc [in] Opcjonalnie: akcelerometr przed filtrowaniem (przebieg surowy na wykresie).
+     * @param rawGyro [in] Opcjonalnie: żyroskop przed filtrowaniem.
+     * @param rawMag [in] Opcjonalnie: magnetometr przed filtrowaniem.
      * @warning Jeśli rozmiar któregokolwiek z wektorów wejściowych nie wynosi 3,
      * odpowiadające mu dane nie zostaną zaktualizowane dla pasków i wykresów.
      */
-    void updateData(const QVector<int> &acc, const QVector<int> &gyro, const QVector<int> &mag);
+    void updateData(const QVector<int> &acc, const QVector<int> &gyro, const QVector<int> &mag, qint64 timestampNs,
+                    const QVector<int> &rawAcc = {}, const QVector<int> &rawGyro = {}, const QVector<int> &rawMag = {});
 
     /**
      * @brief Ustawia liczbę próbek (historię) wyświetlanych na wykresach.
@@ -135,6 +145,91 @@ public:
      */
     void updateCompass(float heading);
 
+    /**
+     * @brief Aktualizuje wszystkie widoki danymi jednej ramki IMU.
+     * @details Zamienia 12 wartości ramki (żyroskop, akcelerometr, magnetometr, roll, pitch, yaw)
+     * na dane pasków i wykresów (`updateData()`) oraz obrót modelu 3D (`setRotation()`). Kurs kompasu
+     * nie jest tu liczony - wywołujący ustawia go raz na paczkę ramek (`updateCompass()`).
+     * @param imuData [in] Wektor 12 wartości IMU w kolejności ramki danych.
+     * @param timestampNs [in] Monotoniczny czas odbioru ramki [ns] (`SensorFrame::hostTimestampNs`).
+     * @param hostOrientation [in] Opcjonalnie: orientacja wyznaczona w aplikacji (`AhrsFusion`) - zastępuje
+     * kąty z ramki w widoku 3D.
+     * @param rawImuData [in] Opcjonalnie: ramka przed filtrowaniem (`FilterBank`) - przebiegi surowe na wykresach,
+     * jeśli są włączone (`setRawTraceVisible()`).
+     * @note Rozmiar wektora nie jest sprawdzany - odpowiada za to wywołujący.
+     */
+    void processFrame(const QVector<float> &imuData, qint64 timestampNs,
+                      const AhrsFusion::EulerAngles *hostOrientation = nullptr,
+                      const QVector<float> *rawImuData = nullptr);
+
+    /**
+     * @brief Pokazuje lub ukrywa na wykresach przebiegi surowe (przed filtrowaniem) pod przefiltrowanymi.
+     * @param visible [in] `true`, aby rysować przebiegi surowe (`SensorGraph::setRawTraceVisible()`).
+     */
+    void setRawTraceVisible(bool visible);
+
+    /**
+     * @brief Pokazuje postęp kalibracji magnetometru (`MagnetometerCalibrator`) pod paskami magnetometru.
+     * @param coverage [in] Pokrycie kierunków w bieżącej sesji [0, 1].
+     * @param calibrated [in] Czy odczyty są korygowane wyznaczoną kalibracją.
+     * @param fitError [in] Względny błąd dopasowania kalibracji.
+     */
+    void setMagCalibrationStatus(float coverage, bool calibrated, float fitError);
+
+    /**
+     * @brief Pokazuje stan detektora spoczynku i bias żyroskopu (`GyroBiasEstimator`) pod paskami żyroskopu.
+     * @param stationary [in] Czy czujnik jest w spoczynku.
+     * @param bias [in] Bias osi X, Y, Z [dps]; `nullptr` - bias jeszcze nie wyznaczony.
+     * @param corrected [in] Czy bias jest odejmowany od odczytów.
+     */
+    void setGyroBiasStatus(bool stationary, const float *bias, bool corrected);
+
+    /**
+     * @brief Przekazuje paczkę ramek do widoku widma (`SpectrumView`), jeśli jest on wyświetlany.
+     * @details Gdy widok widma jest ukryty, ramki są pomijane - analiza w tle nie zajmuje procesora.
+     * @param frames [in] Ramki IMU (wartości w kolejności ramki danych, przed filtrowaniem widoku).
+     * @param timestampsNs [in] Czasy ramek [ns].
+     * @param count [in] Liczba ramek.
+     */
+    void addSpectrumFrames(const float *const *frames, const qint64 *timestampsNs, int count);
+
+    /**
+     * @brief Przekazuje paczkę ramek do statystyk w przesuwnym oknie (`StatisticsView`).
+     * @details Statystyki są aktualizowane zawsze (koszt stały na ramkę), a tabela tylko, gdy jest widoczna.
+     * @param frames [in] Ramki IMU (12 wartości w kolejności ramki danych, przed filtrowaniem widoku).
+     * @param timestampsNs [in] Czasy ramek [ns].
+     * @param count [in] Liczba ramek.
+     */
+    void addStatisticsFrames(const float *const *frames, const qint64 *timestampsNs, int count);
+
+    /** @brief Opróżnia okno statystyk (np. po zmianie urządzenia lub rozpoczęciu odtwarzania). */
+    void resetStatistics();
+
+    /**
+     * @brief Przekazuje paczkę ramek do detektorów zdarzeń (`EventTimelineView`).
+     * @details Detektory działają zawsze (koszt stały na ramkę), także gdy lista zdarzeń jest ukryta.
+     * @param frames [in] Ramki IMU (12 wartości w kolejności ramki danych, przed filtrowaniem widoku).
+     * @param timestampsNs [in] Czasy ramek [ns].
+     * @param count [in] Liczba ramek.
+     * @param fromRecording [in] Czy ramki pochodzą z odtwarzanego nagrania.
+     * @param recordingOffsetNs [in] Przesunięcie czasu ramki na czas nagrania (gdy `fromRecording`).
+     */
+    void addEventFrames(const float *const *frames, const qint64 *timestampsNs, int count, bool fromRecording,
+                        qint64 recordingOffsetNs);
+
+    /** @brief Przerywa bieżące zdarzenia detektorów (np. po zmianie urządzenia lub przewinięciu nagrania). */
+    void resetEventDetector();
+
+    /** @brief Usuwa zdarzenia z listy (np. po wczytaniu innego nagrania). */
+    void clearEvents();
+
+    /**
+     * @brief Zaznacza na wykresach przerwę w danych (utracone ramki).
+     * @details Wykresy nie łączą linią próbek sprzed i zza przerwy (`SensorGraph::markGap()`),
+     * a bufor widma jest zerowany, aby okno FFT nie obejmowało przerwy.
+     */
+    void markGap();
+
     /**
      * @brief Aktualizuje teksty interfejsu użytkownika po zmianie języka.
      * @details Odświeża wszystkie teksty etykiet, przycisków i tytułów grup,
@@ -144,6 +239,14 @@ public:
      */
     void retranslateUi();
 
+protected:
+    /**
+     * @brief Obsługuje zdarzenie wyświetlenia widgetu.
+     * @details Przy pierwszym wyświetleniu planuje (przez kolejkę zdarzeń) utworzenie widoku 3D.
+     * @param event [in] Wskaźnik na obiekt zdarzenia `QShowEvent`.
+     */
+    void showEvent(QShowEvent *event) override;
+
 public slots:
     /**
      * @brief Slot: Przełącza widok na zakładkę z aktualnymi danymi (paski postępu).
@@ -161,6 +264,32 @@ public slots:
      */
     void showGraph();
 
+    /**
+     * @brief Slot: Przełącza widok na zakładkę z widmem i spektrogramem (`SpectrumView`).
+     * @details Aktywuje stronę `QStackedWidget` o indeksie 2. Bufor analizy jest zerowany,
+     * bo w czasie, gdy widok był ukryty, ramki nie były do niego przekazywane.
+     */
+    void showSpectrum();
+
+    /**
+     * @brief Slot: Przełącza widok na zakładkę ze statystykami kanałów (`StatisticsView`).
+     * @details Aktywuje stronę `QStackedWidget` o indeksie 3.
+     */
+    void showStatistics();
+
+    /**
+     * @brief Slot: Przełącza widok na zakładkę z listą wykrytych zdarzeń (`EventTimelineView`).
+     * @details Aktywuje stronę `QStackedWidget` o indeksie 4.
+     */
+    void showEvents();
+
+signals:
+    /**
+     * @brief Wybrano zdarzenie z odtwarzanego nagrania na liście zdarzeń.
+     * @param recordingTimeNs [in] Początek zdarzenia w czasie nagrania [ns].
+     */
+    void eventSelected(qint64 recordingTimeNs);
+
 private:
     /** @brief Inicjalizuje i konfiguruje główny layout widgetu. */
     void setupMainLayout();
@@ -177,12 +306,26 @@ private:
     /** @brief Tworzy widget wyświetlający dane w formie wykresów. @return Wskaźnik na utworzony widget. */
     QWidget *createGraphDisplayWidget();
 
+    /** @brief Odświeża pasek postępu kalibracji magnetometru zapamiętanym stanem. */
+    void updateMagCalibrationBar();
+
+    /** @brief Odświeża etykietę biasu żyroskopu zapamiętanym stanem. */
+    void updateGyroBiasLabel();
+
     /** @brief Inicjalizuje i konfiguruje panel wizualizacji (model 3D i kompas 2D). */
     void setupVisualizationPanel();
 
     /** @brief Tworzy i konfiguruje widok 3D dla modelu płytki. @return Wskaźnik na kontener widgetu Qt3DWindow. */
     QWidget *create3DView();
 
+    /**
+     * @brief Tworzy widok 3D przy pierwszym wyświetleniu widgetu.
+     * @details `Qt3DWindow` wraz z ładowaniem modelu (`QSceneLoader`) jest tworzony dopiero po
+     * pierwszym `showEvent`, aby nie wydłużać czasu do pojawienia się okna. Do tego czasu
+     * w panelu wizualizacji znajduje się pusty kontener zastępczy.
+     */
+    void ensure3DView();
+
     /** @brief Konfiguruje kamerę i kontroler kamery dla sceny 3D.
      * @param view Wskaźnik na okno Qt3D.
      * @param rootEntity [in] Wskaźnik na główną encję sceny.
@@ -208,22 +351,40 @@ private:
     SensorGraph *accGraph; //!< Wykres dla danych akcelerometru.
     SensorGraph *gyroGraph; //!< Wykres dla danych żyroskopu.
     SensorGraph *magGraph; //!< Wykres dla danych magnetometru.
+    SpectrumView *m_spectrumView; //!< Widmo i spektrogram wybranego kanału.
+    StatisticsView *m_statisticsView; //!< Statystyki kanałów w przesuwnym oknie.
+    EventTimelineView *m_eventsView; //!< Detektory i lista wykrytych zdarzeń.
 
     QStackedWidget *stackedWidget; //!< Widget przełączający widoki danych bieżących i wykresów.
     int currentSampleCount; //!< Aktualna liczba próbek wyświetlanych na wykresach.
 
     QWidget *visualizationPanelWidget; //!< Główny widget panelu wizualizacji (3D i kompas).
-    QWidget *view3DContainerWidget; //!< Kontener dla widoku 3D modelu płytki.
+    QWidget *view3DContainerWidget; //!< Kontener dla widoku 3D modelu płytki (początkowo pusty, zob. ensure3DView()).
+    bool m_view3DCreated; //!< Czy widok 3D został już utworzony.
     Compass2DRenderer *m_compass2DRenderer; //!< Wskaźnik na widget renderujący kompas 2D.
 
     Qt3DCore::QTransform *boardTransform; //!< Transformacja stosowana do modelu 3D płytki.
+    QQuaternion m_lastRotation; //!< Ostatnia zadana orientacja, stosowana po załadowaniu modelu 3D.
 
     // Wskaźniki do elementów UI dla łatwej aktualizacji w retranslateUi
     QPushButton *m_currentDataButton; //!< Przycisk przełączający na widok danych bieżących.
     QPushButton *m_graphButton; //!< Przycisk przełączający na widok wykresów.
+    QPushButton *m_spectrumButton; //!< Przycisk przełączający na widok widma.
+    QPushButton *m_statisticsButton; //!< Przycisk przełączający na widok statystyk.
+    QPushButton *m_eventsButton; //!< Przycisk przełączający na listę zdarzeń.
     QGroupBox *m_accGroupBox; //!< Grupa UI dla danych akcelerometru.
     QGroupBox *m_gyroGroupBox; //!< Grupa UI dla danych żyroskopu.
     QGroupBox *m_magGroupBox; //!< Grupa UI dla danych magnetometru.
+    QProgressBar *m_magCalibrationBar; //!< Postęp kalibracji magnetometru.
+    float m_magCalibrationCoverage = 0.0f; //!< Ostatnio pokazane pokrycie (do odświeżenia po zmianie języka).
+    bool m_magCalibrated = false; //!< Ostatnio pokazany stan kalibracji.
+    float m_magCalibrationFitError = 0.0f; //!< Ostatnio pokazany błąd dopasowania.
+    QLabel *m_gyroBiasLabel; //!< Stan detektora spoczynku i bias żyroskopu.
+    bool m_gyroStationary = false; //!< Ostatnio pokazany stan detektora spoczynku.
+    bool m_gyroBiasKnown = false; //!< Czy bias został już wyznaczony.
+    bool m_gyroBiasCorrected = false; //!< Czy bias jest odejmowany od odczytów.
+    bool m_rawTraceVisible = false; //!< Czy wykresy pokazują przebiegi surowe.
+    int m_gyroBiasShown[3] = {}; //!< Ostatnio pokazany bias [0,01 dps] - tekst odświeżany tylko po zmianie.
 };
 
 #endif // IMUDATAHANDLER_H
@@ -0,0 +1,293 @@
+/**
+ * @file LatencyTracer.cpp
+ * @brief Implementacja klasy LatencyTracer.
+ * @author Mateusz Wojtaszek
+ * @date 2025-05-28
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include "LatencyTracer.h"
+#include <QCoreApplication>
+#include <QFile>
+#include <QTextStream>
+#include <QDebug>
+#include <atomic>
+#include <array>
+#include <bit>
+#include <chrono>
+
+constexpr int STAGE_COUNT_LT = static_cast<int>(LatencyTracer::Stage::Count);
+constexpr quint64 TRACE_CAPACITY_LT = 1u << 17; // Potęga dwójki - indeks przez maskę
+constexpr quint64 TRACE_INDEX_MASK_LT = TRACE_CAPACITY_LT - 1;
+constexpr int SEQUENCE_GAP_EVENT_LT = -1; // Pole stage zdarzenia luki (nie jest etapem potoku)
+
+namespace {
+/**
+ * @brief Histogram opóźnień jednego etapu oparty na licznikach atomowych.
+ */
+struct StageHistogram {
+    std::array<std::atomic<quint64>, LatencyTracer::HISTOGRAM_BUCKETS> buckets{};
+    std::atomic<quint64> count{0};
+    std::atomic<quint64> sumUs{0};
+    std::atomic<qint64> maxUs{0};
+};
+
+/**
+ * @brief Zdarzenie w buforze cyklicznym (odcinek od poprzedniego etapu ramki).
+ */
+struct TraceEvent {
+    int stage; //!< Etap lub `SEQUENCE_GAP_EVENT_LT`.
+    qint64 startNs;
+    qint64 endNs;
+    quint64 frame; //!< Numer ramki (dla luki - liczba utraconych ramek).
+};
+
+std::array<StageHistogram, STAGE_COUNT_LT> histograms;
+
+// Stan bieżącej ramki (zapisywany w wątku GUI)
+std::atomic<quint64> frameCounter{0};
+std::atomic<qint64> frameOriginNs{0};
+std::atomic<qint64> frameLastMarkNs{0};
+
+// Ramka oczekująca na odrysowanie
+std::atomic<qint64> paintOriginNs{0};
+std::atomic<qint64> paintLastMarkNs{0};
+std::atomic<quint64> paintFrame{0};
+
+std::atomic<bool> traceEnabled{false};
+std::atomic<quint64> traceWriteIndex{0};
+// Przydzielany przy pierwszym włączeniu nagrywania (wątek GUI) i czytany w wątku I/O - publikowany
+// atomowo (release/acquire) i nigdy nie zwalniany, bo zapis może trwać do końca działania programu
+std::atomic<TraceEvent *> traceBuffer{nullptr};
+
+/**
+ * @brief Zwraca indeks kubełka dla opóźnienia w mikrosekundach.
+ */
+int bucketFor(qint64 latencyUs) {
+    if (latencyUs <= 0) {
+        return 0;
+    }
+    const int bucket = std::bit_width(static_cast<quint64>(latencyUs));
+    return qMin(bucket, LatencyTracer::HISTOGRAM_BUCKETS - 1);
+}
+
+void recordLatency(LatencyTracer::Stage stage, qint64 startNs, qint64 endNs, qint64 originNs, quint64 frame) {
+    StageHistogram &histogram = histograms[static_cast<int>(stage)];
+    const qint64 latencyUs = (endNs - originNs) / 1000;
+    histogram.buckets[bucketFor(latencyUs)].fetch_add(1, std::memory_order_relaxed);
+    histogram.count.fetch_add(1, std::memory_order_relaxed);
+    histogram.sumUs.fetch_add(static_cast<quint64>(qMax<qint64>(0, latencyUs)), std::memory_order_relaxed);
+    qint64 previousMax = histogram.maxUs.load(std::memory_order_relaxed);
+    while (latencyUs > previousMax &&
+           !histogram.maxUs.compare_exchange_weak(previousMax, latencyUs, std::memory_order_relaxed)) {
+    }
+
+    if (!traceEnabled.load(std::memory_order_relaxed)) {
+        return;
+    }
+    if (TraceEvent *buffer = traceBuffer.load(std::memory_order_acquire)) {
+        const quint64 index = traceWriteIndex.fetch_add(1, std::memory_order_relaxed) & TRACE_INDEX_MASK_LT;
+        buffer[index] = TraceEvent{static_cast<int>(stage), startNs, endNs, frame};
+    }
+}
+
+/**
+ * @brief Zwraca górną granicę kubełka, w którym mieści się zadany kwantyl.
+ */
+qint64 percentileUs(const std::array<quint64, LatencyTracer::HISTOGRAM_BUCKETS> &buckets, quint64 count,
+                    double quantile) {
+    if (count == 0) {
+        return 0;
+    }
+    const auto target = static_cast<quint64>(quantile * static_cast<double>(count - 1)) + 1;
+    quint64 cumulative = 0;
+    for (int i = 0; i < LatencyTracer::HISTOGRAM_BUCKETS; ++i) {
+        cumulative += buckets[i];
+        if (cumulative >= target) {
+            return i == 0 ? 0 : (qint64{1} << i) - 1;
+        }
+    }
+    return (qint64{1} << (LatencyTracer::HISTOGRAM_BUCKETS - 1)) - 1;
+}
+} // namespace
+
+qint64 LatencyTracer::nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void LatencyTracer::beginFrame(qint64 originNs) {
+    frameCounter.fetch_add(1, std::memory_order_relaxed);
+    frameOriginNs.store(originNs, std::memory_order_relaxed);
+    frameLastMarkNs.store(originNs, std::memory_order_relaxed);
+}
+
+void LatencyTracer::mark(Stage stage) {
+    const qint64 originNs = frameOriginNs.load(std::memory_order_relaxed);
+    if (originNs == 0) {
+        return; // Brak aktywnej ramki
+    }
+    const qint64 now = nowNs();
+    const qint64 startNs = frameLastMarkNs.exchange(now, std::memory_order_relaxed);
+    recordLatency(stage, startNs, now, originNs, frameCounter.load(std::memory_order_relaxed));
+}
+
+qint64 LatencyTracer::markDetached(Stage stage, qint64 originNs, qint64 previousMarkNs) {
+    const qint64 now = nowNs();
+    recordLatency(stage, previousMarkNs, now, originNs, 0);
+    return now;
+}
+
+void LatencyTracer::armPaint() {
+    paintLastMarkNs.store(frameLastMarkNs.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    paintFrame.store(frameCounter.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    paintOriginNs.store(frameOriginNs.load(std::memory_order_relaxed), std::memory_order_release);
+}
+
+void LatencyTracer::markPaint() {
+    const qint64 originNs = paintOriginNs.exchange(0, std::memory_order_acquire);
+    if (originNs == 0) {
+        return; // Odrysowanie bez nowych danych
+    }
+    recordLatency(Stage::Painted, paintLastMarkNs.load(std::memory_order_relaxed), nowNs(), originNs,
+                  paintFrame.load(std::memory_order_relaxed));
+}
+
+void LatencyTracer::markSequenceGap(quint32 lostFrames) {
+    if (!traceEnabled.load(std::memory_order_relaxed)) {
+        return;
+    }
+    TraceEvent *buffer = traceBuffer.load(std::memory_order_acquire);
+    if (!buffer) {
+        return;
+    }
+    const qint64 now = nowNs();
+    const quint64 index = traceWriteIndex.fetch_add(1, std::memory_order_relaxed) & TRACE_INDEX_MASK_LT;
+    buffer[index] = TraceEvent{SEQUENCE_GAP_EVENT_LT, now, now, lostFrames};
+}
+
+LatencyTracer::StageSummary LatencyTracer::summary(Stage stage) {
+    const StageHistogram &histogram = histograms[static_cast<int>(stage)];
+    std::array<quint64, HISTOGRAM_BUCKETS> buckets{};
+    quint64 count = 0;
+    for (int i = 0; i < HISTOGRAM_BUCKETS; ++i) {
+        buckets[i] = histogram.buckets[i].load(std::memory_order_relaxed);
+        count += buckets[i];
+    }
+
+    StageSummary result;
+    result.count = count;
+    if (count > 0) {
+        result.meanUs = static_cast<double>(histogram.sumUs.load(std::memory_order_relaxed)) / count;
+    }
+    result.maxUs = histogram.maxUs.load(std::memory_order_relaxed);
+    result.p50Us = percentileUs(buckets, count, 0.50);
+    result.p99Us = percentileUs(buckets, count, 0.99);
+    return result;
+}
+
+QString LatencyTracer::summaryText() {
+    QString text;
+    for (int i = 0; i < STAGE_COUNT_LT; ++i) {
+        const auto stage = static_cast<Stage>(i);
+        const StageSummary stageSummary = summary(stage);
+        text += QStringLiteral("%1: n=%2, mean=%3 us, p50<=%4 us, p99<=%5 us, max=%6 us\n")
+                .arg(stageName(stage))
+                .arg(stageSummary.count)
+                .arg(stageSummary.meanUs, 0, 'f', 1)
+                .arg(stageSummary.p50Us)
+                .arg(stageSummary.p99Us)
+                .arg(stageSummary.maxUs);
+    }
+    return text;
+}
+
+QString LatencyTracer::stageName(Stage stage) {
+    switch (stage) {
+        case Stage::ReadyRead: return QStringLiteral("readyRead");
+        case Stage::CrcValidated: return QStringLiteral("crcValidated");
+        case Stage::DataReceived: return QStringLiteral("frameReceived");
+        case Stage::ImuProcessing: return QStringLiteral("processImuData");
+        case Stage::ChartsUpdated: return QStringLiteral("chartsUpdated");
+        case Stage::View3DUpdated: return QStringLiteral("view3DUpdated");
+        case Stage::CompassUpdated: return QStringLiteral("compassUpdated");
+        case Stage::Painted: return QStringLiteral("painted");
+        case Stage::Count: break;
+    }
+    return QStringLiteral("unknown");
+}
+
+void LatencyTracer::reset() {
+    for (StageHistogram &histogram: histograms) {
+        for (auto &bucket: histogram.buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        histogram.count.store(0, std::memory_order_relaxed);
+        histogram.sumUs.store(0, std::memory_order_relaxed);
+        histogram.maxUs.store(0, std::memory_order_relaxed);
+    }
+    traceWriteIndex.store(0, std::memory_order_relaxed);
+}
+
+void LatencyTracer::setTraceEnabled(bool enabled) {
+    if (enabled && !traceBuffer.load(std::memory_order_acquire)) {
+        auto *buffer = new TraceEvent[TRACE_CAPACITY_LT]{};
+        TraceEvent *expected = nullptr;
+        if (!traceBuffer.compare_exchange_strong(expected, buffer, std::memory_order_acq_rel)) {
+            delete[] buffer; // Inny wątek opublikował bufor wcześniej
+        }
+    }
+    traceEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool LatencyTracer::isTraceEnabled() {
+    return traceEnabled.load(std::memory_order_relaxed);
+}
+
+bool LatencyTracer::exportChromeTrace(const QString &filePath) {
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        qWarning() << "Failed to open latency trace file:" << filePath << "Error:" << file.errorString();
+        return false;
+    }
+
+    const TraceEvent *buffer = traceBuffer.load(std::memory_order_acquire);
+    const quint64 written = traceWriteIndex.load(std::memory_order_relaxed);
+    const quint64 available = buffer ? qMin(written, TRACE_CAPACITY_LT) : 0;
+    const qint64 pid = QCoreApplication::applicationPid();
+
+    QTextStream out(&file);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << pid
+        << ",\"args\":{\"name\":\"Orienta\"}}";
+    const char *laneNames[] = {"ingest", "pipeline", "paint"};
+    for (int lane = 0; lane < 3; ++lane) {
+        out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":" << lane
+            << ",\"args\":{\"name\":\"" << laneNames[lane] << "\"}}";
+    }
+    for (quint64 i = written - available; i < written; ++i) {
+        const TraceEvent &event = buffer[i & TRACE_INDEX_MASK_LT];
+        if (event.stage == SEQUENCE_GAP_EVENT_LT) {
+            // Zdarzenie chwilowe "i" o zasięgu procesu - widoczne jako pionowa linia nad wszystkimi ścieżkami
+            out << ",\n{\"name\":\"sequenceGap\",\"cat\":\"link\",\"ph\":\"i\",\"s\":\"p\",\"pid\":" << pid
+                << ",\"tid\":0,\"ts\":" << QString::number(event.startNs / 1000.0, 'f', 3)
+                << ",\"args\":{\"lost\":" << event.frame << "}}";
+            continue;
+        }
+        // Osobne ścieżki, aby odcinki poprawnie się zagnieżdżały: oczekiwanie w porcji danych
+        // (wiele linii z jednego readyRead), przetwarzanie ramki oraz odrysowanie
+        const auto stage = static_cast<Stage>(event.stage);
+        const int lane = stage == Stage::ReadyRead ? 0 : (stage == Stage::Painted ? 2 : 1);
+        // Zdarzenia "X" (complete) - znaczniki czasu i czasy trwania w mikrosekundach
+        out << ",\n{\"name\":\"" << stageName(stage)
+            << "\",\"cat\":\"pipeline\",\"ph\":\"X\",\"pid\":" << pid << ",\"tid\":" << lane
+            << ",\"ts\":" << QString::number(event.startNs / 1000.0, 'f', 3)
+            << ",\"dur\":" << QString::number((event.endNs - event.startNs) / 1000.0, 'f', 3)
+            << ",\"args\":{\"frame\":" << event.frame << "}}";
+    }
+    out << "\n]}\n";
+    out.flush();
+    qInfo() << "Exported" << available << "latency trace events to" << filePath;
+    return out.status() == QTextStream::Ok;
+}
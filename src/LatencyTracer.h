@@ -0,0 +1,163 @@
+#ifndef LATENCYTRACER_H
+#define LATENCYTRACER_H
+
+/**
+ * @file LatencyTracer.h
+ * @brief Definicja klasy LatencyTracer, mierzącej opóźnienie potoku od odbioru bajtów do odrysowania.
+ * @author Mateusz Wojtaszek
+ * @date 2025-05-28
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include <QtGlobal>
+#include <QString>
+
+/**
+ * @class LatencyTracer
+ * @brief Zbiór funkcji statycznych do śledzenia opóźnień kolejnych etapów przetwarzania ramki.
+ *
+ * @details
+ * Każda ramka ma znacznik początku (monotoniczny czas odbioru ramki `SensorFrame::hostTimestampNs`,
+ * interpolowany wewnątrz porcji danych z `readyRead`, lub tyknięcia timera symulacji). Wywołania `mark()` w kolejnych etapach zapisują
+ * opóźnienie względem tego początku do histogramu etapu. Histogramy (kubełki potęg dwójki
+ * w mikrosekundach) są licznikami atomowymi, więc ich aktualizacja nie wymaga blokad.
+ *
+ * Po włączeniu nagrywania (`setTraceEnabled()`) zdarzenia trafiają dodatkowo do bufora
+ * cyklicznego i mogą być wyeksportowane w formacie Chrome trace-event JSON
+ * (do otwarcia w Perfetto lub `chrome://tracing`). Każde zdarzenie obejmuje odcinek
+ * od poprzedniego etapu tej samej ramki do bieżącego.
+ *
+ * Etap `Painted` dotyczy najnowszej ramki, która zdążyła zmienić stan widoku przed
+ * najbliższym odrysowaniem - ramki pośrednie są pomijane, bo nigdy nie trafiły na ekran.
+ *
+ * @note Ramki (`beginFrame()`/`mark()`) są znakowane w wątku GUI; etapy źródeł danych działających
+ * w wątku I/O zapisuje `markDetached()`. Histogramy można bezpiecznie odczytywać z dowolnego wątku.
+ */
+class LatencyTracer {
+public:
+    /**
+     * @enum Stage
+     * @brief Etapy potoku, dla których mierzone jest opóźnienie od początku ramki.
+     */
+    enum class Stage : int {
+        ReadyRead, //!< Wyodrębnienie linii z porcji danych odebranej w `readyRead`.
+        CrcValidated, //!< Pozytywna weryfikacja CRC w `FrameSource::ingest()`.
+        DataReceived, //!< Odbiór sygnału `frameReceived` w `MainWindow`.
+        ImuProcessing, //!< Początek `MainWindow::processImuData()`.
+        ChartsUpdated, //!< Aktualizacja pasków i wykresów.
+        View3DUpdated, //!< Aktualizacja obrotu modelu 3D.
+        CompassUpdated, //!< Aktualizacja kursu kompasu.
+        Painted, //!< Zakończenie najbliższego odrysowania kompasu.
+        Count //!< Liczba etapów (nie jest etapem).
+    };
+
+    static constexpr int HISTOGRAM_BUCKETS = 32; //!< Kubełek i obejmuje opóźnienia [2^(i-1), 2^i) µs.
+
+    /**
+     * @struct StageSummary
+     * @brief Podsumowanie histogramu jednego etapu.
+     */
+    struct StageSummary {
+        quint64 count = 0; //!< Liczba pomiarów.
+        double meanUs = 0.0; //!< Średnie opóźnienie [µs].
+        qint64 maxUs = 0; //!< Największe opóźnienie [µs].
+        qint64 p50Us = 0; //!< Mediana (górna granica kubełka) [µs].
+        qint64 p99Us = 0; //!< 99. percentyl (górna granica kubełka) [µs].
+    };
+
+    /**
+     * @brief Zwraca bieżący czas monotoniczny.
+     * @return Czas w nanosekundach od nieokreślonego punktu odniesienia.
+     */
+    static qint64 nowNs();
+
+    /**
+     * @brief Rozpoczyna nową ramkę.
+     * @param originNs [in] Czas początku ramki w skali `nowNs()` (np. czas odbioru ramki).
+     */
+    static void beginFrame(qint64 originNs);
+
+    /**
+     * @brief Zapisuje opóźnienie etapu bieżącej ramki.
+     * @param stage [in] Etap potoku.
+     */
+    static void mark(Stage stage);
+
+    /**
+     * @brief Zapisuje opóźnienie etapu ramki niezależnie od bieżącej ramki (bezpieczne w dowolnym wątku).
+     * @details Używane przez źródła danych działające poza wątkiem GUI, gdzie `beginFrame()`/`mark()`
+     * kolidowałyby z ramkami przetwarzanymi równolegle w GUI.
+     * @param stage [in] Etap potoku.
+     * @param originNs [in] Czas początku ramki.
+     * @param previousMarkNs [in] Czas poprzedniego etapu tej ramki (początek odcinka w eksporcie).
+     * @return Bieżący czas (do przekazania jako `previousMarkNs` kolejnego etapu).
+     */
+    static qint64 markDetached(Stage stage, qint64 originNs, qint64 previousMarkNs);
+
+    /**
+     * @brief Oznacza bieżącą ramkę jako oczekującą na odrysowanie.
+     */
+    static void armPaint();
+
+    /**
+     * @brief Zapisuje etap `Painted` dla ramki oczekującej na odrysowanie (jeśli jest).
+     */
+    static void markPaint();
+
+    /**
+     * @brief Zapisuje w buforze zdarzeń lukę w numerach sekwencyjnych ramek.
+     * @details W eksporcie luka jest zdarzeniem chwilowym na ścieżce `ingest` z liczbą utraconych ramek,
+     * dzięki czemu skoki opóźnień można zestawić ze stratami na łączu. Bez nagrywania nic nie robi.
+     * @param lostFrames [in] Liczba brakujących ramek.
+     */
+    static void markSequenceGap(quint32 lostFrames);
+
+    /**
+     * @brief Zwraca podsumowanie histogramu etapu.
+     * @param stage [in] Etap potoku.
+     * @return Liczba pomiarów, średnia, maksimum i percentyle.
+     */
+    static StageSummary summary(Stage stage);
+
+    /**
+     * @brief Zwraca czytelne podsumowanie wszystkich etapów (jeden etap w wierszu).
+     */
+    static QString summaryText();
+
+    /**
+     * @brief Zwraca nazwę etapu używaną w raportach i eksporcie.
+     * @param stage [in] Etap potoku.
+     */
+    static QString stageName(Stage stage);
+
+    /**
+     * @brief Zeruje histogramy i bufor zdarzeń.
+     */
+    static void reset();
+
+    /**
+     * @brief Włącza lub wyłącza nagrywanie zdarzeń do bufora cyklicznego.
+     * @details Bufor jest przydzielany przy pierwszym włączeniu i zachowywany do końca działania
+     * programu, więc wątek I/O może do niego zapisywać bez blokad.
+     * @param enabled [in] `true`, aby nagrywać zdarzenia.
+     */
+    static void setTraceEnabled(bool enabled);
+
+    /**
+     * @brief Informuje, czy nagrywanie zdarzeń jest włączone.
+     */
+    static bool isTraceEnabled();
+
+    /**
+     * @brief Zapisuje nagrane zdarzenia w formacie Chrome trace-event JSON.
+     * @param filePath [in] Ścieżka pliku wynikowego.
+     * @return `true`, jeśli plik został zapisany.
+     */
+    static bool exportChromeTrace(const QString &filePath);
+
+private:
+    LatencyTracer() = delete;
+};
+
+#endif // LATENCYTRACER_H
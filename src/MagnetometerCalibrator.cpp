@@ -0,0 +1,404 @@
+/**
+ * @file MagnetometerCalibrator.cpp
+ * @brief Implementacja klasy MagnetometerCalibrator.
+ * @details Po rozwiązaniu równań normalnych kwadryka `x'Ax + 2b'x = 1` jest sprowadzana do postaci
+ * środkowej: środek `c = -A⁻¹b`, `(x - c)'M(x - c) = 1`, gdzie `M = A / (1 + c'Ac)`. Macierz korekcji
+ * to `W = R * sqrt(M)` (pierwiastek z rozkładu własnego), a `R` - średnia geometryczna półosi,
+ * dzięki czemu skorygowane odczyty zachowują jednostki i przybliżone natężenie pola.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-12
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include "MagnetometerCalibrator.h"
+#include <QSettings>
+#include <QUrl>
+#include <QVariantList>
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <utility>
+
+constexpr int UNKNOWNS_MC = 9; // a, b, c, f, g, h, p, q, r
+constexpr float MIN_STEP_RATIO_MC = 0.02f; // Próbka bliższa poprzedniej niż 2% normy jest pomijana
+constexpr float MIN_NORM_MC = 1.0e-6f; // Zerowy odczyt - brak magnetometru
+constexpr double PIVOT_EPSILON_MC = 1.0e-12; // Względny próg osobliwości układu
+constexpr double MAX_AXIS_RATIO_MC = 2.5; // Bardziej spłaszczona "elipsoida" to błędne dopasowanie
+constexpr int JACOBI_SWEEPS_MC = 32;
+constexpr int AZIMUTH_SECTORS_MC = 8;
+constexpr int ELEVATION_BANDS_MC = MagnetometerCalibrator::COVERAGE_BINS / AZIMUTH_SECTORS_MC;
+const QString SETTINGS_GROUP_MC = QStringLiteral("magCalibration/devices/");
+
+namespace {
+/**
+ * @brief Rozkład własny macierzy symetrycznej 3x3 metodą Jacobiego.
+ * @param matrix [in,out] Macierz (wierszami); po wywołaniu na przekątnej są wartości własne.
+ * @param vectors [out] Wektory własne w kolumnach.
+ */
+void jacobiEigen(double matrix[3][3], double vectors[3][3]) {
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            vectors[i][j] = i == j ? 1.0 : 0.0;
+        }
+    }
+    for (int sweep = 0; sweep < JACOBI_SWEEPS_MC; ++sweep) {
+        const double offDiagonal = std::abs(matrix[0][1]) + std::abs(matrix[0][2]) + std::abs(matrix[1][2]);
+        if (offDiagonal < 1.0e-15) {
+            return;
+        }
+        for (int p = 0; p < 2; ++p) {
+            for (int q = p + 1; q < 3; ++q) {
+                if (std::abs(matrix[p][q]) < 1.0e-300) {
+                    continue;
+                }
+                // Obrót zerujący element (p, q)
+                const double theta = (matrix[q][q] - matrix[p][p]) / (2.0 * matrix[p][q]);
+                const double t = (theta >= 0.0 ? 1.0 : -1.0) / (std::abs(theta) + std::sqrt(theta * theta + 1.0));
+                const double c = 1.0 / std::sqrt(t * t + 1.0);
+                const double s = t * c;
+                for (int k = 0; k < 3; ++k) {
+                    const double kp = matrix[k][p];
+                    const double kq = matrix[k][q];
+                    matrix[k][p] = c * kp - s * kq;
+                    matrix[k][q] = s * kp + c * kq;
+                }
+                for (int k = 0; k < 3; ++k) {
+                    const double pk = matrix[p][k];
+                    const double qk = matrix[q][k];
+                    matrix[p][k] = c * pk - s * qk;
+                    matrix[q][k] = s * pk + c * qk;
+                }
+                for (int k = 0; k < 3; ++k) {
+                    const double kp = vectors[k][p];
+                    const double kq = vectors[k][q];
+                    vectors[k][p] = c * kp - s * kq;
+                    vectors[k][q] = s * kp + c * kq;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Rozwiązuje układ `matrix * x = rhs` (eliminacja Gaussa z częściowym wyborem elementu głównego).
+ * @return `false` dla układu (prawie) osobliwego.
+ */
+bool solveLinear(double matrix[UNKNOWNS_MC][UNKNOWNS_MC], double rhs[UNKNOWNS_MC], double solution[UNKNOWNS_MC]) {
+    double maxDiagonal = 0.0;
+    for (int i = 0; i < UNKNOWNS_MC; ++i) {
+        maxDiagonal = qMax(maxDiagonal, std::abs(matrix[i][i]));
+    }
+    const double tolerance = PIVOT_EPSILON_MC * qMax(maxDiagonal, 1.0e-300);
+    for (int column = 0; column < UNKNOWNS_MC; ++column) {
+        int pivot = column;
+        for (int row = column + 1; row < UNKNOWNS_MC; ++row) {
+            if (std::abs(matrix[row][column]) > std::abs(matrix[pivot][column])) {
+                pivot = row;
+            }
+        }
+        if (std::abs(matrix[pivot][column]) < tolerance) {
+            return false;
+        }
+        if (pivot != column) {
+            for (int k = 0; k < UNKNOWNS_MC; ++k) {
+                std::swap(matrix[pivot][k], matrix[column][k]);
+            }
+            std::swap(rhs[pivot], rhs[column]);
+        }
+        for (int row = column + 1; row < UNKNOWNS_MC; ++row) {
+            const double factor = matrix[row][column] / matrix[column][column];
+            for (int k = column; k < UNKNOWNS_MC; ++k) {
+                matrix[row][k] -= factor * matrix[column][k];
+            }
+            rhs[row] -= factor * rhs[column];
+        }
+    }
+    for (int row = UNKNOWNS_MC - 1; row >= 0; --row) {
+        double value = rhs[row];
+        for (int k = row + 1; k < UNKNOWNS_MC; ++k) {
+            value -= matrix[row][k] * solution[k];
+        }
+        solution[row] = value / matrix[row][row];
+    }
+    return true;
+}
+
+/**
+ * @brief Zamienia listę liczb z QSettings na tablicę; `false`, gdy liczba elementów się nie zgadza.
+ */
+bool toFloats(const QVariant &value, float *target, int count) {
+    const QVariantList list = value.toList();
+    if (list.size() != count) {
+        return false;
+    }
+    for (int i = 0; i < count; ++i) {
+        target[i] = list[i].toFloat();
+    }
+    return true;
+}
+
+/**
+ * @brief Zamienia tablicę na listę do zapisu w QSettings.
+ */
+QVariantList fromFloats(const float *source, int count) {
+    QVariantList list;
+    list.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        list.append(source[i]);
+    }
+    return list;
+}
+} // namespace
+
+void MagnetometerCalibrator::addSample(float mx, float my, float mz) {
+    const float normSquared = mx * mx + my * my + mz * mz;
+    if (!std::isfinite(normSquared) || normSquared < MIN_NORM_MC) {
+        return;
+    }
+    if (m_sampleCount > 0) {
+        const float dx = mx - m_last[0];
+        const float dy = my - m_last[1];
+        const float dz = mz - m_last[2];
+        const float lastNormSquared = m_last[0] * m_last[0] + m_last[1] * m_last[1] + m_last[2] * m_last[2];
+        if (dx * dx + dy * dy + dz * dz < MIN_STEP_RATIO_MC * MIN_STEP_RATIO_MC * lastNormSquared) {
+            return;
+        }
+    } else if (m_scale == 0.0) {
+        m_scale = 1.0 / std::sqrt(static_cast<double>(normSquared));
+    }
+    m_last[0] = mx;
+    m_last[1] = my;
+    m_last[2] = mz;
+
+    const double x = mx * m_scale;
+    const double y = my * m_scale;
+    const double z = mz * m_scale;
+    const double d[UNKNOWNS_MC] = {x * x, y * y, z * z, 2.0 * y * z, 2.0 * x * z, 2.0 * x * y, 2.0 * x, 2.0 * y, 2.0 * z};
+    int index = 0;
+    for (int i = 0; i < UNKNOWNS_MC; ++i) {
+        for (int j = i; j < UNKNOWNS_MC; ++j) {
+            m_normal[index++] += d[i] * d[j];
+        }
+        m_rhs[i] += d[i];
+    }
+    m_sum[0] += x;
+    m_sum[1] += y;
+    m_sum[2] += z;
+    ++m_sampleCount;
+    markCoverage(x, y, z);
+}
+
+void MagnetometerCalibrator::markCoverage(double x, double y, double z) {
+    double cx = m_sum[0] / m_sampleCount;
+    double cy = m_sum[1] / m_sampleCount;
+    double cz = m_sum[2] / m_sampleCount;
+    if (m_calibration.isValid()) {
+        cx = m_calibration.offset[0] * m_scale;
+        cy = m_calibration.offset[1] * m_scale;
+        cz = m_calibration.offset[2] * m_scale;
+    }
+    const double vx = x - cx;
+    const double vy = y - cy;
+    const double vz = z - cz;
+    const double norm = std::sqrt(vx * vx + vy * vy + vz * vz);
+    if (norm < 1.0e-9) {
+        return;
+    }
+    const int sector = qBound(0, static_cast<int>((std::atan2(vy, vx) + M_PI) / (2.0 * M_PI) * AZIMUTH_SECTORS_MC),
+                              AZIMUTH_SECTORS_MC - 1);
+    // Pasy o równej powierzchni: równe przedziały składowej pionowej
+    const int band = qBound(0, static_cast<int>((vz / norm + 1.0) * 0.5 * ELEVATION_BANDS_MC), ELEVATION_BANDS_MC - 1);
+    m_coverageMask |= 1u << (band * AZIMUTH_SECTORS_MC + sector);
+}
+
+float MagnetometerCalibrator::coverage() const {
+    int visited = 0;
+    for (quint32 mask = m_coverageMask; mask != 0; mask &= mask - 1) {
+        ++visited;
+    }
+    return static_cast<float>(visited) / COVERAGE_BINS;
+}
+
+bool MagnetometerCalibrator::solveIfDue() {
+    if (m_sampleCount < m_nextSolveCount) {
+        return false;
+    }
+    m_nextSolveCount = m_sampleCount + SOLVE_INTERVAL;
+    const float sessionCoverage = coverage();
+    if (sessionCoverage < ACCEPT_COVERAGE) {
+        return false; // Zbyt mało kierunków - elipsoida byłaby słabo określona
+    }
+    Calibration candidate;
+    if (!fitEllipsoid(candidate)) {
+        return false;
+    }
+    candidate.coverage = sessionCoverage;
+    // Zapisana kalibracja z pełniejszym pokryciem ustępuje tylko lepiej dopasowanej
+    if (m_calibration.isValid() && candidate.coverage < m_calibration.coverage &&
+        candidate.fitError > m_calibration.fitError) {
+        return false;
+    }
+    m_calibration = candidate;
+    return true;
+}
+
+bool MagnetometerCalibrator::fitEllipsoid(Calibration &result) const {
+    double normal[UNKNOWNS_MC][UNKNOWNS_MC];
+    double rhs[UNKNOWNS_MC];
+    int index = 0;
+    for (int i = 0; i < UNKNOWNS_MC; ++i) {
+        for (int j = i; j < UNKNOWNS_MC; ++j) {
+            normal[i][j] = normal[j][i] = m_normal[index++];
+        }
+        rhs[i] = m_rhs[i];
+    }
+    double v[UNKNOWNS_MC];
+    if (!solveLinear(normal, rhs, v)) {
+        return false;
+    }
+
+    // Kwadryka: A = [[a, h, g], [h, b, f], [g, f, c]], b = [p, q, r]
+    const double a[3][3] = {{v[0], v[5], v[4]}, {v[5], v[1], v[3]}, {v[4], v[3], v[2]}};
+    const double det = a[0][0] * (a[1][1] * a[2][2] - a[1][2] * a[2][1]) -
+                       a[0][1] * (a[1][0] * a[2][2] - a[1][2] * a[2][0]) +
+                       a[0][2] * (a[1][0] * a[2][1] - a[1][1] * a[2][0]);
+    if (std::abs(det) < 1.0e-300) {
+        return false;
+    }
+    const double inverse[3][3] = {
+        {(a[1][1] * a[2][2] - a[1][2] * a[2][1]) / det, (a[0][2] * a[2][1] - a[0][1] * a[2][2]) / det,
+         (a[0][1] * a[1][2] - a[0][2] * a[1][1]) / det},
+        {(a[1][2] * a[2][0] - a[1][0] * a[2][2]) / det, (a[0][0] * a[2][2] - a[0][2] * a[2][0]) / det,
+         (a[0][2] * a[1][0] - a[0][0] * a[1][2]) / det},
+        {(a[1][0] * a[2][1] - a[1][1] * a[2][0]) / det, (a[0][1] * a[2][0] - a[0][0] * a[2][1]) / det,
+         (a[0][0] * a[1][1] - a[0][1] * a[1][0]) / det}};
+    double center[3];
+    for (int i = 0; i < 3; ++i) {
+        center[i] = -(inverse[i][0] * v[6] + inverse[i][1] * v[7] + inverse[i][2] * v[8]);
+    }
+    double k = 1.0;
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            k += center[i] * a[i][j] * center[j];
+        }
+    }
+    if (k <= 0.0) {
+        return false;
+    }
+
+    double m[3][3];
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            m[i][j] = a[i][j] / k;
+        }
+    }
+    double eigenvectors[3][3];
+    jacobiEigen(m, eigenvectors);
+    double minRadius = 0.0;
+    double maxRadius = 0.0;
+    double radiusProduct = 1.0;
+    double sqrtEigen[3];
+    for (int i = 0; i < 3; ++i) {
+        if (m[i][i] <= 0.0) {
+            return false; // Hiperboloida - próbki nie leżą na elipsoidzie
+        }
+        sqrtEigen[i] = std::sqrt(m[i][i]);
+        const double radius = 1.0 / sqrtEigen[i];
+        minRadius = i == 0 ? radius : qMin(minRadius, radius);
+        maxRadius = qMax(maxRadius, radius);
+        radiusProduct *= radius;
+    }
+    if (maxRadius > MAX_AXIS_RATIO_MC * minRadius) {
+        return false;
+    }
+    const double fieldRadius = std::cbrt(radiusProduct);
+
+    for (int i = 0; i < 3; ++i) {
+        result.offset[i] = static_cast<float>(center[i] / m_scale);
+        for (int j = 0; j < 3; ++j) {
+            double value = 0.0;
+            for (int e = 0; e < 3; ++e) {
+                value += eigenvectors[i][e] * sqrtEigen[e] * eigenvectors[j][e];
+            }
+            result.softIron[i * 3 + j] = static_cast<float>(fieldRadius * value);
+        }
+    }
+    result.fieldStrength = static_cast<float>(fieldRadius / m_scale);
+
+    // Suma kwadratów residuów d'v - 1 ze statystyk: v'(D'D)v - 2v'(D'1) + N
+    double quadratic = 0.0;
+    double linear = 0.0;
+    index = 0;
+    for (int i = 0; i < UNKNOWNS_MC; ++i) {
+        for (int j = i; j < UNKNOWNS_MC; ++j) {
+            quadratic += (i == j ? 1.0 : 2.0) * v[i] * m_normal[index++] * v[j];
+        }
+        linear += v[i] * m_rhs[i];
+    }
+    const double residual = qMax(0.0, quadratic - 2.0 * linear + static_cast<double>(m_sampleCount));
+    // d'v - 1 = k * ((r / R)² - 1) ≈ 2k * (r - R) / R
+    result.fitError = static_cast<float>(0.5 * std::sqrt(residual / m_sampleCount) / k);
+    return true;
+}
+
+void MagnetometerCalibrator::apply(float *mag) const {
+    if (!m_calibration.isValid()) {
+        return;
+    }
+    const float dx = mag[0] - m_calibration.offset[0];
+    const float dy = mag[1] - m_calibration.offset[1];
+    const float dz = mag[2] - m_calibration.offset[2];
+    const float *w = m_calibration.softIron;
+    mag[0] = w[0] * dx + w[1] * dy + w[2] * dz;
+    mag[1] = w[3] * dx + w[4] * dy + w[5] * dz;
+    mag[2] = w[6] * dx + w[7] * dy + w[8] * dz;
+}
+
+void MagnetometerCalibrator::resetStatistics() {
+    std::fill(std::begin(m_normal), std::end(m_normal), 0.0);
+    std::fill(std::begin(m_rhs), std::end(m_rhs), 0.0);
+    std::fill(std::begin(m_sum), std::end(m_sum), 0.0);
+    std::fill(std::begin(m_last), std::end(m_last), 0.0f);
+    m_scale = 0.0;
+    m_sampleCount = 0;
+    m_nextSolveCount = SOLVE_INTERVAL;
+    m_coverageMask = 0;
+}
+
+void MagnetometerCalibrator::reset() {
+    resetStatistics();
+    m_calibration = Calibration();
+}
+
+bool MagnetometerCalibrator::loadSettings(const QString &deviceKey) {
+    reset();
+    QSettings settings;
+    settings.beginGroup(SETTINGS_GROUP_MC + QString::fromLatin1(QUrl::toPercentEncoding(deviceKey)));
+    Calibration loaded;
+    loaded.fieldStrength = settings.value(QStringLiteral("fieldStrength"), 0.0f).toFloat();
+    loaded.fitError = settings.value(QStringLiteral("fitError"), 0.0f).toFloat();
+    loaded.coverage = settings.value(QStringLiteral("coverage"), 0.0f).toFloat();
+    if (!toFloats(settings.value(QStringLiteral("offset")), loaded.offset, 3) ||
+        !toFloats(settings.value(QStringLiteral("softIron")), loaded.softIron, 9) || !loaded.isValid()) {
+        return false;
+    }
+    m_calibration = loaded;
+    return true;
+}
+
+void MagnetometerCalibrator::saveSettings(const QString &deviceKey) const {
+    QSettings settings;
+    const QString group = SETTINGS_GROUP_MC + QString::fromLatin1(QUrl::toPercentEncoding(deviceKey));
+    if (!m_calibration.isValid()) {
+        settings.remove(group);
+        return;
+    }
+    settings.beginGroup(group);
+    settings.setValue(QStringLiteral("offset"), fromFloats(m_calibration.offset, 3));
+    settings.setValue(QStringLiteral("softIron"), fromFloats(m_calibration.softIron, 9));
+    settings.setValue(QStringLiteral("fieldStrength"), m_calibration.fieldStrength);
+    settings.setValue(QStringLiteral("fitError"), m_calibration.fitError);
+    settings.setValue(QStringLiteral("coverage"), m_calibration.coverage);
+}
@@ -0,0 +1,128 @@
+#ifndef MAGNETOMETERCALIBRATOR_H
+#define MAGNETOMETERCALIBRATOR_H
+
+/**
+ * @file MagnetometerCalibrator.h
+ * @brief Definicja klasy MagnetometerCalibrator - kalibracja magnetometru (hard/soft iron) dopasowaniem elipsoidy na bieżąco.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-12
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include <QString>
+#include <QtGlobal>
+
+/**
+ * @class MagnetometerCalibrator
+ * @brief Dopasowuje elipsoidę do odczytów magnetometru i koryguje je do sfery o środku w zerze.
+ *
+ * @details
+ * Pole Ziemi mierzone przy obracaniu czujnika leży na sferze; stałe pole płytki (hard iron)
+ * przesuwa jej środek, a materiały ferromagnetyczne (soft iron) zamieniają ją w elipsoidę.
+ * Kalibrator dopasowuje kwadrykę `x'Ax + 2b'x = 1` metodą najmniejszych kwadratów:
+ * - `addSample()` dodaje próbkę do macierzy równań normalnych (statystyki dostateczne) - koszt O(1),
+ *   bez przechowywania próbek; próbki prawie równe poprzedniej (czujnik w spoczynku) są pomijane,
+ *   aby nie przeważyły dopasowania,
+ * - `solveIfDue()` co `SOLVE_INTERVAL` przyjętych próbek rozwiązuje układ 9x9 i wyznacza przesunięcie
+ *   oraz macierz korekcji `W`: `skorygowany = W * (surowy - przesunięcie)`.
+ *
+ * Postęp to pokrycie kierunków (`COVERAGE_BINS` wycinków sfery widzianych ze środka pomiarów);
+ * nowe dopasowanie zastępuje bieżące dopiero przy wystarczającym pokryciu. Kalibracja jest zapisywana
+ * w QSettings osobno dla każdego urządzenia (`saveSettings()`, `loadSettings()`).
+ */
+class MagnetometerCalibrator {
+public:
+    static constexpr int COVERAGE_BINS = 32; //!< Wycinki sfery: 8 sektorów azymutu x 4 pasy wysokości.
+    static constexpr int SOLVE_INTERVAL = 100; //!< Co ile przyjętych próbek rozwiązywany jest układ równań.
+    static constexpr float ACCEPT_COVERAGE = 0.75f; //!< Pokrycie wystarczające do zastąpienia kalibracji.
+
+    /**
+     * @struct Calibration
+     * @brief Wynik kalibracji w jednostkach magnetometru.
+     */
+    struct Calibration {
+        float offset[3] = {0.0f, 0.0f, 0.0f}; //!< Przesunięcie (hard iron).
+        float softIron[9] = {1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f}; //!< Macierz `W` (wierszami).
+        float fieldStrength = 0.0f; //!< Promień sfery po korekcji (natężenie pola); 0 - brak kalibracji.
+        float fitError = 0.0f; //!< Względny błąd RMS promienia dopasowania.
+        float coverage = 0.0f; //!< Pokrycie kierunków [0, 1] przy dopasowaniu.
+
+        /** @brief Informuje, czy kalibracja została wyznaczona. */
+        bool isValid() const { return fieldStrength > 0.0f; }
+    };
+
+    /**
+     * @brief Dodaje próbkę do statystyk dopasowania.
+     * @param mx [in] Surowy odczyt X.
+     * @param my [in] Surowy odczyt Y.
+     * @param mz [in] Surowy odczyt Z.
+     */
+    void addSample(float mx, float my, float mz);
+
+    /**
+     * @brief Rozwiązuje układ równań, jeśli od ostatniej próby przybyło `SOLVE_INTERVAL` próbek.
+     * @return `true`, jeśli nowa kalibracja zastąpiła bieżącą (warto ją zapisać).
+     */
+    bool solveIfDue();
+
+    /**
+     * @brief Koryguje odczyt bieżącą kalibracją (bez kalibracji nic nie zmienia).
+     * @param mag [in,out] Trzy wartości magnetometru (X, Y, Z).
+     */
+    void apply(float *mag) const;
+
+    /** @brief Zeruje statystyki i pokrycie bieżącej sesji (kalibracja pozostaje). */
+    void resetStatistics();
+
+    /** @brief Zeruje statystyki i kalibrację. */
+    void reset();
+
+    /** @brief Zwraca bieżącą kalibrację. */
+    const Calibration &calibration() const { return m_calibration; }
+
+    /** @brief Zwraca pokrycie kierunków bieżącej sesji [0, 1]. */
+    float coverage() const;
+
+    /** @brief Zwraca liczbę próbek przyjętych w bieżącej sesji. */
+    qint64 sampleCount() const { return m_sampleCount; }
+
+    /**
+     * @brief Wczytuje kalibrację urządzenia z QSettings i zeruje statystyki sesji.
+     * @param deviceKey [in] Trwały identyfikator urządzenia (np. nazwa portu).
+     * @return `true`, jeśli zapisana kalibracja istniała.
+     */
+    bool loadSettings(const QString &deviceKey);
+
+    /**
+     * @brief Zapisuje bieżącą kalibrację urządzenia w QSettings (bez kalibracji - usuwa wpis).
+     * @param deviceKey [in] Trwały identyfikator urządzenia.
+     */
+    void saveSettings(const QString &deviceKey) const;
+
+private:
+    /**
+     * @brief Dopasowuje elipsoidę do zebranych statystyk.
+     * @param result [out] Kalibracja (w jednostkach magnetometru).
+     * @return `false`, gdy układ jest osobliwy lub wynik nie jest elipsoidą.
+     */
+    bool fitEllipsoid(Calibration &result) const;
+
+    /** @brief Zaznacza wycinek sfery, w którym leży próbka (względem środka pomiarów). */
+    void markCoverage(double x, double y, double z);
+
+    Calibration m_calibration; //!< Bieżąca kalibracja.
+
+    // Statystyki dostateczne: górny trójkąt D'D (9x9) i D'1 dla wektorów
+    // d = [x², y², z², 2yz, 2xz, 2xy, 2x, 2y, 2z] w skali m_scale
+    double m_normal[45] = {}; //!< Górny trójkąt macierzy D'D (wierszami).
+    double m_rhs[9] = {}; //!< Wektor D'1.
+    double m_sum[3] = {}; //!< Suma próbek (środek do wyznaczania pokrycia przed pierwszym dopasowaniem).
+    double m_scale = 0.0; //!< Skala próbek (odwrotność normy pierwszej próbki) - uwarunkowanie układu.
+    float m_last[3] = {}; //!< Ostatnia przyjęta próbka (surowa).
+    qint64 m_sampleCount = 0; //!< Liczba przyjętych próbek.
+    qint64 m_nextSolveCount = SOLVE_INTERVAL; //!< Liczba próbek, przy której nastąpi kolejna próba dopasowania.
+    quint32 m_coverageMask = 0; //!< Odwiedzone wycinki sfery.
+};
+
+#endif // MAGNETOMETERCALIBRATOR_H
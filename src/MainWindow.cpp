@@ -9,23 +9,41 @@
 #include "MainWindow.h"
 #include "ImuDataHandler.h"
 #include "GpsDataHandler.h"
-#include "SerialPortHandler.h"
+#include "DeviceManager.h"
+#include "LatencyTracer.h"
+#include "PerfCounters.h"
+#include "PerfHud.h"
+#include "SimdSupport.h"
+#include "FilterSettingsDialog.h"
+#include "AllanDeviationDialog.h"
 
 #include <QApplication>
 #include <QMenuBar>
 #include <QMenu>
 #include <QAction>
 #include <QStackedWidget>
+#include <QStatusBar>
+#include <QActionGroup>
 #include <QMessageBox>
 #include <QFile>
 #include <QTextStream>
 #include <QDebug>
 #include <QSerialPortInfo>
 #include <QInputDialog>
+#include <QLineEdit>
+#include <QFileDialog>
 #include <QTranslator>
 #include <QTimer>
+#include <QThread>
+#include <QEventLoop>
+#include <QProgressDialog>
+#include <QFileInfo>
+#include <QSettings>
 #include <QVector>
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <utility>
 #ifndef M_PI
     #define M_PI 3.14159265358979323846
 #endif
@@ -34,25 +52,13 @@
 const QString SIMULATION_DATA_FILE_PATH_MW = "/Users/mateuszwojtaszek/projekty/wds_Orienta/simulation_data3.log";
 const QString POLISH_TRANSLATION_FILE_MW = "/Users/mateuszwojtaszek/projekty/wds_Orienta/translations/wds_OrientaPL.qm";
 
-constexpr int SIMULATION_TIMER_INTERVAL_MS_MW = 10; // ms
+constexpr int SIMULATION_TIMER_INTERVAL_MS_MW = 10; // ms, krok odtwarzania plików bez kolumny czasu
+constexpr int TIMED_DATA_SIZE_SIM_FILE_MW = 13; // 12 wartości IMU + czas odbioru [ms]
+constexpr qint64 NS_PER_MS_MW = 1000000;
 
 // Oczekiwana liczba wartości w pliku symulacyjnym (tylko IMU)
 constexpr int EXPECTED_DATA_SIZE_SIM_FILE_MW = 12;
 
-// Indeksy dla danych IMU (wspólne dla pliku symulacyjnego i części IMU z portu)
-constexpr int GYRO_X_IDX_MW = 0;
-constexpr int GYRO_Y_IDX_MW = 1;
-constexpr int GYRO_Z_IDX_MW = 2;
-constexpr int ACC_X_IDX_MW = 3;
-constexpr int ACC_Y_IDX_MW = 4;
-constexpr int ACC_Z_IDX_MW = 5;
-constexpr int MAG_X_IDX_MW = 6;
-constexpr int MAG_Y_IDX_MW = 7;
-constexpr int MAG_Z_IDX_MW = 8;
-constexpr int ROLL_IDX_MW = 9;
-constexpr int PITCH_IDX_MW = 10;
-constexpr int YAW_IDX_MW = 11;
-
 // Indeksy dla danych GPS w pełnej ramce 14-elementowej z portu szeregowego
 constexpr int GPS_LAT_IDX_SERIAL_MW = 12;
 constexpr int GPS_LON_IDX_SERIAL_MW = 13;
@@ -63,40 +69,99 @@ constexpr double BASE_LONGITUDE_MW = 17.0595; // Wrocław
 constexpr double GPS_OSCILLATION_AMPLITUDE_MW = 0.0001;
 constexpr double GPS_OSCILLATION_SPEED_FACTOR_MW = 0.05;
 
+const QString DEFAULT_NETWORK_ADDRESS_MW = QStringLiteral("udp://:5005"); // Propozycja w oknie dodawania źródła
+
+constexpr int MAG_X_IDX_MW = 6; // Magnetometr X w ramce IMU (kolejne: Y, Z)
+const QString MAG_CALIBRATION_ENABLED_SETTINGS_KEY_MW = QStringLiteral("magCalibration/applyCorrection");
+const QString GYRO_BIAS_ENABLED_SETTINGS_KEY_MW = QStringLiteral("gyroBias/applyCorrection");
+const QString RAW_TRACE_SETTINGS_KEY_MW = QStringLiteral("filters/showRawTrace");
+constexpr char SIMULATION_CALIBRATION_KEY_MW[] = "simulation"; // Kalibracja magnetometru dla odtwarzanych nagrań
+const QString DECLINATION_SETTINGS_KEY_MW = QStringLiteral("compass/declination"); // [°], dodatnia na wschód
+constexpr double MAX_DECLINATION_DEG_MW = 180.0;
+const QString ORIENTATION_SOURCE_SETTINGS_KEY_MW = QStringLiteral("imu/orientationSource");
+// Nazwy w QSettings w kolejności wartości MainWindow::OrientationSource
+const QStringList ORIENTATION_SOURCE_NAMES_MW = {QStringLiteral("device"), QStringLiteral("madgwick"),
+                                                 QStringLiteral("mahony")};
+constexpr int ALLAN_PROGRESS_MAXIMUM_MW = 1000; // Postęp AllanDeviation w promilach
+constexpr int ALLAN_PROGRESS_INTERVAL_MS_MW = 100;
+constexpr qint64 EVENT_PREROLL_NS_MW = 2000000000LL; // Odtwarzanie od 2 s przed zdarzeniem - widać, co je poprzedziło
+
 
 MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent),
                                           m_translator(nullptr),
                                           m_stackedWidget(new QStackedWidget(this)),
                                           m_imuHandler(new ImuDataHandler(this)),
-                                          m_gpsHandler(new GPSDataHandler(this)),
-                                          m_serialHandler(new SerialPortHandler(this)),
+                                          m_gpsHandler(nullptr), // Tworzony leniwie w ensureGpsHandler()
+                                          m_deviceManager(new DeviceManager(this)),
                                           m_simulationTimer(new QTimer(this)),
+                                          m_perfHud(nullptr),
                                           m_currentDataIndex(0),
+                                          m_replayBaseNs(0),
+                                          m_replayStartOffsetNs(0),
+                                          m_hasPendingGpsPosition(false),
+                                          m_pendingLatitude(0.0),
+                                          m_pendingLongitude(0.0),
                                           m_simulationMode(false),
-                                          m_serialConnected(false) {
+                                          m_serialConnected(false),
+                                          m_imuDeviceId(0),
+                                          m_gpsDeviceId(0),
+                                          m_imuDeviceMenu(nullptr),
+                                          m_gpsDeviceMenu(nullptr),
+                                          m_orientationSource(OrientationSource::Device),
+                                          m_applyMagCalibration(true),
+                                          m_applyGyroBiasCorrection(true),
+                                          m_showRawTrace(false) {
     setWindowTitle(tr("Sensor Visualizer"));
 
+    m_headingEstimator.setDeclination(QSettings().value(DECLINATION_SETTINGS_KEY_MW, 0.0).toFloat());
+    m_applyMagCalibration = QSettings().value(MAG_CALIBRATION_ENABLED_SETTINGS_KEY_MW, true).toBool();
+    m_applyGyroBiasCorrection = QSettings().value(GYRO_BIAS_ENABLED_SETTINGS_KEY_MW, true).toBool();
+    m_filterBank.loadSettings();
+    m_showRawTrace = QSettings().value(RAW_TRACE_SETTINGS_KEY_MW, false).toBool();
+    m_imuHandler->setRawTraceVisible(m_showRawTrace && !m_filterBank.isEmpty());
+    const int sourceIndex = ORIENTATION_SOURCE_NAMES_MW.indexOf(
+        QSettings().value(ORIENTATION_SOURCE_SETTINGS_KEY_MW).toString());
+    if (sourceIndex > 0) {
+        m_orientationSource = static_cast<OrientationSource>(sourceIndex);
+        m_ahrs.setAlgorithm(m_orientationSource == OrientationSource::Mahony ? AhrsFusion::Algorithm::Mahony
+                                                                             : AhrsFusion::Algorithm::Madgwick);
+    }
+
     if (!loadSimulationData(SIMULATION_DATA_FILE_PATH_MW)) {
         QMessageBox::warning(this, tr("Simulation Data"),
                              tr("Could not load simulation data from: %1. Simulation mode may not work correctly.").arg(
                                  SIMULATION_DATA_FILE_PATH_MW));
     }
 
-    m_stackedWidget->addWidget(m_imuHandler);
-    m_stackedWidget->addWidget(m_gpsHandler);
+    m_stackedWidget->addWidget(m_imuHandler); // Widok GPS dodawany przy pierwszym użyciu
     setCentralWidget(m_stackedWidget);
     m_stackedWidget->setCurrentWidget(m_imuHandler);
 
+    // Nakładka z metrykami - dziecko m_stackedWidget spoza jego stosu, więc widoczna nad każdym widokiem
+    m_perfHud = new PerfHud(m_stackedWidget);
+    m_perfHud->hide();
+
     createMenus();
     // showFullScreen(); // Odkomentuj, jeśli potrzebne
 
     connect(this, &MainWindow::switchToIMU, this, &MainWindow::showIMUHandler);
     connect(this, &MainWindow::switchToGPS, this, &MainWindow::showGPSHandler);
     connect(m_simulationTimer, &QTimer::timeout, this, &MainWindow::updateSimulationData);
-    connect(m_serialHandler, &SerialPortHandler::newDataReceived, this, &MainWindow::handleSerialData);
+    m_simulationTimer->setSingleShot(true); // Każda ramka planowana wg czasu z nagrania
+    m_simulationTimer->setTimerType(Qt::PreciseTimer);
+    connect(m_imuHandler, &ImuDataHandler::eventSelected, this, &MainWindow::seekReplayToEvent);
+    connect(m_deviceManager, &DeviceManager::framesReady, this, &MainWindow::handleDeviceFrames);
+    connect(m_deviceManager, &DeviceManager::devicesChanged, this, &MainWindow::handleDevicesChanged);
+    connect(m_deviceManager, &DeviceManager::deviceError, this, [this](int deviceId, const QString &errorString) {
+        statusBar()->showMessage(m_deviceManager->deviceName(deviceId) + QStringLiteral(": ") + errorString, 10000);
+    });
 }
 
 MainWindow::~MainWindow() {
+    // Destruktor DeviceManager (dziecka okna) zamyka urządzenia i emituje devicesChanged() - okno jest
+    // wtedy częściowo zniszczone, więc sygnały odłączane są wcześniej, a urządzenia zamykane tutaj
+    disconnect(m_deviceManager, nullptr, this, nullptr);
+    m_deviceManager->removeAllDevices();
     if (m_translator) {
         qApp->removeTranslator(m_translator);
         // m_translator jest dzieckiem MainWindow, więc Qt go usunie
@@ -112,6 +177,42 @@ void MainWindow::createMenus() {
     QAction *gpsAction = sensorMenu->addAction(tr("GPS View"));
     connect(imuAction, &QAction::triggered, this, &MainWindow::showIMUHandler);
     connect(gpsAction, &QAction::triggered, this, &MainWindow::showGPSHandler);
+    sensorMenu->addSeparator();
+    m_imuDeviceMenu = sensorMenu->addMenu(tr("IMU View Device"));
+    m_gpsDeviceMenu = sensorMenu->addMenu(tr("GPS View Device"));
+    populateDeviceMenu(m_imuDeviceMenu, &m_imuDeviceId);
+    populateDeviceMenu(m_gpsDeviceMenu, &m_gpsDeviceId);
+    QMenu *orientationSourceMenu = sensorMenu->addMenu(tr("Orientation Source"));
+    auto *orientationSourceGroup = new QActionGroup(orientationSourceMenu);
+    const QList<QPair<QString, OrientationSource>> orientationSources = {
+        {tr("Device (Onboard Fusion)"), OrientationSource::Device},
+        {tr("Host AHRS (Madgwick)"), OrientationSource::Madgwick},
+        {tr("Host AHRS (Mahony)"), OrientationSource::Mahony}
+    };
+    for (const auto &[label, source]: orientationSources) {
+        QAction *sourceAction = orientationSourceMenu->addAction(label);
+        sourceAction->setCheckable(true);
+        sourceAction->setChecked(source == m_orientationSource);
+        orientationSourceGroup->addAction(sourceAction);
+        connect(sourceAction, &QAction::triggered, this, [this, source] { setOrientationSource(source); });
+    }
+    QAction *declinationAction = sensorMenu->addAction(tr("Magnetic Declination..."));
+    connect(declinationAction, &QAction::triggered, this, &MainWindow::setMagneticDeclination);
+    QMenu *magCalibrationMenu = sensorMenu->addMenu(tr("Magnetometer Calibration"));
+    QAction *applyMagCalibrationAction = magCalibrationMenu->addAction(tr("Apply Correction"));
+    applyMagCalibrationAction->setCheckable(true);
+    applyMagCalibrationAction->setChecked(m_applyMagCalibration);
+    QAction *resetMagCalibrationAction = magCalibrationMenu->addAction(tr("Reset Calibration"));
+    connect(applyMagCalibrationAction, &QAction::toggled, this, &MainWindow::toggleMagCalibration);
+    connect(resetMagCalibrationAction, &QAction::triggered, this, &MainWindow::resetMagCalibration);
+    QAction *gyroBiasAction = sensorMenu->addAction(tr("Remove Gyro Bias"));
+    gyroBiasAction->setCheckable(true);
+    gyroBiasAction->setChecked(m_applyGyroBiasCorrection);
+    connect(gyroBiasAction, &QAction::toggled, this, &MainWindow::toggleGyroBiasCorrection);
+    QAction *filtersAction = sensorMenu->addAction(tr("Filters..."));
+    connect(filtersAction, &QAction::triggered, this, &MainWindow::configureFilters);
+    QAction *allanDeviationAction = sensorMenu->addAction(tr("Allan Deviation..."));
+    connect(allanDeviationAction, &QAction::triggered, this, &MainWindow::analyzeAllanDeviation);
 
     QMenu *settingsMenu = menuBarPtr->addMenu(tr("Settings"));
     QMenu *languageMenu = settingsMenu->addMenu(tr("Language"));
@@ -124,12 +225,68 @@ void MainWindow::createMenus() {
     simulationModeAction->setChecked(m_simulationMode);
     simulationModeAction->setObjectName("simulationModeAction");
 
-    QAction *selectPortAction = settingsMenu->addAction(tr("Select Serial Port"));
+    QAction *selectPortAction = settingsMenu->addAction(tr("Add Serial Device..."));
+    QAction *addNetworkDeviceAction = settingsMenu->addAction(tr("Add Network Device..."));
+    QAction *disconnectDevicesAction = settingsMenu->addAction(tr("Disconnect All Devices"));
+    QAction *recordSerialAction = settingsMenu->addAction(tr("Record Serial Data..."));
+    recordSerialAction->setCheckable(true);
+    recordSerialAction->setChecked(m_recorder.isOpen());
+    recordSerialAction->setObjectName("recordSerialAction");
+    QAction *publishFramesAction = settingsMenu->addAction(tr("Publish Frames (Local Socket)"));
+    publishFramesAction->setCheckable(true);
+    publishFramesAction->setChecked(m_deviceManager->isPublishing());
+    publishFramesAction->setObjectName("publishFramesAction");
+    QAction *sharedMemoryExportAction = settingsMenu->addAction(tr("Export Frames (Shared Memory)"));
+    sharedMemoryExportAction->setCheckable(true);
+    sharedMemoryExportAction->setChecked(m_deviceManager->isExportingSharedMemory());
+    sharedMemoryExportAction->setObjectName("sharedMemoryExportAction");
+
+    settingsMenu->addSeparator();
+    QMenu *mapBackendMenu = settingsMenu->addMenu(tr("Map Backend"));
+    auto *mapBackendGroup = new QActionGroup(mapBackendMenu);
+    QAction *webEngineMapAction = mapBackendMenu->addAction(tr("Web (Leaflet)"));
+    QAction *nativeMapAction = mapBackendMenu->addAction(tr("Native (low memory)"));
+    const GPSDataHandler::MapBackend activeBackend = m_gpsHandler ? m_gpsHandler->backend()
+                                                                  : GPSDataHandler::defaultBackend();
+    for (QAction *action: {webEngineMapAction, nativeMapAction}) {
+        action->setCheckable(true);
+        mapBackendGroup->addAction(action);
+    }
+    webEngineMapAction->setChecked(activeBackend == GPSDataHandler::MapBackend::WebEngine);
+    webEngineMapAction->setEnabled(GPSDataHandler::isBackendAvailable(GPSDataHandler::MapBackend::WebEngine));
+    nativeMapAction->setChecked(activeBackend == GPSDataHandler::MapBackend::Native);
+
+    QAction *perfHudAction = settingsMenu->addAction(tr("Performance Overlay"));
+    perfHudAction->setCheckable(true);
+    perfHudAction->setChecked(m_perfHud->isVisible());
+    perfHudAction->setShortcut(QKeySequence(Qt::Key_F12));
+
+    QMenu *latencyMenu = settingsMenu->addMenu(tr("Latency Tracing"));
+    QAction *recordTraceAction = latencyMenu->addAction(tr("Record Trace"));
+    recordTraceAction->setCheckable(true);
+    recordTraceAction->setChecked(LatencyTracer::isTraceEnabled());
+    QAction *exportTraceAction = latencyMenu->addAction(tr("Export Trace..."));
+    QAction *latencySummaryAction = latencyMenu->addAction(tr("Show Latency Summary"));
+    QAction *resetLatencyAction = latencyMenu->addAction(tr("Reset Statistics"));
 
     connect(englishAction, &QAction::triggered, this, &MainWindow::setEnglishLanguage);
     connect(polishAction, &QAction::triggered, this, &MainWindow::setPolishLanguage);
     connect(simulationModeAction, &QAction::triggered, this, &MainWindow::toggleSimulationMode);
     connect(selectPortAction, &QAction::triggered, this, &MainWindow::selectPort);
+    connect(addNetworkDeviceAction, &QAction::triggered, this, &MainWindow::addNetworkDevice);
+    connect(disconnectDevicesAction, &QAction::triggered, this, &MainWindow::disconnectAllDevices);
+    connect(recordSerialAction, &QAction::toggled, this, &MainWindow::toggleSerialRecording);
+    connect(publishFramesAction, &QAction::toggled, this, &MainWindow::toggleFramePublishing);
+    connect(sharedMemoryExportAction, &QAction::toggled, this, &MainWindow::toggleSharedMemoryExport);
+    connect(webEngineMapAction, &QAction::triggered, this, &MainWindow::setWebEngineMapBackend);
+    connect(nativeMapAction, &QAction::triggered, this, &MainWindow::setNativeMapBackend);
+    connect(recordTraceAction, &QAction::toggled, this, [](bool enabled) {
+        LatencyTracer::setTraceEnabled(enabled);
+    });
+    connect(perfHudAction, &QAction::toggled, m_perfHud, &QWidget::setVisible);
+    connect(exportTraceAction, &QAction::triggered, this, &MainWindow::exportLatencyTrace);
+    connect(latencySummaryAction, &QAction::triggered, this, &MainWindow::showLatencySummary);
+    connect(resetLatencyAction, &QAction::triggered, this, [] { LatencyTracer::reset(); });
 }
 
 void MainWindow::setEnglishLanguage() {
@@ -186,17 +343,27 @@ bool MainWindow::loadSimulationData(const QString &pathToSimulationFile) {
     if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
         QTextStream in(&file);
         m_loadedData.clear();
+        m_loadedTimesNs.clear();
+        m_loadedGapIndices.clear();
+        m_loadedHeadings.clear();
+        m_imuHandler->clearEvents(); // Czasy zdarzeń dotyczą poprzedniego nagrania
         m_currentDataIndex = 0;
         while (!in.atEnd()) {
             QString line = in.readLine().trimmed();
+            if (line.startsWith(QLatin1String(FrameRecorder::GAP_MARKER))) {
+                m_loadedGapIndices.insert(static_cast<int>(m_loadedData.size())); // Luka przed kolejną ramką
+                continue;
+            }
             if (line.isEmpty() || line.startsWith('#')) continue;
 
             QStringList values = line.split(',', Qt::SkipEmptyParts);
-            if (values.size() == EXPECTED_DATA_SIZE_SIM_FILE_MW) { // Oczekuje 12 wartości
+            // 12 wartości IMU, opcjonalnie czas odbioru w ms (nagrania FrameRecorder)
+            if (values.size() == EXPECTED_DATA_SIZE_SIM_FILE_MW || values.size() == TIMED_DATA_SIZE_SIM_FILE_MW) {
                 QVector<float> dataFrame;
                 dataFrame.reserve(EXPECTED_DATA_SIZE_SIM_FILE_MW);
                 bool conversionOk = true;
-                for (const QString &valStr: values) {
+                for (int i = 0; i < EXPECTED_DATA_SIZE_SIM_FILE_MW; ++i) {
+                    const QString &valStr = values[i];
                     bool okFlag;
                     float floatVal = valStr.trimmed().toFloat(&okFlag);
                     if (!okFlag) {
@@ -206,15 +373,40 @@ bool MainWindow::loadSimulationData(const QString &pathToSimulationFile) {
                     }
                     dataFrame.append(floatVal);
                 }
+                // Bez kolumny czasu - stały krok względem poprzedniej ramki
+                qint64 frameTimeNs = m_loadedTimesNs.isEmpty()
+                                         ? 0
+                                         : m_loadedTimesNs.last() + SIMULATION_TIMER_INTERVAL_MS_MW * NS_PER_MS_MW;
+                if (conversionOk && values.size() == TIMED_DATA_SIZE_SIM_FILE_MW) {
+                    bool okFlag;
+                    const double timeMs = values.last().trimmed().toDouble(&okFlag);
+                    if (okFlag) {
+                        frameTimeNs = static_cast<qint64>(timeMs * NS_PER_MS_MW);
+                    } else {
+                        qWarning() << "Conversion of frame time failed in line:" << line;
+                        conversionOk = false;
+                    }
+                }
                 if (conversionOk) {
                     m_loadedData.append(dataFrame);
+                    // Czas nie może się cofać (np. sklejone nagrania) - harmonogram odtwarzania jest monotoniczny
+                    m_loadedTimesNs.append(m_loadedTimesNs.isEmpty() ? frameTimeNs
+                                                                     : qMax(frameTimeNs, m_loadedTimesNs.last()));
                 }
             } else {
                 qWarning() << "Skipping line due to incorrect number of values. Expected:" << EXPECTED_DATA_SIZE_SIM_FILE_MW <<
-                        "Got:" << values.size() << "Line:" << line;
+                        "or" << TIMED_DATA_SIZE_SIM_FILE_MW << "Got:" << values.size() << "Line:" << line;
             }
         }
         file.close();
+        // Kurs wszystkich ramek jednym przebiegiem jądra wektorowego - odtwarzanie tylko go odczytuje
+        QVector<const float *> frames;
+        frames.reserve(m_loadedData.size());
+        for (const QVector<float> &frame: std::as_const(m_loadedData)) {
+            frames.append(frame.constData());
+        }
+        m_loadedHeadings.resize(m_loadedData.size());
+        m_headingEstimator.magneticHeadings(frames.constData(), static_cast<int>(frames.size()), m_loadedHeadings.data());
         qInfo() << "Successfully loaded" << m_loadedData.size() << "data frames from" << pathToSimulationFile;
         return !m_loadedData.isEmpty();
     } else {
@@ -224,7 +416,8 @@ bool MainWindow::loadSimulationData(const QString &pathToSimulationFile) {
 }
 
 // Przetwarza tylko 12 wartości IMU
-void MainWindow::processImuData(const QVector<float> &imuData) {
+void MainWindow::processImuData(const QVector<float> &imuData, qint64 timestampNs,
+                                const AhrsFusion::EulerAngles *hostOrientation, const QVector<float> *rawImuData) {
     if (imuData.size() != EXPECTED_DATA_SIZE_SIM_FILE_MW) { // Oczekuje 12 wartości
         qWarning() << "processImuData: Received IMU data with incorrect size. Expected:" << EXPECTED_DATA_SIZE_SIM_FILE_MW << "Got:"
                 << imuData.size();
@@ -234,34 +427,44 @@ void MainWindow::processImuData(const QVector<float> &imuData) {
         qWarning() << "processImuData: ImuDataHandler is null.";
         return;
     }
+    LatencyTracer::mark(LatencyTracer::Stage::ImuProcessing);
+    PerfCounters::addUiFrame();
 
-    QVector<int> gyro = { static_cast<int>(imuData[GYRO_X_IDX_MW]), static_cast<int>(imuData[GYRO_Y_IDX_MW]), static_cast<int>(imuData[GYRO_Z_IDX_MW]) };
-    QVector<int> acc = { static_cast<int>(imuData[ACC_X_IDX_MW]), static_cast<int>(imuData[ACC_Y_IDX_MW]), static_cast<int>(imuData[ACC_Z_IDX_MW]) };
-    QVector<int> mag = { static_cast<int>(imuData[MAG_X_IDX_MW]), static_cast<int>(imuData[MAG_Y_IDX_MW]), static_cast<int>(imuData[MAG_Z_IDX_MW]) };
-    float roll = imuData[ROLL_IDX_MW];
-    float pitch = imuData[PITCH_IDX_MW];
-    float yaw = imuData[YAW_IDX_MW];
-
-    m_imuHandler->updateData(acc, gyro, mag);
-    m_imuHandler->setRotation(yaw, pitch, roll);
+    m_imuHandler->processFrame(imuData, timestampNs, hostOrientation, rawImuData);
+}
 
-    if (std::abs(imuData[MAG_X_IDX_MW]) > 1e-6f || std::abs(imuData[MAG_Y_IDX_MW]) > 1e-6f) {
-        float heading_rad = std::atan2(imuData[MAG_Y_IDX_MW], imuData[MAG_X_IDX_MW]);
-        float heading_deg = heading_rad * 180.0f / static_cast<float>(M_PI);
-        if (heading_deg < 0.0f) heading_deg += 360.0f;
-        m_imuHandler->updateCompass(heading_deg);
+void MainWindow::processImuBatchFrame(int index, qint64 timestampNs) {
+    const AhrsFusion::EulerAngles *hostOrientation =
+        m_orientationSource != OrientationSource::Device ? &m_fusedAngles[index] : nullptr;
+    if (m_filterBank.isEmpty()) {
+        processImuData(m_imuBatch[index], timestampNs, hostOrientation);
     } else {
-        m_imuHandler->updateCompass(0.0f);
+        processImuData(m_filteredBatch[index], timestampNs, hostOrientation, &m_imuBatch[index]);
+    }
+}
+
+void MainWindow::updateCompassHeading(float magneticHeading) {
+    m_imuHandler->updateCompass(m_headingEstimator.trueHeading(magneticHeading));
+    LatencyTracer::mark(LatencyTracer::Stage::CompassUpdated);
+    LatencyTracer::armPaint(); // Opóźnienie do najbliższego odrysowania kompasu
+}
+
+void MainWindow::setMagneticDeclination() {
+    bool ok = false;
+    const double declination = QInputDialog::getDouble(this, tr("Magnetic Declination"),
+                                                       tr("Declination in degrees (east positive):"),
+                                                       m_headingEstimator.declination(), -MAX_DECLINATION_DEG_MW,
+                                                       MAX_DECLINATION_DEG_MW, 1, &ok);
+    if (!ok) {
+        return;
     }
+    m_headingEstimator.setDeclination(static_cast<float>(declination));
+    QSettings().setValue(DECLINATION_SETTINGS_KEY_MW, declination);
+    statusBar()->showMessage(tr("Compass shows true heading (declination %1°).").arg(declination, 0, 'f', 1), 5000);
 }
 
 void MainWindow::handlePortConnectionAttempt(const QString &portName) {
     m_selectedPort = portName;
-    if (m_serialConnected) {
-        m_serialHandler->closePort();
-        m_serialConnected = false;
-        qInfo() << "Closed previously connected serial port.";
-    }
     if (m_simulationMode) {
         m_simulationTimer->stop();
         m_simulationMode = false;
@@ -269,14 +472,84 @@ void MainWindow::handlePortConnectionAttempt(const QString &portName) {
         QList<QAction *> actions = menuBar()->findChildren<QAction *>("simulationModeAction");
         if (!actions.isEmpty()) actions.first()->setChecked(false);
     }
-    if (m_serialHandler->openPort(m_selectedPort)) {
-        m_serialConnected = true;
+    QString errorString;
+    const int deviceId = m_deviceManager->addSerialDevice(m_selectedPort, 115200, &errorString);
+    if (deviceId > 0) {
         QMessageBox::information(this, tr("Serial Port Connected"), tr("Successfully connected to port: %1").arg(m_selectedPort));
-        qInfo() << "Successfully connected to serial port:" << m_selectedPort;
+        qInfo() << "Successfully connected to serial port:" << m_selectedPort << "as device" << deviceId;
+    } else {
+        QMessageBox::critical(this, tr("Serial Port Error"), tr("Failed to open port %1. Reason: %2").arg(m_selectedPort).arg(errorString));
+        qWarning() << "Failed to open serial port:" << m_selectedPort << "Reason:" << errorString;
+    }
+}
+
+void MainWindow::addNetworkDevice() {
+    bool ok = false;
+    const QString address = QInputDialog::getText(this, tr("Add Network Device"),
+                                                  tr("Source address (udp://[address]:port or tcp://host:port):"),
+                                                  QLineEdit::Normal, DEFAULT_NETWORK_ADDRESS_MW, &ok).trimmed();
+    if (!ok || address.isEmpty()) {
+        return;
+    }
+    if (m_simulationMode) {
+        toggleSimulationMode(); // Dane na żywo zastępują odtwarzanie
+    }
+    QString errorString;
+    const int deviceId = m_deviceManager->addNetworkDevice(address, &errorString);
+    if (deviceId > 0) {
+        statusBar()->showMessage(tr("Receiving telemetry from %1").arg(m_deviceManager->deviceName(deviceId)), 5000);
     } else {
-        QMessageBox::critical(this, tr("Serial Port Error"), tr("Failed to open port %1. Reason: %2").arg(m_selectedPort).arg(m_serialHandler->getLastError()));
-        qWarning() << "Failed to open serial port:" << m_selectedPort << "Reason:" << m_serialHandler->getLastError();
-        m_serialConnected = false;
+        QMessageBox::critical(this, tr("Network Source Error"),
+                              tr("Failed to open %1. Reason: %2").arg(address, errorString));
+        qWarning() << "Failed to open network source:" << address << "Reason:" << errorString;
+    }
+}
+
+void MainWindow::disconnectAllDevices() {
+    m_deviceManager->removeAllDevices();
+    qInfo() << "All serial devices closed.";
+}
+
+void MainWindow::handleDevicesChanged() {
+    m_serialConnected = m_deviceManager->hasDevices();
+    const QList<int> deviceIds = m_deviceManager->deviceIds();
+    const int previousImuDeviceId = m_imuDeviceId;
+    // Widok bez urządzenia (lub z zamkniętym) przejmuje pierwsze dostępne
+    for (int *viewDeviceId: {&m_imuDeviceId, &m_gpsDeviceId}) {
+        if (!deviceIds.contains(*viewDeviceId)) {
+            *viewDeviceId = deviceIds.isEmpty() ? 0 : deviceIds.first();
+            m_imuHandler->markGap(); // Nie łącz na wykresie danych różnych urządzeń
+        }
+    }
+    if (m_imuDeviceId != previousImuDeviceId) {
+        imuDeviceChanged();
+    }
+    populateDeviceMenu(m_imuDeviceMenu, &m_imuDeviceId);
+    populateDeviceMenu(m_gpsDeviceMenu, &m_gpsDeviceId);
+}
+
+void MainWindow::populateDeviceMenu(QMenu *menu, int *selectedDeviceId) {
+    if (!menu) {
+        return;
+    }
+    menu->clear();
+    const QList<int> deviceIds = m_deviceManager->deviceIds();
+    menu->setEnabled(!deviceIds.isEmpty());
+    auto *deviceGroup = new QActionGroup(menu);
+    for (int deviceId: deviceIds) {
+        QAction *deviceAction = menu->addAction(m_deviceManager->deviceName(deviceId));
+        deviceAction->setCheckable(true);
+        deviceAction->setChecked(deviceId == *selectedDeviceId);
+        deviceGroup->addAction(deviceAction);
+        connect(deviceAction, &QAction::triggered, this, [this, deviceId, selectedDeviceId] {
+            if (*selectedDeviceId != deviceId) {
+                *selectedDeviceId = deviceId;
+                m_imuHandler->markGap();
+                if (selectedDeviceId == &m_imuDeviceId) {
+                    imuDeviceChanged();
+                }
+            }
+        });
     }
 }
 
@@ -295,13 +568,13 @@ bool MainWindow::checkSimulationEndAndUpdateState() {
 
 // Ta funkcja generuje dane GPS dla trybu symulacji, niezależnie od zawartości pliku
 void MainWindow::updateSimulatedGPSMarker() {
-    if (m_simulationMode && m_gpsHandler && !m_loadedData.isEmpty() && m_currentDataIndex < m_loadedData.size()) {
+    if (m_simulationMode && !m_loadedData.isEmpty() && m_currentDataIndex < m_loadedData.size()) {
         double angleRad = static_cast<double>(m_currentDataIndex) * GPS_OSCILLATION_SPEED_FACTOR_MW;
         double latOffset = GPS_OSCILLATION_AMPLITUDE_MW * std::sin(angleRad);
         double lonOffset = GPS_OSCILLATION_AMPLITUDE_MW * std::cos(angleRad);
         double currentLatitude = BASE_LATITUDE_MW + latOffset;
         double currentLongitude = BASE_LONGITUDE_MW + lonOffset;
-        m_gpsHandler->updateMarker(currentLatitude, currentLongitude);
+        updateGpsPosition(currentLatitude, currentLongitude);
     }
 }
 
@@ -311,13 +584,12 @@ void MainWindow::toggleSimulationMode() {
     QAction *simAction = menuBar()->findChild<QAction *>("simulationModeAction");
     if (m_simulationMode) {
         if (m_serialConnected) {
-            m_serialHandler->closePort();
-            m_serialConnected = false;
-            qInfo() << "Serial port closed due to enabling simulation mode.";
+            m_deviceManager->removeAllDevices();
+            qInfo() << "Serial devices closed due to enabling simulation mode.";
         }
         if (!m_loadedData.isEmpty()) {
-            if (m_gpsHandler) m_gpsHandler->updateMarker(BASE_LATITUDE_MW, BASE_LONGITUDE_MW); // Ustaw GPS na start
-            m_simulationTimer->start(SIMULATION_TIMER_INTERVAL_MS_MW);
+            updateGpsPosition(BASE_LATITUDE_MW, BASE_LONGITUDE_MW); // Ustaw GPS na start
+            startSimulationReplay();
             qInfo() << "Simulation mode enabled. Timer started.";
         } else {
             QMessageBox::warning(this, tr("Simulation Mode Warning"), tr("Simulation mode enabled, but no simulation data is loaded. Please load data first."));
@@ -353,8 +625,104 @@ void MainWindow::showIMUHandler() {
     }
 }
 
+void MainWindow::updateGpsPosition(double latitude, double longitude) {
+    if (m_gpsHandler) {
+        m_gpsHandler->updateMarker(static_cast<float>(latitude), static_cast<float>(longitude));
+    }
+    // Zapamiętaj najnowszy stan dla mapy tworzonej później (lub odtwarzanej po zmianie zaplecza)
+    m_pendingLatitude = latitude;
+    m_pendingLongitude = longitude;
+    m_hasPendingGpsPosition = true;
+}
+
+GPSDataHandler *MainWindow::ensureGpsHandler() {
+    if (!m_gpsHandler) {
+        m_gpsHandler = new GPSDataHandler(this);
+        m_stackedWidget->addWidget(m_gpsHandler);
+        m_perfHud->raise(); // Nowy widok nie może przykryć nakładki
+        connect(m_gpsHandler, &GPSDataHandler::mapReady, this, [this](const QString &report) {
+            statusBar()->showMessage(report, 10000);
+        });
+        qInfo() << "GPS map view created on first activation.";
+        if (m_hasPendingGpsPosition) {
+            m_gpsHandler->updateMarker(static_cast<float>(m_pendingLatitude), static_cast<float>(m_pendingLongitude));
+        }
+    }
+    return m_gpsHandler;
+}
+
+void MainWindow::setWebEngineMapBackend() {
+    switchMapBackend(GPSDataHandler::backendName(GPSDataHandler::MapBackend::WebEngine));
+}
+
+void MainWindow::setNativeMapBackend() {
+    switchMapBackend(GPSDataHandler::backendName(GPSDataHandler::MapBackend::Native));
+}
+
+void MainWindow::switchMapBackend(const QString &backendName) {
+    const GPSDataHandler::MapBackend backend = GPSDataHandler::backendFromName(backendName);
+    GPSDataHandler::storeDefaultBackend(backend);
+    if (!m_gpsHandler || m_gpsHandler->backend() == backend) {
+        return;
+    }
+    const bool wasVisible = m_stackedWidget->currentWidget() == m_gpsHandler;
+    m_stackedWidget->removeWidget(m_gpsHandler);
+    m_gpsHandler->deleteLater();
+    m_gpsHandler = nullptr;
+    qInfo() << "Map backend switched to" << backendName;
+    if (wasVisible) {
+        showGPSHandler();
+    }
+}
+
+void MainWindow::exportLatencyTrace() {
+    const QString filePath = QFileDialog::getSaveFileName(this, tr("Export Latency Trace"),
+                                                          QStringLiteral("orienta_trace.json"),
+                                                          tr("Chrome trace (*.json)"));
+    if (filePath.isEmpty()) {
+        return;
+    }
+    if (!LatencyTracer::exportChromeTrace(filePath)) {
+        QMessageBox::warning(this, tr("Latency Trace"), tr("Failed to write trace file: %1").arg(filePath));
+    } else if (!LatencyTracer::isTraceEnabled()) {
+        QMessageBox::information(this, tr("Latency Trace"),
+                                 tr("Trace recording is off - enable \"Record Trace\" to capture events."));
+    }
+}
+
+void MainWindow::showLatencySummary() {
+    const DeviceManager::DeviceStats device = m_deviceManager->deviceStats(m_imuDeviceId);
+    const SequenceTracker::Stats &sequence = device.sequence;
+    const QString sequenceText = tr("Frame sequence (%7): %1 received, %2 lost (%3 %), %4 gaps, %5 duplicates, %6 late")
+            .arg(sequence.received)
+            .arg(sequence.lost)
+            .arg(sequence.lossRate() * 100.0, 0, 'f', 3)
+            .arg(sequence.gaps)
+            .arg(sequence.duplicates)
+            .arg(sequence.late)
+            .arg(m_imuDeviceId > 0 ? m_deviceManager->deviceName(m_imuDeviceId) : tr("no device"));
+    QString publisherText;
+    if (m_deviceManager->isPublishing()) {
+        const FramePublisher::Stats publisher = m_deviceManager->publisherStats();
+        publisherText = tr("\nPublished on %1: %2 frames, %3 client(s), %4 dropped for slow clients")
+                .arg(m_deviceManager->publisherName())
+                .arg(publisher.framesPublished)
+                .arg(publisher.clients)
+                .arg(publisher.framesDropped);
+    }
+    if (m_deviceManager->isExportingSharedMemory()) {
+        publisherText += tr("\nShared memory %1: %2 frames written")
+                .arg(m_deviceManager->sharedMemoryName())
+                .arg(m_deviceManager->sharedMemoryFramesWritten());
+    }
+    QMessageBox::information(this, tr("Latency Summary"),
+                             tr("Latency from frame receive time (or simulation tick) to each stage:\n\n%1\n%2\n%3")
+                             .arg(LatencyTracer::summaryText(), sequenceText,
+                                  device.timingSummary) + publisherText);
+}
+
 void MainWindow::showGPSHandler() {
-    if (m_stackedWidget && m_gpsHandler) {
+    if (m_stackedWidget && ensureGpsHandler()) {
         m_stackedWidget->setCurrentWidget(m_gpsHandler);
         qDebug() << "View switched to GPS Handler.";
     }
@@ -370,31 +738,403 @@ void MainWindow::updateSimulationData() {
     }
     if (checkSimulationEndAndUpdateState()) return;
 
-    const QVector<float> &currentFrameData = m_loadedData[m_currentDataIndex]; // Dane IMU z pliku (12 wartości)
-    processImuData(currentFrameData);     // Przetwórz dane IMU
-    updateSimulatedGPSMarker();           // Generuj i zaktualizuj GPS dla symulacji
+    // Wszystkie ramki należne do tej chwili - timer mógł się spóźnić
+    const qint64 elapsedNs = m_replayClock.nsecsElapsed();
+    const int firstIndex = m_currentDataIndex;
+    int endIndex = firstIndex;
+    while (endIndex < m_loadedData.size() && m_loadedTimesNs[endIndex] - m_replayStartOffsetNs <= elapsedNs) {
+        ++endIndex;
+    }
+    if (endIndex == firstIndex) {
+        scheduleNextSimulationFrame();
+        return;
+    }
+    m_batchInputs.clear();
+    m_batchTimesNs.clear();
+    for (int i = firstIndex; i < endIndex; ++i) {
+        m_batchInputs.append(m_loadedData[i].constData());
+        m_batchTimesNs.append(m_replayBaseNs + m_loadedTimesNs[i] - m_replayStartOffsetNs);
+    }
+    prepareImuBatch();
+    for (int i = firstIndex; i < endIndex; ++i) {
+        const qint64 frameOffsetNs = m_loadedTimesNs[i] - m_replayStartOffsetNs;
+        LatencyTracer::beginFrame(LatencyTracer::nowNs()); // W symulacji ramka zaczyna się od tyknięcia timera
+        if (m_loadedGapIndices.contains(i)) {
+            m_imuHandler->markGap(); // Luka zapisana w nagraniu
+        }
+        processImuBatchFrame(i - firstIndex, m_replayBaseNs + frameOffsetNs); // Oś czasu wg czasu z nagrania
+        updateSimulatedGPSMarker();           // Generuj i zaktualizuj GPS dla symulacji
+
+        m_currentDataIndex++;
+    }
+    // Kursy z wczytania dotyczą surowych odczytów - po korekcji magnetometru liczony jest tylko ostatni
+    const bool hostFusion = m_orientationSource != OrientationSource::Device;
+    const bool magCorrected = m_applyMagCalibration && m_magCalibrator.calibration().isValid();
+    updateCompassHeading(hostFusion     ? m_fusedAngles[endIndex - firstIndex - 1].yaw
+                         : magCorrected ? HeadingEstimator::magneticHeading(m_imuBatch[endIndex - firstIndex - 1].constData())
+                                        : m_loadedHeadings[endIndex - 1]);
+    scheduleNextSimulationFrame();
+}
 
-    m_currentDataIndex++;
+void MainWindow::startSimulationReplay() {
+    m_replayStartOffsetNs = m_currentDataIndex < m_loadedTimesNs.size() ? m_loadedTimesNs[m_currentDataIndex] : 0;
+    m_replayBaseNs = LatencyTracer::nowNs();
+    m_ahrs.reset(); // Czas nagrania zaczyna się od nowa - nie całkuj przez przerwę
+    m_gyroBias.reset(); // Nagranie może pochodzić z innej płytki niż urządzenie na żywo
+    m_filterBank.reset();
+    m_imuHandler->resetStatistics();
+    m_imuHandler->resetEventDetector();
+    selectMagCalibrationDevice(QString::fromLatin1(SIMULATION_CALIBRATION_KEY_MW));
+    m_replayClock.start();
+    m_simulationTimer->start(0);
 }
 
-void MainWindow::handleSerialData(const QVector<float> &dataFromSerial) {
+void MainWindow::scheduleNextSimulationFrame() {
+    if (m_currentDataIndex >= m_loadedData.size()) {
+        m_simulationTimer->start(0); // Koniec danych obsłuży checkSimulationEndAndUpdateState()
+        return;
+    }
+    const qint64 remainingNs = m_loadedTimesNs[m_currentDataIndex] - m_replayStartOffsetNs - m_replayClock.nsecsElapsed();
+    m_simulationTimer->start(static_cast<int>(qMax<qint64>(0, (remainingNs + NS_PER_MS_MW - 1) / NS_PER_MS_MW)));
+}
+
+void MainWindow::toggleSerialRecording(bool enabled) {
+    if (!enabled) {
+        m_recorder.close();
+        return;
+    }
+    const QString filePath = QFileDialog::getSaveFileName(this, tr("Record Serial Data"),
+                                                          QStringLiteral("orienta_recording.log"),
+                                                          tr("Simulation data (*.log)"));
+    if (filePath.isEmpty() || !m_recorder.open(filePath)) {
+        if (!filePath.isEmpty()) {
+            QMessageBox::warning(this, tr("Recording"), tr("Failed to open recording file: %1").arg(filePath));
+        }
+        if (QAction *recordAction = menuBar()->findChild<QAction *>("recordSerialAction")) {
+            QSignalBlocker blocker(recordAction);
+            recordAction->setChecked(false);
+        }
+    }
+}
+
+void MainWindow::toggleFramePublishing(bool enabled) {
+    if (!enabled) {
+        m_deviceManager->stopPublishing();
+        statusBar()->showMessage(tr("Frame publishing stopped."), 5000);
+        return;
+    }
+    QString errorString;
+    if (m_deviceManager->startPublishing(QString::fromLatin1(FramePublisher::DEFAULT_SERVER_NAME), &errorString)) {
+        statusBar()->showMessage(tr("Publishing frames on %1").arg(m_deviceManager->publisherName()), 10000);
+    } else {
+        QMessageBox::warning(this, tr("Frame Publishing"), tr("Failed to start the local frame server: %1").arg(errorString));
+        if (QAction *publishAction = menuBar()->findChild<QAction *>("publishFramesAction")) {
+            QSignalBlocker blocker(publishAction);
+            publishAction->setChecked(false);
+        }
+    }
+}
+
+void MainWindow::toggleSharedMemoryExport(bool enabled) {
+    if (!enabled) {
+        m_deviceManager->stopSharedMemoryExport();
+        statusBar()->showMessage(tr("Shared memory export stopped."), 5000);
+        return;
+    }
+    QString errorString;
+    if (m_deviceManager->startSharedMemoryExport(QString::fromLatin1(SharedFrameRing::DEFAULT_NAME),
+                                                 SharedFrameRing::DEFAULT_CAPACITY, &errorString)) {
+        statusBar()->showMessage(tr("Exporting frames to shared memory %1").arg(m_deviceManager->sharedMemoryName()),
+                                 10000);
+    } else {
+        QMessageBox::warning(this, tr("Shared Memory Export"),
+                             tr("Failed to create the shared memory segment: %1").arg(errorString));
+        if (QAction *exportAction = menuBar()->findChild<QAction *>("sharedMemoryExportAction")) {
+            QSignalBlocker blocker(exportAction);
+            exportAction->setChecked(false);
+        }
+    }
+}
+
+void MainWindow::handleDeviceFrames(const QVector<SensorFrame> &frames) {
     if (!m_serialConnected || m_simulationMode) {
         return; // Ignoruj, jeśli nie w trybie live lub symulacja aktywna
     }
+    m_batchInputs.clear();
+    m_batchTimesNs.clear();
+    for (const SensorFrame &frame: frames) {
+        if (frame.deviceId == m_imuDeviceId && frame.values.size() == EXPECTED_VALUE_COUNT_SERIAL) {
+            m_batchInputs.append(frame.values.constData());
+            m_batchTimesNs.append(frame.hostTimestampNs);
+        }
+    }
+    prepareImuBatch();
+    const bool hostFusion = m_orientationSource != OrientationSource::Device;
+    int imuIndex = 0;
+    for (const SensorFrame &frame: frames) {
+        if (frame.deviceId == m_imuDeviceId && frame.values.size() == EXPECTED_VALUE_COUNT_SERIAL) {
+            handleSerialData(frame, imuIndex++); // Ta sama kolejność co przy wypełnianiu m_batchInputs
+        } else {
+            handleSerialData(frame);
+        }
+    }
+    if (imuIndex > 0) {
+        // Kompas raz na paczkę: kurs najnowszej ramki (bieżącej ramki pomiaru opóźnień)
+        updateCompassHeading(hostFusion ? m_fusedAngles[imuIndex - 1].yaw
+                                        : HeadingEstimator::magneticHeading(m_imuBatch[imuIndex - 1].constData()));
+    }
+}
+
+void MainWindow::prepareImuBatch() {
+    const int count = static_cast<int>(m_batchInputs.size());
+    if (count == 0) {
+        return;
+    }
+    if (m_imuBatch.size() < count) {
+        m_imuBatch.resize(count); // Bufory ramek zachowywane między paczkami
+    }
+    const bool applyCalibration = m_applyMagCalibration;
+    const bool removeGyroBias = m_applyGyroBiasCorrection;
+    for (int i = 0; i < count; ++i) {
+        const float *raw = m_batchInputs[i];
+        QVector<float> &values = m_imuBatch[i];
+        values.resize(EXPECTED_DATA_SIZE_SIM_FILE_MW);
+        std::copy(raw, raw + EXPECTED_DATA_SIZE_SIM_FILE_MW, values.begin());
+        m_gyroBias.addSample(raw);
+        if (removeGyroBias) {
+            m_gyroBias.apply(values.data()); // Żyroskop na początku ramki
+        }
+        m_magCalibrator.addSample(raw[MAG_X_IDX_MW], raw[MAG_X_IDX_MW + 1], raw[MAG_X_IDX_MW + 2]);
+        if (applyCalibration) {
+            m_magCalibrator.apply(values.data() + MAG_X_IDX_MW);
+        }
+    }
+    if (m_magCalibrator.solveIfDue()) {
+        m_magCalibrator.saveSettings(m_magCalibrationKey);
+        qInfo() << "Magnetometer calibration updated for" << m_magCalibrationKey << "- offset"
+                << m_magCalibrator.calibration().offset[0] << m_magCalibrator.calibration().offset[1]
+                << m_magCalibrator.calibration().offset[2] << "field" << m_magCalibrator.calibration().fieldStrength;
+    }
+    const MagnetometerCalibrator::Calibration &calibration = m_magCalibrator.calibration();
+    m_imuHandler->setMagCalibrationStatus(m_magCalibrator.coverage(), applyCalibration && calibration.isValid(),
+                                          calibration.fitError);
+    m_imuHandler->setGyroBiasStatus(m_gyroBias.isStationary(), m_gyroBias.hasEstimate() ? m_gyroBias.bias() : nullptr,
+                                    removeGyroBias);
+
+    m_fusionInputs.resize(count);
+    for (int i = 0; i < count; ++i) {
+        m_fusionInputs[i] = m_imuBatch[i].constData();
+    }
+    // Widmo, statystyki i zdarzenia z odczytów po korekcjach, ale przed filtrami widoku - filtry zniekształciłyby
+    // obraz drgań i spłaszczyły uderzenia
+    m_imuHandler->addSpectrumFrames(m_fusionInputs.constData(), m_batchTimesNs.constData(), count);
+    m_imuHandler->addStatisticsFrames(m_fusionInputs.constData(), m_batchTimesNs.constData(), count);
+    m_imuHandler->addEventFrames(m_fusionInputs.constData(), m_batchTimesNs.constData(), count, m_simulationMode,
+                                 m_replayStartOffsetNs - m_replayBaseNs); // Czas ramki odtwarzania -> czas nagrania
+
+    if (m_orientationSource != OrientationSource::Device) {
+        m_fusedAngles.resize(count);
+        m_ahrs.updateBatch(m_fusionInputs.constData(), m_batchTimesNs.constData(), count, m_fusedAngles.data());
+    }
+
+    if (!m_filterBank.isEmpty()) {
+        // Filtry tylko dla widoku - fuzja i kompas korzystają z nieprzefiltrowanych odczytów
+        if (m_filteredBatch.size() < count) {
+            m_filteredBatch.resize(count);
+        }
+        m_filterInputs.resize(count);
+        m_filterOutputs.resize(count);
+        for (int i = 0; i < count; ++i) {
+            // Kopia wartości (z kątami ROLL/PITCH/YAW) do własnego bufora - bez współdzielenia i alokacji
+            QVector<float> &filtered = m_filteredBatch[i];
+            filtered.resize(EXPECTED_DATA_SIZE_SIM_FILE_MW);
+            std::copy(m_imuBatch[i].cbegin(), m_imuBatch[i].cend(), filtered.begin());
+            m_filterInputs[i] = m_imuBatch[i].constData();
+            m_filterOutputs[i] = filtered.data();
+        }
+        QElapsedTimer filterTimer;
+        filterTimer.start();
+        m_filterBank.process(m_filterInputs.constData(), m_filterOutputs.constData(), count);
+        PerfCounters::addFilterWork(static_cast<quint64>(count) * FilterBank::CHANNELS, filterTimer.nsecsElapsed());
+    }
+}
+
+void MainWindow::imuDeviceChanged() {
+    m_ahrs.reset(); // Orientacja innego urządzenia ustalana od nowa
+    m_gyroBias.reset();
+    m_filterBank.reset();
+    m_imuHandler->resetStatistics();
+    m_imuHandler->resetEventDetector();
+    if (m_imuDeviceId > 0) {
+        selectMagCalibrationDevice(m_deviceManager->deviceKey(m_imuDeviceId));
+    }
+}
+
+void MainWindow::selectMagCalibrationDevice(const QString &deviceKey) {
+    if (deviceKey == m_magCalibrationKey) {
+        return; // Np. wznowienie odtwarzania - statystyki sesji zachowane
+    }
+    m_magCalibrationKey = deviceKey;
+    if (m_magCalibrator.loadSettings(deviceKey)) {
+        qInfo() << "Loaded magnetometer calibration for" << deviceKey;
+    }
+}
+
+void MainWindow::toggleMagCalibration(bool enabled) {
+    m_applyMagCalibration = enabled;
+    QSettings().setValue(MAG_CALIBRATION_ENABLED_SETTINGS_KEY_MW, enabled);
+}
+
+void MainWindow::toggleGyroBiasCorrection(bool enabled) {
+    m_applyGyroBiasCorrection = enabled;
+    QSettings().setValue(GYRO_BIAS_ENABLED_SETTINGS_KEY_MW, enabled);
+}
+
+void MainWindow::configureFilters() {
+    FilterSettingsDialog dialog(this);
+    dialog.setStages(m_filterBank.stages(), m_filterBank.sampleRate());
+    dialog.setRawTraceVisible(m_showRawTrace);
+    if (dialog.exec() != QDialog::Accepted) {
+        return;
+    }
+    m_filterBank.configure(dialog.stages(), dialog.sampleRate());
+    m_filterBank.saveSettings();
+    m_showRawTrace = dialog.rawTraceVisible();
+    QSettings().setValue(RAW_TRACE_SETTINGS_KEY_MW, m_showRawTrace);
+    m_imuHandler->setRawTraceVisible(m_showRawTrace && !m_filterBank.isEmpty());
+    statusBar()->showMessage(m_filterBank.isEmpty()
+                                 ? tr("Sensor filters disabled.")
+                                 : tr("Sensor filters: %1 stage(s) at %2 Hz (%3 backend).")
+                                       .arg(m_filterBank.stages().size())
+                                       .arg(m_filterBank.sampleRate(), 0, 'f', 1)
+                                       .arg(QLatin1String(SimdFloat4::backendName())),
+                             5000);
+}
+
+void MainWindow::analyzeAllanDeviation() {
+    const QString filePath = QFileDialog::getOpenFileName(this, tr("Allan Deviation"), QString(),
+                                                          tr("Simulation data (*.log)"));
+    if (filePath.isEmpty()) {
+        return;
+    }
+
+    QProgressDialog progressDialog(tr("Analyzing %1...").arg(QFileInfo(filePath).fileName()), tr("Cancel"),
+                                   0, ALLAN_PROGRESS_MAXIMUM_MW, this);
+    progressDialog.setWindowModality(Qt::WindowModal);
+    progressDialog.setMinimumDuration(0);
+
+    // Analiza wielogigabajtowego nagrania trwa długo - wątek roboczy, a GUI tylko odpytuje postęp
+    std::atomic<int> permille{0};
+    std::atomic<bool> cancelled{false};
+    AllanDeviation::Result result;
+    QString errorString;
+    bool succeeded = false;
+    QThread *worker = QThread::create([&] {
+        succeeded = AllanDeviation::analyzeFile(filePath, result, &errorString, [&](int value) {
+            permille.store(value, std::memory_order_relaxed);
+            return !cancelled.load(std::memory_order_relaxed);
+        });
+    });
+    QEventLoop loop;
+    QTimer progressTimer;
+    connect(worker, &QThread::finished, &loop, &QEventLoop::quit);
+    connect(&progressTimer, &QTimer::timeout, &progressDialog, [&] {
+        progressDialog.setValue(permille.load(std::memory_order_relaxed));
+    });
+    connect(&progressDialog, &QProgressDialog::canceled, &progressDialog, [&] { cancelled.store(true); });
+    worker->start();
+    progressTimer.start(ALLAN_PROGRESS_INTERVAL_MS_MW);
+    loop.exec(); // Wraca dopiero po zakończeniu wątku - zmienne lokalne przeżywają zadanie
+    progressTimer.stop();
+    worker->wait();
+    delete worker;
+    progressDialog.reset();
+
+    if (!succeeded) {
+        if (!cancelled.load()) {
+            QMessageBox::warning(this, tr("Allan Deviation"), tr("Analysis failed: %1").arg(errorString));
+        }
+        return;
+    }
+    AllanDeviationDialog dialog(result, QFileInfo(filePath).fileName(), this);
+    dialog.exec();
+}
+
+void MainWindow::seekReplayToEvent(qint64 recordingTimeNs) {
+    if (m_serialConnected || m_loadedData.isEmpty()) {
+        statusBar()->showMessage(tr("Disconnect the devices to replay recorded events."), 5000);
+        return;
+    }
+    // Czasy nagrania są niemalejące - wyszukiwanie binarne zamiast ponownego wczytania pliku
+    const auto first = std::lower_bound(m_loadedTimesNs.cbegin(), m_loadedTimesNs.cend(),
+                                        recordingTimeNs - EVENT_PREROLL_NS_MW);
+    m_currentDataIndex = qMin(static_cast<int>(first - m_loadedTimesNs.cbegin()),
+                              static_cast<int>(m_loadedData.size()) - 1);
+    m_simulationTimer->stop();
+    m_imuHandler->markGap(); // Wykresy nie łączą ramek sprzed i zza przeskoku
+    if (!m_simulationMode) {
+        m_simulationMode = true; // Np. po dojściu do końca nagrania
+        if (QAction *simulationAction = menuBar()->findChild<QAction *>("simulationModeAction")) {
+            simulationAction->setChecked(true);
+        }
+    }
+    startSimulationReplay();
+    statusBar()->showMessage(tr("Replaying from %1 s before the event at %2 s.")
+                                 .arg(EVENT_PREROLL_NS_MW / 1.0e9, 0, 'f', 1)
+                                 .arg(recordingTimeNs / 1.0e9, 0, 'f', 3),
+                             5000);
+}
+
+void MainWindow::resetMagCalibration() {
+    m_magCalibrator.reset();
+    if (!m_magCalibrationKey.isEmpty()) {
+        m_magCalibrator.saveSettings(m_magCalibrationKey); // Usuwa zapisaną kalibrację
+    }
+    m_imuHandler->setMagCalibrationStatus(0.0f, false, 0.0f);
+    statusBar()->showMessage(tr("Magnetometer calibration reset - rotate the sensor in all directions."), 10000);
+}
+
+void MainWindow::setOrientationSource(OrientationSource source) {
+    m_orientationSource = source;
+    QSettings().setValue(ORIENTATION_SOURCE_SETTINGS_KEY_MW, ORIENTATION_SOURCE_NAMES_MW.at(static_cast<int>(source)));
+    if (source == OrientationSource::Device) {
+        statusBar()->showMessage(tr("Orientation: angles computed by the device."), 5000);
+        return;
+    }
+    m_ahrs.setAlgorithm(source == OrientationSource::Mahony ? AhrsFusion::Algorithm::Mahony
+                                                            : AhrsFusion::Algorithm::Madgwick);
+    m_ahrs.reset();
+    statusBar()->showMessage(tr("Orientation: host AHRS (%1 backend).").arg(QLatin1String(SimdFloat4::backendName())),
+                             5000);
+}
+
+void MainWindow::handleSerialData(const SensorFrame &frame, int imuBatchIndex) {
+    const bool imuFrame = frame.deviceId == m_imuDeviceId;
+    const bool gpsFrame = frame.deviceId == m_gpsDeviceId;
+    if (!imuFrame && !gpsFrame) {
+        return; // Urządzenie nie jest pokazywane w żadnym widoku
+    }
+    const QVector<float> &dataFromSerial = frame.values;
 
     // Oczekujemy 14 wartości z portu szeregowego (12 IMU + 2 GPS)
     if (dataFromSerial.size() == EXPECTED_VALUE_COUNT_SERIAL) { // Użyj stałej z SerialPortHandler
-        // Wyodrębnij pierwsze 12 wartości dla IMU
-        QVector<float> imuData = dataFromSerial.mid(0, EXPECTED_DATA_SIZE_SIM_FILE_MW); // 12 wartości dla IMU
-        processImuData(imuData); // Przetwórz dane IMU
-
-        // Wyodrębnij dane GPS (indeksy 12 i 13 w ramce 14-elementowej)
-        float latitude = dataFromSerial[GPS_LAT_IDX_SERIAL_MW];
-        float longitude = dataFromSerial[GPS_LON_IDX_SERIAL_MW];
+        if (imuFrame && imuBatchIndex >= 0) {
+            LatencyTracer::beginFrame(frame.hostTimestampNs);
+            LatencyTracer::mark(LatencyTracer::Stage::DataReceived);
+            if (frame.lostFramesBefore > 0) {
+                m_imuHandler->markGap();
+                m_recorder.writeGap(frame.lostFramesBefore);
+            }
+            m_recorder.write(frame);
+            // Pierwsze 12 wartości (IMU) po korekcji i filtrach - przygotowane w prepareImuBatch()
+            processImuBatchFrame(imuBatchIndex, frame.hostTimestampNs); // Przetwórz dane IMU
+        }
+        if (gpsFrame) {
+            // Wyodrębnij dane GPS (indeksy 12 i 13 w ramce 14-elementowej)
+            float latitude = dataFromSerial[GPS_LAT_IDX_SERIAL_MW];
+            float longitude = dataFromSerial[GPS_LON_IDX_SERIAL_MW];
 
-        if (m_gpsHandler) {
-            m_gpsHandler->updateMarker(static_cast<double>(latitude), static_cast<double>(longitude));
-            // qDebug() << "Live GPS Data Updated:" << latitude << longitude; // Opcjonalny log
+            updateGpsPosition(static_cast<double>(latitude), static_cast<double>(longitude));
         }
     } else {
         qWarning() << "handleSerialData: Received data with incorrect size from serial. Expected:"
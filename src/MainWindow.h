@@ -13,17 +13,28 @@
 #define MAINWINDOW_H
 
 #include <QMainWindow>
+#include <QElapsedTimer>
+#include <QSet>
+#include "SensorFrame.h"
+#include "FrameRecorder.h"
+#include "AhrsFusion.h"
+#include "HeadingEstimator.h"
+#include "MagnetometerCalibrator.h"
+#include "GyroBiasEstimator.h"
+#include "FilterBank.h"
 
 // Deklaracje wyprzedzające dla klas Qt
 class QStackedWidget;
 class QTimer;
 class QTranslator;
 class QAction;
+class QMenu;
 
 // Deklaracje wyprzedzające dla klas projektu
 class ImuDataHandler;
 class GPSDataHandler;
-class SerialPortHandler;
+class DeviceManager;
+class PerfHud;
 
 /**
  * @class MainWindow
@@ -51,22 +62,102 @@ private slots:
     void setEnglishLanguage();
     void setPolishLanguage();
     void toggleSimulationMode();
+    /**
+     * @brief Pozwala wybrać port szeregowy i dodaje go jako kolejne urządzenie.
+     */
     void selectPort();
+    /**
+     * @brief Pyta o adres źródła sieciowego (`udp://[adres]:port`, `tcp://host:port`) i dodaje je jako urządzenie.
+     */
+    void addNetworkDevice();
+    /**
+     * @brief Zamyka wszystkie urządzenia (porty szeregowe i źródła sieciowe).
+     */
+    void disconnectAllDevices();
     void showIMUHandler();
     void showGPSHandler();
+    void setWebEngineMapBackend();
+    void setNativeMapBackend();
+    /**
+     * @brief Zapisuje nagrane zdarzenia opóźnień w formacie Chrome trace-event JSON (Perfetto).
+     */
+    void exportLatencyTrace();
+    /**
+     * @brief Wyświetla podsumowanie histogramów opóźnień poszczególnych etapów potoku.
+     */
+    void showLatencySummary();
     void updateSimulationData();
     /**
-     * @brief Przetwarza dane odebrane z portu szeregowego (12 wartości IMU + 2 wartości GPS).
-     * @author Mateusz Wojtaszek // Zakładając, że jest to nowy kod lub znacząca modyfikacja [cite: 8, 10]
-     *
-     * @details Wywoływana po otrzymaniu sygnału `newDataReceived` od `SerialPortHandler`.
-     * Dzieli dane na część IMU i GPS, przekazując je do odpowiednich handlerów.
-     * Działa tylko, gdy aplikacja nie jest w trybie symulacji i port jest połączony. [cite: 28]
-     * @param dataFromSerial [in] Wektor 14 sparsowanych wartości (12 IMU + 2 GPS) z portu szeregowego. [cite: 33]
+     * @brief Rozdziela paczkę ramek ze wszystkich urządzeń (`DeviceManager::framesReady`) między widoki.
+     * @param frames [in] Ramki uporządkowane wg czasu odbioru.
+     */
+    void handleDeviceFrames(const QVector<SensorFrame> &frames);
+    /**
+     * @brief Odświeża menu wyboru urządzeń widoków po zmianie listy urządzeń.
+     */
+    void handleDevicesChanged();
+    /**
+     * @brief Rozpoczyna lub kończy nagrywanie ramek z portu szeregowego do pliku symulacyjnego.
+     * @details Nagranie zawiera czas odbioru każdej ramki, dzięki czemu tryb symulacji odtwarza je
+     * w rzeczywistym tempie (`FrameRecorder`).
+     * @param enabled [in] `true`, aby wybrać plik i rozpocząć nagrywanie.
+     */
+    void toggleSerialRecording(bool enabled);
+    /**
+     * @brief Włącza lub wyłącza publikację ramek innym procesom przez gniazdo lokalne (`FramePublisher`).
+     * @param enabled [in] `true`, aby uruchomić serwer `FramePublisher::DEFAULT_SERVER_NAME`.
+     */
+    void toggleFramePublishing(bool enabled);
+    /**
+     * @brief Włącza lub wyłącza eksport ramek do pamięci współdzielonej (`SharedFrameRing`).
+     * @param enabled [in] `true`, aby utworzyć segment `SharedFrameRing::DEFAULT_NAME`.
+     */
+    void toggleSharedMemoryExport(bool enabled);
+    /**
+     * @brief Pyta o deklinację magnetyczną dodawaną do kursu kompasu i zapisuje ją w QSettings.
+     */
+    void setMagneticDeclination();
+    /**
+     * @brief Włącza lub wyłącza korekcję magnetometru (`MagnetometerCalibrator`) i zapisuje wybór w QSettings.
+     * @param enabled [in] `true`, aby korygować odczyty przed wykresami, kompasem i fuzją.
+     */
+    void toggleMagCalibration(bool enabled);
+    /**
+     * @brief Usuwa kalibrację magnetometru bieżącego urządzenia i rozpoczyna zbieranie próbek od nowa.
+     */
+    void resetMagCalibration();
+    /**
+     * @brief Włącza lub wyłącza odejmowanie biasu żyroskopu (`GyroBiasEstimator`) i zapisuje wybór w QSettings.
+     * @param enabled [in] `true`, aby wykresy, paski i fuzja dostawały odczyty bez biasu.
+     */
+    void toggleGyroBiasCorrection(bool enabled);
+    /**
+     * @brief Otwiera okno konfiguracji filtrów kanałów IMU (`FilterSettingsDialog`) i zapisuje wybór w QSettings.
+     */
+    void configureFilters();
+    /**
+     * @brief Liczy odchylenie Allana wybranego nagrania w tle (`AllanDeviation`) i pokazuje wynik w `AllanDeviationDialog`.
+     */
+    void analyzeAllanDeviation();
+    /**
+     * @brief Przewija odtwarzanie nagrania (i wykresy) do zdarzenia wybranego na liście zdarzeń.
+     * @details Ramki nagrania są już w pamięci - zmieniany jest tylko indeks bieżącej ramki, bez ponownego
+     * wczytywania pliku. Odtwarzanie zaczyna się `EVENT_PREROLL_NS_MW` przed zdarzeniem.
+     * @param recordingTimeNs [in] Początek zdarzenia w czasie nagrania [ns].
      */
-    void handleSerialData(const QVector<float> &dataFromSerial);
+    void seekReplayToEvent(qint64 recordingTimeNs);
 
 private:
+    /**
+     * @enum OrientationSource
+     * @brief Źródło orientacji pokazywanej w widoku 3D i na kompasie.
+     */
+    enum class OrientationSource {
+        Device, //!< Kąty ROLL/PITCH/YAW z ramki (fuzja w firmware), kurs z magnetometru (`HeadingEstimator`).
+        Madgwick, //!< Fuzja w aplikacji - filtr Madgwicka.
+        Mahony //!< Fuzja w aplikacji - filtr Mahony'ego.
+    };
+
     void createMenus();
     void retranslateApplicationUi();
     bool loadSimulationData(const QString &pathToSimulationFile);
@@ -76,25 +167,155 @@ private:
      *
      * @details Używana głównie dla danych z pliku symulacyjnego oraz części IMU z danych live. [cite: 28]
      * @param imuData [in] Wektor zawierający 12 wartości danych IMU. [cite: 33]
+     * @param timestampNs [in] Monotoniczny czas odbioru ramki [ns] (oś czasu wykresów).
+     * @param hostOrientation [in] Orientacja z `AhrsFusion` wyliczona dla paczki ramek; `nullptr` - kąty z ramki.
+     * @param rawImuData [in] Ramka przed filtrowaniem (przebiegi surowe na wykresach) lub `nullptr`.
+     * @note Kursu kompasu nie aktualizuje - zob. `updateCompassHeading()`.
      */
-    void processImuData(const QVector<float> &imuData);
+    void processImuData(const QVector<float> &imuData, qint64 timestampNs,
+                        const AhrsFusion::EulerAngles *hostOrientation = nullptr,
+                        const QVector<float> *rawImuData = nullptr);
+    /**
+     * @brief Przekazuje do widoku IMU ramkę paczki przygotowanej w `prepareImuBatch()`.
+     * @details Przy włączonych filtrach widok dostaje ramkę przefiltrowaną, a nieprzefiltrowaną jako przebieg
+     * surowy; orientacja z `m_fusedAngles`, jeśli źródłem nie jest urządzenie.
+     * @param index [in] Indeks ramki w paczce.
+     * @param timestampNs [in] Czas ramki na osi wykresów [ns].
+     */
+    void processImuBatchFrame(int index, qint64 timestampNs);
+    /**
+     * @brief Przetwarza ramkę z portu szeregowego (12 wartości IMU + 2 wartości GPS).
+     * @author Mateusz Wojtaszek // Zakładając, że jest to nowy kod lub znacząca modyfikacja [cite: 8, 10]
+     *
+     * @details Dzieli dane na część IMU i GPS i przekazuje każdą z nich do widoku, jeśli ramka
+     * pochodzi z urządzenia wybranego dla tego widoku (`m_imuDeviceId`, `m_gpsDeviceId`).
+     * Ramki urządzenia widoku IMU są też zapisywane do pliku, jeśli włączono nagrywanie
+     * (`toggleSerialRecording()`). [cite: 28]
+     * @param frame [in] Ramka: 14 sparsowanych wartości (12 IMU + 2 GPS), czas odbioru i urządzenie. [cite: 33]
+     * @param imuBatchIndex [in] Indeks ramki w paczce `prepareImuBatch()`; -1 - ramka nie trafia do widoku IMU.
+     */
+    void handleSerialData(const SensorFrame &frame, int imuBatchIndex = -1);
+    /**
+     * @brief Przygotowuje paczkę ramek widoku IMU (`m_batchInputs`, `m_batchTimesNs`) do wyświetlenia.
+     * @details Kopiuje 12 wartości IMU każdej ramki do `m_imuBatch` (bufory używane ponownie), podaje surowy
+     * magnetometr do `m_magCalibrator`, a żyroskop i akcelerometr do `m_gyroBias` i - jeśli włączono
+     * korekcje - koryguje kopię. Po paczce próbuje
+     * dopasować kalibrację (zapis w QSettings przy zmianie) i, gdy źródłem orientacji nie jest urządzenie,
+     * wyznacza orientację jednym wywołaniem `AhrsFusion::updateBatch()` (wyniki w `m_fusedAngles`).
+     * Na końcu, jeśli łańcuch filtrów nie jest pusty, filtruje kopie do `m_filteredBatch` (tylko dla widoku).
+     * Surowe ramki (nagrywanie, eksport) pozostają bez zmian.
+     */
+    void prepareImuBatch();
+    /**
+     * @brief Rozpoczyna nową orientację i estymację biasu żyroskopu oraz wczytuje kalibrację magnetometru
+     * po zmianie urządzenia widoku IMU.
+     */
+    void imuDeviceChanged();
+    /**
+     * @brief Przełącza kalibrację magnetometru na podane urządzenie (wczytuje ją z QSettings).
+     * @param deviceKey [in] Trwały identyfikator urządzenia; ten sam klucz - bez zmian.
+     */
+    void selectMagCalibrationDevice(const QString &deviceKey);
+    /**
+     * @brief Ustawia źródło orientacji widoku 3D i kompasu i zapisuje je w QSettings.
+     * @param source [in] Źródło orientacji.
+     */
+    void setOrientationSource(OrientationSource source);
+    /**
+     * @brief Ustawia kurs kompasu raz na paczkę ramek (odświeżenie widoku), z deklinacją magnetyczną.
+     * @details Pokazywany jest kurs najnowszej ramki - ramki pośrednie i tak nie trafiłyby na ekran.
+     * Zamyka pomiar opóźnień bieżącej ramki (`CompassUpdated`, oczekiwanie na odrysowanie).
+     * @param magneticHeading [in] Kurs magnetyczny [°] (`HeadingEstimator` lub `AhrsFusion`).
+     */
+    void updateCompassHeading(float magneticHeading);
     void handlePortConnectionAttempt(const QString &portName);
+    /**
+     * @brief Wypełnia menu wyboru urządzenia jednego widoku.
+     * @param menu [in] Menu do wypełnienia.
+     * @param selectedDeviceId [in,out] Identyfikator urządzenia wybranego dla widoku.
+     */
+    void populateDeviceMenu(QMenu *menu, int *selectedDeviceId);
     bool checkSimulationEndAndUpdateState();
+    /**
+     * @brief Rozpoczyna odtwarzanie danych symulacyjnych od bieżącej ramki.
+     */
+    void startSimulationReplay();
+    /**
+     * @brief Ustawia jednorazowy timer symulacji na czas kolejnej ramki nagrania.
+     */
+    void scheduleNextSimulationFrame();
     void updateSimulatedGPSMarker(); // Dla generowania GPS w trybie symulacji
+    /**
+     * @brief Przekazuje pozycję GPS do widoku mapy lub buforuje ją do czasu jego utworzenia.
+     * @details Widok mapy (`GPSDataHandler`) jest tworzony leniwie przy pierwszym przełączeniu
+     * na widok GPS. Do tego czasu przechowywana jest wyłącznie ostatnia pozycja.
+     * @param latitude [in] Szerokość geograficzna w stopniach dziesiętnych.
+     * @param longitude [in] Długość geograficzna w stopniach dziesiętnych.
+     */
+    void updateGpsPosition(double latitude, double longitude);
+    /**
+     * @brief Tworzy widok mapy GPS przy pierwszym użyciu.
+     * @details Uruchomienie `QWebEngineView` (proces Chromium + Leaflet) jest kosztowne, dlatego
+     * następuje dopiero przy pierwszej aktywacji widoku. Po utworzeniu do mapy trafia
+     * zbuforowana ostatnia pozycja.
+     * @return Wskaźnik na (ewentualnie nowo utworzony) `GPSDataHandler`.
+     */
+    GPSDataHandler *ensureGpsHandler();
+    /**
+     * @brief Zapisuje wybrane zaplecze mapy i odtwarza istniejący widok mapy.
+     * @details Jeśli widok mapy już istnieje, jest usuwany i tworzony ponownie z nowym zapleczem
+     * (z ostatnią znaną pozycją). W przeciwnym razie wybór zostanie użyty przy pierwszej aktywacji.
+     * @param backendName [in] Nazwa zaplecza (`webengine` lub `native`).
+     */
+    void switchMapBackend(const QString &backendName);
 
     QTranslator *m_translator;
     QStackedWidget *m_stackedWidget;
     ImuDataHandler *m_imuHandler;
-    GPSDataHandler *m_gpsHandler;
-    SerialPortHandler *m_serialHandler;
+    GPSDataHandler *m_gpsHandler; //!< Widok mapy, tworzony leniwie w ensureGpsHandler().
+    DeviceManager *m_deviceManager; //!< Urządzenia (porty szeregowe, źródła sieciowe) we wspólnym wątku I/O.
     QTimer *m_simulationTimer;
+    PerfHud *m_perfHud; //!< Nakładka z metrykami wydajności (Ustawienia > Performance Overlay, F12).
 
     QVector<QVector<float> > m_loadedData; // Dla danych symulacyjnych (12 wartości IMU)
+    QVector<qint64> m_loadedTimesNs; //!< Czas każdej ramki symulacji od początku nagrania [ns].
+    QSet<int> m_loadedGapIndices; //!< Indeksy ramek symulacji poprzedzonych luką (`# gap`).
+    QVector<float> m_loadedHeadings; //!< Kurs magnetyczny każdej ramki symulacji (wyliczany przy wczytaniu).
     int m_currentDataIndex;
+    QElapsedTimer m_replayClock; //!< Czas od rozpoczęcia odtwarzania.
+    qint64 m_replayBaseNs; //!< Czas hosta odpowiadający początkowi odtwarzania (`LatencyTracer::nowNs()`).
+    qint64 m_replayStartOffsetNs; //!< Czas nagrania ramki, od której rozpoczęto odtwarzanie [ns].
+    FrameRecorder m_recorder; //!< Nagrywanie ramek z portu szeregowego.
+
+    bool m_hasPendingGpsPosition; //!< Czy znana jest ostatnia pozycja GPS (przekazywana nowo tworzonej mapie).
+    double m_pendingLatitude; //!< Ostatnia znana szerokość geograficzna.
+    double m_pendingLongitude; //!< Ostatnia znana długość geograficzna.
 
     bool m_simulationMode;
     bool m_serialConnected;
     QString m_selectedPort;
+    int m_imuDeviceId; //!< Urządzenie, którego ramki pokazuje widok IMU (0 - brak).
+    int m_gpsDeviceId; //!< Urządzenie, którego pozycję pokazuje mapa GPS (0 - brak).
+    QMenu *m_imuDeviceMenu; //!< Menu Sensor > IMU View Device.
+    QMenu *m_gpsDeviceMenu; //!< Menu Sensor > GPS View Device.
+    OrientationSource m_orientationSource; //!< Źródło orientacji (Sensor > Orientation Source).
+    AhrsFusion m_ahrs; //!< Fuzja orientacji urządzenia widoku IMU (gdy źródłem nie jest urządzenie).
+    QVector<const float *> m_batchInputs; //!< Surowe wartości ramek widoku IMU w paczce (pojemność zachowywana).
+    QVector<qint64> m_batchTimesNs; //!< Czasy ramek paczki.
+    QVector<QVector<float>> m_imuBatch; //!< 12 wartości IMU ramek paczki po korekcji (bufory używane ponownie).
+    QVector<const float *> m_fusionInputs; //!< Wartości z `m_imuBatch` przekazywane do `m_ahrs` i widoku widma.
+    QVector<AhrsFusion::EulerAngles> m_fusedAngles; //!< Orientacja po każdej ramce paczki.
+    HeadingEstimator m_headingEstimator; //!< Kurs z kompensacją przechyłu i deklinacja (Sensor > Magnetic Declination).
+    MagnetometerCalibrator m_magCalibrator; //!< Kalibracja magnetometru urządzenia widoku IMU.
+    QString m_magCalibrationKey; //!< Urządzenie, którego kalibrację trzyma `m_magCalibrator`.
+    bool m_applyMagCalibration; //!< Korekcja magnetometru włączona (Sensor > Magnetometer Calibration).
+    GyroBiasEstimator m_gyroBias; //!< Detektor spoczynku i bias żyroskopu urządzenia widoku IMU.
+    bool m_applyGyroBiasCorrection; //!< Odejmowanie biasu żyroskopu włączone (Sensor > Remove Gyro Bias).
+    FilterBank m_filterBank; //!< Filtry kanałów IMU przed wyświetleniem (Sensor > Filters...).
+    QVector<QVector<float>> m_filteredBatch; //!< Ramki paczki po filtrach (bufory używane ponownie).
+    QVector<const float *> m_filterInputs; //!< Wejścia `m_filterBank` (ramki `m_imuBatch`).
+    QVector<float *> m_filterOutputs; //!< Wyjścia `m_filterBank` (ramki `m_filteredBatch`).
+    bool m_showRawTrace; //!< Przebiegi surowe pod przefiltrowanymi na wykresach.
     /**
      * @var EXPECTED_VALUE_COUNT_SERIAL
      * @brief Definiuje oczekiwaną liczbę wartości w ładunku CSV (12 IMU + 2 GPS = 14). [cite: 5, 17]
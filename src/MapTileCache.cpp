@@ -0,0 +1,274 @@
+/**
+ * @file MapTileCache.cpp
+ * @brief Implementacja klasy MapTileCache.
+ * @author Mateusz Wojtaszek
+ * @date 2025-05-25
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include "MapTileCache.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QNetworkAccessManager>
+#include <QNetworkRequest>
+#include <QNetworkReply>
+#include <QTimer>
+#include <QSettings>
+#include <QStandardPaths>
+#include <QUrl>
+#include <QDebug>
+
+constexpr int DEFAULT_MEMORY_CACHE_KB_MTC = 32 * 1024; // 32 MB
+constexpr int MAX_ZOOM_LEVEL_MTC = 22;
+const QString DEFAULT_TILE_URL_TEMPLATE_MTC = "https://tile.openstreetmap.org/{z}/{x}/{y}.png";
+// Zasady korzystania z serwerów OSM wymagają identyfikującego nagłówka User-Agent
+const QByteArray TILE_USER_AGENT_MTC = "Orienta/1.0 (+https://github.com/MateuszWojtaszek/wds_Orienta)";
+
+MapTileCache::MapTileCache(QObject *parent)
+    : QObject(parent),
+      m_memoryCache(DEFAULT_MEMORY_CACHE_KB_MTC),
+      m_onlineFallbackEnabled(false),
+      m_tileUrlTemplate(DEFAULT_TILE_URL_TEMPLATE_MTC),
+      m_network(nullptr) {
+}
+
+MapTileCache::~MapTileCache() {
+    if (!m_mbTilesConnectionName.isEmpty()) {
+        {
+            QSqlDatabase db = QSqlDatabase::database(m_mbTilesConnectionName, false);
+            db.close();
+        }
+        QSqlDatabase::removeDatabase(m_mbTilesConnectionName);
+    }
+}
+
+void MapTileCache::applySettings() {
+    QSettings settings;
+    const QString defaultCacheDir =
+            QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QStringLiteral("/tiles");
+    setCacheDirectory(settings.value("map/tileCacheDir", defaultCacheDir).toString());
+    setOnlineFallbackEnabled(settings.value("map/onlineFallback", false).toBool());
+    if (settings.contains("map/memoryCacheKb")) {
+        setMemoryCacheLimit(settings.value("map/memoryCacheKb").toInt());
+    }
+    const QString mbTilesPath = settings.value("map/mbtilesPath").toString();
+    if (!mbTilesPath.isEmpty()) {
+        openMbTiles(mbTilesPath);
+    }
+}
+
+bool MapTileCache::openMbTiles(const QString &path) {
+    if (!QFileInfo::exists(path)) {
+        qWarning() << "MBTiles file does not exist:" << path;
+        return false;
+    }
+    if (m_mbTilesConnectionName.isEmpty()) {
+        m_mbTilesConnectionName = QStringLiteral("mbtiles_%1").arg(reinterpret_cast<quintptr>(this), 0, 16);
+    }
+
+    QSqlDatabase db = QSqlDatabase::contains(m_mbTilesConnectionName)
+                          ? QSqlDatabase::database(m_mbTilesConnectionName, false)
+                          : QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), m_mbTilesConnectionName);
+    db.close();
+    db.setDatabaseName(path);
+    db.setConnectOptions(QStringLiteral("QSQLITE_OPEN_READONLY"));
+    if (!db.open()) {
+        qWarning() << "Failed to open MBTiles file:" << path << "Error:" << db.lastError().text();
+        return false;
+    }
+    if (!db.tables().contains(QStringLiteral("tiles"))) {
+        qWarning() << "MBTiles file has no 'tiles' table:" << path;
+        db.close();
+        return false;
+    }
+    m_memoryCache.clear();
+    qInfo() << "Opened MBTiles tile source:" << path;
+    return true;
+}
+
+void MapTileCache::setCacheDirectory(const QString &directory) {
+    m_cacheDirectory = directory;
+    if (!m_cacheDirectory.isEmpty()) {
+        QDir().mkpath(m_cacheDirectory);
+    }
+}
+
+void MapTileCache::setOnlineFallbackEnabled(bool enabled) {
+    m_onlineFallbackEnabled = enabled;
+}
+
+void MapTileCache::setTileUrlTemplate(const QString &urlTemplate) {
+    m_tileUrlTemplate = urlTemplate;
+}
+
+void MapTileCache::setMemoryCacheLimit(int kilobytes) {
+    m_memoryCache.setMaxCost(qMax(1, kilobytes));
+}
+
+bool MapTileCache::isValidTile(int z, int x, int y) {
+    if (z < 0 || z > MAX_ZOOM_LEVEL_MTC) {
+        return false;
+    }
+    const int tilesPerAxis = 1 << z;
+    return x >= 0 && x < tilesPerAxis && y >= 0 && y < tilesPerAxis;
+}
+
+quint64 MapTileCache::tileKey(int z, int x, int y) {
+    return (static_cast<quint64>(z) << 48) | (static_cast<quint64>(x) << 24) | static_cast<quint64>(y);
+}
+
+QByteArray MapTileCache::localTile(int z, int x, int y) {
+    if (!isValidTile(z, x, y)) {
+        return QByteArray();
+    }
+    const quint64 key = tileKey(z, x, y);
+    if (const QByteArray *cached = m_memoryCache.object(key)) {
+        return *cached; // QCache::object() odświeża pozycję w LRU
+    }
+
+    QByteArray data = readMbTilesTile(z, x, y);
+    if (data.isEmpty()) {
+        data = readDirectoryTile(z, x, y);
+    }
+    if (!data.isEmpty()) {
+        insertIntoMemory(key, data);
+    }
+    return data;
+}
+
+QByteArray MapTileCache::readMbTilesTile(int z, int x, int y) const {
+    if (m_mbTilesConnectionName.isEmpty()) {
+        return QByteArray();
+    }
+    QSqlDatabase db = QSqlDatabase::database(m_mbTilesConnectionName, false);
+    if (!db.isOpen()) {
+        return QByteArray();
+    }
+    QSqlQuery query(db);
+    query.prepare(QStringLiteral(
+        "SELECT tile_data FROM tiles WHERE zoom_level = ? AND tile_column = ? AND tile_row = ?"));
+    query.addBindValue(z);
+    query.addBindValue(x);
+    query.addBindValue((1 << z) - 1 - y); // MBTiles używa schematu TMS (oś Y od dołu)
+    if (query.exec() && query.next()) {
+        return query.value(0).toByteArray();
+    }
+    return QByteArray();
+}
+
+QByteArray MapTileCache::readDirectoryTile(int z, int x, int y) const {
+    if (m_cacheDirectory.isEmpty()) {
+        return QByteArray();
+    }
+    QFile file(QStringLiteral("%1/%2/%3/%4.png").arg(m_cacheDirectory).arg(z).arg(x).arg(y));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    return file.readAll();
+}
+
+void MapTileCache::writeDirectoryTile(int z, int x, int y, const QByteArray &data) const {
+    if (m_cacheDirectory.isEmpty()) {
+        return;
+    }
+    const QString tileDir = QStringLiteral("%1/%2/%3").arg(m_cacheDirectory).arg(z).arg(x);
+    if (!QDir().mkpath(tileDir)) {
+        return;
+    }
+    QFile file(QStringLiteral("%1/%2.png").arg(tileDir).arg(y));
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(data);
+    }
+}
+
+void MapTileCache::insertIntoMemory(quint64 key, const QByteArray &data) {
+    const int costKb = qMax(1, static_cast<int>(data.size() / 1024));
+    m_memoryCache.insert(key, new QByteArray(data), costKb);
+}
+
+bool MapTileCache::fetchRemoteTile(int z, int x, int y) {
+    if (!m_onlineFallbackEnabled || !isValidTile(z, x, y)) {
+        return false;
+    }
+    const quint64 key = tileKey(z, x, y);
+    if (m_pendingFetches.contains(key)) {
+        return true;
+    }
+    if (!m_network) {
+        m_network = new QNetworkAccessManager(this);
+    }
+
+    QString url = m_tileUrlTemplate;
+    url.replace(QLatin1String("{z}"), QString::number(z));
+    url.replace(QLatin1String("{x}"), QString::number(x));
+    url.replace(QLatin1String("{y}"), QString::number(y));
+
+    QNetworkRequest request{QUrl(url)};
+    request.setHeader(QNetworkRequest::UserAgentHeader, TILE_USER_AGENT_MTC);
+    QNetworkReply *reply = m_network->get(request);
+    m_pendingFetches.insert(key, reply);
+    connect(reply, &QNetworkReply::finished, this, [this, reply, z, x, y]() {
+        handleRemoteReply(reply, z, x, y);
+    });
+    return true;
+}
+
+void MapTileCache::handleRemoteReply(QNetworkReply *reply, int z, int x, int y) {
+    m_pendingFetches.remove(tileKey(z, x, y));
+    reply->deleteLater();
+
+    if (reply->error() != QNetworkReply::NoError) {
+        qWarning() << "Failed to fetch map tile" << z << x << y << "Error:" << reply->errorString();
+        emit tileFetchFailed(z, x, y);
+        return;
+    }
+    const QByteArray data = reply->readAll();
+    if (data.isEmpty()) {
+        emit tileFetchFailed(z, x, y);
+        return;
+    }
+    insertIntoMemory(tileKey(z, x, y), data);
+    writeDirectoryTile(z, x, y, data); // Uzupełnij cache offline
+    emit tileFetched(z, x, y, data);
+}
+
+void MapTileCache::prefetchNeighbours(int z, int x, int y) {
+    const bool wasIdle = m_prefetchQueue.isEmpty();
+
+    auto enqueue = [this](int tz, int tx, int ty) {
+        if (!isValidTile(tz, tx, ty)) {
+            return;
+        }
+        const quint64 key = tileKey(tz, tx, ty);
+        if (!m_memoryCache.contains(key) && !m_prefetchQueue.contains(key)) {
+            m_prefetchQueue.append(key);
+        }
+    };
+
+    enqueue(z - 1, x / 2, y / 2); // Kafelek nadrzędny
+    for (int dy = 0; dy < 2; ++dy) {
+        for (int dx = 0; dx < 2; ++dx) {
+            enqueue(z + 1, 2 * x + dx, 2 * y + dy); // Kafelki podrzędne
+        }
+    }
+
+    if (wasIdle && !m_prefetchQueue.isEmpty()) {
+        // Wczytywanie w kolejnej iteracji pętli zdarzeń, po obsłużeniu bieżących żądań
+        QTimer::singleShot(0, this, &MapTileCache::processPrefetchQueue);
+    }
+}
+
+void MapTileCache::processPrefetchQueue() {
+    while (!m_prefetchQueue.isEmpty()) {
+        const quint64 key = m_prefetchQueue.takeFirst();
+        const int z = static_cast<int>(key >> 48);
+        const int x = static_cast<int>((key >> 24) & 0xFFFFFF);
+        const int y = static_cast<int>(key & 0xFFFFFF);
+        localTile(z, x, y); // Tylko źródła lokalne - bez ruchu sieciowego
+    }
+}
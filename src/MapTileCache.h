@@ -0,0 +1,184 @@
+#ifndef MAPTILECACHE_H
+#define MAPTILECACHE_H
+
+/**
+ * @file MapTileCache.h
+ * @brief Definicja klasy MapTileCache, lokalnego magazynu kafelków mapy OpenStreetMap.
+ * @author Mateusz Wojtaszek
+ * @date 2025-05-25
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include <QObject>
+#include <QByteArray>
+#include <QCache>
+#include <QHash>
+#include <QList>
+#include <QString>
+
+class QNetworkAccessManager;
+class QNetworkReply;
+
+/**
+ * @class MapTileCache
+ * @brief Dostarcza kafelki mapy z pamięci, pliku MBTiles lub katalogu, opcjonalnie dociągając brakujące z sieci.
+ *
+ * @details
+ * Kolejność wyszukiwania kafelka `z/x/y`:
+ * 1. Pamięć podręczna LRU (`QCache`, limit w kilobajtach).
+ * 2. Plik MBTiles (SQLite, schemat TMS - oś Y odwrócona).
+ * 3. Katalog w układzie `<katalog>/<z>/<x>/<y>.png`.
+ *
+ * Jeśli kafelka nie ma lokalnie, a pobieranie z sieci jest włączone, `fetchRemoteTile()`
+ * pobiera go z serwera kafelków, zapisuje w katalogu (budując w ten sposób cache offline)
+ * i emituje `tileFetched()`. Bez sieci mapa działa wyłącznie z danych lokalnych.
+ *
+ * `prefetchNeighbours()` wczytuje do pamięci kafelek nadrzędny (z-1) oraz cztery kafelki
+ * podrzędne (z+1), aby zmiana poziomu przybliżenia nie czekała na dysk. Wstępne ładowanie
+ * korzysta tylko ze źródeł lokalnych.
+ *
+ * @note Wszystkie metody muszą być wywoływane z wątku, w którym żyje obiekt.
+ * @see MapTileSchemeHandler
+ */
+class MapTileCache : public QObject {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Konstruktor klasy MapTileCache.
+     * @param parent [in] Wskaźnik na obiekt nadrzędny. Domyślnie `nullptr`.
+     */
+    explicit MapTileCache(QObject *parent = nullptr);
+
+    /**
+     * @brief Destruktor. Zamyka połączenie z bazą MBTiles.
+     */
+    ~MapTileCache() override;
+
+    /**
+     * @brief Konfiguruje źródła kafelków na podstawie ustawień aplikacji (`QSettings`).
+     * @details Odczytywane klucze:
+     * - `map/mbtilesPath` - ścieżka do pliku MBTiles (domyślnie brak),
+     * - `map/tileCacheDir` - katalog kafelków (domyślnie `<CacheLocation>/tiles`),
+     * - `map/onlineFallback` - pobieranie brakujących kafelków z sieci (domyślnie `false` - tylko dane lokalne),
+     * - `map/memoryCacheKb` - limit pamięci podręcznej LRU w KB.
+     */
+    void applySettings();
+
+    /**
+     * @brief Otwiera plik MBTiles jako źródło kafelków.
+     * @param path [in] Ścieżka do pliku `.mbtiles`.
+     * @return `true`, jeśli plik został otwarty i zawiera tabelę `tiles`.
+     */
+    bool openMbTiles(const QString &path);
+
+    /**
+     * @brief Ustawia katalog z kafelkami (`<z>/<x>/<y>.png`), używany do odczytu i zapisu.
+     * @param directory [in] Ścieżka do katalogu. Pusty QString wyłącza źródło katalogowe.
+     */
+    void setCacheDirectory(const QString &directory);
+
+    /**
+     * @brief Włącza lub wyłącza pobieranie brakujących kafelków z sieci.
+     * @param enabled [in] `true`, aby pobierać brakujące kafelki z `tileUrlTemplate`.
+     */
+    void setOnlineFallbackEnabled(bool enabled);
+
+    /**
+     * @brief Ustawia szablon adresu serwera kafelków (np. `https://tile.openstreetmap.org/{z}/{x}/{y}.png`).
+     * @param urlTemplate [in] Szablon adresu z polami `{z}`, `{x}`, `{y}`.
+     */
+    void setTileUrlTemplate(const QString &urlTemplate);
+
+    /**
+     * @brief Ustawia limit pamięci podręcznej LRU.
+     * @param kilobytes [in] Limit w kilobajtach.
+     */
+    void setMemoryCacheLimit(int kilobytes);
+
+    /**
+     * @brief Zwraca kafelek ze źródeł lokalnych (pamięć, MBTiles, katalog).
+     * @param z [in] Poziom przybliżenia.
+     * @param x [in] Kolumna kafelka.
+     * @param y [in] Wiersz kafelka (schemat XYZ, jak w Leaflet).
+     * @return Dane obrazu PNG lub pusty QByteArray, jeśli kafelka nie ma lokalnie.
+     */
+    QByteArray localTile(int z, int x, int y);
+
+    /**
+     * @brief Rozpoczyna asynchroniczne pobieranie kafelka z sieci.
+     * @details Równoległe żądania tego samego kafelka są łączone w jedno.
+     * @param z [in] Poziom przybliżenia.
+     * @param x [in] Kolumna kafelka.
+     * @param y [in] Wiersz kafelka.
+     * @return `true`, jeśli pobieranie zostało rozpoczęte (lub już trwa); `false`, gdy sieć jest wyłączona.
+     */
+    bool fetchRemoteTile(int z, int x, int y);
+
+    /**
+     * @brief Planuje wczytanie do pamięci kafelków sąsiednich poziomów przybliżenia.
+     * @param z [in] Poziom przybliżenia żądanego kafelka.
+     * @param x [in] Kolumna żądanego kafelka.
+     * @param y [in] Wiersz żądanego kafelka.
+     */
+    void prefetchNeighbours(int z, int x, int y);
+
+    /**
+     * @brief Sprawdza poprawność współrzędnych kafelka.
+     * @return `true`, jeśli `0 <= z <= 22` oraz `x`, `y` mieszczą się w siatce poziomu `z`.
+     */
+    static bool isValidTile(int z, int x, int y);
+
+signals:
+    /**
+     * @brief Emitowany po pobraniu kafelka z sieci.
+     * @param z [out] Poziom przybliżenia.
+     * @param x [out] Kolumna kafelka.
+     * @param y [out] Wiersz kafelka.
+     * @param data [out] Dane obrazu PNG.
+     */
+    void tileFetched(int z, int x, int y, const QByteArray &data);
+
+    /**
+     * @brief Emitowany, gdy pobranie kafelka z sieci nie powiodło się.
+     * @param z [out] Poziom przybliżenia.
+     * @param x [out] Kolumna kafelka.
+     * @param y [out] Wiersz kafelka.
+     */
+    void tileFetchFailed(int z, int x, int y);
+
+private slots:
+    /** @brief Wczytuje do pamięci kafelki z kolejki wstępnego ładowania. */
+    void processPrefetchQueue();
+
+private:
+    /** @brief Buduje 64-bitowy klucz kafelka. */
+    static quint64 tileKey(int z, int x, int y);
+
+    /** @brief Odczytuje kafelek z pliku MBTiles. */
+    QByteArray readMbTilesTile(int z, int x, int y) const;
+
+    /** @brief Odczytuje kafelek z katalogu. */
+    QByteArray readDirectoryTile(int z, int x, int y) const;
+
+    /** @brief Zapisuje kafelek w katalogu. */
+    void writeDirectoryTile(int z, int x, int y, const QByteArray &data) const;
+
+    /** @brief Wstawia kafelek do pamięci podręcznej LRU. */
+    void insertIntoMemory(quint64 key, const QByteArray &data);
+
+    /** @brief Obsługuje zakończenie pobierania kafelka z sieci. */
+    void handleRemoteReply(QNetworkReply *reply, int z, int x, int y);
+
+    QCache<quint64, QByteArray> m_memoryCache; //!< Pamięć podręczna LRU (koszt w KB).
+    QString m_mbTilesConnectionName; //!< Nazwa połączenia QSqlDatabase dla MBTiles (pusta, gdy brak).
+    QString m_cacheDirectory; //!< Katalog z kafelkami.
+    bool m_onlineFallbackEnabled; //!< Czy brakujące kafelki są pobierane z sieci.
+    QString m_tileUrlTemplate; //!< Szablon adresu serwera kafelków.
+    QNetworkAccessManager *m_network; //!< Menedżer sieci, tworzony przy pierwszym użyciu.
+    QHash<quint64, QNetworkReply *> m_pendingFetches; //!< Trwające pobrania kafelków.
+    QList<quint64> m_prefetchQueue; //!< Kafelki oczekujące na wczytanie do pamięci.
+};
+
+#endif // MAPTILECACHE_H
@@ -0,0 +1,139 @@
+/**
+ * @file MapTileSchemeHandler.cpp
+ * @brief Implementacja klasy MapTileSchemeHandler.
+ * @author Mateusz Wojtaszek
+ * @date 2025-05-25
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include "MapTileSchemeHandler.h"
+#include "MapTileCache.h"
+#include <QWebEngineUrlRequestJob>
+#include <QWebEngineUrlScheme>
+#include <QWebEngineProfile>
+#include <QBuffer>
+#include <QFile>
+#include <QFileInfo>
+#include <QMimeDatabase>
+#include <QUrl>
+#include <QDebug>
+
+const QByteArray MapTileSchemeHandler::SCHEME_NAME = QByteArrayLiteral("orienta");
+
+const QString TILES_HOST_MTSH = "tiles";
+const QString LIBRARY_HOST_MTSH = "lib";
+const QString LEAFLET_RESOURCE_PREFIX_MTSH = ":/leaflet/";
+
+MapTileSchemeHandler::MapTileSchemeHandler(QObject *parent)
+    : QWebEngineUrlSchemeHandler(parent),
+      m_tileCache(new MapTileCache(this)) {
+    m_tileCache->applySettings();
+
+    connect(m_tileCache, &MapTileCache::tileFetched, this, &MapTileSchemeHandler::handleTileFetched);
+    connect(m_tileCache, &MapTileCache::tileFetchFailed, this, &MapTileSchemeHandler::handleTileFetchFailed);
+}
+
+void MapTileSchemeHandler::registerUrlScheme() {
+    QWebEngineUrlScheme scheme(SCHEME_NAME);
+    scheme.setSyntax(QWebEngineUrlScheme::Syntax::Host);
+    scheme.setFlags(QWebEngineUrlScheme::SecureScheme |
+                    QWebEngineUrlScheme::LocalAccessAllowed |
+                    QWebEngineUrlScheme::CorsEnabled);
+    QWebEngineUrlScheme::registerScheme(scheme);
+}
+
+void MapTileSchemeHandler::installOn(QWebEngineProfile *profile) {
+    if (profile && !profile->urlSchemeHandler(SCHEME_NAME)) {
+        profile->installUrlSchemeHandler(SCHEME_NAME, new MapTileSchemeHandler(profile));
+    }
+}
+
+bool MapTileSchemeHandler::hasEmbeddedLeaflet() {
+    return QFileInfo::exists(LEAFLET_RESOURCE_PREFIX_MTSH + QStringLiteral("leaflet.js"));
+}
+
+void MapTileSchemeHandler::requestStarted(QWebEngineUrlRequestJob *job) {
+    const QUrl url = job->requestUrl();
+    const QString path = url.path();
+    if (url.host() == TILES_HOST_MTSH) {
+        serveTile(job, path);
+    } else if (url.host() == LIBRARY_HOST_MTSH) {
+        serveLibraryFile(job, path);
+    } else {
+        job->fail(QWebEngineUrlRequestJob::UrlNotFound);
+    }
+}
+
+void MapTileSchemeHandler::serveTile(QWebEngineUrlRequestJob *job, const QString &path) {
+    // Oczekiwany format ścieżki: /<z>/<x>/<y>.png
+    const QStringList parts = path.split('/', Qt::SkipEmptyParts);
+    if (parts.size() != 3 || !parts[2].endsWith(QLatin1String(".png"))) {
+        job->fail(QWebEngineUrlRequestJob::UrlInvalid);
+        return;
+    }
+    bool okZ = false, okX = false, okY = false;
+    const int z = parts[0].toInt(&okZ);
+    const int x = parts[1].toInt(&okX);
+    const int y = parts[2].chopped(4).toInt(&okY);
+    if (!okZ || !okX || !okY || !MapTileCache::isValidTile(z, x, y)) {
+        job->fail(QWebEngineUrlRequestJob::UrlInvalid);
+        return;
+    }
+
+    const QByteArray data = m_tileCache->localTile(z, x, y);
+    m_tileCache->prefetchNeighbours(z, x, y);
+    if (!data.isEmpty()) {
+        replyWithData(job, QByteArrayLiteral("image/png"), data);
+        return;
+    }
+    if (m_tileCache->fetchRemoteTile(z, x, y)) {
+        m_pendingJobs[path].append(QPointer<QWebEngineUrlRequestJob>(job));
+        return;
+    }
+    job->fail(QWebEngineUrlRequestJob::UrlNotFound); // Offline i brak kafelka w cache
+}
+
+void MapTileSchemeHandler::serveLibraryFile(QWebEngineUrlRequestJob *job, const QString &path) {
+    if (path.contains(QLatin1String(".."))) {
+        job->fail(QWebEngineUrlRequestJob::RequestDenied);
+        return;
+    }
+    const QString resourcePath = LEAFLET_RESOURCE_PREFIX_MTSH + path.mid(1);
+    QFile resource(resourcePath);
+    if (!resource.open(QIODevice::ReadOnly)) {
+        job->fail(QWebEngineUrlRequestJob::UrlNotFound);
+        return;
+    }
+    const QByteArray mimeType = QMimeDatabase().mimeTypeForFile(resourcePath, QMimeDatabase::MatchExtension)
+            .name().toUtf8();
+    replyWithData(job, mimeType, resource.readAll());
+}
+
+void MapTileSchemeHandler::replyWithData(QWebEngineUrlRequestJob *job, const QByteArray &mimeType,
+                                         const QByteArray &data) {
+    auto *buffer = new QBuffer(job); // Bufor żyje tak długo jak zadanie
+    buffer->setData(data);
+    buffer->open(QIODevice::ReadOnly);
+    job->reply(mimeType, buffer);
+}
+
+void MapTileSchemeHandler::handleTileFetched(int z, int x, int y, const QByteArray &data) {
+    const QString path = QStringLiteral("/%1/%2/%3.png").arg(z).arg(x).arg(y);
+    const auto jobs = m_pendingJobs.take(path);
+    for (const QPointer<QWebEngineUrlRequestJob> &job: jobs) {
+        if (job) {
+            replyWithData(job, QByteArrayLiteral("image/png"), data);
+        }
+    }
+}
+
+void MapTileSchemeHandler::handleTileFetchFailed(int z, int x, int y) {
+    const QString path = QStringLiteral("/%1/%2/%3.png").arg(z).arg(x).arg(y);
+    const auto jobs = m_pendingJobs.take(path);
+    for (const QPointer<QWebEngineUrlRequestJob> &job: jobs) {
+        if (job) {
+            job->fail(QWebEngineUrlRequestJob::RequestFailed);
+        }
+    }
+}
@@ -0,0 +1,100 @@
+#ifndef MAPTILESCHEMEHANDLER_H
+#define MAPTILESCHEMEHANDLER_H
+
+/**
+ * @file MapTileSchemeHandler.h
+ * @brief Definicja klasy MapTileSchemeHandler, obsługującej schemat URL `orienta:` w QWebEngine.
+ * @author Mateusz Wojtaszek
+ * @date 2025-05-25
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include <QWebEngineUrlSchemeHandler>
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QPointer>
+
+class QWebEngineUrlRequestJob;
+class QWebEngineProfile;
+class MapTileCache;
+
+/**
+ * @class MapTileSchemeHandler
+ * @brief Serwuje stronie mapy kafelki z lokalnego cache oraz bibliotekę Leaflet z zasobów aplikacji.
+ *
+ * @details
+ * Obsługiwane adresy:
+ * - `orienta://tiles/<z>/<x>/<y>.png` - kafelek z `MapTileCache` (pamięć, MBTiles, katalog,
+ *   a przy włączonej sieci - pobranie i zapis do katalogu).
+ * - `orienta://lib/<plik>` - pliki Leaflet osadzone w zasobach Qt pod prefiksem `:/leaflet/`.
+ *
+ * Dzięki temu mapa ładuje się natychmiast i działa bez dostępu do sieci.
+ *
+ * @note Schemat musi zostać zarejestrowany przez `registerUrlScheme()` przed utworzeniem
+ * `QApplication`.
+ * @see MapTileCache
+ * @see GPSDataHandler
+ */
+class MapTileSchemeHandler : public QWebEngineUrlSchemeHandler {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Konstruktor klasy MapTileSchemeHandler.
+     * @details Konfiguruje `MapTileCache` na podstawie ustawień aplikacji
+     * (zob. `MapTileCache::applySettings()`).
+     * @param parent [in] Wskaźnik na obiekt nadrzędny. Domyślnie `nullptr`.
+     */
+    explicit MapTileSchemeHandler(QObject *parent = nullptr);
+
+    /**
+     * @brief Obsługuje żądanie zasobu w schemacie `orienta:`.
+     * @param job [in] Wskaźnik na zadanie żądania QWebEngine.
+     */
+    void requestStarted(QWebEngineUrlRequestJob *job) override;
+
+    /**
+     * @brief Rejestruje schemat `orienta:` w QWebEngine.
+     * @note Musi zostać wywołana przed utworzeniem obiektu `QApplication`.
+     */
+    static void registerUrlScheme();
+
+    /**
+     * @brief Instaluje (jednokrotnie) obsługę schematu w podanym profilu.
+     * @param profile [in] Profil QWebEngine, np. `QWebEngineProfile::defaultProfile()`.
+     */
+    static void installOn(QWebEngineProfile *profile);
+
+    /**
+     * @brief Czy biblioteka Leaflet jest dostępna w zasobach aplikacji.
+     * @return `true`, jeśli `:/leaflet/leaflet.js` istnieje.
+     */
+    static bool hasEmbeddedLeaflet();
+
+    /** @brief Nazwa schematu URL obsługiwanego przez klasę. */
+    static const QByteArray SCHEME_NAME;
+
+private slots:
+    /** @brief Odpowiada oczekującym zadaniom po pobraniu kafelka z sieci. */
+    void handleTileFetched(int z, int x, int y, const QByteArray &data);
+
+    /** @brief Kończy błędem oczekujące zadania, gdy pobranie kafelka się nie powiodło. */
+    void handleTileFetchFailed(int z, int x, int y);
+
+private:
+    /** @brief Obsługuje żądanie kafelka. */
+    void serveTile(QWebEngineUrlRequestJob *job, const QString &path);
+
+    /** @brief Obsługuje żądanie pliku biblioteki Leaflet. */
+    void serveLibraryFile(QWebEngineUrlRequestJob *job, const QString &path);
+
+    /** @brief Odpowiada na zadanie podanymi danymi. */
+    static void replyWithData(QWebEngineUrlRequestJob *job, const QByteArray &mimeType, const QByteArray &data);
+
+    MapTileCache *m_tileCache; //!< Źródło kafelków.
+    QHash<QString, QList<QPointer<QWebEngineUrlRequestJob>>> m_pendingJobs; //!< Zadania czekające na pobranie kafelka.
+};
+
+#endif // MAPTILESCHEMEHANDLER_H
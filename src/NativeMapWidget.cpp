@@ -0,0 +1,278 @@
+/**
+ * @file NativeMapWidget.cpp
+ * @brief Implementacja klasy NativeMapWidget.
+ * @author Mateusz Wojtaszek
+ * @date 2025-05-27
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include "NativeMapWidget.h"
+#include "MapTileCache.h"
+#include "PerfCounters.h"
+#include <QPainter>
+#include <QPolygonF>
+#include <QMouseEvent>
+#include <QWheelEvent>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QtMath>
+#include <cmath>
+
+constexpr int TILE_SIZE_PX_NMW = 256;
+constexpr int MIN_ZOOM_NMW = 2;
+constexpr int MAX_ZOOM_NMW = 19;
+constexpr int DEFAULT_ZOOM_NMW = 15;
+constexpr int REPAINT_INTERVAL_MS_NMW = 33; // ~30 klatek/s
+constexpr int PIXMAP_CACHE_KB_NMW = 48 * 1024; // Zdekodowany kafelek 256x256 ARGB to 256 KB
+constexpr int MAX_TRACK_VERTICES_NMW = 20000;
+
+/**
+ * @brief Buduje 64-bitowy klucz kafelka dla pamięci podręcznej obrazów.
+ */
+static quint64 pixmapKey(int z, int x, int y) {
+    return (static_cast<quint64>(z) << 48) | (static_cast<quint64>(x) << 24) | static_cast<quint64>(y);
+}
+
+NativeMapWidget::NativeMapWidget(QWidget *parent)
+    : QWidget(parent),
+      m_tileCache(new MapTileCache(this)),
+      m_pixmapCache(PIXMAP_CACHE_KB_NMW),
+      m_repaintTimer(new QTimer(this)),
+      m_zoom(DEFAULT_ZOOM_NMW),
+      m_followMarker(true),
+      m_hasMarker(false),
+      m_markerLatitude(0.0),
+      m_markerLongitude(0.0),
+      m_dragging(false) {
+    m_tileCache->applySettings();
+    connect(m_tileCache, &MapTileCache::tileFetched, this, &NativeMapWidget::handleTileFetched);
+
+    m_repaintTimer->setSingleShot(true);
+    m_repaintTimer->setInterval(REPAINT_INTERVAL_MS_NMW);
+    connect(m_repaintTimer, &QTimer::timeout, this, qOverload<>(&QWidget::update));
+
+    m_centerWorld = worldPixel(0.0, 0.0);
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+    setAttribute(Qt::WA_OpaquePaintEvent); // Kafelki i tło pokrywają cały obszar
+    setMouseTracking(false);
+}
+
+QSize NativeMapWidget::sizeHint() const {
+    return QSize(640, 480);
+}
+
+void NativeMapWidget::setMarkerPosition(double latitude, double longitude) {
+    m_markerLatitude = latitude;
+    m_markerLongitude = longitude;
+    m_hasMarker = true;
+
+    m_trackSimplifier.addPoint(latitude, longitude);
+    m_trackVertices += m_trackSimplifier.takeCommitted();
+    if (m_trackVertices.size() > MAX_TRACK_VERTICES_NMW) {
+        m_trackVertices.remove(0, m_trackVertices.size() - MAX_TRACK_VERTICES_NMW);
+    }
+
+    if (m_followMarker && !m_dragging) {
+        m_centerWorld = worldPixel(latitude, longitude);
+    }
+    scheduleRepaint();
+}
+
+void NativeMapWidget::setTrackTolerance(double toleranceMeters) {
+    m_trackSimplifier.setTolerance(toleranceMeters);
+}
+
+void NativeMapWidget::clearTrack() {
+    m_trackSimplifier.reset();
+    m_trackVertices.clear();
+    scheduleRepaint();
+}
+
+void NativeMapWidget::setZoom(int zoom) {
+    const int newZoom = qBound(MIN_ZOOM_NMW, zoom, MAX_ZOOM_NMW);
+    if (newZoom == m_zoom) {
+        return;
+    }
+    m_centerWorld *= std::ldexp(1.0, newZoom - m_zoom);
+    m_zoom = newZoom;
+    scheduleRepaint();
+}
+
+void NativeMapWidget::scheduleRepaint() {
+    if (!m_repaintTimer->isActive()) {
+        m_repaintTimer->start();
+    }
+}
+
+QPointF NativeMapWidget::worldPixel(double latitude, double longitude) const {
+    const double worldSize = TILE_SIZE_PX_NMW * std::ldexp(1.0, m_zoom);
+    const double clampedLat = qBound(-85.05112878, latitude, 85.05112878);
+    const double latRad = qDegreesToRadians(clampedLat);
+    const double x = (longitude + 180.0) / 360.0 * worldSize;
+    const double y = (1.0 - std::asinh(std::tan(latRad)) / M_PI) / 2.0 * worldSize;
+    return QPointF(x, y);
+}
+
+QPointF NativeMapWidget::screenPoint(double latitude, double longitude) const {
+    const QPointF halfSize(width() / 2.0, height() / 2.0);
+    return worldPixel(latitude, longitude) - m_centerWorld + halfSize;
+}
+
+QPixmap NativeMapWidget::tilePixmap(int z, int x, int y) {
+    const quint64 key = pixmapKey(z, x, y);
+    if (const QPixmap *cached = m_pixmapCache.object(key)) {
+        return *cached;
+    }
+    const QByteArray data = m_tileCache->localTile(z, x, y);
+    if (data.isEmpty()) {
+        m_tileCache->fetchRemoteTile(z, x, y); // Odpowiedź przyjdzie przez tileFetched()
+        return QPixmap();
+    }
+    QPixmap pixmap;
+    if (!pixmap.loadFromData(data)) {
+        return QPixmap();
+    }
+    m_pixmapCache.insert(key, new QPixmap(pixmap), TILE_SIZE_PX_NMW * TILE_SIZE_PX_NMW * 4 / 1024);
+    return pixmap;
+}
+
+void NativeMapWidget::handleTileFetched(int z, int x, int y, const QByteArray &data) {
+    Q_UNUSED(x);
+    Q_UNUSED(y);
+    Q_UNUSED(data);
+    if (z == m_zoom) {
+        scheduleRepaint();
+    }
+}
+
+void NativeMapWidget::paintEvent(QPaintEvent *event) {
+    Q_UNUSED(event);
+    QElapsedTimer paintTimer;
+    paintTimer.start();
+    QPainter painter(this);
+    painter.fillRect(rect(), QColor(Qt::lightGray));
+
+    // Zakres kafelków widocznych w oknie
+    const QPointF topLeftWorld = m_centerWorld - QPointF(width() / 2.0, height() / 2.0);
+    const int tilesPerAxis = 1 << m_zoom;
+    const int firstTileX = static_cast<int>(std::floor(topLeftWorld.x() / TILE_SIZE_PX_NMW));
+    const int firstTileY = static_cast<int>(std::floor(topLeftWorld.y() / TILE_SIZE_PX_NMW));
+    const int lastTileX = static_cast<int>(std::floor((topLeftWorld.x() + width()) / TILE_SIZE_PX_NMW));
+    const int lastTileY = static_cast<int>(std::floor((topLeftWorld.y() + height()) / TILE_SIZE_PX_NMW));
+
+    for (int tileY = firstTileY; tileY <= lastTileY; ++tileY) {
+        if (tileY < 0 || tileY >= tilesPerAxis) {
+            continue;
+        }
+        for (int tileX = firstTileX; tileX <= lastTileX; ++tileX) {
+            const int wrappedX = ((tileX % tilesPerAxis) + tilesPerAxis) % tilesPerAxis; // Zawijanie po długości
+            const QPixmap tile = tilePixmap(m_zoom, wrappedX, tileY);
+            if (tile.isNull()) {
+                continue;
+            }
+            const QPointF target(tileX * TILE_SIZE_PX_NMW - topLeftWorld.x(), tileY * TILE_SIZE_PX_NMW - topLeftWorld.y());
+            painter.drawPixmap(target, tile);
+        }
+    }
+    if (firstTileX >= 0 && firstTileY >= 0) {
+        m_tileCache->prefetchNeighbours(m_zoom, qBound(0, (firstTileX + lastTileX) / 2, tilesPerAxis - 1),
+                                        qBound(0, (firstTileY + lastTileY) / 2, tilesPerAxis - 1));
+    }
+
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    // Trasa: zatwierdzone wierzchołki + odcinek do bieżącej pozycji markera
+    if (!m_trackVertices.isEmpty()) {
+        QPolygonF trackPolygon;
+        trackPolygon.reserve(m_trackVertices.size() + 1);
+        for (const TrackSimplifier::Point &vertex: std::as_const(m_trackVertices)) {
+            trackPolygon << screenPoint(vertex.latitude, vertex.longitude);
+        }
+        if (m_hasMarker) {
+            trackPolygon << screenPoint(m_markerLatitude, m_markerLongitude);
+        }
+        painter.setPen(QPen(QColor(Qt::blue), 3, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
+        painter.setBrush(Qt::NoBrush);
+        painter.drawPolyline(trackPolygon);
+    }
+
+    // Marker
+    if (m_hasMarker) {
+        const QPointF markerPoint = screenPoint(m_markerLatitude, m_markerLongitude);
+        painter.setPen(QPen(Qt::white, 2));
+        painter.setBrush(QColor(0x1E, 0x88, 0xE5));
+        painter.drawEllipse(markerPoint, 7, 7);
+    }
+
+    // Atrybucja wymagana przez licencję danych OSM
+    const QString attribution = QStringLiteral("© OpenStreetMap contributors");
+    QFont attributionFont = font();
+    attributionFont.setPixelSize(11);
+    painter.setFont(attributionFont);
+    const QRect textRect = painter.fontMetrics().boundingRect(attribution).adjusted(-4, -2, 4, 2);
+    const QRect attributionRect(width() - textRect.width(), height() - textRect.height(),
+                                textRect.width(), textRect.height());
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(QColor(255, 255, 255, 200));
+    painter.drawRect(attributionRect);
+    painter.setPen(Qt::black);
+    painter.drawText(attributionRect, Qt::AlignCenter, attribution);
+    PerfCounters::addPaintTime(PerfCounters::PaintSource::Map, paintTimer.nsecsElapsed());
+}
+
+void NativeMapWidget::mousePressEvent(QMouseEvent *event) {
+    if (event->button() == Qt::LeftButton) {
+        m_dragging = true;
+        m_followMarker = false;
+        m_lastDragPosition = event->position().toPoint();
+    }
+    QWidget::mousePressEvent(event);
+}
+
+void NativeMapWidget::mouseMoveEvent(QMouseEvent *event) {
+    if (m_dragging) {
+        const QPoint position = event->position().toPoint();
+        m_centerWorld -= QPointF(position - m_lastDragPosition);
+        m_lastDragPosition = position;
+        update(); // Interakcja użytkownika - bez opóźnienia
+    }
+    QWidget::mouseMoveEvent(event);
+}
+
+void NativeMapWidget::mouseReleaseEvent(QMouseEvent *event) {
+    if (event->button() == Qt::LeftButton) {
+        m_dragging = false;
+    }
+    QWidget::mouseReleaseEvent(event);
+}
+
+void NativeMapWidget::mouseDoubleClickEvent(QMouseEvent *event) {
+    m_followMarker = true;
+    if (m_hasMarker) {
+        m_centerWorld = worldPixel(m_markerLatitude, m_markerLongitude);
+    }
+    update();
+    QWidget::mouseDoubleClickEvent(event);
+}
+
+void NativeMapWidget::wheelEvent(QWheelEvent *event) {
+    const int steps = event->angleDelta().y() / 120;
+    if (steps == 0) {
+        return;
+    }
+    const int newZoom = qBound(MIN_ZOOM_NMW, m_zoom + steps, MAX_ZOOM_NMW);
+    if (newZoom == m_zoom) {
+        return;
+    }
+    // Punkt pod kursorem pozostaje w miejscu
+    const QPointF cursorOffset = event->position() - QPointF(width() / 2.0, height() / 2.0);
+    const QPointF cursorWorld = m_centerWorld + cursorOffset;
+    const double scale = std::ldexp(1.0, newZoom - m_zoom);
+    m_zoom = newZoom;
+    m_centerWorld = m_followMarker && m_hasMarker
+                        ? worldPixel(m_markerLatitude, m_markerLongitude)
+                        : cursorWorld * scale - cursorOffset;
+    update();
+    event->accept();
+}
@@ -0,0 +1,130 @@
+#ifndef NATIVEMAPWIDGET_H
+#define NATIVEMAPWIDGET_H
+
+/**
+ * @file NativeMapWidget.h
+ * @brief Definicja klasy NativeMapWidget, lekkiej mapy kafelkowej rysowanej przez QPainter.
+ * @author Mateusz Wojtaszek
+ * @date 2025-05-27
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include <QWidget>
+#include <QCache>
+#include <QPixmap>
+#include <QPoint>
+#include <QPointF>
+#include <QVector>
+#include "TrackSimplifier.h"
+
+class QTimer;
+class MapTileCache;
+
+/**
+ * @class NativeMapWidget
+ * @brief Mapa OpenStreetMap (slippy map) rysowana natywnie, bez QWebEngine.
+ *
+ * @details
+ * Alternatywa dla widoku Leaflet w `QWebEngineView` dla wdrożeń z małą ilością pamięci.
+ * Kafelki pochodzą z `MapTileCache` (pamięć LRU, MBTiles, katalog, opcjonalnie sieć),
+ * a zdekodowane obrazy są dodatkowo przechowywane w `QCache<QPixmap>`.
+ *
+ * Obsługa:
+ * - przeciąganie myszą - przesuwanie mapy (wyłącza śledzenie markera),
+ * - kółko myszy - przybliżanie/oddalanie względem kursora,
+ * - dwuklik - ponowne włączenie śledzenia markera.
+ *
+ * Marker i trasa (upraszczana przez `TrackSimplifier`) są rysowane nad kafelkami. Odświeżanie
+ * jest ograniczone do ok. 30 klatek/s niezależnie od częstotliwości danych.
+ *
+ * @see GPSDataHandler
+ * @see MapTileCache
+ */
+class NativeMapWidget : public QWidget {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Konstruktor klasy NativeMapWidget.
+     * @param parent [in] Wskaźnik na widget nadrzędny. Domyślnie `nullptr`.
+     */
+    explicit NativeMapWidget(QWidget *parent = nullptr);
+
+    /**
+     * @brief Ustawia pozycję markera i dodaje punkt do trasy.
+     * @param latitude [in] Szerokość geograficzna w stopniach dziesiętnych.
+     * @param longitude [in] Długość geograficzna w stopniach dziesiętnych.
+     */
+    void setMarkerPosition(double latitude, double longitude);
+
+    /**
+     * @brief Ustawia tolerancję upraszczania trasy.
+     * @param toleranceMeters [in] Tolerancja w metrach.
+     */
+    void setTrackTolerance(double toleranceMeters);
+
+    /** @brief Usuwa trasę. */
+    void clearTrack();
+
+    /**
+     * @brief Ustawia poziom przybliżenia mapy.
+     * @param zoom [in] Poziom przybliżenia (ograniczany do zakresu 2-19).
+     */
+    void setZoom(int zoom);
+
+    /** @brief Zwraca preferowany rozmiar widgetu. */
+    QSize sizeHint() const override;
+
+protected:
+    /** @brief Rysuje kafelki, trasę i marker. */
+    void paintEvent(QPaintEvent *event) override;
+
+    /** @brief Rozpoczyna przeciąganie mapy. */
+    void mousePressEvent(QMouseEvent *event) override;
+
+    /** @brief Przesuwa mapę podczas przeciągania. */
+    void mouseMoveEvent(QMouseEvent *event) override;
+
+    /** @brief Kończy przeciąganie mapy. */
+    void mouseReleaseEvent(QMouseEvent *event) override;
+
+    /** @brief Włącza ponownie śledzenie markera. */
+    void mouseDoubleClickEvent(QMouseEvent *event) override;
+
+    /** @brief Zmienia poziom przybliżenia względem pozycji kursora. */
+    void wheelEvent(QWheelEvent *event) override;
+
+private slots:
+    /** @brief Odświeża widok po pobraniu kafelka z sieci. */
+    void handleTileFetched(int z, int x, int y, const QByteArray &data);
+
+private:
+    /** @brief Planuje odświeżenie widoku (z ograniczeniem częstotliwości). */
+    void scheduleRepaint();
+
+    /** @brief Zwraca zdekodowany kafelek lub pusty QPixmap (i zleca pobranie). */
+    QPixmap tilePixmap(int z, int x, int y);
+
+    /** @brief Przelicza współrzędne geograficzne na piksele świata przy bieżącym przybliżeniu (Web Mercator). */
+    QPointF worldPixel(double latitude, double longitude) const;
+
+    /** @brief Przelicza współrzędne geograficzne na współrzędne ekranu widgetu. */
+    QPointF screenPoint(double latitude, double longitude) const;
+
+    MapTileCache *m_tileCache; //!< Źródło kafelków.
+    QCache<quint64, QPixmap> m_pixmapCache; //!< Zdekodowane kafelki (koszt w KB).
+    QTimer *m_repaintTimer; //!< Jednorazowy timer ograniczający częstotliwość odświeżania.
+    int m_zoom; //!< Bieżący poziom przybliżenia.
+    QPointF m_centerWorld; //!< Środek widoku w pikselach świata przy bieżącym przybliżeniu.
+    bool m_followMarker; //!< Czy widok podąża za markerem.
+    bool m_hasMarker; //!< Czy marker ma znaną pozycję.
+    double m_markerLatitude; //!< Szerokość geograficzna markera.
+    double m_markerLongitude; //!< Długość geograficzna markera.
+    bool m_dragging; //!< Czy trwa przeciąganie mapy.
+    QPoint m_lastDragPosition; //!< Ostatnia pozycja kursora podczas przeciągania.
+    TrackSimplifier m_trackSimplifier; //!< Przyrostowe upraszczanie trasy.
+    QVector<TrackSimplifier::Point> m_trackVertices; //!< Zatwierdzone wierzchołki trasy.
+};
+
+#endif // NATIVEMAPWIDGET_H
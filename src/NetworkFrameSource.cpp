@@ -0,0 +1,231 @@
+/**
+ * @file NetworkFrameSource.cpp
+ * @brief Implementacja klasy NetworkFrameSource.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-05
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include "NetworkFrameSource.h"
+#include "LatencyTracer.h"
+#include <QUdpSocket>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QDebug>
+
+const QString UDP_SCHEME_NFS = QStringLiteral("udp://");
+const QString TCP_SCHEME_NFS = QStringLiteral("tcp://");
+
+NetworkFrameSource::NetworkFrameSource(QObject *parent)
+    : FrameSource(parent),
+      m_reconnectTimer(new QTimer(this)),
+      m_connectTimer(new QTimer(this)) {
+    m_reconnectTimer->setSingleShot(true);
+    m_reconnectTimer->setInterval(TCP_RECONNECT_INTERVAL_MS);
+    connect(m_reconnectTimer, &QTimer::timeout, this, &NetworkFrameSource::reconnect);
+    m_connectTimer->setSingleShot(true);
+    m_connectTimer->setInterval(TCP_CONNECT_TIMEOUT_MS);
+    connect(m_connectTimer, &QTimer::timeout, this, &NetworkFrameSource::handleConnectTimeout);
+}
+
+NetworkFrameSource::~NetworkFrameSource() {
+    close();
+}
+
+bool NetworkFrameSource::parseAddress(const QString &address, Protocol &protocol, QString &host, quint16 &port) {
+    QString hostAndPort = address.trimmed();
+    if (hostAndPort.startsWith(UDP_SCHEME_NFS, Qt::CaseInsensitive)) {
+        protocol = Protocol::Udp;
+    } else if (hostAndPort.startsWith(TCP_SCHEME_NFS, Qt::CaseInsensitive)) {
+        protocol = Protocol::Tcp;
+    } else {
+        return false;
+    }
+    hostAndPort = hostAndPort.mid(UDP_SCHEME_NFS.size()); // Oba schematy mają tę samą długość
+    const qsizetype separator = hostAndPort.lastIndexOf(':');
+    if (separator < 0) {
+        return false;
+    }
+    bool ok = false;
+    const uint parsedPort = hostAndPort.mid(separator + 1).toUInt(&ok);
+    if (!ok || parsedPort > 65535) {
+        return false;
+    }
+    host = hostAndPort.left(separator);
+    if (host.startsWith('[') && host.endsWith(']')) {
+        host = host.mid(1, host.size() - 2); // Adres IPv6 w nawiasach
+    }
+    port = static_cast<quint16>(parsedPort);
+    return protocol == Protocol::Udp || (!host.isEmpty() && port != 0);
+}
+
+bool NetworkFrameSource::open(const QString &address) {
+    Protocol protocol = Protocol::Udp;
+    QString host;
+    quint16 port = 0;
+    if (!parseAddress(address, protocol, host, port)) {
+        m_lastError = tr("Invalid address \"%1\" - expected udp://[address]:port or tcp://host:port.").arg(address);
+        return false;
+    }
+    if (protocol == Protocol::Tcp) {
+        return openTcp(host, port);
+    }
+    return openUdp(host.isEmpty() ? QHostAddress(QHostAddress::Any) : QHostAddress(host), port);
+}
+
+bool NetworkFrameSource::openUdp(const QHostAddress &bindAddress, quint16 port) {
+    close();
+    m_protocol = Protocol::Udp;
+    m_udpSocket = new QUdpSocket(this);
+    if (!m_udpSocket->bind(bindAddress, port)) {
+        m_lastError = m_udpSocket->errorString();
+        qWarning() << "Failed to bind UDP socket on" << bindAddress << port << "Error:" << m_lastError;
+        delete m_udpSocket;
+        m_udpSocket = nullptr;
+        return false;
+    }
+    // Większy bufor jądra - paczki datagramów nie przepadają, gdy wątek I/O jest chwilowo zajęty
+    m_udpSocket->setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption, UDP_RECEIVE_BUFFER_BYTES);
+    connect(m_udpSocket, &QUdpSocket::readyRead, this, &NetworkFrameSource::readDatagrams);
+    connect(m_udpSocket, &QUdpSocket::errorOccurred, this, &NetworkFrameSource::handleSocketError);
+
+    m_address = QStringLiteral("udp://%1:%2")
+            .arg(bindAddress == QHostAddress(QHostAddress::Any) ? QString() : bindAddress.toString())
+            .arg(m_udpSocket->localPort());
+    m_packetsReceived = 0;
+    resetDecoder(0); // Prędkość łącza nieznana - znacznik czasu to chwila odczytu datagramu
+    qInfo() << "Listening for telemetry datagrams on" << m_address;
+    return true;
+}
+
+bool NetworkFrameSource::openTcp(const QString &host, quint16 port) {
+    close();
+    m_protocol = Protocol::Tcp;
+    m_tcpHost = host;
+    m_tcpPort = port;
+    m_address = QStringLiteral("tcp://%1:%2").arg(host).arg(port);
+    m_tcpSocket = new QTcpSocket(this);
+    connect(m_tcpSocket, &QTcpSocket::connected, this, &NetworkFrameSource::handleConnected);
+    connect(m_tcpSocket, &QTcpSocket::readyRead, this, &NetworkFrameSource::readStream);
+    connect(m_tcpSocket, &QTcpSocket::errorOccurred, this, &NetworkFrameSource::handleSocketError);
+    connect(m_tcpSocket, &QTcpSocket::disconnected, this, &NetworkFrameSource::handleDisconnected);
+
+    // Bez waitForConnected() - wątek I/O obsługuje w tym czasie pozostałe urządzenia
+    m_packetsReceived = 0;
+    reconnect();
+    qInfo() << "Connecting to telemetry stream" << m_address;
+    return true;
+}
+
+bool NetworkFrameSource::isConnected() const {
+    if (m_tcpSocket) {
+        return m_tcpSocket->state() == QAbstractSocket::ConnectedState;
+    }
+    return m_udpSocket != nullptr;
+}
+
+void NetworkFrameSource::handleConnected() {
+    m_connectTimer->stop();
+    m_tcpSocket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+    resetDecoder(0);
+    qInfo() << "Connected to telemetry stream" << m_address;
+    emit connected();
+}
+
+void NetworkFrameSource::handleConnectTimeout() {
+    if (!m_tcpSocket || m_tcpSocket->state() == QAbstractSocket::ConnectedState) {
+        return;
+    }
+    m_lastError = tr("Connection to %1 timed out.").arg(m_address);
+    qWarning() << "Telemetry stream" << m_address << "error:" << m_lastError;
+    m_tcpSocket->abort(); // Przerwanie łączenia nie emituje disconnected()
+    emit errorOccurred(m_lastError);
+    handleDisconnected();
+}
+
+void NetworkFrameSource::close() {
+    m_reconnectTimer->stop();
+    m_connectTimer->stop();
+    if (m_udpSocket) {
+        m_udpSocket->disconnect(this);
+        m_udpSocket->close();
+        m_udpSocket->deleteLater();
+        m_udpSocket = nullptr;
+    }
+    if (m_tcpSocket) {
+        m_tcpSocket->disconnect(this); // Zamknięcie na żądanie nie jest zerwaniem połączenia
+        m_tcpSocket->abort();
+        m_tcpSocket->deleteLater();
+        m_tcpSocket = nullptr;
+    }
+    discardPartialLine();
+}
+
+bool NetworkFrameSource::isOpen() const {
+    return m_udpSocket != nullptr || m_tcpSocket != nullptr;
+}
+
+quint16 NetworkFrameSource::localPort() const {
+    return m_udpSocket ? m_udpSocket->localPort() : 0;
+}
+
+void NetworkFrameSource::readDatagrams() {
+    while (m_udpSocket && m_udpSocket->hasPendingDatagrams()) {
+        const qint64 receivedNs = LatencyTracer::nowNs();
+        const qint64 size = m_udpSocket->pendingDatagramSize();
+        m_datagram.resize(qMax<qint64>(0, size)); // Pojemność zachowana między datagramami
+        const qint64 read = m_udpSocket->readDatagram(m_datagram.data(), m_datagram.size());
+        if (read <= 0) {
+            continue;
+        }
+        m_datagram.resize(read);
+        if (!m_datagram.endsWith('\n')) {
+            m_datagram.append('\n'); // Koniec datagramu kończy linię - nie sklejaj z następnym
+        }
+        ++m_packetsReceived;
+        ingest(m_datagram, receivedNs);
+    }
+}
+
+void NetworkFrameSource::readStream() {
+    if (!m_tcpSocket) {
+        return;
+    }
+    const qint64 receivedNs = LatencyTracer::nowNs();
+    const QByteArray chunk = m_tcpSocket->readAll();
+    if (!chunk.isEmpty()) {
+        ++m_packetsReceived;
+        ingest(chunk, receivedNs);
+    }
+}
+
+void NetworkFrameSource::handleSocketError(QAbstractSocket::SocketError error) {
+    if (error == QAbstractSocket::RemoteHostClosedError) {
+        return; // Obsługiwane przez handleDisconnected()
+    }
+    const QAbstractSocket *socket = m_udpSocket ? static_cast<QAbstractSocket *>(m_udpSocket) : m_tcpSocket;
+    m_lastError = socket ? socket->errorString() : tr("Socket not initialized.");
+    qWarning() << "Network source" << m_address << "error:" << error << "-" << m_lastError;
+    emit errorOccurred(m_lastError);
+    if (m_tcpSocket && m_tcpSocket->state() == QAbstractSocket::UnconnectedState) {
+        handleDisconnected(); // Nieudana próba ponownego połączenia
+    }
+}
+
+void NetworkFrameSource::handleDisconnected() {
+    m_connectTimer->stop();
+    if (!m_tcpSocket || m_reconnectTimer->isActive()) {
+        return;
+    }
+    qWarning() << "Telemetry stream" << m_address << "disconnected - retrying in" << TCP_RECONNECT_INTERVAL_MS << "ms.";
+    discardPartialLine(); // Urwana linia nie może skleić się z danymi nowego połączenia
+    m_reconnectTimer->start();
+}
+
+void NetworkFrameSource::reconnect() {
+    if (m_tcpSocket && m_tcpSocket->state() == QAbstractSocket::UnconnectedState) {
+        m_tcpSocket->connectToHost(m_tcpHost, m_tcpPort, QIODevice::ReadOnly); // Asynchronicznie
+        m_connectTimer->start();
+    }
+}
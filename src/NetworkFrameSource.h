@@ -0,0 +1,160 @@
+#ifndef NETWORKFRAMESOURCE_H
+#define NETWORKFRAMESOURCE_H
+
+/**
+ * @file NetworkFrameSource.h
+ * @brief Definicja klasy NetworkFrameSource - odbiór ramek `CSV*CRC16` przez UDP lub TCP.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-05
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include <QAbstractSocket>
+#include <QByteArray>
+#include <QHostAddress>
+#include <QString>
+#include "FrameSource.h"
+
+class QUdpSocket;
+class QTcpSocket;
+class QTimer;
+
+/**
+ * @class NetworkFrameSource
+ * @brief Źródło ramek z sieci (np. głowice sensorów przez Wi-Fi) dekodowanych tak samo jak z portu szeregowego.
+ *
+ * @details
+ * Adres źródła ma postać:
+ * - `udp://[adres]:port` - nasłuch datagramów na porcie (domyślnie na wszystkich interfejsach);
+ *   każdy datagram zawiera jedną lub więcej kompletnych linii `CSV*CRC16`,
+ * - `tcp://host:port` - połączenie ze strumieniem TCP udostępnianym przez urządzenie. Połączenie jest
+ *   nawiązywane asynchronicznie (bez blokowania wątku I/O); nieudana próba lub zerwanie połączenia
+ *   jest zgłaszane sygnałem `errorOccurred()`, a kolejna próba następuje po `TCP_RECONNECT_INTERVAL_MS`.
+ *
+ * Datagram jest niepodzielny, więc linia niezakończona znakiem końca linii nie jest sklejana
+ * z kolejnym datagramem - jest zamykana i trafia do diagnostyki jako błędna ramka.
+ */
+class NetworkFrameSource : public FrameSource {
+    Q_OBJECT
+
+public:
+    /**
+     * @enum Protocol
+     * @brief Protokół transportowy źródła.
+     */
+    enum class Protocol {
+        Udp, //!< Datagramy UDP.
+        Tcp //!< Strumień TCP.
+    };
+
+    static constexpr int TCP_CONNECT_TIMEOUT_MS = 3000; //!< Limit czasu jednej próby nawiązania połączenia TCP.
+    static constexpr int TCP_RECONNECT_INTERVAL_MS = 1000; //!< Odstęp prób ponownego połączenia TCP.
+    static constexpr int UDP_RECEIVE_BUFFER_BYTES = 1 << 20; //!< Bufor odbiorczy gniazda UDP (paczki datagramów).
+
+    /**
+     * @brief Konstruktor klasy NetworkFrameSource.
+     * @param parent [in] Obiekt nadrzędny.
+     */
+    explicit NetworkFrameSource(QObject *parent = nullptr);
+
+    /**
+     * @brief Destruktor - zamyka gniazdo.
+     */
+    ~NetworkFrameSource() override;
+
+    /**
+     * @brief Otwiera źródło wg adresu `udp://[adres]:port` lub `tcp://host:port`.
+     * @param address [in] Adres źródła.
+     * @return `true`, jeśli gniazdo zostało otwarte (dla TCP - rozpoczęto łączenie).
+     */
+    bool open(const QString &address);
+
+    /**
+     * @brief Rozpoczyna nasłuch datagramów UDP.
+     * @param bindAddress [in] Adres lokalny (`QHostAddress::Any` - wszystkie interfejsy).
+     * @param port [in] Port lokalny (0 - dowolny wolny port, zob. `localPort()`).
+     * @return `true`, jeśli gniazdo zostało powiązane z portem.
+     */
+    bool openUdp(const QHostAddress &bindAddress, quint16 port);
+
+    /**
+     * @brief Rozpoczyna łączenie ze strumieniem TCP urządzenia i wraca bez czekania na wynik.
+     * @details Ramki płyną po sygnale `connected()`; błąd próby jest zgłaszany przez `errorOccurred()`.
+     * @param host [in] Nazwa lub adres urządzenia.
+     * @param port [in] Port urządzenia.
+     * @return `true` (łączenie rozpoczęte; wynik przychodzi asynchronicznie).
+     */
+    bool openTcp(const QString &host, quint16 port);
+
+    /** @brief Czy strumień TCP jest połączony (dla UDP - czy gniazdo jest otwarte). */
+    bool isConnected() const;
+
+    void close() override;
+    bool isOpen() const override;
+    QString sourceName() const override { return m_address; }
+    QString getLastError() const override { return m_lastError; }
+
+    /** @brief Zwraca protokół ostatnio otwartego źródła. */
+    Protocol protocol() const { return m_protocol; }
+
+    /** @brief Zwraca lokalny port gniazda UDP (0, jeśli nie jest otwarte). */
+    quint16 localPort() const;
+
+    /** @brief Zwraca liczbę datagramów (UDP) lub porcji strumienia (TCP) odebranych od otwarcia. */
+    quint64 packetsReceived() const { return m_packetsReceived; }
+
+    /**
+     * @brief Rozkłada adres źródła na protokół, host i port.
+     * @param address [in] Adres `udp://[adres]:port` lub `tcp://host:port`.
+     * @param protocol [out] Protokół.
+     * @param host [out] Host (pusty dla UDP bez adresu).
+     * @param port [out] Port.
+     * @return `true`, jeśli adres jest poprawny.
+     */
+    static bool parseAddress(const QString &address, Protocol &protocol, QString &host, quint16 &port);
+
+signals:
+    /** @brief Emitowany po nawiązaniu (także ponownym) połączenia TCP. */
+    void connected();
+
+private slots:
+    /** @brief Odczytuje wszystkie oczekujące datagramy. */
+    void readDatagrams();
+
+    /** @brief Odczytuje dostępne bajty strumienia TCP. */
+    void readStream();
+
+    /**
+     * @brief Obsługuje błąd gniazda.
+     * @param error [in] Kod błędu.
+     */
+    void handleSocketError(QAbstractSocket::SocketError error);
+
+    /** @brief Przygotowuje dekodowanie po nawiązaniu połączenia TCP. */
+    void handleConnected();
+
+    /** @brief Przerywa próbę połączenia TCP, która trwa dłużej niż `TCP_CONNECT_TIMEOUT_MS`. */
+    void handleConnectTimeout();
+
+    /** @brief Planuje ponowne połączenie po zerwaniu połączenia TCP. */
+    void handleDisconnected();
+
+    /** @brief Rozpoczyna (ponowną) próbę połączenia TCP. */
+    void reconnect();
+
+private:
+    QUdpSocket *m_udpSocket = nullptr; //!< Gniazdo UDP (tylko dla `Protocol::Udp`).
+    QTcpSocket *m_tcpSocket = nullptr; //!< Gniazdo TCP (tylko dla `Protocol::Tcp`).
+    QTimer *m_reconnectTimer; //!< Timer ponownych prób połączenia TCP.
+    QTimer *m_connectTimer; //!< Limit czasu bieżącej próby połączenia TCP.
+    Protocol m_protocol = Protocol::Udp; //!< Protokół bieżącego źródła.
+    QString m_address; //!< Adres źródła do wyświetlenia.
+    QString m_lastError; //!< Opis ostatniego błędu.
+    QString m_tcpHost; //!< Host strumienia TCP (ponowne połączenia).
+    quint16 m_tcpPort = 0; //!< Port strumienia TCP.
+    QByteArray m_datagram; //!< Bufor datagramu wielokrotnego użytku.
+    quint64 m_packetsReceived = 0; //!< Odebrane datagramy lub porcje strumienia.
+};
+
+#endif // NETWORKFRAMESOURCE_H
@@ -0,0 +1,100 @@
+/**
+ * @file PerfCounters.cpp
+ * @brief Implementacja klasy PerfCounters.
+ * @author Mateusz Wojtaszek
+ * @date 2025-05-29
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include "PerfCounters.h"
+#include <array>
+#include <atomic>
+
+constexpr int PAINT_SOURCE_COUNT_PC = static_cast<int>(PerfCounters::PaintSource::Count);
+
+namespace {
+std::atomic<quint64> framesReceived{0};
+std::atomic<quint64> crcFailures{0};
+std::atomic<quint64> parseFailures{0};
+std::atomic<quint64> framesLost{0};
+std::atomic<quint64> duplicateFrames{0};
+std::atomic<quint64> lateFrames{0};
+std::atomic<qint64> queueDepthBytes{0};
+std::atomic<qint64> frameIntervalNs{0};
+std::atomic<qint64> frameJitterNs{0};
+std::atomic<quint64> uiFrames{0};
+std::atomic<quint64> filterChannelSamples{0};
+std::atomic<quint64> filterTimeNs{0};
+std::array<std::atomic<quint64>, PAINT_SOURCE_COUNT_PC> paintCount{};
+std::array<std::atomic<quint64>, PAINT_SOURCE_COUNT_PC> paintTimeNs{};
+} // namespace
+
+void PerfCounters::addFrameReceived() {
+    framesReceived.fetch_add(1, std::memory_order_relaxed);
+}
+
+void PerfCounters::addCrcFailure() {
+    crcFailures.fetch_add(1, std::memory_order_relaxed);
+}
+
+void PerfCounters::addParseFailure() {
+    parseFailures.fetch_add(1, std::memory_order_relaxed);
+}
+
+void PerfCounters::addFramesLost(quint64 frames) {
+    framesLost.fetch_add(frames, std::memory_order_relaxed);
+}
+
+void PerfCounters::addDuplicateFrame() {
+    duplicateFrames.fetch_add(1, std::memory_order_relaxed);
+}
+
+void PerfCounters::addLateFrame() {
+    lateFrames.fetch_add(1, std::memory_order_relaxed);
+}
+
+void PerfCounters::setQueueDepth(qint64 bytes) {
+    queueDepthBytes.store(bytes, std::memory_order_relaxed);
+}
+
+void PerfCounters::setFrameInterval(qint64 meanNs, qint64 jitterNs) {
+    frameIntervalNs.store(meanNs, std::memory_order_relaxed);
+    frameJitterNs.store(jitterNs, std::memory_order_relaxed);
+}
+
+void PerfCounters::addUiFrame() {
+    uiFrames.fetch_add(1, std::memory_order_relaxed);
+}
+
+void PerfCounters::addFilterWork(quint64 channelSamples, qint64 elapsedNs) {
+    filterChannelSamples.fetch_add(channelSamples, std::memory_order_relaxed);
+    filterTimeNs.fetch_add(static_cast<quint64>(qMax<qint64>(0, elapsedNs)), std::memory_order_relaxed);
+}
+
+void PerfCounters::addPaintTime(PaintSource source, qint64 elapsedNs) {
+    const int index = static_cast<int>(source);
+    paintCount[index].fetch_add(1, std::memory_order_relaxed);
+    paintTimeNs[index].fetch_add(static_cast<quint64>(qMax<qint64>(0, elapsedNs)), std::memory_order_relaxed);
+}
+
+PerfCounters::Snapshot PerfCounters::snapshot() {
+    Snapshot result;
+    result.framesReceived = framesReceived.load(std::memory_order_relaxed);
+    result.crcFailures = crcFailures.load(std::memory_order_relaxed);
+    result.parseFailures = parseFailures.load(std::memory_order_relaxed);
+    result.framesLost = framesLost.load(std::memory_order_relaxed);
+    result.duplicateFrames = duplicateFrames.load(std::memory_order_relaxed);
+    result.lateFrames = lateFrames.load(std::memory_order_relaxed);
+    result.queueDepthBytes = queueDepthBytes.load(std::memory_order_relaxed);
+    result.frameIntervalNs = frameIntervalNs.load(std::memory_order_relaxed);
+    result.frameJitterNs = frameJitterNs.load(std::memory_order_relaxed);
+    result.uiFrames = uiFrames.load(std::memory_order_relaxed);
+    result.filterChannelSamples = filterChannelSamples.load(std::memory_order_relaxed);
+    result.filterTimeNs = filterTimeNs.load(std::memory_order_relaxed);
+    for (int i = 0; i < PAINT_SOURCE_COUNT_PC; ++i) {
+        result.paintCount[i] = paintCount[i].load(std::memory_order_relaxed);
+        result.paintTimeNs[i] = paintTimeNs[i].load(std::memory_order_relaxed);
+    }
+    return result;
+}
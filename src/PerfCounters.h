@@ -0,0 +1,119 @@
+#ifndef PERFCOUNTERS_H
+#define PERFCOUNTERS_H
+
+/**
+ * @file PerfCounters.h
+ * @brief Definicja klasy PerfCounters, zbioru atomowych liczników wydajności aplikacji.
+ * @author Mateusz Wojtaszek
+ * @date 2025-05-29
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include <QtGlobal>
+
+/**
+ * @class PerfCounters
+ * @brief Tanie, atomowe liczniki odbioru danych i odrysowywania widoków.
+ *
+ * @details
+ * Liczniki są zwiększane w miejscach ich powstawania (`SerialPortHandler`, `MainWindow`,
+ * metody `paintEvent()` widoków) operacjami atomowymi bez blokad, a odczytywane
+ * okresowo przez `PerfHud`, który wylicza z różnic kolejnych migawek wartości na sekundę.
+ * Liczniki są monotoniczne - nigdy nie są zerowane.
+ */
+class PerfCounters {
+public:
+    /**
+     * @enum PaintSource
+     * @brief Widoki, dla których mierzony jest czas odrysowania.
+     */
+    enum class PaintSource : int {
+        Compass, //!< `Compass2DRenderer`.
+        Charts, //!< Wszystkie wykresy `SensorGraph`.
+        Map, //!< `NativeMapWidget`.
+        Count //!< Liczba źródeł (nie jest źródłem).
+    };
+
+    /**
+     * @struct Snapshot
+     * @brief Migawka wszystkich liczników.
+     */
+    struct Snapshot {
+        quint64 framesReceived = 0; //!< Ramki poprawnie sparsowane.
+        quint64 crcFailures = 0; //!< Linie odrzucone przez CRC (błędna suma lub jej brak).
+        quint64 parseFailures = 0; //!< Linie z poprawnym CRC, ale błędną treścią.
+        quint64 framesLost = 0; //!< Ramki brakujące według numerów sekwencyjnych (w chwili wykrycia luki).
+        quint64 duplicateFrames = 0; //!< Ramki zdublowane (ten sam numer sekwencyjny).
+        quint64 lateFrames = 0; //!< Ramki odebrane poza kolejnością.
+        qint64 queueDepthBytes = 0; //!< Bajty oczekujące w buforze odbiorczym (bez pełnej linii).
+        qint64 frameIntervalNs = 0; //!< Średni odstęp czasów odbioru ramek [ns].
+        qint64 frameJitterNs = 0; //!< Odchylenie standardowe odstępu czasów odbioru ramek [ns].
+        quint64 uiFrames = 0; //!< Ramki przekazane do widoków IMU (nie liczba odświeżeń - zob. `paintCount`).
+        quint64 filterChannelSamples = 0; //!< Próbki kanałów przetworzone przez `FilterBank` (kanały x ramki).
+        quint64 filterTimeNs = 0; //!< Łączny czas filtrowania [ns].
+        quint64 paintCount[static_cast<int>(PaintSource::Count)] = {}; //!< Liczba odrysowań.
+        quint64 paintTimeNs[static_cast<int>(PaintSource::Count)] = {}; //!< Łączny czas odrysowań [ns].
+    };
+
+    /** @brief Zlicza poprawnie sparsowaną ramkę. */
+    static void addFrameReceived();
+
+    /** @brief Zlicza linię odrzuconą przez weryfikację CRC. */
+    static void addCrcFailure();
+
+    /** @brief Zlicza linię z poprawnym CRC, której nie udało się sparsować. */
+    static void addParseFailure();
+
+    /**
+     * @brief Zlicza ramki brakujące w luce numerów sekwencyjnych.
+     * @param frames [in] Liczba brakujących ramek.
+     */
+    static void addFramesLost(quint64 frames);
+
+    /** @brief Zlicza ramkę z powtórzonym numerem sekwencyjnym. */
+    static void addDuplicateFrame();
+
+    /** @brief Zlicza ramkę odebraną poza kolejnością numerów sekwencyjnych. */
+    static void addLateFrame();
+
+    /**
+     * @brief Ustawia bieżącą głębokość kolejki odbiorczej.
+     * @param bytes [in] Liczba bajtów oczekujących na przetworzenie.
+     */
+    static void setQueueDepth(qint64 bytes);
+
+    /**
+     * @brief Ustawia bieżące statystyki odstępów między czasami odbioru ramek.
+     * @param meanNs [in] Średni odstęp [ns].
+     * @param jitterNs [in] Odchylenie standardowe odstępu [ns].
+     */
+    static void setFrameInterval(qint64 meanNs, qint64 jitterNs);
+
+    /** @brief Zlicza ramkę przekazaną do widoków IMU (odświeżenia ekranu liczy `addPaintTime()`). */
+    static void addUiFrame();
+
+    /**
+     * @brief Dodaje pracę filtrów jednej paczki ramek.
+     * @param channelSamples [in] Liczba przetworzonych próbek kanałów (kanały x ramki).
+     * @param elapsedNs [in] Czas filtrowania paczki [ns].
+     */
+    static void addFilterWork(quint64 channelSamples, qint64 elapsedNs);
+
+    /**
+     * @brief Dodaje czas jednego odrysowania widoku.
+     * @param source [in] Odrysowany widok.
+     * @param elapsedNs [in] Czas wykonania `paintEvent()` w nanosekundach.
+     */
+    static void addPaintTime(PaintSource source, qint64 elapsedNs);
+
+    /**
+     * @brief Zwraca migawkę wszystkich liczników.
+     */
+    static Snapshot snapshot();
+
+private:
+    PerfCounters() = delete;
+};
+
+#endif // PERFCOUNTERS_H
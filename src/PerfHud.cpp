@@ -0,0 +1,124 @@
+/**
+ * @file PerfHud.cpp
+ * @brief Implementacja klasy PerfHud.
+ * @author Mateusz Wojtaszek
+ * @date 2025-05-29
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include "PerfHud.h"
+#include "ProcessStats.h"
+#include <QPainter>
+#include <QFontDatabase>
+#include <QFontMetrics>
+#include <QTimer>
+
+constexpr int REFRESH_INTERVAL_MS_PH = 1000;
+constexpr int MARGIN_PX_PH = 6;
+constexpr int OFFSET_PX_PH = 8; // Odległość od lewego górnego rogu rodzica
+
+PerfHud::PerfHud(QWidget *parent)
+    : QWidget(parent),
+      m_refreshTimer(new QTimer(this)) {
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+    setAttribute(Qt::WA_NoSystemBackground);
+    setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+
+    m_refreshTimer->setInterval(REFRESH_INTERVAL_MS_PH);
+    connect(m_refreshTimer, &QTimer::timeout, this, &PerfHud::refresh);
+
+    m_lines << tr("Collecting metrics...");
+    updateGeometryForText();
+}
+
+void PerfHud::showEvent(QShowEvent *event) {
+    QWidget::showEvent(event);
+    m_previous = PerfCounters::snapshot();
+    m_intervalTimer.start();
+    m_refreshTimer->start();
+    raise(); // Nakładka nad pozostałymi dziećmi rodzica
+}
+
+void PerfHud::hideEvent(QHideEvent *event) {
+    m_refreshTimer->stop();
+    QWidget::hideEvent(event);
+}
+
+void PerfHud::refresh() {
+    const PerfCounters::Snapshot current = PerfCounters::snapshot();
+    const double seconds = qMax<qint64>(1, m_intervalTimer.restart()) / 1000.0;
+    auto perSecond = [seconds](quint64 now, quint64 before) {
+        return QString::number(static_cast<double>(now - before) / seconds, 'f', 1);
+    };
+
+    m_lines.clear();
+    m_lines << tr("Frames:       %1 /s").arg(perSecond(current.framesReceived, m_previous.framesReceived));
+    m_lines << tr("CRC failures: %1 /s").arg(perSecond(current.crcFailures, m_previous.crcFailures));
+    m_lines << tr("Parse errors: %1 /s").arg(perSecond(current.parseFailures, m_previous.parseFailures));
+    const quint64 intervalReceived = current.framesReceived - m_previous.framesReceived;
+    const quint64 intervalLost = current.framesLost - m_previous.framesLost;
+    const double lossPercent = intervalReceived + intervalLost > 0
+                                   ? 100.0 * static_cast<double>(intervalLost) / (intervalReceived + intervalLost)
+                                   : 0.0;
+    m_lines << tr("Lost frames:  %1 /s (%2 %)").arg(perSecond(current.framesLost, m_previous.framesLost))
+            .arg(lossPercent, 0, 'f', 2);
+    m_lines << tr("Dup / late:   %1 / %2 total").arg(current.duplicateFrames).arg(current.lateFrames);
+    m_lines << tr("Queue depth:  %1 B").arg(current.queueDepthBytes);
+    m_lines << tr("Interval:     %1 ms, jitter %2 ms").arg(current.frameIntervalNs / 1.0e6, 0, 'f', 2)
+            .arg(current.frameJitterNs / 1.0e6, 0, 'f', 2);
+    m_lines << tr("UI frames:    %1 /s").arg(perSecond(current.uiFrames, m_previous.uiFrames));
+    const quint64 filterNs = current.filterTimeNs - m_previous.filterTimeNs;
+    if (filterNs > 0) {
+        // Przepustowość samego filtrowania (kanały x próbki na sekundę czasu filtrów)
+        const double channelSamples = static_cast<double>(current.filterChannelSamples - m_previous.filterChannelSamples);
+        m_lines << tr("Filters:      %1 ch*samples/s (capacity %2 M ch*samples/s)")
+                .arg(perSecond(current.filterChannelSamples, m_previous.filterChannelSamples))
+                .arg(channelSamples / (static_cast<double>(filterNs) / 1.0e9) / 1.0e6, 0, 'f', 1);
+    }
+
+    const QString paintNames[] = {tr("compass"), tr("charts"), tr("map")};
+    for (int i = 0; i < static_cast<int>(PerfCounters::PaintSource::Count); ++i) {
+        const quint64 paints = current.paintCount[i] - m_previous.paintCount[i];
+        const quint64 paintNs = current.paintTimeNs[i] - m_previous.paintTimeNs[i];
+        const double averageMs = paints > 0 ? static_cast<double>(paintNs) / paints / 1.0e6 : 0.0;
+        m_lines << tr("Paint %1: %2 ms x %3 /s")
+                .arg(paintNames[i], -7)
+                .arg(averageMs, 0, 'f', 2)
+                .arg(perSecond(current.paintCount[i], m_previous.paintCount[i]));
+    }
+
+    const qint64 rssBytes = ProcessStats::residentSetSizeBytes();
+    m_lines << tr("RSS:          %1 MB").arg(rssBytes / (1024.0 * 1024.0), 0, 'f', 1);
+
+    m_previous = current;
+    updateGeometryForText();
+    update();
+}
+
+void PerfHud::updateGeometryForText() {
+    const QFontMetrics metrics(font());
+    int textWidth = 0;
+    for (const QString &line: std::as_const(m_lines)) {
+        textWidth = qMax(textWidth, metrics.horizontalAdvance(line));
+    }
+    setGeometry(OFFSET_PX_PH, OFFSET_PX_PH, textWidth + 2 * MARGIN_PX_PH,
+                metrics.lineSpacing() * m_lines.size() + 2 * MARGIN_PX_PH);
+}
+
+void PerfHud::paintEvent(QPaintEvent *event) {
+    Q_UNUSED(event);
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(QColor(0, 0, 0, 170));
+    painter.drawRoundedRect(rect(), 4, 4);
+
+    painter.setPen(QColor(0x7C, 0xFC, 0x00)); // Jasnozielony tekst na ciemnym tle
+    const QFontMetrics metrics(font());
+    int baseline = MARGIN_PX_PH + metrics.ascent();
+    for (const QString &line: std::as_const(m_lines)) {
+        painter.drawText(MARGIN_PX_PH, baseline, line);
+        baseline += metrics.lineSpacing();
+    }
+}
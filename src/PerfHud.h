@@ -0,0 +1,67 @@
+#ifndef PERFHUD_H
+#define PERFHUD_H
+
+/**
+ * @file PerfHud.h
+ * @brief Definicja klasy PerfHud, nakładki z bieżącymi metrykami odbioru danych i renderowania.
+ * @author Mateusz Wojtaszek
+ * @date 2025-05-29
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include <QWidget>
+#include <QElapsedTimer>
+#include <QStringList>
+#include "PerfCounters.h"
+
+class QTimer;
+
+/**
+ * @class PerfHud
+ * @brief Półprzezroczysta nakładka wyświetlająca metryki wydajności w czasie rzeczywistym.
+ *
+ * @details
+ * Co sekundę pobiera migawkę `PerfCounters` i na podstawie różnicy z poprzednią wylicza:
+ * ramki/s, błędy CRC/s, błędy parsowania/s, aktualizacje GUI/s, przepustowość filtrów oraz średni czas odrysowania
+ * poszczególnych widoków. Pokazuje też głębokość kolejki odbiorczej i RSS procesu
+ * (`ProcessStats`). Nakładka nie przechwytuje zdarzeń myszy, a jej timer działa tylko,
+ * gdy jest widoczna.
+ *
+ * @see PerfCounters
+ */
+class PerfHud : public QWidget {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Konstruktor klasy PerfHud.
+     * @param parent [in] Widget, nad którym wyświetlana jest nakładka.
+     */
+    explicit PerfHud(QWidget *parent = nullptr);
+
+protected:
+    /** @brief Rysuje tło i wiersze metryk. */
+    void paintEvent(QPaintEvent *event) override;
+
+    /** @brief Uruchamia okresowe odświeżanie metryk. */
+    void showEvent(QShowEvent *event) override;
+
+    /** @brief Zatrzymuje okresowe odświeżanie metryk. */
+    void hideEvent(QHideEvent *event) override;
+
+private slots:
+    /** @brief Pobiera migawkę liczników i przelicza metryki. */
+    void refresh();
+
+private:
+    /** @brief Dopasowuje rozmiar nakładki do bieżących wierszy tekstu. */
+    void updateGeometryForText();
+
+    QTimer *m_refreshTimer; //!< Timer odświeżania metryk.
+    QElapsedTimer m_intervalTimer; //!< Rzeczywisty czas między migawkami.
+    PerfCounters::Snapshot m_previous; //!< Poprzednia migawka liczników.
+    QStringList m_lines; //!< Wiersze tekstu do wyświetlenia.
+};
+
+#endif // PERFHUD_H
@@ -0,0 +1,108 @@
+/**
+ * @file ProcessStats.cpp
+ * @brief Implementacja klasy ProcessStats.
+ * @author Mateusz Wojtaszek
+ * @date 2025-05-27
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include "ProcessStats.h"
+
+#if defined(Q_OS_LINUX)
+#include <QDir>
+#include <QFile>
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QStringList>
+#include <unistd.h>
+#elif defined(Q_OS_MACOS)
+#include <mach/mach.h>
+#endif
+
+#if defined(Q_OS_LINUX)
+/**
+ * @brief Odczytuje RSS procesu z `/proc/<pid>/statm` (druga kolumna, w stronach).
+ * @param pidPath [in] Ścieżka katalogu procesu, np. `/proc/self`.
+ * @return RSS w bajtach lub 0 przy błędzie.
+ */
+static qint64 readStatmRss(const QString &pidPath) {
+    QFile statm(pidPath + QStringLiteral("/statm"));
+    if (!statm.open(QIODevice::ReadOnly)) {
+        return 0;
+    }
+    const QList<QByteArray> fields = statm.readAll().split(' ');
+    if (fields.size() < 2) {
+        return 0;
+    }
+    return fields[1].toLongLong() * static_cast<qint64>(sysconf(_SC_PAGESIZE));
+}
+
+/**
+ * @brief Odczytuje identyfikator procesu nadrzędnego z `/proc/<pid>/stat`.
+ * @param pidPath [in] Ścieżka katalogu procesu.
+ * @return PPID lub -1 przy błędzie.
+ */
+static qint64 readParentPid(const QString &pidPath) {
+    QFile stat(pidPath + QStringLiteral("/stat"));
+    if (!stat.open(QIODevice::ReadOnly)) {
+        return -1;
+    }
+    const QByteArray content = stat.readAll();
+    // Nazwa procesu (pole 2) może zawierać spacje - pola po niej zaczynają się za ostatnim ')'
+    const int nameEnd = content.lastIndexOf(')');
+    if (nameEnd < 0) {
+        return -1;
+    }
+    const QList<QByteArray> fields = content.mid(nameEnd + 2).split(' ');
+    return fields.size() > 1 ? fields[1].toLongLong() : -1; // pola: state, ppid, ...
+}
+#endif
+
+qint64 ProcessStats::residentSetSizeBytes() {
+#if defined(Q_OS_LINUX)
+    return readStatmRss(QStringLiteral("/proc/self"));
+#elif defined(Q_OS_MACOS)
+    mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS) {
+        return 0;
+    }
+    return static_cast<qint64>(info.resident_size);
+#else
+    return 0;
+#endif
+}
+
+qint64 ProcessStats::childrenResidentSetSizeBytes() {
+#if defined(Q_OS_LINUX)
+    // Procesy Chromium (renderer, GPU) są potomkami procesu zygote, a nie bezpośrednio
+    // procesu aplikacji - dlatego sumowane są wszystkie procesy potomne, nie tylko dzieci.
+    QHash<qint64, qint64> parentOf;
+    const QStringList entries = QDir(QStringLiteral("/proc")).entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+    for (const QString &entry: entries) {
+        bool isPid = false;
+        const qint64 pid = entry.toLongLong(&isPid);
+        if (isPid) {
+            parentOf.insert(pid, readParentPid(QStringLiteral("/proc/") + entry));
+        }
+    }
+
+    const qint64 ownPid = static_cast<qint64>(getpid());
+    qint64 total = 0;
+    for (auto it = parentOf.cbegin(); it != parentOf.cend(); ++it) {
+        qint64 ancestor = it.value();
+        for (int depth = 0; depth < 16 && ancestor > 1; ++depth) {
+            if (ancestor == ownPid) {
+                total += readStatmRss(QStringLiteral("/proc/%1").arg(it.key()));
+                break;
+            }
+            ancestor = parentOf.value(ancestor, -1);
+        }
+    }
+    return total;
+#else
+    return 0;
+#endif
+}
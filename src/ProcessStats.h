@@ -0,0 +1,44 @@
+#ifndef PROCESSSTATS_H
+#define PROCESSSTATS_H
+
+/**
+ * @file ProcessStats.h
+ * @brief Definicja klasy ProcessStats, odczytującej zużycie pamięci procesu aplikacji.
+ * @author Mateusz Wojtaszek
+ * @date 2025-05-27
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include <QtGlobal>
+
+/**
+ * @class ProcessStats
+ * @brief Zbiór funkcji statycznych zwracających zużycie pamięci (RSS) procesu.
+ *
+ * @details
+ * Obsługiwane platformy: Linux (`/proc`) oraz macOS (`task_info`). Na pozostałych
+ * platformach funkcje zwracają 0.
+ *
+ * `childrenResidentSetSizeBytes()` sumuje RSS wszystkich procesów potomnych (np. procesów
+ * `QtWebEngineProcess`), które nie są wliczane do RSS procesu głównego. Na macOS zwraca 0.
+ */
+class ProcessStats {
+public:
+    /**
+     * @brief Zwraca rozmiar pamięci rezydentnej (RSS) bieżącego procesu.
+     * @return RSS w bajtach lub 0, jeśli platforma nie jest obsługiwana.
+     */
+    static qint64 residentSetSizeBytes();
+
+    /**
+     * @brief Zwraca sumaryczny RSS wszystkich procesów potomnych (również pośrednich).
+     * @return RSS procesów potomnych w bajtach lub 0, jeśli platforma nie jest obsługiwana.
+     */
+    static qint64 childrenResidentSetSizeBytes();
+
+private:
+    ProcessStats() = delete;
+};
+
+#endif // PROCESSSTATS_H
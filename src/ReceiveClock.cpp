@@ -0,0 +1,47 @@
+/**
+ * @file ReceiveClock.cpp
+ * @brief Implementacja klasy ReceiveClock.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-03
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include "ReceiveClock.h"
+
+constexpr qint64 BITS_PER_BYTE_RC = 10; // Bit startu, 8 bitów danych, bit stopu (8N1)
+constexpr qint64 NS_PER_SECOND_RC = 1000000000;
+
+void ReceiveClock::setBaudRate(qint32 baudRate) {
+    m_nsPerByte = baudRate > 0 ? BITS_PER_BYTE_RC * NS_PER_SECOND_RC / baudRate : 0;
+}
+
+void ReceiveClock::chunkReceived(qint64 receivedNs, qint64 streamEndOffset, qint64 chunkBytes) {
+    qint64 spanNs = m_previousChunkNs > 0 ? qMax<qint64>(0, receivedNs - m_previousChunkNs) : 0;
+    if (m_nsPerByte > 0) {
+        // Po dłuższej ciszy porcja nie mogła nadawać się dłużej niż trwa jej transmisja
+        const qint64 transmitNs = chunkBytes * m_nsPerByte;
+        spanNs = m_previousChunkNs > 0 ? qMin(spanNs, transmitNs) : transmitNs;
+    }
+    m_previousChunkNs = receivedNs;
+    m_chunkStartNs = receivedNs - spanNs;
+    m_chunkSpanNs = spanNs;
+    m_chunkStartOffset = streamEndOffset - chunkBytes;
+    m_chunkBytes = chunkBytes;
+}
+
+qint64 ReceiveClock::timestampFor(qint64 lineEndOffset) const {
+    if (m_chunkBytes <= 0) {
+        return m_chunkStartNs + m_chunkSpanNs;
+    }
+    const qint64 bytesIntoChunk = qBound<qint64>(0, lineEndOffset - m_chunkStartOffset, m_chunkBytes);
+    return m_chunkStartNs + m_chunkSpanNs * bytesIntoChunk / m_chunkBytes;
+}
+
+void ReceiveClock::reset() {
+    m_previousChunkNs = 0;
+    m_chunkStartNs = 0;
+    m_chunkSpanNs = 0;
+    m_chunkStartOffset = 0;
+    m_chunkBytes = 0;
+}
@@ -0,0 +1,65 @@
+#ifndef RECEIVECLOCK_H
+#define RECEIVECLOCK_H
+
+/**
+ * @file ReceiveClock.h
+ * @brief Definicja klasy ReceiveClock - interpolacja czasu odbioru linii wewnątrz porcji danych.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-03
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include <QtGlobal>
+
+/**
+ * @class ReceiveClock
+ * @brief Przypisuje liniom strumienia znaczniki czasu na podstawie czasu odczytu porcji bajtów.
+ *
+ * @details
+ * `readyRead` dostarcza naraz wiele linii, więc wspólny czas odczytu porcji zlewałby je w jedną
+ * chwilę. Bajty porcji dotarły jednak w przedziale zakończonym odczytem, którego długość jest
+ * ograniczona przez czas od poprzedniego odczytu oraz - jeśli znana jest prędkość łącza - czas
+ * transmisji porcji. Czas linii jest interpolowany liniowo wg pozycji jej znaku końca wewnątrz
+ * porcji: ostatni bajt porcji otrzymuje czas odczytu, a pierwszy - początek przedziału.
+ *
+ * Znaczniki są niemalejące, bo przedział porcji nigdy nie sięga przed poprzedni odczyt.
+ */
+class ReceiveClock {
+public:
+    /**
+     * @brief Ustawia prędkość łącza używaną do oszacowania czasu transmisji porcji.
+     * @param baudRate [in] Prędkość w bitach na sekundę (10 bitów na bajt: start + 8 danych + stop);
+     * 0 lub wartość ujemna - prędkość nieznana (np. źródła sieciowe).
+     */
+    void setBaudRate(qint32 baudRate);
+
+    /**
+     * @brief Rejestruje odczyt kolejnej porcji bajtów.
+     * @param receivedNs [in] Czas odczytu porcji (`LatencyTracer::nowNs()`).
+     * @param streamEndOffset [in] Pozycja w strumieniu tuż za ostatnim bajtem porcji.
+     * @param chunkBytes [in] Liczba bajtów porcji.
+     */
+    void chunkReceived(qint64 receivedNs, qint64 streamEndOffset, qint64 chunkBytes);
+
+    /**
+     * @brief Zwraca interpolowany czas odbioru linii zakończonej w bieżącej porcji.
+     * @param lineEndOffset [in] Pozycja w strumieniu tuż za znakiem końca linii
+     * (`FrameParser::lastLineEndOffset()`).
+     * @return Czas odbioru [ns] w skali `LatencyTracer::nowNs()`.
+     */
+    qint64 timestampFor(qint64 lineEndOffset) const;
+
+    /** @brief Zapomina poprzednie porcje (np. po ponownym otwarciu portu). */
+    void reset();
+
+private:
+    qint64 m_nsPerByte = 0; //!< Czas transmisji bajtu [ns]; 0 - nieznany.
+    qint64 m_previousChunkNs = 0; //!< Czas odczytu poprzedniej porcji; 0 - brak.
+    qint64 m_chunkStartNs = 0; //!< Początek przedziału bieżącej porcji.
+    qint64 m_chunkSpanNs = 0; //!< Długość przedziału bieżącej porcji.
+    qint64 m_chunkStartOffset = 0; //!< Pozycja pierwszego bajtu bieżącej porcji w strumieniu.
+    qint64 m_chunkBytes = 0; //!< Liczba bajtów bieżącej porcji.
+};
+
+#endif // RECEIVECLOCK_H
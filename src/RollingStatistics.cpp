@@ -0,0 +1,139 @@
+/**
+ * @file RollingStatistics.cpp
+ * @brief Implementacja klasy RollingStatistics.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-16
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include "RollingStatistics.h"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+constexpr qint64 MIN_WINDOW_NS_RS = 1000000; // 1 ms
+
+RollingStatistics::RollingStatistics(qint64 windowNs)
+    : m_windowNs(qMax(MIN_WINDOW_NS_RS, windowNs)) {
+}
+
+void RollingStatistics::setWindow(qint64 windowNs) {
+    m_windowNs = qMax(MIN_WINDOW_NS_RS, windowNs);
+    if (!m_frames.empty()) {
+        const qint64 newestNs = m_frames.back().timestampNs;
+        while (newestNs - m_frames.front().timestampNs > m_windowNs) {
+            popOldest();
+        }
+    }
+}
+
+void RollingStatistics::addFrame(const float *frame, qint64 timestampNs) {
+    if (!m_frames.empty() && timestampNs < m_frames.back().timestampNs) {
+        reset(); // Czas cofnął się - nowe nagranie lub urządzenie
+    }
+    Frame &added = m_frames.emplace_back();
+    added.timestampNs = timestampNs;
+    std::copy(frame, frame + CHANNELS, added.values);
+    const qint64 index = m_nextIndex++;
+    const double count = static_cast<double>(m_frames.size());
+    for (int channel = 0; channel < CHANNELS; ++channel) {
+        const float value = frame[channel];
+        const double delta = value - m_mean[channel];
+        m_mean[channel] += delta / count;
+        m_m2[channel] += delta * (value - m_mean[channel]);
+
+        // Próbki nie mniejsze (nie większe) od nowej nigdy już nie będą minimum (maksimum) okna
+        std::deque<Extremum> &minQueue = m_minQueue[channel];
+        while (!minQueue.empty() && minQueue.back().value >= value) {
+            minQueue.pop_back();
+        }
+        minQueue.push_back({index, value});
+        std::deque<Extremum> &maxQueue = m_maxQueue[channel];
+        while (!maxQueue.empty() && maxQueue.back().value <= value) {
+            maxQueue.pop_back();
+        }
+        maxQueue.push_back({index, value});
+    }
+
+    while (timestampNs - m_frames.front().timestampNs > m_windowNs) {
+        popOldest();
+    }
+}
+
+void RollingStatistics::popOldest() {
+    const Frame &oldest = m_frames.front();
+    const qint64 index = m_nextIndex - static_cast<qint64>(m_frames.size());
+    const double count = static_cast<double>(m_frames.size()) - 1.0;
+    for (int channel = 0; channel < CHANNELS; ++channel) {
+        if (count > 0.0) {
+            const float value = oldest.values[channel];
+            const double delta = value - m_mean[channel];
+            m_mean[channel] -= delta / count;
+            m_m2[channel] = qMax(0.0, m_m2[channel] - delta * (value - m_mean[channel]));
+        }
+        if (m_minQueue[channel].front().index == index) {
+            m_minQueue[channel].pop_front();
+        }
+        if (m_maxQueue[channel].front().index == index) {
+            m_maxQueue[channel].pop_front();
+        }
+    }
+    m_frames.pop_front();
+    if (m_frames.empty()) {
+        std::fill(std::begin(m_mean), std::end(m_mean), 0.0);
+        std::fill(std::begin(m_m2), std::end(m_m2), 0.0);
+        m_removedSinceRecompute = 0;
+    } else if (++m_removedSinceRecompute >= static_cast<int>(m_frames.size())) {
+        recomputeMoments(); // Koszt O(okno) raz na wymianę okna - stały w przeliczeniu na ramkę
+    }
+}
+
+void RollingStatistics::recomputeMoments() {
+    const double count = static_cast<double>(m_frames.size());
+    for (int channel = 0; channel < CHANNELS; ++channel) {
+        double sum = 0.0;
+        for (const Frame &frame: m_frames) {
+            sum += frame.values[channel];
+        }
+        const double mean = sum / count;
+        double m2 = 0.0;
+        for (const Frame &frame: m_frames) {
+            const double delta = frame.values[channel] - mean;
+            m2 += delta * delta;
+        }
+        m_mean[channel] = mean;
+        m_m2[channel] = m2;
+    }
+    m_removedSinceRecompute = 0;
+}
+
+void RollingStatistics::reset() {
+    m_frames.clear();
+    for (int channel = 0; channel < CHANNELS; ++channel) {
+        m_minQueue[channel].clear();
+        m_maxQueue[channel].clear();
+    }
+    std::fill(std::begin(m_mean), std::end(m_mean), 0.0);
+    std::fill(std::begin(m_m2), std::end(m_m2), 0.0);
+    m_nextIndex = 0;
+    m_removedSinceRecompute = 0;
+}
+
+qint64 RollingStatistics::coveredNs() const {
+    return m_frames.empty() ? 0 : m_frames.back().timestampNs - m_frames.front().timestampNs;
+}
+
+RollingStatistics::Summary RollingStatistics::summary(int channel) const {
+    Summary result;
+    if (m_frames.empty() || channel < 0 || channel >= CHANNELS) {
+        return result;
+    }
+    const double variance = m_m2[channel] / static_cast<double>(m_frames.size());
+    result.mean = static_cast<float>(m_mean[channel]);
+    result.stdDev = static_cast<float>(std::sqrt(variance));
+    result.min = m_minQueue[channel].front().value;
+    result.max = m_maxQueue[channel].front().value;
+    result.rms = static_cast<float>(std::sqrt(m_mean[channel] * m_mean[channel] + variance));
+    return result;
+}
@@ -0,0 +1,113 @@
+#ifndef ROLLINGSTATISTICS_H
+#define ROLLINGSTATISTICS_H
+
+/**
+ * @file RollingStatistics.h
+ * @brief Definicja klasy RollingStatistics - statystyki kanałów IMU w przesuwnym oknie czasu.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-16
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include <QtGlobal>
+#include <deque>
+
+/**
+ * @class RollingStatistics
+ * @brief Średnia, odchylenie standardowe, minimum, maksimum i RMS 12 kanałów ramki IMU z ostatnich `window()` ns.
+ *
+ * @details
+ * Średnia i wariancja są aktualizowane algorytmem Welforda - przy dodaniu ramki i przy usunięciu
+ * ramki, która wypadła z okna - a RMS wynika z nich (`RMS² = średnia² + wariancja`). Minimum
+ * i maksimum dają kolejki monotoniczne: kolejka minimum przechowuje tylko próbki mniejsze od
+ * wszystkich późniejszych, więc jej początek jest minimum okna, a każda próbka jest do niej dodawana
+ * i z niej usuwana co najwyżej raz. Koszt ramki jest więc stały (zamortyzowany), niezależnie od
+ * długości okna. Po każdej wymianie całej zawartości okna sumy Welforda są liczone od nowa,
+ * aby błędy zaokrągleń się nie kumulowały.
+ *
+ * Okno jest określone czasem (a nie liczbą próbek), więc nie zależy od częstotliwości ramek ani
+ * od liczby próbek na wykresach.
+ */
+class RollingStatistics {
+public:
+    static constexpr int CHANNELS = 12; //!< Kanały ramki IMU: żyroskop, akcelerometr, magnetometr, ROLL/PITCH/YAW.
+    static constexpr qint64 DEFAULT_WINDOW_NS = 5000000000LL; //!< Domyślna długość okna (5 s).
+
+    /** @brief Statystyki jednego kanału w oknie. */
+    struct Summary {
+        float mean = 0.0f; //!< Średnia.
+        float stdDev = 0.0f; //!< Odchylenie standardowe (populacji).
+        float min = 0.0f; //!< Minimum.
+        float max = 0.0f; //!< Maksimum.
+        float rms = 0.0f; //!< Wartość skuteczna.
+    };
+
+    /**
+     * @brief Konstruktor.
+     * @param windowNs [in] Długość okna [ns].
+     */
+    explicit RollingStatistics(qint64 windowNs = DEFAULT_WINDOW_NS);
+
+    /**
+     * @brief Zmienia długość okna; przy skróceniu od razu usuwa najstarsze ramki.
+     * @param windowNs [in] Długość okna [ns] (co najmniej 1 ms).
+     */
+    void setWindow(qint64 windowNs);
+
+    /** @brief Zwraca długość okna [ns]. */
+    qint64 window() const { return m_windowNs; }
+
+    /**
+     * @brief Dodaje ramkę i usuwa ramki starsze niż okno.
+     * @details Czas wcześniejszy niż ostatniej ramki (np. nowe odtwarzanie) zeruje statystyki.
+     * @param frame [in] `CHANNELS` wartości ramki IMU.
+     * @param timestampNs [in] Czas ramki [ns].
+     */
+    void addFrame(const float *frame, qint64 timestampNs);
+
+    /** @brief Usuwa wszystkie ramki z okna. */
+    void reset();
+
+    /** @brief Zwraca liczbę ramek w oknie. */
+    int sampleCount() const { return static_cast<int>(m_frames.size()); }
+
+    /** @brief Zwraca czas między najstarszą a najnowszą ramką w oknie [ns]. */
+    qint64 coveredNs() const;
+
+    /**
+     * @brief Zwraca statystyki kanału (zera przy pustym oknie).
+     * @param channel [in] Indeks kanału w ramce (0 - `CHANNELS - 1`).
+     */
+    Summary summary(int channel) const;
+
+private:
+    /** @brief Ramka w oknie. */
+    struct Frame {
+        qint64 timestampNs; //!< Czas ramki [ns].
+        float values[CHANNELS]; //!< Wartości kanałów.
+    };
+
+    /** @brief Próbka w kolejce monotonicznej. */
+    struct Extremum {
+        qint64 index; //!< Numer ramki (rosnący od `reset()`).
+        float value; //!< Wartość kanału.
+    };
+
+    /** @brief Usuwa najstarszą ramkę z okna (odwrotna aktualizacja Welforda, początek kolejek). */
+    void popOldest();
+
+    /** @brief Przelicza średnie i sumy kwadratów odchyleń od nowa z ramek w oknie. */
+    void recomputeMoments();
+
+    qint64 m_windowNs; //!< Długość okna [ns].
+    std::deque<Frame> m_frames; //!< Ramki w oknie, od najstarszej.
+    qint64 m_nextIndex = 0; //!< Numer następnej dodanej ramki.
+    double m_mean[CHANNELS] = {}; //!< Średnie kanałów.
+    double m_m2[CHANNELS] = {}; //!< Sumy kwadratów odchyleń od średniej (Welford).
+    std::deque<Extremum> m_minQueue[CHANNELS]; //!< Kolejki monotoniczne minimum (wartości rosnące).
+    std::deque<Extremum> m_maxQueue[CHANNELS]; //!< Kolejki monotoniczne maksimum (wartości malejące).
+    int m_removedSinceRecompute = 0; //!< Ramki usunięte od ostatniego przeliczenia momentów.
+};
+
+#endif // ROLLINGSTATISTICS_H
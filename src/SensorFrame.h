@@ -0,0 +1,39 @@
+#ifndef SENSORFRAME_H
+#define SENSORFRAME_H
+
+/**
+ * @file SensorFrame.h
+ * @brief Definicja struktury SensorFrame - zdekodowana ramka telemetryczna ze znacznikiem czasu odbioru.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-03
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include <QMetaType>
+#include <QVector>
+#include <QtGlobal>
+
+/**
+ * @struct SensorFrame
+ * @brief Wartości jednej ramki wraz z monotonicznym czasem jej odbioru przez hosta.
+ *
+ * @details
+ * Znacznik `hostTimestampNs` pochodzi z zegara `LatencyTracer::nowNs()` (`steady_clock`) i jest
+ * nadawany możliwie wcześnie - w chwili odczytu porcji bajtów z portu, a następnie interpolowany
+ * dla linii zakończonych wewnątrz tej porcji (`ReceiveClock`). Dzięki temu odstępy między ramkami
+ * odzwierciedlają rzeczywisty rytm urządzenia, a nie rytm obsługi zdarzeń w wątku GUI.
+ *
+ * Informacja o luce w numeracji (`lostFramesBefore`) podróżuje razem z ramką, aby odbiorcy
+ * scalonego strumienia wielu urządzeń mogli zaznaczyć przerwę dokładnie w tym miejscu.
+ */
+struct SensorFrame {
+    qint64 hostTimestampNs = 0; //!< Monotoniczny czas odbioru ramki [ns].
+    QVector<float> values; //!< Wartości ramki (12 IMU + 2 GPS, bez numeru sekwencyjnego).
+    int deviceId = 0; //!< Identyfikator urządzenia źródłowego (`DeviceManager`).
+    int lostFramesBefore = 0; //!< Liczba ramek utraconych bezpośrednio przed tą ramką (luka w numeracji).
+};
+
+Q_DECLARE_METATYPE(SensorFrame)
+
+#endif // SENSORFRAME_H
@@ -9,23 +9,33 @@
  */
 
 #include "SensorGraph.h"
+#include "PerfCounters.h"
 
 #include <QtCharts/QChart>
 #include <QtCharts/QLineSeries>
 #include <QtCharts/QValueAxis>
 #include <QtCharts/QLegend>
+#include <QtCharts/QLegendMarker>
 #include <QDebug>
 #include <QStringList>
 #include <QColor>
 #include <QSizePolicy>
 #include <QtMath> // Dla qMax
 #include <QPainter>
+#include <QElapsedTimer>
+
+constexpr qreal NS_PER_SECOND_SG = 1.0e9;
+constexpr qreal MIN_TIME_SPAN_S_SG = 1.0; // Minimalna szerokość osi czasu przed zapełnieniem okna
+constexpr int RAW_TRACE_ALPHA_SG = 90; // Krycie surowego przebiegu pod przefiltrowanym
 
 
 SensorGraph::SensorGraph(const QString &titleKey, int minY, int maxY, QWidget *parent)
     : QChartView(new QChart(), parent), // Inicjalizacja QChart bezpośrednio
       m_maxSampleCount(1000), // Domyślna liczba próbek
       m_currentSampleIndex(0),
+      m_pointCount(0),
+      m_timeOriginNs(0),
+      m_rawTraceVisible(false),
       m_baseTitleKey(titleKey) {
     QChart *chartPtr = this->chart(); // Pobierz wskaźnik na QChart
 
@@ -36,23 +46,10 @@ SensorGraph::SensorGraph(const QString &titleKey, int minY, int maxY, QWidget *p
     legend->setAlignment(Qt::AlignTop);
     legend->setMarkerShape(QLegend::MarkerShapeCircle);
 
-    // Nazwy serii są stałe i nie podlegają tłumaczeniu w tym kontekście,
-    // reprezentują kanały danych.
-    QStringList seriesNames = {"X", "Y", "Z"};
-    QList<QColor> seriesColors = {Qt::blue, Qt::red, Qt::green};
-
-    for (int i = 0; i < 3; ++i) {
-        auto *series = new QLineSeries(this); // Ustawienie rodzica dla serii
-        series->setName(seriesNames[i]);
-        series->setColor(seriesColors[i]);
-        chartPtr->addSeries(series);
-        m_seriesList.append(series);
-    }
-
     auto *axisX = new QValueAxis(this); // Ustawienie rodzica dla osi
-    axisX->setTitleText(tr("Sample Index"));
+    axisX->setTitleText(tr("Time [s]"));
     axisX->setTickCount(11); // Przykładowa liczba ticków
-    axisX->setLabelFormat("%lld");
+    axisX->setLabelFormat("%.1f");
     chartPtr->setAxisX(axisX);
 
     auto *axisY = new QValueAxis(this); // Ustawienie rodzica dla osi
@@ -60,36 +57,68 @@ SensorGraph::SensorGraph(const QString &titleKey, int minY, int maxY, QWidget *p
     axisY->setRange(minY, maxY);
     chartPtr->setAxisY(axisY);
 
-    // Przypisanie osi do serii
-    for (QLineSeries *series: m_seriesList) {
-        chartPtr->setAxisX(axisX, series);
-        chartPtr->setAxisY(axisY, series);
-    }
+    m_seriesList = createSeries();
 
-    axisX->setRange(0, m_maxSampleCount > 0 ? m_maxSampleCount - 1 : 0);
+    axisX->setRange(0, MIN_TIME_SPAN_S_SG);
 
     this->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::MinimumExpanding);
     this->setRenderHint(QPainter::Antialiasing);
 }
 
-void SensorGraph::addData(const QVector<int> &axisValuesToAdd) {
+QList<QLineSeries *> SensorGraph::createSeries() {
     QChart *chartPtr = this->chart();
-    if (axisValuesToAdd.size() != 3 || m_seriesList.size() != 3 || !chartPtr) {
+    // Nazwy serii są stałe i nie podlegają tłumaczeniu w tym kontekście,
+    // reprezentują kanały danych.
+    const QStringList seriesNames = {"X", "Y", "Z"};
+    const QList<QColor> seriesColors = {Qt::blue, Qt::red, Qt::green};
+
+    QList<QLineSeries *> segment;
+    for (int i = 0; i < (m_rawTraceVisible ? 6 : 3); ++i) {
+        auto *series = new QLineSeries(this); // Ustawienie rodzica dla serii
+        if (i < 3) {
+            series->setName(seriesNames[i]);
+            series->setColor(seriesColors[i]);
+        } else {
+            QColor rawColor = seriesColors[i - 3]; // Surowy przebieg: ten sam kolor, półprzezroczysty
+            rawColor.setAlpha(RAW_TRACE_ALPHA_SG);
+            series->setName(seriesNames[i - 3] + QStringLiteral(" (raw)"));
+            series->setColor(rawColor);
+        }
+        chartPtr->addSeries(series);
+        chartPtr->setAxisX(chartPtr->axisX(), series);
+        chartPtr->setAxisY(chartPtr->axisY(), series);
+        segment.append(series);
+    }
+    return segment;
+}
+
+void SensorGraph::addData(const QVector<int> &axisValuesToAdd, qint64 timestampNs, const QVector<int> &rawValues) {
+    QChart *chartPtr = this->chart();
+    if (axisValuesToAdd.size() != 3 || m_seriesList.isEmpty() || !chartPtr) {
         // Można dodać qWarning, jeśli oczekiwane jest logowanie takich sytuacji
         return;
     }
 
+    if (m_pointCount == 0 && m_closedSegments.isEmpty()) {
+        m_timeOriginNs = timestampNs; // Oś czasu liczona od pierwszej próbki
+    }
+    const qreal timeS = static_cast<qreal>(timestampNs - m_timeOriginNs) / NS_PER_SECOND_SG;
     for (int i = 0; i < 3; ++i) {
         QLineSeries *series = m_seriesList.at(i);
         if (!series) continue;
 
-        series->append(m_currentSampleIndex, axisValuesToAdd[i]);
-
-        // Usuń najstarszy punkt, jeśli przekroczono limit
-        if (series->count() > m_maxSampleCount) {
-            series->remove(0);
+        series->append(timeS, axisValuesToAdd[i]);
+    }
+    if (m_rawTraceVisible) {
+        // Bez surowych wartości (np. filtry wyłączone) oba przebiegi się pokrywają
+        const QVector<int> &raw = rawValues.size() == 3 ? rawValues : axisValuesToAdd;
+        for (int i = 0; i < 3; ++i) {
+            m_seriesList.at(3 + i)->append(timeS, raw[i]);
         }
     }
+    ++m_pointCount;
+    // Usuń najstarsze punkty, jeśli przekroczono limit (także z serii sprzed przerw)
+    trimOldest();
 
     // Aktualizacja zakresu osi X
     // Aktualizuj co pewną liczbę próbek lub przy pierwszej próbce, aby zoptymalizować wydajność
@@ -97,52 +126,110 @@ void SensorGraph::addData(const QVector<int> &axisValuesToAdd) {
     bool needsUpdate = (m_currentSampleIndex == 0 || m_currentSampleIndex % xAxisUpdateFrequency == 0);
 
     if (needsUpdate) {
-        if (auto *axisX = qobject_cast<QValueAxis *>(chartPtr->axisX())) {
-            qint64 minX = 0;
-            qint64 maxX = m_currentSampleIndex;
-
-            if (m_currentSampleIndex >= m_maxSampleCount) {
-                minX = m_currentSampleIndex - m_maxSampleCount + 1;
-            } else {
-                minX = 0;
-                maxX = qMax(m_currentSampleIndex, static_cast<qint64>(m_maxSampleCount - 1));
-                // Upewnij się, że początkowy zakres jest poprawny
-            }
-            axisX->setRange(minX, maxX);
-        }
+        updateTimeAxisRange(timeS);
     }
     m_currentSampleIndex++;
 }
 
-void SensorGraph::setSampleCount(int sampleCount) {
-    m_maxSampleCount = qMax(10, sampleCount); // Minimalna liczba próbek to 10
+void SensorGraph::markGap() {
     QChart *chartPtr = this->chart();
+    if (!chartPtr || m_seriesList.isEmpty() || m_seriesList.first()->count() == 0) {
+        return; // Bieżące serie są puste - nie ma czego rozdzielać
+    }
 
-    // Dostosuj istniejące serie do nowej liczby próbek
-    for (QLineSeries *series: m_seriesList) {
-        if (series) {
-            while (series->count() > m_maxSampleCount) {
-                series->remove(0); // Usuwaj najstarsze próbki
-            }
+    // Legenda pokazuje tylko bieżące serie, bo starsze zostaną kiedyś usunięte
+    for (QLineSeries *series: std::as_const(m_seriesList)) {
+        for (QLegendMarker *marker: chartPtr->legend()->markers(series)) {
+            marker->setVisible(false);
         }
     }
+    m_closedSegments.append(m_seriesList);
+    m_seriesList = createSeries();
+}
 
-    // Zaktualizuj zakres osi X
-    if (chartPtr) {
-        if (auto *axisX = qobject_cast<QValueAxis *>(chartPtr->axisX())) {
-            qint64 minX = 0;
-            qint64 maxX = m_maxSampleCount > 0 ? m_maxSampleCount - 1 : 0; // Domyślny zakres
-
-            if (m_currentSampleIndex > 0) {
-                // Jeśli są już jakieś dane
-                maxX = m_currentSampleIndex;
-                if (m_currentSampleIndex >= m_maxSampleCount) {
-                    minX = m_currentSampleIndex - m_maxSampleCount + 1;
-                }
+void SensorGraph::setRawTraceVisible(bool visible) {
+    if (visible == m_rawTraceVisible) {
+        return;
+    }
+    m_rawTraceVisible = visible;
+
+    // Liczba serii w segmencie się zmienia - historia wykresu zaczyna się od nowa
+    m_closedSegments.append(m_seriesList);
+    for (const QList<QLineSeries *> &segment: std::as_const(m_closedSegments)) {
+        for (QLineSeries *series: segment) {
+            chart()->removeSeries(series);
+            delete series;
+        }
+    }
+    m_closedSegments.clear();
+    m_seriesList = createSeries();
+    m_pointCount = 0;
+    m_currentSampleIndex = 0;
+    updateTimeAxisRange(0.0);
+}
+
+void SensorGraph::trimOldest() {
+    while (m_pointCount > m_maxSampleCount) {
+        const int excess = m_pointCount - m_maxSampleCount;
+        if (m_closedSegments.isEmpty()) {
+            for (QLineSeries *series: std::as_const(m_seriesList)) {
+                series->removePoints(0, qMin(excess, static_cast<int>(series->count())));
             }
-            axisX->setRange(minX, maxX);
+            m_pointCount -= excess;
+            break;
+        }
+
+        // Najpierw najstarsze serie sprzed przerw - puste są usuwane z wykresu
+        QList<QLineSeries *> &oldest = m_closedSegments.first();
+        const int oldestCount = static_cast<int>(oldest.first()->count());
+        if (oldestCount > excess) {
+            for (QLineSeries *series: std::as_const(oldest)) {
+                series->removePoints(0, excess);
+            }
+            m_pointCount -= excess;
+            break;
+        }
+        for (QLineSeries *series: m_closedSegments.takeFirst()) {
+            chart()->removeSeries(series);
+            delete series;
+        }
+        m_pointCount -= oldestCount;
+    }
+}
+
+qreal SensorGraph::oldestTime() const {
+    for (const QList<QLineSeries *> &segment: m_closedSegments) {
+        if (segment.first()->count() > 0) {
+            return segment.first()->at(0).x();
         }
     }
+    return m_seriesList.isEmpty() || m_seriesList.first()->count() == 0 ? 0.0 : m_seriesList.first()->at(0).x();
+}
+
+void SensorGraph::updateTimeAxisRange(qreal latestTimeS) {
+    QChart *chartPtr = this->chart();
+    if (!chartPtr) {
+        return;
+    }
+    if (auto *axisX = qobject_cast<QValueAxis *>(chartPtr->axisX())) {
+        const qreal minX = m_pointCount > 0 ? oldestTime() : 0.0;
+        // Dopóki okno się nie zapełni, oś obejmuje co najmniej domyślny przedział
+        const qreal maxX = qMax(latestTimeS, minX + MIN_TIME_SPAN_S_SG);
+        axisX->setRange(minX, maxX);
+    }
+}
+
+void SensorGraph::setSampleCount(int sampleCount) {
+    m_maxSampleCount = qMax(10, sampleCount); // Minimalna liczba próbek to 10
+
+    // Dostosuj istniejące serie do nowej liczby próbek
+    trimOldest();
+
+    // Zaktualizuj zakres osi X
+    const qreal latestTimeS = m_seriesList.isEmpty() || m_seriesList.first()->count() == 0
+                                  ? oldestTime()
+                                  : m_seriesList.first()->at(m_seriesList.first()->count() - 1).x();
+    updateTimeAxisRange(latestTimeS);
 }
 
 void SensorGraph::setYRange(int minY, int maxY) {
@@ -163,7 +250,7 @@ void SensorGraph::retranslateUi() {
         chartPtr->setTitle(tr(qPrintable(m_baseTitleKey)));
 
         if (auto *axisX = qobject_cast<QValueAxis *>(chartPtr->axisX())) {
-            axisX->setTitleText(tr("Sample Index"));
+            axisX->setTitleText(tr("Time [s]"));
         }
         if (auto *axisY = qobject_cast<QValueAxis *>(chartPtr->axisY())) {
             axisY->setTitleText(tr("Value"));
@@ -172,3 +259,10 @@ void SensorGraph::retranslateUi() {
         // Jeśli miałyby być tłumaczone, należałoby zaimplementować ich aktualizację tutaj.
     }
 }
+
+void SensorGraph::paintEvent(QPaintEvent *event) {
+    QElapsedTimer paintTimer;
+    paintTimer.start();
+    QChartView::paintEvent(event);
+    PerfCounters::addPaintTime(PerfCounters::PaintSource::Charts, paintTimer.nsecsElapsed());
+}
@@ -5,7 +5,7 @@
  * i jest przeznaczona do wizualizacji danych telemetrycznych (np. z akcelerometru, żyroskopu, magnetometru)
  * w czasie rzeczywistym. Klasa obsługuje dynamiczne dodawanie danych dla trzech
  * osobnych kanałów (np. osie X, Y, Z), automatyczne przesuwanie osi czasu
- * oraz zarządzanie liczbą wyświetlanych próbek.
+ * (czas odbioru próbek w sekundach) oraz zarządzanie liczbą wyświetlanych próbek.
  * @author Mateusz Wojtaszek
  * @date 2025-05-19
  * @version 1.0
@@ -44,7 +44,7 @@ public:
     /**
      * @brief Konstruktor klasy SensorGraph.
      * @details Inicjalizuje wykres, tworzy trzy serie danych (dla kanałów X, Y, Z),
-     * konfiguruje osie (oś X jako indeks próbki, oś Y jako wartość), ustawia legendę
+     * konfiguruje osie (oś X jako czas w sekundach, oś Y jako wartość), ustawia legendę
      * oraz tytuł wykresu.
      * @param titleKey [in] Klucz tłumaczenia dla tytułu wykresu (np. "AccelerometerData").
      * @param minY [in] Początkowa minimalna wartość dla osi Y.
@@ -56,17 +56,36 @@ public:
     /**
      * @brief Dodaje nowy zestaw punktów danych (X, Y, Z) do wykresu.
      * @details Każda wartość z wektora `axisValuesToAdd` jest dodawana do odpowiedniej
-     * serii danych (pierwsza wartość do pierwszej serii, itd.) wraz z bieżącym
-     * indeksem próbki. Jeśli liczba punktów w serii przekroczy zdefiniowany limit,
-     * najstarszy punkt jest usuwany. Oś X jest automatycznie aktualizowana.
+     * serii danych (pierwsza wartość do pierwszej serii, itd.) w chwili `timestampNs`,
+     * liczonej na osi X w sekundach od pierwszej próbki. Jeśli liczba punktów przekroczy
+     * zdefiniowany limit, najstarszy punkt jest usuwany. Oś X jest automatycznie aktualizowana.
      * @param axisValuesToAdd [in] Wektor zawierający 3 wartości całkowite dla kolejnych serii.
+     * @param timestampNs [in] Monotoniczny czas próbki [ns] (`SensorFrame::hostTimestampNs`).
+     * @param rawValues [in] Opcjonalnie: 3 wartości przed filtrowaniem dla przebiegu surowego
+     * (`setRawTraceVisible()`); pusty wektor - przebieg surowy pokrywa się z głównym.
      * @note Dane nie zostaną dodane, jeśli wektor nie zawiera dokładnie 3 wartości.
      */
-    void addData(const QVector<int> &axisValuesToAdd);
+    void addData(const QVector<int> &axisValuesToAdd, qint64 timestampNs, const QVector<int> &rawValues = {});
+
+    /**
+     * @brief Zaznacza przerwę w danych (np. utracone ramki).
+     * @details Kolejne punkty trafiają do nowych serii, więc linia nie łączy próbek sprzed i zza
+     * przerwy - na osi czasu pozostaje pusty odcinek. Serie sprzed przerwy są usuwane,
+     * gdy wyjdą poza okno wykresu.
+     */
+    void markGap();
+
+    /**
+     * @brief Pokazuje lub ukrywa przebiegi surowe (przed filtrowaniem) pod przebiegami głównymi.
+     * @details Zmienia liczbę serii w segmencie (3 lub 6), więc dotychczasowa historia wykresu
+     * jest usuwana.
+     * @param visible [in] `true`, aby rysować półprzezroczyste serie "X (raw)", "Y (raw)", "Z (raw)".
+     */
+    void setRawTraceVisible(bool visible);
 
     /**
      * @brief Ustawia maksymalną liczbę próbek wyświetlanych jednocześnie na wykresie.
-     * @details Definiuje szerokość "okna" danych widocznych na osi X. Minimalna
+     * @details Definiuje liczbę próbek w "oknie" danych widocznym na osi X. Minimalna
      * dozwolona wartość to 10. Zmiana tej wartości powoduje usunięcie nadmiarowych
      * starych próbek i dostosowanie zakresu osi X. [cite: 27]
      * @param sampleCount [in] Nowa maksymalna liczba widocznych próbek (minimum 10).
@@ -89,10 +108,43 @@ public:
      */
     void retranslateUi();
 
+protected:
+    /**
+     * @brief Odrysowuje wykres i zlicza czas odrysowania w `PerfCounters`.
+     * @param event [in] Zdarzenie odrysowania.
+     */
+    void paintEvent(QPaintEvent *event) override;
+
 private:
-    QList<QLineSeries *> m_seriesList; ///< Lista wskaźników na trzy serie danych (X, Y, Z).
+    /**
+     * @brief Usuwa najstarsze punkty ponad limit próbek oraz opróżnione serie sprzed przerw.
+     */
+    void trimOldest();
+
+    /**
+     * @brief Tworzy i dodaje do wykresu serie jednego segmentu (X, Y, Z i ewentualnie przebiegi surowe).
+     * @return Nowe serie w kolejności kanałów.
+     */
+    QList<QLineSeries *> createSeries();
+
+    /**
+     * @brief Zwraca czas [s] najstarszego punktu na wykresie.
+     */
+    qreal oldestTime() const;
+
+    /**
+     * @brief Ustawia zakres osi czasu od najstarszego punktu do `latestTimeS`.
+     * @param latestTimeS [in] Czas [s] najnowszego punktu.
+     */
+    void updateTimeAxisRange(qreal latestTimeS);
+
+    QList<QLineSeries *> m_seriesList; ///< Bieżące serie danych (X, Y, Z, a przy przebiegach surowych także ich kopie surowe).
+    QList<QList<QLineSeries *>> m_closedSegments; ///< Serie sprzed przerw w danych, od najstarszych.
     int m_maxSampleCount; ///< Maksymalna liczba wyświetlanych punktów na serii.
-    qint64 m_currentSampleIndex; ///< Bieżący indeks próbki (wartość na osi X).
+    qint64 m_currentSampleIndex; ///< Liczba dodanych próbek (do rzadszej aktualizacji osi X).
+    int m_pointCount; ///< Liczba punktów na kanał we wszystkich seriach.
+    qint64 m_timeOriginNs; ///< Czas pierwszej próbki (zero osi X) [ns].
+    bool m_rawTraceVisible; ///< Czy segmenty zawierają serie surowe.
     QString m_baseTitleKey; ///< Klucz tłumaczenia dla głównego tytułu wykresu.
 };
 
@@ -0,0 +1,72 @@
+/**
+ * @file SequenceTracker.cpp
+ * @brief Implementacja klasy SequenceTracker.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-02
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include "SequenceTracker.h"
+
+SequenceTracker::Event SequenceTracker::observe(quint32 sequence, quint32 *lostFrames) {
+    if (lostFrames) {
+        *lostFrames = 0;
+    }
+    sequence %= SEQUENCE_MODULUS;
+    if (!m_hasLast) {
+        m_hasLast = true;
+        m_last = sequence;
+        m_seenMask = 1;
+        ++m_stats.received;
+        return Event::First;
+    }
+
+    const quint32 ahead = (sequence + SEQUENCE_MODULUS - m_last) % SEQUENCE_MODULUS;
+    if (ahead > 0 && ahead < SEQUENCE_MODULUS / 2) {
+        m_seenMask = ahead >= HISTORY_WINDOW ? 0 : m_seenMask << ahead;
+        m_seenMask |= 1;
+        m_last = sequence;
+        ++m_stats.received;
+        if (ahead == 1) {
+            return Event::InOrder;
+        }
+        const quint32 missing = ahead - 1;
+        m_stats.lost += missing;
+        ++m_stats.gaps;
+        if (lostFrames) {
+            *lostFrames = missing;
+        }
+        return Event::Gap;
+    }
+
+    const quint32 behind = (m_last + SEQUENCE_MODULUS - sequence) % SEQUENCE_MODULUS;
+    if (behind < HISTORY_WINDOW) {
+        const quint64 bit = quint64{1} << behind;
+        if (m_seenMask & bit) {
+            ++m_stats.duplicates;
+            return Event::Duplicate;
+        }
+        // Numer wcześniej policzony jako utracony jednak dotarł
+        m_seenMask |= bit;
+        ++m_stats.received;
+        ++m_stats.late;
+        if (m_stats.lost > 0) {
+            --m_stats.lost;
+        }
+        return Event::Late;
+    }
+
+    m_last = sequence;
+    m_seenMask = 1;
+    ++m_stats.received;
+    ++m_stats.restarts;
+    return Event::Restart;
+}
+
+void SequenceTracker::reset() {
+    m_hasLast = false;
+    m_last = 0;
+    m_seenMask = 0;
+    m_stats = Stats();
+}
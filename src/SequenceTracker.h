@@ -0,0 +1,95 @@
+#ifndef SEQUENCETRACKER_H
+#define SEQUENCETRACKER_H
+
+/**
+ * @file SequenceTracker.h
+ * @brief Definicja klasy SequenceTracker - wykrywanie utraconych, zdublowanych i spóźnionych ramek.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-02
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include <QtGlobal>
+
+/**
+ * @class SequenceTracker
+ * @brief Analizuje numery sekwencyjne kolejnych ramek i prowadzi statystyki strat.
+ *
+ * @details
+ * Numer sekwencyjny jest 16-bitowym licznikiem urządzenia (0-65535, po 65535 następuje 0).
+ * Odległość od ostatniego numeru liczona jest modulo `SEQUENCE_MODULUS`:
+ * - o 1 do przodu - ramka w kolejności,
+ * - o więcej do przodu (mniej niż pół zakresu) - luka, brakujące ramki są liczone jako utracone,
+ * - do tyłu w obrębie okna `HISTORY_WINDOW` - ramka zdublowana (numer już widziany) albo spóźniona
+ *   (numer wcześniej uznany za utracony - licznik strat jest wtedy korygowany),
+ * - do tyłu poza oknem - restart licznika urządzenia; śledzenie zaczyna się od nowa bez naliczania strat.
+ *
+ * Klasa nie jest powiązana z `QObject` ani z portem - podobnie jak `FrameParser` może być używana
+ * w benchmarkach i innych źródłach danych.
+ */
+class SequenceTracker {
+public:
+    static constexpr quint32 SEQUENCE_MODULUS = 65536; //!< Zakres licznika urządzenia (16 bitów).
+    static constexpr quint32 HISTORY_WINDOW = 64; //!< Liczba ostatnich numerów pamiętanych do wykrywania duplikatów.
+
+    /**
+     * @enum Event
+     * @brief Klasyfikacja odebranej ramki.
+     */
+    enum class Event {
+        First, //!< Pierwsza ramka (lub pierwsza po restarcie licznika).
+        InOrder, //!< Kolejny oczekiwany numer.
+        Gap, //!< Przed ramką brakuje co najmniej jednego numeru.
+        Duplicate, //!< Numer już odebrany.
+        Late, //!< Numer odebrany po późniejszych (wcześniej uznany za utracony).
+        Restart //!< Duży skok wstecz - licznik urządzenia wystartował od nowa.
+    };
+
+    /**
+     * @struct Stats
+     * @brief Łączne statystyki od ostatniego `reset()`.
+     */
+    struct Stats {
+        quint64 received = 0; //!< Ramki unikalne (bez duplikatów).
+        quint64 lost = 0; //!< Numery brakujące (z korektą o ramki spóźnione).
+        quint64 duplicates = 0; //!< Ramki zdublowane.
+        quint64 late = 0; //!< Ramki odebrane poza kolejnością.
+        quint64 gaps = 0; //!< Liczba luk (zdarzeń `Event::Gap`).
+        quint64 restarts = 0; //!< Wykryte restarty licznika.
+
+        /**
+         * @brief Zwraca udział utraconych ramek wśród oczekiwanych (0-1).
+         */
+        double lossRate() const {
+            const quint64 expected = received + lost;
+            return expected > 0 ? static_cast<double>(lost) / static_cast<double>(expected) : 0.0;
+        }
+    };
+
+    /**
+     * @brief Klasyfikuje numer kolejnej ramki i aktualizuje statystyki.
+     * @param sequence [in] Numer sekwencyjny ramki (0 - `SEQUENCE_MODULUS` - 1).
+     * @param lostFrames [out] Opcjonalnie: liczba brakujących numerów przed ramką (dla `Event::Gap`), w innych przypadkach 0.
+     * @return Klasyfikacja ramki.
+     */
+    Event observe(quint32 sequence, quint32 *lostFrames = nullptr);
+
+    /**
+     * @brief Zwraca statystyki.
+     */
+    const Stats &stats() const { return m_stats; }
+
+    /**
+     * @brief Zeruje statystyki i zapomina ostatni numer.
+     */
+    void reset();
+
+private:
+    bool m_hasLast = false; //!< Czy odebrano już jakikolwiek numer.
+    quint32 m_last = 0; //!< Najwyższy (w sensie modulo) odebrany numer.
+    quint64 m_seenMask = 0; //!< Bit i oznacza, że odebrano numer `m_last - i`.
+    Stats m_stats; //!< Łączne statystyki.
+};
+
+#endif // SEQUENCETRACKER_H
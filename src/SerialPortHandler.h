@@ -11,17 +11,16 @@
  * i sygnalizuje błędy komunikacji.
  * @note Ta klasa opiera się na frameworku Qt, w szczególności na QSerialPort.
  * Oczekiwany format ramki danych: CSV_PAYLOAD*CRC16_HEX\r\n
- * CSV_PAYLOAD: 12 wartości IMU, 2 wartości GPS (LAT, LON)
+ * CSV_PAYLOAD: 12 wartości IMU, 2 wartości GPS (LAT, LON), opcjonalnie numer sekwencyjny ramki (SEQ)
  */
 
 #ifndef SERIALPORTHANDLER_H
 #define SERIALPORTHANDLER_H
 
-#include <QObject>
 #include <QSerialPort>
 #include <QSerialPortInfo>
-#include <QVector>
 #include <QString>
+#include "FrameSource.h"
 
 /**
  * @class SerialPortHandler
@@ -33,9 +32,13 @@
  * - Buforowanie i odczytywanie przychodzących danych.
  * - Weryfikację integralności danych za pomocą sumy kontrolnej CRC-16.
  * - Parsowanie danych w formacie CSV (12 wartości IMU + 2 wartości GPS) do wektora liczb zmiennoprzecinkowych.
+ * - Wykrywanie utraconych, zdublowanych i spóźnionych ramek na podstawie opcjonalnego numeru sekwencyjnego.
  * - Emitowanie sygnałów o nowych, zweryfikowanych danych i błędach komunikacji, wykorzystując mechanizm sygnałów i slotów Qt.
+ *
+ * Dekodowanie ramek (CRC, CSV, numery sekwencyjne, czas odbioru) jest wspólne dla wszystkich źródeł
+ * i realizuje je `FrameSource`; ta klasa odpowiada za transport przez `QSerialPort`.
  */
-class SerialPortHandler : public QObject {
+class SerialPortHandler : public FrameSource {
     Q_OBJECT
 
 public:
@@ -73,30 +76,16 @@ public:
      * @author Mateusz Wojtaszek
      * @return QString zawierający opis błędu.
      */
-    QString getLastError() const;
+    QString getLastError() const override;
 
-signals:
     /**
-     * @brief Emitowany, gdy kompletna linia danych została odebrana, zweryfikowana przez CRC i pomyślnie sparsowana.
-     * @author Mateusz Wojtaszek
-     *
-     * @details Oczekuje się, że przychodzące dane będą w formacie CSV_PAYLOAD*CRC16_HEX.
-     * Ładunek CSV (CSV_PAYLOAD) powinien zawierać określone wartości telemetryczne.
-     * Oczekiwany format ładunku danych CSV to:
-     * GYRO_X, GYRO_Y, GYRO_Z, ACC_X, ACC_Y, ACC_Z, MAG_X, MAG_Y, MAG_Z, ROLL, PITCH, YAW, GPS_LAT, GPS_LON.
-     * Sygnał ten dostarcza sparsowane dane jako wektor liczb zmiennoprzecinkowych.
-     * @param parsedDataFromSensors [out] Stała referencja do QVector<float> zawierającego sparsowane wartości (12 IMU + 2 GPS).
-     * @note Liczba wartości w ładunku CSV musi odpowiadać oczekiwanej liczbie (14 dla obecnego formatu).
+     * @brief Zwraca nazwę otwartego (lub ostatnio otwieranego) portu.
      */
-    void newDataReceived(const QVector<float> &parsedDataFromSensors);
+    QString portName() const { return serial ? serial->portName() : QString(); }
 
-    /**
-     * @brief Emitowany, gdy wystąpi błąd komunikacji szeregowej.
-     * @author Mateusz Wojtaszek
-     * @param error [out] Kod błędu QSerialPort::SerialPortError.
-     * @param errorString [out] Stała referencja do QString opisującego błąd.
-     */
-    void errorOccurred(QSerialPort::SerialPortError error, const QString &errorString);
+    void close() override { closePort(); }
+    bool isOpen() const override { return serial && serial->isOpen(); }
+    QString sourceName() const override { return portName(); }
 
 private slots:
     /**
@@ -114,21 +103,6 @@ private slots:
 
 private:
     QSerialPort *serial = nullptr; ///< Wskaźnik na obiekt QSerialPort. @brief Wskaźnik na obiekt QSerialPort.
-    QByteArray buffer;             ///< Wewnętrzny bufor na dane. @brief Wewnętrzny bufor na dane.
-
-    /**
-     * @var EXPECTED_VALUE_COUNT_SERIAL
-     * @brief Definiuje oczekiwaną liczbę wartości w ładunku CSV (12 IMU + 2 GPS = 14).
-     */
-    const int EXPECTED_VALUE_COUNT_SERIAL = 14;
-
-    /**
-     * @brief Oblicza sumę kontrolną CRC-16/CCITT-FALSE.
-     * @author Mateusz Wojtaszek
-     * @param data Dane wejściowe.
-     * @return 16-bitowa suma kontrolna CRC.
-     */
-    static uint16_t calculateCrc16(const QByteArray &data);
 };
 
 #endif // SERIALPORTHANDLER_H
\ No newline at end of file
@@ -0,0 +1,312 @@
+/**
+ * @file SharedFrameRing.cpp
+ * @brief Implementacja klasy SharedFrameRing.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-08
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include "SharedFrameRing.h"
+#include "LatencyTracer.h"
+#include <QDebug>
+#include <cstring>
+
+#if defined(Q_OS_UNIX)
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+constexpr quint32 MAX_CAPACITY_SFR = 1u << 20; // 128 MiB segmentu
+constexpr int MAX_READ_RETRIES_SFR = 8; // Ponowienia odczytu slotu nadpisanego w trakcie kopiowania
+
+namespace {
+/**
+ * @brief Zaokrągla w górę do potęgi dwójki (indeks slotu wyznaczany maską).
+ */
+quint32 roundUpToPowerOfTwo(quint32 value) {
+    quint32 result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+/**
+ * @brief Ustawia opis błędu, jeśli wywołujący go oczekuje.
+ */
+void setError(QString *errorString, const QString &message) {
+    if (errorString) {
+        *errorString = message;
+    }
+}
+} // namespace
+
+SharedFrameRing::~SharedFrameRing() {
+    close();
+}
+
+#if defined(Q_OS_UNIX)
+
+namespace {
+/**
+ * @brief Sprawdza, czy istniejący segment można bezpiecznie usunąć.
+ * @details Segment jest porzucony, gdy pisarz oznaczył go jako zamknięty albo proces pisarza nie istnieje.
+ * Segment pusty, o innym układzie lub z żyjącym pisarzem nie jest uznawany za porzucony.
+ * @param nativeName [in] Nazwa segmentu POSIX.
+ * @param errorString [out] Opcjonalnie: powód, dla którego segmentu nie można zastąpić.
+ * @return `true`, jeśli segment jest na pewno porzucony.
+ */
+bool isAbandonedSegment(const QByteArray &nativeName, QString *errorString) {
+    const QString name = QString::fromLocal8Bit(nativeName);
+    const int fd = shm_open(nativeName.constData(), O_RDONLY, 0);
+    if (fd < 0) {
+        setError(errorString, QString::fromLocal8Bit(std::strerror(errno)));
+        return false;
+    }
+    struct stat info{};
+    void *memory = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && info.st_size >= static_cast<off_t>(sizeof(SharedFrameRing::Header))) {
+        memory = mmap(nullptr, sizeof(SharedFrameRing::Header), PROT_READ, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        setError(errorString, QStringLiteral("Shared memory segment %1 exists but is not initialized - "
+                                             "remove it manually if no process uses it.").arg(name));
+        return false;
+    }
+    const auto *header = static_cast<const SharedFrameRing::Header *>(memory);
+    const bool known = header->magic.load(std::memory_order_acquire) == SharedFrameRing::MAGIC &&
+                       header->version == SharedFrameRing::VERSION;
+    const bool closed = header->writerClosed.load(std::memory_order_acquire) != 0;
+    const qint32 writerPid = header->writerPid.load(std::memory_order_relaxed);
+    munmap(memory, sizeof(SharedFrameRing::Header));
+
+    if (!known) {
+        setError(errorString, QStringLiteral("Shared memory segment %1 exists with an unknown layout - "
+                                             "remove it manually if no process uses it.").arg(name));
+        return false;
+    }
+    if (closed || (writerPid > 0 && kill(writerPid, 0) != 0 && errno == ESRCH)) {
+        return true;
+    }
+    setError(errorString, QStringLiteral("Shared memory segment %1 is in use by process %2.").arg(name).arg(writerPid));
+    return false;
+}
+} // namespace
+
+bool SharedFrameRing::create(const QString &name, quint32 capacity, QString *errorString) {
+    close();
+    const QByteArray nativeName = name.toLocal8Bit();
+    const quint32 slotCount = roundUpToPowerOfTwo(qBound<quint32>(2, capacity, MAX_CAPACITY_SFR));
+    const qsizetype bytes = static_cast<qsizetype>(sizeof(Header) + slotCount * sizeof(Slot));
+
+    int fd = shm_open(nativeName.constData(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+    if (fd < 0 && errno == EEXIST) {
+        if (!isAbandonedSegment(nativeName, errorString)) {
+            return false; // Segment innego działającego pisarza nie może zniknąć spod jego czytelników
+        }
+        // Pozostałość po procesie, który nie usunął segmentu - dołączeni czytelnicy zachowują stary segment
+        qInfo() << "Replacing abandoned shared memory frame ring" << name;
+        shm_unlink(nativeName.constData());
+        fd = shm_open(nativeName.constData(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+    }
+    if (fd < 0) {
+        setError(errorString, QString::fromLocal8Bit(std::strerror(errno)));
+        return false;
+    }
+    if (ftruncate(fd, bytes) != 0) {
+        setError(errorString, QString::fromLocal8Bit(std::strerror(errno)));
+        ::close(fd);
+        shm_unlink(nativeName.constData());
+        return false;
+    }
+    void *memory = mmap(nullptr, static_cast<size_t>(bytes), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (memory == MAP_FAILED) {
+        setError(errorString, QString::fromLocal8Bit(std::strerror(errno)));
+        ::close(fd);
+        shm_unlink(nativeName.constData());
+        return false;
+    }
+
+    // ftruncate wypełnia segment zerami: liczniki slotów = 0 (puste), writeIndex = 0
+    m_fd = fd;
+    m_mappedBytes = bytes;
+    m_header = static_cast<Header *>(memory);
+    m_slots = reinterpret_cast<Slot *>(m_header + 1);
+    m_mask = slotCount - 1;
+    m_nextIndex = 0;
+    m_writer = true;
+    m_name = name;
+    m_header->version = VERSION;
+    m_header->slotBytes = sizeof(Slot);
+    m_header->capacity = slotCount;
+    m_header->writerPid.store(static_cast<qint32>(getpid()), std::memory_order_relaxed);
+    m_header->magic.store(MAGIC, std::memory_order_release); // Czytelnik widzi wypełniony nagłówek
+    qInfo() << "Shared memory frame ring" << name << "created -" << slotCount << "slots," << bytes << "bytes.";
+    return true;
+}
+
+bool SharedFrameRing::attach(const QString &name, QString *errorString) {
+    close();
+    const QByteArray nativeName = name.toLocal8Bit();
+    const int fd = shm_open(nativeName.constData(), O_RDONLY, 0);
+    if (fd < 0) {
+        setError(errorString, QString::fromLocal8Bit(std::strerror(errno)));
+        return false;
+    }
+    struct stat info{};
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(Header))) {
+        setError(errorString, QStringLiteral("Shared memory segment is too small."));
+        ::close(fd);
+        return false;
+    }
+    const auto bytes = static_cast<qsizetype>(info.st_size);
+    void *memory = mmap(nullptr, static_cast<size_t>(bytes), PROT_READ, MAP_SHARED, fd, 0);
+    if (memory == MAP_FAILED) {
+        setError(errorString, QString::fromLocal8Bit(std::strerror(errno)));
+        ::close(fd);
+        return false;
+    }
+    m_fd = fd;
+    m_mappedBytes = bytes;
+    m_header = static_cast<Header *>(memory);
+    m_slots = reinterpret_cast<Slot *>(m_header + 1);
+    m_writer = false;
+    m_name = name;
+
+    const quint32 capacity = m_header->capacity;
+    if (m_header->magic.load(std::memory_order_acquire) != MAGIC || m_header->version != VERSION ||
+        m_header->slotBytes != sizeof(Slot) || capacity == 0 || (capacity & (capacity - 1)) != 0 ||
+        bytes < static_cast<qsizetype>(sizeof(Header) + capacity * sizeof(Slot))) {
+        setError(errorString, QStringLiteral("Shared memory segment has an unsupported layout."));
+        unmap();
+        return false;
+    }
+    m_mask = capacity - 1;
+    return true;
+}
+
+void SharedFrameRing::close() {
+    if (!m_header) {
+        return;
+    }
+    if (m_writer) {
+        m_header->writerClosed.store(1, std::memory_order_release);
+        shm_unlink(m_name.toLocal8Bit().constData());
+        qInfo() << "Shared memory frame ring" << m_name << "closed after" << m_nextIndex << "frames.";
+    }
+    unmap();
+}
+
+void SharedFrameRing::unmap() {
+    munmap(m_header, static_cast<size_t>(m_mappedBytes));
+    ::close(m_fd);
+    m_header = nullptr;
+    m_slots = nullptr;
+    m_fd = -1;
+    m_mappedBytes = 0;
+    m_mask = 0;
+    m_writer = false;
+}
+
+#else
+
+bool SharedFrameRing::create(const QString &, quint32, QString *errorString) {
+    setError(errorString, QStringLiteral("POSIX shared memory is not available on this platform."));
+    return false;
+}
+
+bool SharedFrameRing::attach(const QString &, QString *errorString) {
+    setError(errorString, QStringLiteral("POSIX shared memory is not available on this platform."));
+    return false;
+}
+
+void SharedFrameRing::close() {
+}
+
+void SharedFrameRing::unmap() {
+}
+
+#endif
+
+quint64 SharedFrameRing::writeIndex() const {
+    return m_header ? m_header->writeIndex.load(std::memory_order_acquire) : 0;
+}
+
+bool SharedFrameRing::isWriterClosed() const {
+    return !m_header || m_header->writerClosed.load(std::memory_order_acquire) != 0;
+}
+
+void SharedFrameRing::publish(const SensorFrame &frame) {
+    if (!m_writer) {
+        return;
+    }
+    const quint64 index = m_nextIndex++;
+    Slot &slot = m_slots[index & m_mask];
+    slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release); // Licznik nieparzysty widoczny przed danymi
+
+    const int valueCount = static_cast<int>(qMin<qsizetype>(frame.values.size(), MAX_VALUE_COUNT));
+    slot.hostTimestampNs = frame.hostTimestampNs;
+    slot.deviceId = static_cast<quint16>(frame.deviceId);
+    slot.lostFramesBefore = static_cast<quint16>(qBound(0, frame.lostFramesBefore, 0xFFFF));
+    slot.valueCount = static_cast<quint16>(valueCount);
+    std::memcpy(slot.values, frame.values.constData(), valueCount * sizeof(float));
+    slot.publishedNs = LatencyTracer::nowNs();
+
+    slot.sequence.store(2 * index + 2, std::memory_order_release);
+    m_header->writeIndex.store(index + 1, std::memory_order_release);
+}
+
+bool SharedFrameRing::read(quint64 &cursor, SensorFrame &frame, quint64 &lostFrames, qint64 *publishedNs) const {
+    lostFrames = 0;
+    if (!m_header) {
+        return false;
+    }
+    const quint64 capacity = static_cast<quint64>(m_mask) + 1;
+    for (int attempt = 0; attempt < MAX_READ_RETRIES_SFR; ++attempt) {
+        const quint64 written = m_header->writeIndex.load(std::memory_order_acquire);
+        if (cursor >= written) {
+            return false;
+        }
+        if (written - cursor > capacity) {
+            // Czytelnik wyprzedzony o całe okrążenie - najstarsze ramki są już nadpisane
+            const quint64 oldest = written - capacity;
+            lostFrames += oldest - cursor;
+            cursor = oldest;
+        }
+
+        const Slot &slot = m_slots[cursor & m_mask];
+        const quint64 expected = 2 * cursor + 2;
+        if (slot.sequence.load(std::memory_order_acquire) != expected) {
+            // Pisarz zapisuje już ten slot w kolejnym okrążeniu - pomiń nadpisywaną ramkę
+            ++lostFrames;
+            ++cursor;
+            continue;
+        }
+        const int valueCount = qMin<int>(slot.valueCount, MAX_VALUE_COUNT);
+        frame.values.resize(valueCount);
+        std::memcpy(frame.values.data(), slot.values, valueCount * sizeof(float));
+        frame.hostTimestampNs = slot.hostTimestampNs;
+        frame.deviceId = slot.deviceId;
+        frame.lostFramesBefore = slot.lostFramesBefore;
+        const qint64 slotPublishedNs = slot.publishedNs;
+        std::atomic_thread_fence(std::memory_order_acquire); // Kopia zakończona przed ponownym odczytem licznika
+        if (slot.sequence.load(std::memory_order_relaxed) != expected) {
+            ++lostFrames; // Slot nadpisany w trakcie kopiowania - kopia jest niespójna
+            ++cursor;
+            continue;
+        }
+        if (publishedNs) {
+            *publishedNs = slotPublishedNs;
+        }
+        ++cursor;
+        return true;
+    }
+    return false;
+}
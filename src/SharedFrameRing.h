@@ -0,0 +1,161 @@
+#ifndef SHAREDFRAMERING_H
+#define SHAREDFRAMERING_H
+
+/**
+ * @file SharedFrameRing.h
+ * @brief Definicja klasy SharedFrameRing - bufor cykliczny ramek w pamięci współdzielonej POSIX.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-08
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include <QString>
+#include <QtGlobal>
+#include <atomic>
+#include "SensorFrame.h"
+
+/**
+ * @class SharedFrameRing
+ * @brief Bufor cykliczny ramek w segmencie `shm_open` - jeden pisarz, dowolnie wielu czytelników (SPMC).
+ *
+ * @details
+ * Pisarz (`create()`) zapisuje każdą ramkę do kolejnego slotu i przesuwa indeks zapisu; czytelnicy
+ * (`attach()`) mapują segment tylko do odczytu i odpytują go bez blokad i bez wywołań systemowych -
+ * ramka trafia do innego procesu bez kopiowania przez jądro.
+ *
+ * Każdy slot jest chroniony licznikiem sekwencyjnym (seqlock): przed zapisem pisarz ustawia go na
+ * wartość nieparzystą `2 * i + 1`, po zapisie na `2 * i + 2`, gdzie `i` to numer ramki. Czytelnik
+ * kopiuje slot tylko wtedy, gdy licznik przed i po kopii jest równy `2 * i + 2`. Pisarz nigdy nie czeka
+ * na czytelników: czytelnik, którego wyprzedzono o więcej niż `capacity()` ramek, przeskakuje do
+ * najstarszych dostępnych danych i otrzymuje liczbę utraconych ramek.
+ *
+ * Układ segmentu: nagłówek (`Header`, 128 B), a po nim `capacity()` slotów (`Slot`, 128 B).
+ * Wszystkie pola są w natywnej kolejności bajtów - segment jest dostępny tylko lokalnie.
+ */
+class SharedFrameRing {
+public:
+    static constexpr char DEFAULT_NAME[] = "/orienta-frames"; //!< Domyślna nazwa segmentu.
+    static constexpr quint32 DEFAULT_CAPACITY = 4096; //!< Domyślna liczba slotów (~40 s przy 100 Hz).
+    static constexpr int MAX_VALUE_COUNT = 16; //!< Największa liczba wartości ramki w slocie.
+    static constexpr quint32 MAGIC = 0x4F524652; //!< "ORFR" - segment zainicjalizowany.
+    static constexpr quint16 VERSION = 2; //!< Wersja układu segmentu.
+
+    /**
+     * @struct Header
+     * @brief Nagłówek segmentu. Indeks zapisu leży w osobnej linii pamięci podręcznej.
+     */
+    struct alignas(64) Header {
+        std::atomic<quint32> magic; //!< `MAGIC` zapisywane na końcu inicjalizacji.
+        quint16 version; //!< `VERSION`.
+        quint16 slotBytes; //!< `sizeof(Slot)` - kontrola zgodności układu.
+        quint32 capacity; //!< Liczba slotów (potęga dwójki).
+        std::atomic<quint32> writerClosed; //!< 1 - pisarz zakończył pracę (segment nie będzie już zapisywany).
+        std::atomic<qint32> writerPid; //!< PID procesu pisarza - wykrywanie segmentów porzuconych.
+        alignas(64) std::atomic<quint64> writeIndex; //!< Liczba opublikowanych ramek.
+    };
+
+    /**
+     * @struct Slot
+     * @brief Slot jednej ramki (dwie linie pamięci podręcznej).
+     */
+    struct alignas(64) Slot {
+        std::atomic<quint64> sequence; //!< Licznik seqlock: `2 * i + 1` w trakcie zapisu, `2 * i + 2` po zapisie.
+        qint64 hostTimestampNs; //!< `SensorFrame::hostTimestampNs`.
+        qint64 publishedNs; //!< Czas zapisu do bufora (`LatencyTracer::nowNs()`, zegar monotoniczny).
+        quint16 deviceId; //!< `SensorFrame::deviceId`.
+        quint16 lostFramesBefore; //!< `SensorFrame::lostFramesBefore` (nasycane do 65535).
+        quint16 valueCount; //!< Liczba wartości.
+        quint16 reserved; //!< Wyrównanie.
+        float values[MAX_VALUE_COUNT]; //!< Wartości ramki.
+    };
+
+    static_assert(std::atomic<quint64>::is_always_lock_free, "Shared memory ring requires lock-free 64-bit atomics");
+    static_assert(sizeof(Header) == 128 && sizeof(Slot) == 128, "Unexpected shared memory layout");
+
+    SharedFrameRing() = default;
+
+    /**
+     * @brief Destruktor - odłącza segment (pisarz dodatkowo go usuwa).
+     */
+    ~SharedFrameRing();
+
+    SharedFrameRing(const SharedFrameRing &) = delete;
+    SharedFrameRing &operator=(const SharedFrameRing &) = delete;
+
+    /**
+     * @brief Tworzy segment i otwiera bufor do zapisu.
+     * @details Istniejący segment o tej nazwie jest zastępowany tylko wtedy, gdy na pewno jest porzucony:
+     * pisarz oznaczył go jako zamknięty albo proces o PID z nagłówka już nie istnieje. Segment używany
+     * przez działający proces lub o nieznanym układzie nie jest usuwany - `create()` zwraca błąd.
+     * Dostęp ma tylko bieżący użytkownik (0600).
+     * @param name [in] Nazwa segmentu POSIX (np. `/orienta-frames`).
+     * @param capacity [in] Liczba slotów (zaokrąglana w górę do potęgi dwójki).
+     * @param errorString [out] Opcjonalnie: opis błędu.
+     * @return `true`, jeśli bufor jest gotowy do zapisu.
+     */
+    bool create(const QString &name, quint32 capacity = DEFAULT_CAPACITY, QString *errorString = nullptr);
+
+    /**
+     * @brief Dołącza do istniejącego segmentu w trybie tylko do odczytu.
+     * @param name [in] Nazwa segmentu POSIX.
+     * @param errorString [out] Opcjonalnie: opis błędu.
+     * @return `true`, jeśli segment ma zgodny układ.
+     */
+    bool attach(const QString &name, QString *errorString = nullptr);
+
+    /** @brief Odłącza segment; pisarz oznacza go jako zamknięty i usuwa nazwę. */
+    void close();
+
+    /** @brief Informuje, czy segment jest dołączony. */
+    bool isOpen() const { return m_header != nullptr; }
+
+    /** @brief Informuje, czy obiekt jest pisarzem segmentu. */
+    bool isWriter() const { return m_writer; }
+
+    /** @brief Zwraca nazwę segmentu. */
+    QString name() const { return m_name; }
+
+    /** @brief Zwraca liczbę slotów. */
+    quint32 capacity() const { return m_mask + 1; }
+
+    /** @brief Zwraca liczbę ramek opublikowanych w segmencie. */
+    quint64 writeIndex() const;
+
+    /** @brief Informuje, czy pisarz zamknął segment (czytelnik powinien dołączyć ponownie). */
+    bool isWriterClosed() const;
+
+    /**
+     * @brief Zapisuje ramkę (tylko pisarz, jeden wątek).
+     * @param frame [in] Ramka (wartości ponad `MAX_VALUE_COUNT` są pomijane).
+     */
+    void publish(const SensorFrame &frame);
+
+    /**
+     * @brief Odczytuje kolejną ramkę bez blokowania (czytelnik).
+     * @param cursor [in,out] Numer następnej ramki do odczytu - prywatny dla czytelnika.
+     * Na początek `writeIndex()` (tylko nowe ramki) albo 0 (wszystkie dostępne).
+     * @param frame [out] Odczytana ramka (bufor wartości jest używany ponownie).
+     * @param lostFrames [out] Ramki nadpisane przed odczytem od poprzedniego wywołania (czytelnik nie nadążał).
+     * @param publishedNs [out] Opcjonalnie: czas zapisu ramki do bufora.
+     * @return `true`, jeśli odczytano ramkę; `false`, jeśli nie ma nowych danych.
+     */
+    bool read(quint64 &cursor, SensorFrame &frame, quint64 &lostFrames, qint64 *publishedNs = nullptr) const;
+
+private:
+    /**
+     * @brief Odmapowuje segment i zamyka deskryptor.
+     */
+    void unmap();
+
+    Header *m_header = nullptr; //!< Nagłówek zmapowanego segmentu.
+    Slot *m_slots = nullptr; //!< Pierwszy slot.
+    quint32 m_mask = 0; //!< `capacity() - 1`.
+    quint64 m_nextIndex = 0; //!< Numer kolejnej ramki pisarza.
+    qsizetype m_mappedBytes = 0; //!< Rozmiar mapowania.
+    int m_fd = -1; //!< Deskryptor segmentu.
+    bool m_writer = false; //!< Obiekt utworzył segment.
+    QString m_name; //!< Nazwa segmentu.
+};
+
+#endif // SHAREDFRAMERING_H
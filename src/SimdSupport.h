@@ -0,0 +1,211 @@
+#ifndef SIMDSUPPORT_H
+#define SIMDSUPPORT_H
+
+/**
+ * @file SimdSupport.h
+ * @brief Definicja klasy SimdFloat4 - przenośny wektor czterech liczb `float` (SSE2 / NEON / skalarnie).
+ * @details Jądra obliczeniowe (np. `AhrsFusion`) piszą pętle przetwarzające po `SimdFloat4::LANES`
+ * próbek naraz; wybór instrukcji odbywa się w czasie kompilacji:
+ * - SSE2 na x86-64 (zawsze dostępne),
+ * - NEON na ARM64 (Apple Silicon, Raspberry Pi 4/5),
+ * - wersja skalarna w pozostałych przypadkach lub po zdefiniowaniu `ORIENTA_SIMD_SCALAR`
+ *   (opcja CMake `ORIENTA_FORCE_SCALAR_SIMD`, np. do porównania wyników i wydajności).
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-10
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include <cmath>
+
+#if !defined(ORIENTA_SIMD_SCALAR) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define ORIENTA_SIMD_SSE2 1
+#include <emmintrin.h>
+#elif !defined(ORIENTA_SIMD_SCALAR) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define ORIENTA_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+/**
+ * @class SimdFloat4
+ * @brief Cztery liczby `float` przetwarzane jedną instrukcją.
+ *
+ * @details
+ * Udostępnia tylko operacje potrzebne jądrom aplikacji. `load()`/`store()` nie wymagają wyrównania
+ * danych. `rsqrt()` jest dokładne do ~1 ulp w wersjach SIMD (przybliżenie sprzętowe + krok Newtona),
+ * więc wyniki wszystkich wariantów są praktycznie równe.
+ */
+class SimdFloat4 {
+public:
+    static constexpr int LANES = 4; //!< Liczba elementów wektora.
+
+    SimdFloat4() = default;
+
+    /** @brief Wczytuje `LANES` kolejnych wartości (bez wymogu wyrównania). */
+    static SimdFloat4 load(const float *source) {
+#if defined(ORIENTA_SIMD_SSE2)
+        return SimdFloat4(_mm_loadu_ps(source));
+#elif defined(ORIENTA_SIMD_NEON)
+        return SimdFloat4(vld1q_f32(source));
+#else
+        SimdFloat4 result;
+        for (int i = 0; i < LANES; ++i) {
+            result.m_value[i] = source[i];
+        }
+        return result;
+#endif
+    }
+
+    /** @brief Zwraca wektor z tą samą wartością we wszystkich elementach. */
+    static SimdFloat4 broadcast(float value) {
+#if defined(ORIENTA_SIMD_SSE2)
+        return SimdFloat4(_mm_set1_ps(value));
+#elif defined(ORIENTA_SIMD_NEON)
+        return SimdFloat4(vdupq_n_f32(value));
+#else
+        SimdFloat4 result;
+        for (int i = 0; i < LANES; ++i) {
+            result.m_value[i] = value;
+        }
+        return result;
+#endif
+    }
+
+    /** @brief Zapisuje `LANES` wartości (bez wymogu wyrównania). */
+    void store(float *target) const {
+#if defined(ORIENTA_SIMD_SSE2)
+        _mm_storeu_ps(target, m_value);
+#elif defined(ORIENTA_SIMD_NEON)
+        vst1q_f32(target, m_value);
+#else
+        for (int i = 0; i < LANES; ++i) {
+            target[i] = m_value[i];
+        }
+#endif
+    }
+
+    friend SimdFloat4 operator+(SimdFloat4 a, SimdFloat4 b) {
+#if defined(ORIENTA_SIMD_SSE2)
+        return SimdFloat4(_mm_add_ps(a.m_value, b.m_value));
+#elif defined(ORIENTA_SIMD_NEON)
+        return SimdFloat4(vaddq_f32(a.m_value, b.m_value));
+#else
+        return apply(a, b, [](float x, float y) { return x + y; });
+#endif
+    }
+
+    friend SimdFloat4 operator-(SimdFloat4 a, SimdFloat4 b) {
+#if defined(ORIENTA_SIMD_SSE2)
+        return SimdFloat4(_mm_sub_ps(a.m_value, b.m_value));
+#elif defined(ORIENTA_SIMD_NEON)
+        return SimdFloat4(vsubq_f32(a.m_value, b.m_value));
+#else
+        return apply(a, b, [](float x, float y) { return x - y; });
+#endif
+    }
+
+    friend SimdFloat4 operator*(SimdFloat4 a, SimdFloat4 b) {
+#if defined(ORIENTA_SIMD_SSE2)
+        return SimdFloat4(_mm_mul_ps(a.m_value, b.m_value));
+#elif defined(ORIENTA_SIMD_NEON)
+        return SimdFloat4(vmulq_f32(a.m_value, b.m_value));
+#else
+        return apply(a, b, [](float x, float y) { return x * y; });
+#endif
+    }
+
+    /** @brief Zwraca `a * b + c` (bez gwarancji jednego zaokrąglenia). */
+    static SimdFloat4 mulAdd(SimdFloat4 a, SimdFloat4 b, SimdFloat4 c) {
+#if defined(ORIENTA_SIMD_NEON)
+        return SimdFloat4(vmlaq_f32(c.m_value, a.m_value, b.m_value));
+#else
+        return a * b + c;
+#endif
+    }
+
+    /** @brief Zwraca większą z wartości w każdym elemencie. */
+    static SimdFloat4 max(SimdFloat4 a, SimdFloat4 b) {
+#if defined(ORIENTA_SIMD_SSE2)
+        return SimdFloat4(_mm_max_ps(a.m_value, b.m_value));
+#elif defined(ORIENTA_SIMD_NEON)
+        return SimdFloat4(vmaxq_f32(a.m_value, b.m_value));
+#else
+        return apply(a, b, [](float x, float y) { return x > y ? x : y; });
+#endif
+    }
+
+    /** @brief Zwraca mniejszą z wartości w każdym elemencie. */
+    static SimdFloat4 min(SimdFloat4 a, SimdFloat4 b) {
+#if defined(ORIENTA_SIMD_SSE2)
+        return SimdFloat4(_mm_min_ps(a.m_value, b.m_value));
+#elif defined(ORIENTA_SIMD_NEON)
+        return SimdFloat4(vminq_f32(a.m_value, b.m_value));
+#else
+        return apply(a, b, [](float x, float y) { return x < y ? x : y; });
+#endif
+    }
+
+    /**
+     * @brief Zwraca `1 / sqrt(a)`.
+     * @note Argument musi być dodatni - zerowe normy należy wcześniej ograniczyć z dołu (`max()`).
+     */
+    static SimdFloat4 rsqrt(SimdFloat4 a) {
+#if defined(ORIENTA_SIMD_SSE2)
+        const __m128 estimate = _mm_rsqrt_ps(a.m_value); // ~12 bitów
+        const __m128 halfA = _mm_mul_ps(_mm_set1_ps(0.5f), a.m_value);
+        const __m128 correction = _mm_sub_ps(_mm_set1_ps(1.5f),
+                                             _mm_mul_ps(halfA, _mm_mul_ps(estimate, estimate)));
+        return SimdFloat4(_mm_mul_ps(estimate, correction)); // Krok Newtona: ~23 bity
+#elif defined(ORIENTA_SIMD_NEON)
+        float32x4_t estimate = vrsqrteq_f32(a.m_value); // ~8 bitów
+        estimate = vmulq_f32(estimate, vrsqrtsq_f32(vmulq_f32(a.m_value, estimate), estimate));
+        estimate = vmulq_f32(estimate, vrsqrtsq_f32(vmulq_f32(a.m_value, estimate), estimate));
+        return SimdFloat4(estimate);
+#else
+        SimdFloat4 result;
+        for (int i = 0; i < LANES; ++i) {
+            result.m_value[i] = 1.0f / std::sqrt(a.m_value[i]);
+        }
+        return result;
+#endif
+    }
+
+    /** @brief Zwraca nazwę użytego zestawu instrukcji (do logów i wyników benchmarków). */
+    static const char *backendName() {
+#if defined(ORIENTA_SIMD_SSE2)
+        return "sse2";
+#elif defined(ORIENTA_SIMD_NEON)
+        return "neon";
+#else
+        return "scalar";
+#endif
+    }
+
+private:
+#if defined(ORIENTA_SIMD_SSE2)
+    using Native = __m128;
+#elif defined(ORIENTA_SIMD_NEON)
+    using Native = float32x4_t;
+#else
+    using Native = float[LANES];
+
+    /** @brief Wykonuje operację dwuargumentową element po elemencie (wersja skalarna). */
+    template<typename Operation>
+    static SimdFloat4 apply(const SimdFloat4 &a, const SimdFloat4 &b, Operation operation) {
+        SimdFloat4 result;
+        for (int i = 0; i < LANES; ++i) {
+            result.m_value[i] = operation(a.m_value[i], b.m_value[i]);
+        }
+        return result;
+    }
+#endif
+
+#if defined(ORIENTA_SIMD_SSE2) || defined(ORIENTA_SIMD_NEON)
+    explicit SimdFloat4(Native value) : m_value(value) {
+    }
+#endif
+
+    Native m_value; //!< Wartości w rejestrze SIMD (lub tablicy w wersji skalarnej).
+};
+
+#endif // SIMDSUPPORT_H
@@ -0,0 +1,162 @@
+/**
+ * @file SpectrumAnalyzer.cpp
+ * @brief Implementacja klasy SpectrumAnalyzer.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-15
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include "SpectrumAnalyzer.h"
+#include "Fft.h"
+#include <QMutexLocker>
+#include <QThread>
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+
+constexpr int MAX_OVERLAP_PERCENT_SA = 90;
+constexpr float MIN_MAGNITUDE_SA = 1.0e-6f; // Dolne ograniczenie amplitudy przed logarytmem (-120 dB)
+constexpr float FALLBACK_SAMPLE_RATE_HZ_SA = 100.0f; // Gdy czasy próbek w oknie są jednakowe
+
+SpectrumAnalyzer::SpectrumAnalyzer(QObject *parent)
+    : QObject(parent),
+      m_workerThread(new QThread(this)),
+      m_workerContext(new QObject()) {
+    m_workerThread->setObjectName(QStringLiteral("OrientaSpectrum"));
+    m_workerContext->moveToThread(m_workerThread);
+    m_workerThread->start(QThread::LowPriority); // Analiza nie może spowalniać odbioru ramek
+    QMetaObject::invokeMethod(m_workerContext, [this, fftSize = m_fftSize, overlap = m_overlapPercent] {
+        prepare(fftSize, overlap);
+    });
+}
+
+SpectrumAnalyzer::~SpectrumAnalyzer() {
+    QMetaObject::invokeMethod(m_workerContext, [this] {
+        delete m_workerContext;
+    }, Qt::BlockingQueuedConnection);
+    m_workerThread->quit();
+    m_workerThread->wait();
+}
+
+void SpectrumAnalyzer::configure(int channel, int fftSize, int overlapPercent) {
+    m_channel = qBound(0, channel, CHANNEL_COUNT - 1);
+    m_fftSize = qMax(Fft::MIN_SIZE, fftSize);
+    m_overlapPercent = qBound(0, overlapPercent, MAX_OVERLAP_PERCENT_SA);
+    clearPending(); // Próbki poprzedniego kanału
+    QMetaObject::invokeMethod(m_workerContext, [this, fftSize = m_fftSize, overlap = m_overlapPercent] {
+        prepare(fftSize, overlap);
+    });
+}
+
+void SpectrumAnalyzer::addFrames(const float *const *frames, const qint64 *timestampsNs, int count) {
+    if (count <= 0) {
+        return;
+    }
+    {
+        // Do wątku analizy trafia tylko wybrany kanał - kopia niezależna od buforów paczki
+        QMutexLocker locker(&m_pendingMutex);
+        for (int i = 0; i < count; ++i) {
+            m_pendingSamples.append(frames[i][m_channel]);
+            m_pendingTimesNs.append(timestampsNs[i]);
+        }
+        const qsizetype excess = m_pendingSamples.size() - MAX_PENDING_SAMPLES;
+        if (excess > 0) {
+            m_pendingSamples.remove(0, excess); // Analiza nie nadąża - najstarsze próbki odrzucane
+            m_pendingTimesNs.remove(0, excess);
+        }
+    }
+    if (!m_drainQueued.exchange(true, std::memory_order_acq_rel)) {
+        QMetaObject::invokeMethod(m_workerContext, [this] { drainPending(); });
+    }
+}
+
+void SpectrumAnalyzer::drainPending() {
+    m_drainQueued.store(false, std::memory_order_release); // Próbki dopisane od teraz zgłoszą kolejne zadanie
+    {
+        QMutexLocker locker(&m_pendingMutex);
+        m_drainSamples.swap(m_pendingSamples);
+        m_drainTimesNs.swap(m_pendingTimesNs);
+    }
+    appendSamples(m_drainSamples, m_drainTimesNs);
+    m_drainSamples.clear();
+    m_drainTimesNs.clear();
+}
+
+void SpectrumAnalyzer::clearPending() {
+    QMutexLocker locker(&m_pendingMutex);
+    m_pendingSamples.clear();
+    m_pendingTimesNs.clear();
+}
+
+void SpectrumAnalyzer::reset() {
+    clearPending();
+    QMetaObject::invokeMethod(m_workerContext, [this] {
+        m_historyNext = 0;
+        m_historyCount = 0;
+        m_samplesSinceSpectrum = 0;
+    });
+}
+
+void SpectrumAnalyzer::prepare(int fftSize, int overlapPercent) {
+    m_fft = std::make_unique<Fft>(fftSize);
+    const int size = m_fft->size();
+    m_window.resize(size);
+    double windowSum = 0.0;
+    for (int i = 0; i < size; ++i) {
+        m_window[i] = static_cast<float>(0.5 - 0.5 * std::cos(2.0 * M_PI * i / size)); // Hann (okresowe)
+        windowSum += m_window[i];
+    }
+    m_amplitudeScale = static_cast<float>(2.0 / windowSum); // Amplituda sinusoidy niezależna od okna
+    m_history.fill(0.0f, size);
+    m_historyTimesNs.fill(0, size);
+    m_re.resize(size);
+    m_im.resize(size);
+    m_historyNext = 0;
+    m_historyCount = 0;
+    m_hop = qMax(1, size * (100 - overlapPercent) / 100);
+    m_samplesSinceSpectrum = 0;
+}
+
+void SpectrumAnalyzer::appendSamples(const QVector<float> &samples, const QVector<qint64> &timestampsNs) {
+    const int size = static_cast<int>(m_history.size());
+    for (int i = 0; i < samples.size(); ++i) {
+        m_history[m_historyNext] = samples[i];
+        m_historyTimesNs[m_historyNext] = timestampsNs[i];
+        m_historyNext = (m_historyNext + 1) % size;
+        m_historyCount = qMin(m_historyCount + 1, size);
+        if (m_historyCount == size && ++m_samplesSinceSpectrum >= m_hop) {
+            m_samplesSinceSpectrum = 0;
+            computeSpectrum();
+        }
+    }
+}
+
+void SpectrumAnalyzer::computeSpectrum() {
+    const int size = m_fft->size();
+    // Bufor od najstarszej próbki (m_historyNext) - bez składowej stałej (np. 1 g na osi Z)
+    double mean = 0.0;
+    for (float value: std::as_const(m_history)) {
+        mean += value;
+    }
+    mean /= size;
+    for (int i = 0; i < size; ++i) {
+        const int source = (m_historyNext + i) % size;
+        m_re[i] = static_cast<float>(m_history[source] - mean) * m_window[i];
+    }
+    std::fill(m_im.begin(), m_im.end(), 0.0f);
+    m_fft->forward(m_re.data(), m_im.data());
+
+    QVector<float> magnitudesDb(size / 2 + 1);
+    for (int k = 0; k <= size / 2; ++k) {
+        const float magnitude = std::sqrt(m_re[k] * m_re[k] + m_im[k] * m_im[k]) * m_amplitudeScale;
+        magnitudesDb[k] = 20.0f * std::log10(qMax(magnitude, MIN_MAGNITUDE_SA));
+    }
+
+    const qint64 oldestNs = m_historyTimesNs[m_historyNext];
+    const qint64 newestNs = m_historyTimesNs[(m_historyNext + size - 1) % size];
+    const float sampleRateHz = newestNs > oldestNs
+                                   ? static_cast<float>((size - 1) * 1.0e9 / static_cast<double>(newestNs - oldestNs))
+                                   : FALLBACK_SAMPLE_RATE_HZ_SA;
+    emit spectrumReady(magnitudesDb, sampleRateHz);
+}
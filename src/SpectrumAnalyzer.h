@@ -0,0 +1,144 @@
+#ifndef SPECTRUMANALYZER_H
+#define SPECTRUMANALYZER_H
+
+/**
+ * @file SpectrumAnalyzer.h
+ * @brief Definicja klasy SpectrumAnalyzer - widmo kanału IMU w przesuwnym oknie, liczone w osobnym wątku.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-15
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include <QMutex>
+#include <QObject>
+#include <QVector>
+#include <atomic>
+#include <memory>
+
+class QThread;
+class Fft;
+
+/**
+ * @class SpectrumAnalyzer
+ * @brief Liczy widmo amplitudowe wybranego kanału (żyroskop lub akcelerometr) z nakładaniem okien.
+ *
+ * @details
+ * Wątek GUI przekazuje paczki ramek (`addFrames()`): z każdej ramki kopiowana jest tylko wartość
+ * wybranego kanału i czas do wspólnego bufora oczekujących próbek (ograniczonego do
+ * `MAX_PENDING_SAMPLES` - gdy analiza nie nadąża, najstarsze próbki są odrzucane). Do wątku obliczeń
+ * (wzorzec jak w `DeviceManager`: własny `QThread` i obiekt kontekstu) trafia co najwyżej jedno
+ * zadanie opróżnienia bufora naraz. Tam próbki trafiają do bufora kołowego `fftSize` ostatnich
+ * wartości; co `fftSize * (100 - overlap) / 100` nowych próbek liczone jest widmo:
+ * usunięcie składowej stałej, okno Hanna, `Fft::forward()` i amplitudy prążków `0..fftSize/2` w dB
+ * (względem jednostki kanału). Częstotliwość próbkowania jest szacowana z czasów próbek w oknie,
+ * więc oś częstotliwości jest poprawna także przy odtwarzaniu nagrań. Wynik trafia do GUI sygnałem
+ * `spectrumReady()` (połączenie kolejkowane).
+ */
+class SpectrumAnalyzer : public QObject {
+    Q_OBJECT
+
+public:
+    static constexpr int CHANNEL_COUNT = 6; //!< Kanały do analizy: żyroskop X-Z i akcelerometr X-Z (indeksy ramki 0-5).
+    static constexpr int DEFAULT_FFT_SIZE = 512; //!< Domyślna długość okna [próbki].
+    static constexpr int DEFAULT_OVERLAP_PERCENT = 75; //!< Domyślne nakładanie okien [%].
+    static constexpr int MAX_PENDING_SAMPLES = 8192; //!< Limit próbek czekających na wątek analizy.
+
+    /**
+     * @brief Konstruktor - uruchamia wątek obliczeń.
+     * @param parent [in] Obiekt nadrzędny.
+     */
+    explicit SpectrumAnalyzer(QObject *parent = nullptr);
+
+    /** @brief Zatrzymuje wątek obliczeń. */
+    ~SpectrumAnalyzer() override;
+
+    /**
+     * @brief Ustawia kanał i parametry okna; zeruje bufor próbek.
+     * @param channel [in] Indeks kanału w ramce (0-5).
+     * @param fftSize [in] Długość okna - potęga dwójki.
+     * @param overlapPercent [in] Nakładanie kolejnych okien [%] (0-90).
+     */
+    void configure(int channel, int fftSize, int overlapPercent);
+
+    /**
+     * @brief Przekazuje paczkę ramek do analizy (wątek GUI; obliczenia w wątku analizy).
+     * @param frames [in] Ramki IMU (co najmniej 6 wartości).
+     * @param timestampsNs [in] Czasy ramek [ns].
+     * @param count [in] Liczba ramek.
+     */
+    void addFrames(const float *const *frames, const qint64 *timestampsNs, int count);
+
+    /** @brief Zeruje bufor próbek (np. po zmianie urządzenia lub luce w danych). */
+    void reset();
+
+    /** @brief Zwraca bieżący kanał. */
+    int channel() const { return m_channel; }
+
+    /** @brief Zwraca bieżącą długość okna. */
+    int fftSize() const { return m_fftSize; }
+
+    /** @brief Zwraca bieżące nakładanie okien [%]. */
+    int overlapPercent() const { return m_overlapPercent; }
+
+signals:
+    /**
+     * @brief Nowe widmo (emitowany z wątku analizy).
+     * @param magnitudesDb [out] Amplitudy prążków `0..fftSize/2` [dB].
+     * @param sampleRateHz [out] Oszacowana częstotliwość próbkowania [Hz] (prążek `k` to `k * fs / fftSize`).
+     */
+    void spectrumReady(const QVector<float> &magnitudesDb, float sampleRateHz);
+
+private:
+    /**
+     * @brief Przygotowuje transformatę, okno i bufory (wątek analizy).
+     * @param fftSize [in] Długość okna.
+     * @param overlapPercent [in] Nakładanie okien [%].
+     */
+    void prepare(int fftSize, int overlapPercent);
+
+    /**
+     * @brief Dopisuje próbki do bufora i liczy widmo co krok okna (wątek analizy).
+     * @param samples [in] Wartości kanału.
+     * @param timestampsNs [in] Czasy próbek [ns].
+     */
+    void appendSamples(const QVector<float> &samples, const QVector<qint64> &timestampsNs);
+
+    /** @brief Przejmuje oczekujące próbki i dopisuje je do bufora (wątek analizy). */
+    void drainPending();
+
+    /** @brief Odrzuca oczekujące próbki (np. po zmianie kanału). */
+    void clearPending();
+
+    /** @brief Liczy widmo bieżącego okna i emituje `spectrumReady()` (wątek analizy). */
+    void computeSpectrum();
+
+    QThread *m_workerThread; //!< Wątek analizy.
+    QObject *m_workerContext; //!< Obiekt w wątku analizy (cel `invokeMethod`).
+    int m_channel = 3; //!< Kanał (wątek GUI); domyślnie akcelerometr X.
+    int m_fftSize = DEFAULT_FFT_SIZE; //!< Długość okna (wątek GUI).
+    int m_overlapPercent = DEFAULT_OVERLAP_PERCENT; //!< Nakładanie okien (wątek GUI).
+
+    // Próbki przekazywane między wątkami
+    QMutex m_pendingMutex; //!< Chroni `m_pendingSamples` i `m_pendingTimesNs`.
+    QVector<float> m_pendingSamples; //!< Próbki czekające na wątek analizy.
+    QVector<qint64> m_pendingTimesNs; //!< Czasy próbek czekających na wątek analizy.
+    std::atomic<bool> m_drainQueued{false}; //!< Czy zadanie `drainPending()` czeka w kolejce wątku analizy.
+
+    // Stan wątku analizy
+    std::unique_ptr<Fft> m_fft; //!< Transformata długości okna.
+    QVector<float> m_window; //!< Współczynniki okna Hanna.
+    float m_amplitudeScale = 1.0f; //!< Skala amplitudy (2 / suma okna).
+    QVector<float> m_history; //!< Bufor kołowy ostatnich próbek.
+    QVector<qint64> m_historyTimesNs; //!< Czasy próbek w buforze.
+    int m_historyNext = 0; //!< Pozycja zapisu w buforze.
+    int m_historyCount = 0; //!< Liczba próbek w buforze.
+    int m_hop = 1; //!< Liczba nowych próbek między kolejnymi widmami.
+    int m_samplesSinceSpectrum = 0; //!< Próbki od ostatniego widma.
+    QVector<float> m_drainSamples; //!< Próbki przejęte z bufora oczekujących (pojemność zachowywana).
+    QVector<qint64> m_drainTimesNs; //!< Czasy przejętych próbek.
+    QVector<float> m_re; //!< Części rzeczywiste transformaty.
+    QVector<float> m_im; //!< Części urojone transformaty.
+};
+
+#endif // SPECTRUMANALYZER_H
@@ -0,0 +1,269 @@
+/**
+ * @file SpectrumView.cpp
+ * @brief Implementacja klasy SpectrumView.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-15
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include "SpectrumView.h"
+#include "SpectrumAnalyzer.h"
+#include <QColor>
+#include <QComboBox>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QPainter>
+#include <QPolygonF>
+#include <QSettings>
+#include <QVBoxLayout>
+#include <iterator>
+
+constexpr int SPECTROGRAM_COLUMNS_SV = 240; // Liczba widm widocznych na spektrogramie
+constexpr float MIN_LEVEL_DB_SV = -40.0f; // Dół skali widma i palety spektrogramu
+constexpr float MAX_LEVEL_DB_SV = 60.0f; // Góra skali (1000 jednostek kanału)
+constexpr float LEVEL_GRID_STEP_DB_SV = 20.0f;
+constexpr int FREQUENCY_TICKS_SV = 5; // Podziałka osi częstotliwości: 0, fs/8, ..., fs/2
+constexpr int PLOT_MARGIN_SV = 6;
+constexpr int AXIS_LABEL_WIDTH_SV = 44;
+constexpr int AXIS_LABEL_HEIGHT_SV = 16;
+constexpr int PALETTE_SIZE_SV = 256;
+const char *const CHANNEL_SETTINGS_KEY_SV = "spectrum/channel";
+const char *const FFT_SIZE_SETTINGS_KEY_SV = "spectrum/fftSize";
+const char *const OVERLAP_SETTINGS_KEY_SV = "spectrum/overlapPercent";
+const int FFT_SIZES_SV[] = {256, 512, 1024, 2048};
+const int OVERLAP_PERCENTS_SV[] = {0, 50, 75};
+
+SpectrumView::SpectrumView(QWidget *parent)
+    : QWidget(parent),
+      m_analyzer(new SpectrumAnalyzer(this)),
+      m_controls(new QWidget(this)),
+      m_channelLabel(new QLabel(m_controls)),
+      m_fftSizeLabel(new QLabel(m_controls)),
+      m_overlapLabel(new QLabel(m_controls)),
+      m_channelCombo(new QComboBox(m_controls)),
+      m_fftSizeCombo(new QComboBox(m_controls)),
+      m_overlapCombo(new QComboBox(m_controls)) {
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+
+    // Paleta: czarny -> niebieski -> turkusowy -> żółty -> czerwony
+    const QColor stops[] = {QColor(0, 0, 0), QColor(20, 40, 160), QColor(0, 190, 200), QColor(250, 230, 40),
+                            QColor(220, 20, 20)};
+    constexpr int segments = static_cast<int>(std::size(stops)) - 1;
+    m_palette.resize(PALETTE_SIZE_SV);
+    for (int i = 0; i < PALETTE_SIZE_SV; ++i) {
+        const float position = static_cast<float>(i) * segments / (PALETTE_SIZE_SV - 1);
+        const int segment = qMin(static_cast<int>(position), segments - 1);
+        const float t = position - segment;
+        const QColor &from = stops[segment];
+        const QColor &to = stops[segment + 1];
+        m_palette[i] = qRgb(qRound(from.red() + (to.red() - from.red()) * t),
+                            qRound(from.green() + (to.green() - from.green()) * t),
+                            qRound(from.blue() + (to.blue() - from.blue()) * t));
+    }
+
+    fillChannelCombo();
+    for (int size: FFT_SIZES_SV) {
+        m_fftSizeCombo->addItem(QString::number(size), size);
+    }
+    for (int percent: OVERLAP_PERCENTS_SV) {
+        m_overlapCombo->addItem(QStringLiteral("%1%").arg(percent), percent);
+    }
+    const QSettings settings;
+    const auto selectData = [](QComboBox *combo, const QVariant &value) {
+        const int index = combo->findData(value);
+        if (index >= 0) {
+            combo->setCurrentIndex(index);
+        }
+    };
+    selectData(m_channelCombo, settings.value(CHANNEL_SETTINGS_KEY_SV, 3));
+    selectData(m_fftSizeCombo, settings.value(FFT_SIZE_SETTINGS_KEY_SV, SpectrumAnalyzer::DEFAULT_FFT_SIZE));
+    selectData(m_overlapCombo, settings.value(OVERLAP_SETTINGS_KEY_SV, SpectrumAnalyzer::DEFAULT_OVERLAP_PERCENT));
+
+    auto *controlsLayout = new QHBoxLayout(m_controls);
+    controlsLayout->setContentsMargins(0, 0, 0, 0);
+    controlsLayout->addWidget(m_channelLabel);
+    controlsLayout->addWidget(m_channelCombo);
+    controlsLayout->addSpacing(PLOT_MARGIN_SV * 2);
+    controlsLayout->addWidget(m_fftSizeLabel);
+    controlsLayout->addWidget(m_fftSizeCombo);
+    controlsLayout->addSpacing(PLOT_MARGIN_SV * 2);
+    controlsLayout->addWidget(m_overlapLabel);
+    controlsLayout->addWidget(m_overlapCombo);
+    controlsLayout->addStretch();
+
+    // Wykresy rysowane w paintEvent() pod wierszem kontrolek
+    auto *mainLayout = new QVBoxLayout(this);
+    mainLayout->setContentsMargins(PLOT_MARGIN_SV, PLOT_MARGIN_SV, PLOT_MARGIN_SV, PLOT_MARGIN_SV);
+    mainLayout->addWidget(m_controls);
+    mainLayout->addStretch();
+    retranslateUi();
+
+    connect(m_analyzer, &SpectrumAnalyzer::spectrumReady, this, &SpectrumView::handleSpectrum);
+    applySettings();
+    connect(m_channelCombo, &QComboBox::currentIndexChanged, this, &SpectrumView::applySettings);
+    connect(m_fftSizeCombo, &QComboBox::currentIndexChanged, this, &SpectrumView::applySettings);
+    connect(m_overlapCombo, &QComboBox::currentIndexChanged, this, &SpectrumView::applySettings);
+}
+
+void SpectrumView::addFrames(const float *const *frames, const qint64 *timestampsNs, int count) {
+    m_analyzer->addFrames(frames, timestampsNs, count);
+}
+
+void SpectrumView::reset() {
+    m_analyzer->reset();
+}
+
+void SpectrumView::fillChannelCombo() {
+    const QVariant selected = m_channelCombo->currentData();
+    const QSignalBlocker blocker(m_channelCombo);
+    m_channelCombo->clear();
+    m_channelCombo->addItem(tr("Gyroscope X"), 0);
+    m_channelCombo->addItem(tr("Gyroscope Y"), 1);
+    m_channelCombo->addItem(tr("Gyroscope Z"), 2);
+    m_channelCombo->addItem(tr("Accelerometer X"), 3);
+    m_channelCombo->addItem(tr("Accelerometer Y"), 4);
+    m_channelCombo->addItem(tr("Accelerometer Z"), 5);
+    const int index = m_channelCombo->findData(selected);
+    m_channelCombo->setCurrentIndex(index >= 0 ? index : 0);
+}
+
+void SpectrumView::retranslateUi() {
+    m_channelLabel->setText(tr("Channel:"));
+    m_fftSizeLabel->setText(tr("FFT size:"));
+    m_overlapLabel->setText(tr("Overlap:"));
+    fillChannelCombo();
+    update();
+}
+
+QSize SpectrumView::sizeHint() const {
+    return QSize(480, 480);
+}
+
+void SpectrumView::applySettings() {
+    const int channel = m_channelCombo->currentData().toInt();
+    const int fftSize = m_fftSizeCombo->currentData().toInt();
+    const int overlapPercent = m_overlapCombo->currentData().toInt();
+    m_analyzer->configure(channel, fftSize, overlapPercent);
+
+    QSettings settings;
+    settings.setValue(CHANNEL_SETTINGS_KEY_SV, channel);
+    settings.setValue(FFT_SIZE_SETTINGS_KEY_SV, fftSize);
+    settings.setValue(OVERLAP_SETTINGS_KEY_SV, overlapPercent);
+
+    m_spectrumDb.clear();
+    resetSpectrogram(fftSize / 2 + 1);
+    update();
+}
+
+void SpectrumView::resetSpectrogram(int bins) {
+    m_spectrogram = QImage(SPECTROGRAM_COLUMNS_SV, bins, QImage::Format_RGB32);
+    m_spectrogram.fill(m_palette.first());
+    m_nextColumn = 0;
+}
+
+void SpectrumView::handleSpectrum(const QVector<float> &magnitudesDb, float sampleRateHz) {
+    const int bins = static_cast<int>(magnitudesDb.size());
+    if (bins != m_spectrogram.height()) {
+        resetSpectrogram(bins); // Widmo policzone jeszcze przed zmianą długości okna
+    }
+    m_spectrumDb = magnitudesDb;
+    m_sampleRateHz = sampleRateHz;
+
+    // Jedna nowa kolumna - reszta obrazu bez zmian
+    for (int k = 0; k < bins; ++k) {
+        const float level = (magnitudesDb[k] - MIN_LEVEL_DB_SV) / (MAX_LEVEL_DB_SV - MIN_LEVEL_DB_SV);
+        const int colorIndex = qBound(0, static_cast<int>(level * (PALETTE_SIZE_SV - 1)), PALETTE_SIZE_SV - 1);
+        reinterpret_cast<QRgb *>(m_spectrogram.scanLine(bins - 1 - k))[m_nextColumn] = m_palette[colorIndex];
+    }
+    m_nextColumn = (m_nextColumn + 1) % SPECTROGRAM_COLUMNS_SV;
+    update();
+}
+
+void SpectrumView::paintEvent(QPaintEvent *event) {
+    Q_UNUSED(event);
+    QPainter painter(this);
+    const QRect area = rect().adjusted(PLOT_MARGIN_SV, m_controls->geometry().bottom() + PLOT_MARGIN_SV,
+                                       -PLOT_MARGIN_SV, -PLOT_MARGIN_SV);
+    if (area.height() < 4 * AXIS_LABEL_HEIGHT_SV || area.width() < 2 * AXIS_LABEL_WIDTH_SV) {
+        return;
+    }
+    const int plotLeft = area.left() + AXIS_LABEL_WIDTH_SV;
+    const int plotWidth = area.right() - plotLeft;
+    const int spectrumHeight = (area.height() - 2 * AXIS_LABEL_HEIGHT_SV) * 2 / 5;
+    const QRect spectrumRect(plotLeft, area.top(), plotWidth, spectrumHeight);
+    const QRect spectrogramRect(plotLeft, spectrumRect.bottom() + AXIS_LABEL_HEIGHT_SV + PLOT_MARGIN_SV, plotWidth,
+                                area.bottom() - AXIS_LABEL_HEIGHT_SV - spectrumRect.bottom() - AXIS_LABEL_HEIGHT_SV
+                                - PLOT_MARGIN_SV);
+    const QColor textColor = palette().color(QPalette::WindowText);
+    const float nyquistHz = m_sampleRateHz / 2.0f;
+
+    // Widmo: siatka poziomów co LEVEL_GRID_STEP_DB_SV i przebieg
+    painter.fillRect(spectrumRect, QColor(30, 30, 30));
+    painter.setPen(textColor);
+    for (float level = MIN_LEVEL_DB_SV; level <= MAX_LEVEL_DB_SV; level += LEVEL_GRID_STEP_DB_SV) {
+        const int y = spectrumRect.bottom()
+                      - qRound((level - MIN_LEVEL_DB_SV) / (MAX_LEVEL_DB_SV - MIN_LEVEL_DB_SV) * spectrumRect.height());
+        painter.setPen(QColor(70, 70, 70));
+        painter.drawLine(spectrumRect.left(), y, spectrumRect.right(), y);
+        painter.setPen(textColor);
+        painter.drawText(QRect(area.left(), y - AXIS_LABEL_HEIGHT_SV / 2, AXIS_LABEL_WIDTH_SV - 4, AXIS_LABEL_HEIGHT_SV),
+                         Qt::AlignRight | Qt::AlignVCenter, QStringLiteral("%1 dB").arg(level, 0, 'f', 0));
+    }
+    if (m_spectrumDb.size() > 1) {
+        QPolygonF trace;
+        trace.reserve(m_spectrumDb.size());
+        const double xScale = static_cast<double>(spectrumRect.width()) / (m_spectrumDb.size() - 1);
+        for (int k = 0; k < m_spectrumDb.size(); ++k) {
+            const float level = qBound(MIN_LEVEL_DB_SV, m_spectrumDb[k], MAX_LEVEL_DB_SV);
+            trace.append(QPointF(spectrumRect.left() + k * xScale,
+                                 spectrumRect.bottom() - (level - MIN_LEVEL_DB_SV)
+                                                             / (MAX_LEVEL_DB_SV - MIN_LEVEL_DB_SV)
+                                                             * spectrumRect.height()));
+        }
+        painter.setPen(QPen(QColor(80, 200, 255), 1.0));
+        painter.drawPolyline(trace);
+    } else {
+        painter.drawText(spectrumRect, Qt::AlignCenter, tr("Collecting samples..."));
+    }
+
+    // Oś częstotliwości pod widmem
+    painter.setPen(textColor);
+    for (int tick = 0; tick < FREQUENCY_TICKS_SV; ++tick) {
+        const int x = spectrumRect.left() + spectrumRect.width() * tick / (FREQUENCY_TICKS_SV - 1);
+        const QString label = m_sampleRateHz > 0.0f
+                                  ? QStringLiteral("%1 Hz").arg(nyquistHz * tick / (FREQUENCY_TICKS_SV - 1), 0, 'f', 1)
+                                  : QString();
+        const Qt::Alignment alignment = tick == 0 ? Qt::AlignLeft
+                                        : tick == FREQUENCY_TICKS_SV - 1 ? Qt::AlignRight
+                                        : Qt::AlignHCenter;
+        const int labelLeft = tick == 0 ? x : tick == FREQUENCY_TICKS_SV - 1 ? x - AXIS_LABEL_WIDTH_SV * 2
+                                                                              : x - AXIS_LABEL_WIDTH_SV;
+        painter.drawText(QRect(labelLeft, spectrumRect.bottom() + 1, AXIS_LABEL_WIDTH_SV * 2, AXIS_LABEL_HEIGHT_SV),
+                         alignment | Qt::AlignTop, label);
+    }
+
+    // Spektrogram: najstarsze kolumny (od m_nextColumn) po lewej, najnowsza przy prawej krawędzi
+    if (spectrogramRect.height() > 0 && !m_spectrogram.isNull()) {
+        const int columns = m_spectrogram.width();
+        const int bins = m_spectrogram.height();
+        const double olderWidth = static_cast<double>(spectrogramRect.width()) * (columns - m_nextColumn) / columns;
+        painter.drawImage(QRectF(spectrogramRect.left(), spectrogramRect.top(), olderWidth, spectrogramRect.height()),
+                          m_spectrogram, QRectF(m_nextColumn, 0, columns - m_nextColumn, bins));
+        if (m_nextColumn > 0) {
+            painter.drawImage(QRectF(spectrogramRect.left() + olderWidth, spectrogramRect.top(),
+                                     spectrogramRect.width() - olderWidth, spectrogramRect.height()),
+                              m_spectrogram, QRectF(0, 0, m_nextColumn, bins));
+        }
+        if (m_sampleRateHz > 0.0f) {
+            painter.drawText(QRect(area.left(), spectrogramRect.top(), AXIS_LABEL_WIDTH_SV - 4, AXIS_LABEL_HEIGHT_SV),
+                             Qt::AlignRight | Qt::AlignTop, QStringLiteral("%1 Hz").arg(nyquistHz, 0, 'f', 0));
+            painter.drawText(QRect(area.left(), spectrogramRect.bottom() - AXIS_LABEL_HEIGHT_SV,
+                                   AXIS_LABEL_WIDTH_SV - 4, AXIS_LABEL_HEIGHT_SV),
+                             Qt::AlignRight | Qt::AlignBottom, QStringLiteral("%1 Hz").arg(0));
+        }
+        painter.drawText(QRect(spectrogramRect.left(), spectrogramRect.bottom() + 1, spectrogramRect.width(),
+                               AXIS_LABEL_HEIGHT_SV),
+                         Qt::AlignRight | Qt::AlignTop, tr("Time →"));
+    }
+}
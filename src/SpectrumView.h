@@ -0,0 +1,99 @@
+#ifndef SPECTRUMVIEW_H
+#define SPECTRUMVIEW_H
+
+/**
+ * @file SpectrumView.h
+ * @brief Definicja klasy SpectrumView - widmo i spektrogram wybranego kanału IMU.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-15
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include <QImage>
+#include <QVector>
+#include <QWidget>
+
+class QComboBox;
+class QLabel;
+class SpectrumAnalyzer;
+
+/**
+ * @class SpectrumView
+ * @brief Widget z bieżącym widmem amplitudowym (wykres liniowy) i spektrogramem (mapa czas-częstotliwość).
+ *
+ * @details
+ * Nad wykresami znajdują się listy wyboru kanału, długości okna FFT i nakładania okien; wybór jest
+ * zapamiętywany w QSettings. Obliczenia wykonuje `SpectrumAnalyzer` w osobnym wątku - widget tylko
+ * przekazuje ramki i rysuje wyniki. Spektrogram jest obrazem o stałej liczbie kolumn używanym jak
+ * bufor kołowy: każde nowe widmo zapisuje jedną kolumnę, a rysowanie składa obraz z dwóch części
+ * tak, aby najnowsza kolumna była po prawej stronie. Nie ma więc przesuwania całego obrazu.
+ */
+class SpectrumView : public QWidget {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Konstruktor - tworzy kontrolki i analizator z zapamiętanymi ustawieniami.
+     * @param parent [in] Widget nadrzędny.
+     */
+    explicit SpectrumView(QWidget *parent = nullptr);
+
+    /**
+     * @brief Przekazuje paczkę ramek IMU do analizy.
+     * @param frames [in] Ramki IMU (wartości w kolejności ramki danych).
+     * @param timestampsNs [in] Czasy ramek [ns].
+     * @param count [in] Liczba ramek.
+     */
+    void addFrames(const float *const *frames, const qint64 *timestampsNs, int count);
+
+    /** @brief Zeruje bufor analizatora (luka w danych, zmiana źródła). Spektrogram pozostaje. */
+    void reset();
+
+    /** @brief Aktualizuje teksty po zmianie języka. */
+    void retranslateUi();
+
+    /** @brief Zwraca preferowany rozmiar widgetu. */
+    QSize sizeHint() const override;
+
+protected:
+    /**
+     * @brief Rysuje widmo (górna część) i spektrogram (dolna część) pod kontrolkami.
+     * @param event [in] Zdarzenie rysowania (nieużywane).
+     */
+    void paintEvent(QPaintEvent *event) override;
+
+private slots:
+    /** @brief Przekazuje wybór z list do analizatora, zapisuje go i czyści spektrogram. */
+    void applySettings();
+
+    /**
+     * @brief Zapamiętuje nowe widmo i dopisuje kolumnę spektrogramu.
+     * @param magnitudesDb [in] Amplitudy prążków [dB].
+     * @param sampleRateHz [in] Częstotliwość próbkowania [Hz].
+     */
+    void handleSpectrum(const QVector<float> &magnitudesDb, float sampleRateHz);
+
+private:
+    /** @brief Wypełnia listę kanałów przetłumaczonymi nazwami (zachowuje wybór). */
+    void fillChannelCombo();
+
+    /** @brief Tworzy pusty spektrogram dla bieżącej liczby prążków. @param bins [in] Liczba prążków. */
+    void resetSpectrogram(int bins);
+
+    SpectrumAnalyzer *m_analyzer; //!< Obliczenia widma w osobnym wątku.
+    QWidget *m_controls; //!< Wiersz kontrolek nad wykresami.
+    QLabel *m_channelLabel; //!< Etykieta listy kanałów.
+    QLabel *m_fftSizeLabel; //!< Etykieta listy długości okna.
+    QLabel *m_overlapLabel; //!< Etykieta listy nakładania okien.
+    QComboBox *m_channelCombo; //!< Kanał (indeks w ramce jako dane elementu).
+    QComboBox *m_fftSizeCombo; //!< Długość okna FFT.
+    QComboBox *m_overlapCombo; //!< Nakładanie okien [%].
+    QVector<float> m_spectrumDb; //!< Ostatnie widmo [dB].
+    float m_sampleRateHz = 0.0f; //!< Częstotliwość próbkowania ostatniego widma [Hz].
+    QImage m_spectrogram; //!< Spektrogram: kolumna na widmo, wiersz na prążek (niskie częstotliwości na dole).
+    int m_nextColumn = 0; //!< Kolumna spektrogramu do zapisania następnym widmem.
+    QVector<QRgb> m_palette; //!< Paleta kolorów spektrogramu (od najniższego do najwyższego poziomu).
+};
+
+#endif // SPECTRUMVIEW_H
@@ -0,0 +1,113 @@
+/**
+ * @file StatisticsView.cpp
+ * @brief Implementacja klasy StatisticsView.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-16
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include "StatisticsView.h"
+#include <QDoubleSpinBox>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QSettings>
+#include <QTableWidget>
+#include <QTimer>
+#include <QVBoxLayout>
+
+constexpr int REFRESH_INTERVAL_MS_STV = 200;
+constexpr int COLUMN_COUNT_STV = 5; // Średnia, odchylenie, min, max, RMS
+constexpr double DEFAULT_WINDOW_SECONDS_STV = RollingStatistics::DEFAULT_WINDOW_NS / 1.0e9;
+constexpr double MIN_WINDOW_SECONDS_STV = 0.1;
+constexpr double MAX_WINDOW_SECONDS_STV = 120.0; // Okno 120 s przy 2 kHz to ok. 13 MB ramek
+const char *const WINDOW_SETTINGS_KEY_STV = "statistics/windowSeconds";
+
+StatisticsView::StatisticsView(QWidget *parent)
+    : QWidget(parent),
+      m_windowLabel(new QLabel(this)),
+      m_windowSpin(new QDoubleSpinBox(this)),
+      m_coverageLabel(new QLabel(this)),
+      m_table(new QTableWidget(RollingStatistics::CHANNELS, COLUMN_COUNT_STV, this)),
+      m_refreshTimer(new QTimer(this)) {
+    m_windowSpin->setRange(MIN_WINDOW_SECONDS_STV, MAX_WINDOW_SECONDS_STV);
+    m_windowSpin->setDecimals(1);
+    m_windowSpin->setSingleStep(1.0);
+    m_windowSpin->setSuffix(QStringLiteral(" s"));
+    m_windowSpin->setValue(QSettings().value(WINDOW_SETTINGS_KEY_STV, DEFAULT_WINDOW_SECONDS_STV).toDouble());
+
+    m_table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_table->setSelectionMode(QAbstractItemView::NoSelection);
+    m_table->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    m_table->verticalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    for (int row = 0; row < RollingStatistics::CHANNELS; ++row) {
+        for (int column = 0; column < COLUMN_COUNT_STV; ++column) {
+            auto *item = new QTableWidgetItem();
+            item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+            m_table->setItem(row, column, item); // Komórki tworzone raz - odświeżanie zmienia tylko tekst
+        }
+    }
+
+    auto *windowLayout = new QHBoxLayout();
+    windowLayout->addWidget(m_windowLabel);
+    windowLayout->addWidget(m_windowSpin);
+    windowLayout->addStretch();
+    windowLayout->addWidget(m_coverageLabel);
+
+    auto *mainLayout = new QVBoxLayout(this);
+    mainLayout->addLayout(windowLayout);
+    mainLayout->addWidget(m_table);
+    retranslateUi();
+
+    applyWindow();
+    connect(m_windowSpin, &QDoubleSpinBox::valueChanged, this, &StatisticsView::applyWindow);
+    connect(m_refreshTimer, &QTimer::timeout, this, &StatisticsView::refresh);
+    m_refreshTimer->start(REFRESH_INTERVAL_MS_STV);
+}
+
+void StatisticsView::addFrames(const float *const *frames, const qint64 *timestampsNs, int count) {
+    for (int i = 0; i < count; ++i) {
+        m_statistics.addFrame(frames[i], timestampsNs[i]);
+    }
+}
+
+void StatisticsView::reset() {
+    m_statistics.reset();
+    refresh();
+}
+
+void StatisticsView::applyWindow() {
+    const double seconds = m_windowSpin->value();
+    m_statistics.setWindow(static_cast<qint64>(seconds * 1.0e9));
+    QSettings().setValue(WINDOW_SETTINGS_KEY_STV, seconds);
+    refresh();
+}
+
+void StatisticsView::refresh() {
+    if (!isVisible()) {
+        return;
+    }
+    const bool empty = m_statistics.sampleCount() == 0;
+    for (int row = 0; row < RollingStatistics::CHANNELS; ++row) {
+        const RollingStatistics::Summary summary = m_statistics.summary(row);
+        const float values[COLUMN_COUNT_STV] = {summary.mean, summary.stdDev, summary.min, summary.max, summary.rms};
+        for (int column = 0; column < COLUMN_COUNT_STV; ++column) {
+            m_table->item(row, column)->setText(empty ? QStringLiteral("-") : QString::number(values[column], 'f', 2));
+        }
+    }
+    m_coverageLabel->setText(tr("%1 samples over %2 s").arg(m_statistics.sampleCount())
+                                 .arg(m_statistics.coveredNs() / 1.0e9, 0, 'f', 2));
+}
+
+void StatisticsView::retranslateUi() {
+    m_windowLabel->setText(tr("Window:"));
+    m_table->setHorizontalHeaderLabels({tr("Mean"), tr("Std. dev."), tr("Min"), tr("Max"), tr("RMS")});
+    m_table->setVerticalHeaderLabels({
+        tr("Gyroscope X [dps]"), tr("Gyroscope Y [dps]"), tr("Gyroscope Z [dps]"),
+        tr("Accelerometer X [mg]"), tr("Accelerometer Y [mg]"), tr("Accelerometer Z [mg]"),
+        tr("Magnetometer X [mG]"), tr("Magnetometer Y [mG]"), tr("Magnetometer Z [mG]"),
+        tr("Roll [°]"), tr("Pitch [°]"), tr("Yaw [°]")
+    });
+    refresh();
+}
@@ -0,0 +1,71 @@
+#ifndef STATISTICSVIEW_H
+#define STATISTICSVIEW_H
+
+/**
+ * @file StatisticsView.h
+ * @brief Definicja klasy StatisticsView - tabela statystyk kanałów IMU w przesuwnym oknie.
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-16
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include "RollingStatistics.h"
+#include <QWidget>
+
+class QDoubleSpinBox;
+class QLabel;
+class QTableWidget;
+class QTimer;
+
+/**
+ * @class StatisticsView
+ * @brief Widget z tabelą średniej, odchylenia, minimum, maksimum i RMS każdego z 12 kanałów ramki IMU.
+ *
+ * @details
+ * Statystyki liczy `RollingStatistics` dla każdej ramki (koszt stały), także gdy widok jest ukryty -
+ * po przełączeniu na niego okno jest od razu wypełnione. Tabela jest odświeżana timerem kilka razy
+ * na sekundę i tylko wtedy, gdy widok jest widoczny. Długość okna [s] jest niezależna od liczby
+ * próbek na wykresach i zapamiętywana w QSettings (`statistics/windowSeconds`).
+ */
+class StatisticsView : public QWidget {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Konstruktor - tworzy tabelę i pole długości okna z zapamiętaną wartością.
+     * @param parent [in] Widget nadrzędny.
+     */
+    explicit StatisticsView(QWidget *parent = nullptr);
+
+    /**
+     * @brief Dodaje paczkę ramek IMU do okna statystyk.
+     * @param frames [in] Ramki IMU (`RollingStatistics::CHANNELS` wartości w kolejności ramki danych).
+     * @param timestampsNs [in] Czasy ramek [ns].
+     * @param count [in] Liczba ramek.
+     */
+    void addFrames(const float *const *frames, const qint64 *timestampsNs, int count);
+
+    /** @brief Opróżnia okno statystyk (np. po zmianie urządzenia). */
+    void reset();
+
+    /** @brief Aktualizuje teksty po zmianie języka. */
+    void retranslateUi();
+
+private slots:
+    /** @brief Ustawia długość okna z pola i zapisuje ją w QSettings. */
+    void applyWindow();
+
+    /** @brief Przepisuje bieżące statystyki do tabeli (tylko gdy widok jest widoczny). */
+    void refresh();
+
+private:
+    RollingStatistics m_statistics; //!< Statystyki w przesuwnym oknie.
+    QLabel *m_windowLabel; //!< Etykieta pola długości okna.
+    QDoubleSpinBox *m_windowSpin; //!< Długość okna [s].
+    QLabel *m_coverageLabel; //!< Liczba ramek i czas objęty oknem.
+    QTableWidget *m_table; //!< Wiersz na kanał, kolumny: średnia, odchylenie, min, max, RMS.
+    QTimer *m_refreshTimer; //!< Odświeżanie tabeli.
+};
+
+#endif // STATISTICSVIEW_H
@@ -0,0 +1,126 @@
+/**
+ * @file TrackSimplifier.cpp
+ * @brief Implementacja klasy TrackSimplifier.
+ * @author Mateusz Wojtaszek
+ * @date 2025-05-26
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include "TrackSimplifier.h"
+#include <QtMath>
+#include <cmath>
+#include <utility>
+
+constexpr double EARTH_RADIUS_M_TS = 6371000.0;
+
+TrackSimplifier::TrackSimplifier(double toleranceMeters, double minDistanceMeters, int maxWindow)
+    : m_tolerance(qMax(0.0, toleranceMeters)),
+      m_minDistance(qMax(0.0, minDistanceMeters)),
+      m_maxWindow(qMax(2, maxWindow)),
+      m_hasAnchor(false),
+      m_anchor{0.0, 0.0},
+      m_inputCount(0),
+      m_committedCount(0) {
+    m_window.reserve(m_maxWindow);
+}
+
+void TrackSimplifier::setTolerance(double toleranceMeters) {
+    m_tolerance = qMax(0.0, toleranceMeters);
+}
+
+void TrackSimplifier::setMinDistance(double minDistanceMeters) {
+    m_minDistance = qMax(0.0, minDistanceMeters);
+}
+
+bool TrackSimplifier::addPoint(double latitude, double longitude) {
+    ++m_inputCount;
+    const Point point{latitude, longitude};
+
+    if (!m_hasAnchor) {
+        commit(point);
+        return true;
+    }
+
+    // Etap 1: filtr radialny względem ostatniego przyjętego punktu
+    const Point &lastAccepted = m_window.isEmpty() ? m_anchor : m_window.constLast();
+    if (distanceMeters(point, lastAccepted) < m_minDistance) {
+        return false;
+    }
+
+    // Etap 2: czy wszystkie punkty okna leżą w tolerancji od odcinka kotwica -> nowy punkt?
+    bool toleranceExceeded = false;
+    for (const Point &windowPoint: std::as_const(m_window)) {
+        if (distanceToSegmentMeters(windowPoint, m_anchor, point) > m_tolerance) {
+            toleranceExceeded = true;
+            break;
+        }
+    }
+    if (toleranceExceeded) {
+        // Poprzedni punkt końcowy staje się wierzchołkiem i nową kotwicą
+        const Point previousTail = m_window.last();
+        m_window.clear();
+        commit(previousTail);
+    }
+
+    m_window.append(point);
+    if (m_window.size() >= m_maxWindow) {
+        const Point forcedVertex = m_window.last();
+        m_window.clear();
+        commit(forcedVertex);
+    }
+    return true;
+}
+
+QVector<TrackSimplifier::Point> TrackSimplifier::takeCommitted() {
+    QVector<Point> result;
+    result.swap(m_committed);
+    return result;
+}
+
+bool TrackSimplifier::hasTail() const {
+    return !m_window.isEmpty();
+}
+
+TrackSimplifier::Point TrackSimplifier::tail() const {
+    return m_window.isEmpty() ? m_anchor : m_window.last();
+}
+
+void TrackSimplifier::reset() {
+    m_hasAnchor = false;
+    m_window.clear();
+    m_committed.clear();
+    m_inputCount = 0;
+    m_committedCount = 0;
+}
+
+void TrackSimplifier::commit(const Point &point) {
+    m_anchor = point;
+    m_hasAnchor = true;
+    m_committed.append(point);
+    ++m_committedCount;
+}
+
+double TrackSimplifier::distanceMeters(const Point &a, const Point &b) {
+    const double cosLat = std::cos(qDegreesToRadians(a.latitude));
+    const double dx = qDegreesToRadians(b.longitude - a.longitude) * cosLat * EARTH_RADIUS_M_TS;
+    const double dy = qDegreesToRadians(b.latitude - a.latitude) * EARTH_RADIUS_M_TS;
+    return std::hypot(dx, dy);
+}
+
+double TrackSimplifier::distanceToSegmentMeters(const Point &p, const Point &a, const Point &b) {
+    // Rzut równoodległościowy z początkiem w punkcie a
+    const double metersPerDegLat = qDegreesToRadians(1.0) * EARTH_RADIUS_M_TS;
+    const double metersPerDegLon = metersPerDegLat * std::cos(qDegreesToRadians(a.latitude));
+    const double bx = (b.longitude - a.longitude) * metersPerDegLon;
+    const double by = (b.latitude - a.latitude) * metersPerDegLat;
+    const double px = (p.longitude - a.longitude) * metersPerDegLon;
+    const double py = (p.latitude - a.latitude) * metersPerDegLat;
+
+    const double segmentLengthSq = bx * bx + by * by;
+    double t = 0.0;
+    if (segmentLengthSq > 0.0) {
+        t = qBound(0.0, (px * bx + py * by) / segmentLengthSq, 1.0);
+    }
+    return std::hypot(px - t * bx, py - t * by);
+}
@@ -0,0 +1,122 @@
+#ifndef TRACKSIMPLIFIER_H
+#define TRACKSIMPLIFIER_H
+
+/**
+ * @file TrackSimplifier.h
+ * @brief Definicja klasy TrackSimplifier, upraszczającej trasę GPS w trybie strumieniowym.
+ * @author Mateusz Wojtaszek
+ * @date 2025-05-26
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include <QVector>
+
+/**
+ * @class TrackSimplifier
+ * @brief Przyrostowo upraszcza trasę GPS (filtr odległości radialnej + okno przesuwne Douglasa-Peuckera).
+ *
+ * @details
+ * Każdy nowy punkt przechodzi dwa etapy:
+ * 1. Filtr radialny - punkt bliżej niż `minDistance` metrów od ostatniego przyjętego punktu jest odrzucany
+ *    (usuwa szum GPS podczas postoju).
+ * 2. Okno otwierające (strumieniowy wariant Douglasa-Peuckera) - punkty przyjęte od ostatniego
+ *    zatwierdzonego wierzchołka (kotwicy) są sprawdzane względem odcinka kotwica -> nowy punkt.
+ *    Dopóki wszystkie mieszczą się w tolerancji `tolerance` metrów, odcinek jest przedłużany.
+ *    Gdy któryś ją przekracza, poprzedni punkt zostaje zatwierdzony jako wierzchołek i staje się nową kotwicą.
+ *
+ * Zatwierdzone wierzchołki nigdy się nie zmieniają, więc mogą być wysyłane do strony mapy przyrostowo
+ * (`takeCommitted()`). Ostatni przyjęty, niezatwierdzony punkt jest dostępny jako `tail()`.
+ * Okno jest ograniczone do `maxWindow` punktów, więc koszt pojedynczego punktu jest stały.
+ *
+ * Odległości liczone są w rzucie równoodległościowym względem kotwicy, co przy tolerancjach
+ * rzędu metrów jest wystarczająco dokładne.
+ */
+class TrackSimplifier {
+public:
+    /**
+     * @struct Point
+     * @brief Punkt trasy we współrzędnych geograficznych.
+     */
+    struct Point {
+        double latitude; //!< Szerokość geograficzna w stopniach dziesiętnych.
+        double longitude; //!< Długość geograficzna w stopniach dziesiętnych.
+    };
+
+    /**
+     * @brief Konstruktor klasy TrackSimplifier.
+     * @param toleranceMeters [in] Maksymalne odchylenie trasy uproszczonej od oryginalnej [m].
+     * @param minDistanceMeters [in] Minimalna odległość między kolejnymi przyjętymi punktami [m].
+     * @param maxWindow [in] Maksymalna liczba punktów w oknie przed wymuszonym zatwierdzeniem.
+     */
+    explicit TrackSimplifier(double toleranceMeters = 2.0, double minDistanceMeters = 1.0, int maxWindow = 256);
+
+    /**
+     * @brief Ustawia tolerancję upraszczania.
+     * @param toleranceMeters [in] Tolerancja w metrach (minimum 0).
+     */
+    void setTolerance(double toleranceMeters);
+
+    /**
+     * @brief Ustawia minimalną odległość filtra radialnego.
+     * @param minDistanceMeters [in] Odległość w metrach (minimum 0).
+     */
+    void setMinDistance(double minDistanceMeters);
+
+    /**
+     * @brief Dodaje nowy punkt trasy.
+     * @param latitude [in] Szerokość geograficzna.
+     * @param longitude [in] Długość geograficzna.
+     * @return `true`, jeśli punkt został przyjęty; `false`, jeśli odrzucił go filtr radialny.
+     */
+    bool addPoint(double latitude, double longitude);
+
+    /**
+     * @brief Zwraca i usuwa wierzchołki zatwierdzone od poprzedniego wywołania.
+     * @return Nowe wierzchołki w kolejności chronologicznej.
+     */
+    QVector<Point> takeCommitted();
+
+    /**
+     * @brief Czy istnieje przyjęty, jeszcze niezatwierdzony punkt końcowy.
+     * @return `true`, jeśli `tail()` zwraca poprawny punkt.
+     */
+    bool hasTail() const;
+
+    /**
+     * @brief Zwraca ostatni przyjęty, niezatwierdzony punkt trasy.
+     * @return Punkt końcowy trasy (niezdefiniowany, gdy `hasTail()` zwraca `false`).
+     */
+    Point tail() const;
+
+    /** @brief Usuwa całą trasę i stan okna. */
+    void reset();
+
+    /** @brief Liczba punktów przekazanych do `addPoint()`. */
+    qint64 inputCount() const { return m_inputCount; }
+
+    /** @brief Liczba zatwierdzonych wierzchołków. */
+    qint64 committedCount() const { return m_committedCount; }
+
+private:
+    /** @brief Zatwierdza punkt jako wierzchołek i nową kotwicę. */
+    void commit(const Point &point);
+
+    /** @brief Odległość punktu od odcinka [a, b] w metrach. */
+    static double distanceToSegmentMeters(const Point &p, const Point &a, const Point &b);
+
+    /** @brief Odległość między dwoma punktami w metrach. */
+    static double distanceMeters(const Point &a, const Point &b);
+
+    double m_tolerance; //!< Tolerancja upraszczania [m].
+    double m_minDistance; //!< Minimalna odległość filtra radialnego [m].
+    int m_maxWindow; //!< Maksymalny rozmiar okna.
+    bool m_hasAnchor; //!< Czy istnieje kotwica (pierwszy punkt został przyjęty).
+    Point m_anchor; //!< Ostatni zatwierdzony wierzchołek.
+    QVector<Point> m_window; //!< Punkty przyjęte od kotwicy (ostatni to `tail()`).
+    QVector<Point> m_committed; //!< Wierzchołki zatwierdzone od ostatniego `takeCommitted()`.
+    qint64 m_inputCount; //!< Licznik punktów wejściowych.
+    qint64 m_committedCount; //!< Licznik zatwierdzonych wierzchołków.
+};
+
+#endif // TRACKSIMPLIFIER_H
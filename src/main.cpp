@@ -15,6 +15,8 @@
  * - Wyświetlanie kursu za pomocą kompasu 2D.
  * - Prezentacja pozycji GPS na interaktywnej mapie OpenStreetMap.
  * - Interfejs użytkownika z możliwością przełączania widoków i internacjonalizacji (obsługa tłumaczeń).
+ * - Udostępnianie zdekodowanych ramek innym procesom przez gniazdo lokalne, także bez interfejsu (`--headless`).
+ * - Charakterystyka szumów czujników z nagrań (odchylenie Allana), także z wiersza poleceń (`--allan-deviation`).
  *
  * @section structure_sec Struktura Dokumentacji
  * Dokumentacja została podzielona na następujące główne części:
@@ -46,14 +48,192 @@
  * @brief Główny plik źródłowy aplikacji "Orienta".
  * @details Zawiera punkt wejścia aplikacji (funkcję `main`), która jest
  * odpowiedzialna za inicjalizację środowiska Qt, ustawienie nazwy aplikacji
- * oraz utworzenie i uruchomienie głównego okna.
+ * oraz utworzenie i uruchomienie głównego okna. Z opcją `--headless` aplikacja działa bez okna:
+ * otwiera wskazane źródła i publikuje ich ramki przez gniazdo lokalne (`FramePublisher`), a z `--shm`
+ * także do pamięci współdzielonej (`SharedFrameRing`). Opcja `--allan-deviation` liczy odchylenie Allana
+ * nagrania (`AllanDeviation`) i zapisuje je do CSV bez otwierania okna.
  * @author Mateusz Wojtaszek
  * @date 2025-03-19
  * @bug Brak znanych błędów.
  */
 
 #include <QApplication>
+#include <QCommandLineParser>
+#include <QTimer>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <algorithm>
+#include <csignal>
+#include <cstring>
 #include "MainWindow.h" // Dołączenie definicji klasy głównego okna
+#include "GpsDataHandler.h"
+#ifdef ORIENTA_WEBENGINE_MAP
+#include "MapTileSchemeHandler.h"
+#endif
+#include "DeviceManager.h"
+#include "AllanDeviation.h"
+
+constexpr int HEADLESS_REPORT_INTERVAL_MS_MAIN = 5000; // Okres raportu liczników w trybie bez okna
+constexpr int SIGNAL_POLL_INTERVAL_MS_MAIN = 200;
+constexpr int ALLAN_REPORT_STEP_PERMILLE_MAIN = 100; // Raport postępu analizy co 10 %
+
+static volatile std::sig_atomic_t stopRequested = 0;
+
+static void handleStopSignal(int) {
+    stopRequested = 1;
+}
+
+/**
+ * @brief Tryb bez okna: otwiera źródła z wiersza poleceń i publikuje ich ramki przez gniazdo lokalne.
+ * @details Pozwala udostępnić urządzenie innym narzędziom (np. rejestratorowi
+ * `wds_Orienta_frame_sub`) na maszynie bez ekranu. Działa do SIGINT/SIGTERM.
+ * @param argc [in] Liczba argumentów.
+ * @param argv [in] Argumenty wiersza poleceń.
+ * @return Kod wyjścia.
+ */
+static int runHeadless(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("Orienta");
+    app.setOrganizationName("Orienta");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Orienta headless frame publisher."));
+    parser.addHelpOption();
+    const QCommandLineOption headlessOption(QStringLiteral("headless"), QStringLiteral("Run without a window."));
+    const QCommandLineOption serialOption(QStringLiteral("serial"),
+                                          QStringLiteral("Serial port to open (may be repeated)."),
+                                          QStringLiteral("port"));
+    const QCommandLineOption baudOption(QStringLiteral("baud"), QStringLiteral("Serial baud rate."),
+                                        QStringLiteral("rate"), QStringLiteral("115200"));
+    const QCommandLineOption networkOption(QStringLiteral("network"),
+                                           QStringLiteral("Network source udp://[address]:port or tcp://host:port "
+                                               "(may be repeated)."),
+                                           QStringLiteral("address"));
+    const QCommandLineOption publishOption(QStringLiteral("publish"), QStringLiteral("Local socket server name."),
+                                           QStringLiteral("name"),
+                                           QString::fromLatin1(FramePublisher::DEFAULT_SERVER_NAME));
+    const QCommandLineOption sharedMemoryOption(QStringLiteral("shm"),
+                                                QStringLiteral("Also export frames to a POSIX shared memory ring."),
+                                                QStringLiteral("name"),
+                                                QString::fromLatin1(SharedFrameRing::DEFAULT_NAME));
+    parser.addOptions({headlessOption, serialOption, baudOption, networkOption, publishOption, sharedMemoryOption});
+    parser.process(app);
+
+    DeviceManager deviceManager;
+    QString errorString;
+    if (!deviceManager.startPublishing(parser.value(publishOption), &errorString)) {
+        qCritical() << "Cannot publish frames:" << errorString;
+        return 1;
+    }
+    if (parser.isSet(sharedMemoryOption) &&
+        !deviceManager.startSharedMemoryExport(parser.value(sharedMemoryOption), SharedFrameRing::DEFAULT_CAPACITY,
+                                               &errorString)) {
+        qCritical() << "Cannot export frames to shared memory:" << errorString;
+        return 1;
+    }
+    const qint32 baudRate = parser.value(baudOption).toInt();
+    for (const QString &portName: parser.values(serialOption)) {
+        if (deviceManager.addSerialDevice(portName, baudRate, &errorString) < 0) {
+            qWarning() << "Failed to open serial port" << portName << "-" << errorString;
+        }
+    }
+    for (const QString &address: parser.values(networkOption)) {
+        if (deviceManager.addNetworkDevice(address, &errorString) < 0) {
+            qWarning() << "Failed to open network source" << address << "-" << errorString;
+        }
+    }
+    if (!deviceManager.hasDevices()) {
+        qCritical() << "No source could be opened - use --serial and/or --network.";
+        return 1;
+    }
+    QObject::connect(&deviceManager, &DeviceManager::deviceError, [&deviceManager](int deviceId, const QString &error) {
+        qWarning().noquote() << deviceManager.deviceName(deviceId) << "error:" << error;
+    });
+
+    QTimer reportTimer;
+    QObject::connect(&reportTimer, &QTimer::timeout, [&deviceManager] {
+        const FramePublisher::Stats stats = deviceManager.publisherStats();
+        qInfo().noquote() << QStringLiteral("published %1 frames, %2 client(s), %3 dropped for slow clients, %4 disconnected")
+                .arg(stats.framesPublished).arg(stats.clients).arg(stats.framesDropped).arg(stats.clientsDisconnected);
+        if (deviceManager.isExportingSharedMemory()) {
+            qInfo().noquote() << QStringLiteral("shared memory %1: %2 frames written")
+                    .arg(deviceManager.sharedMemoryName()).arg(deviceManager.sharedMemoryFramesWritten());
+        }
+    });
+    reportTimer.start(HEADLESS_REPORT_INTERVAL_MS_MAIN);
+
+    std::signal(SIGINT, handleStopSignal);
+    std::signal(SIGTERM, handleStopSignal);
+    QTimer signalTimer; // Obsługa sygnałów poza kontekstem procedury sygnału
+    QObject::connect(&signalTimer, &QTimer::timeout, &app, [] {
+        if (stopRequested) {
+            QCoreApplication::quit();
+        }
+    });
+    signalTimer.start(SIGNAL_POLL_INTERVAL_MS_MAIN);
+
+    qInfo().noquote() << "Publishing" << deviceManager.deviceIds().size() << "source(s) on"
+                      << deviceManager.publisherName() << "- Ctrl+C to stop.";
+    return QCoreApplication::exec();
+}
+
+/**
+ * @brief Tryb bez okna: liczy odchylenie Allana nagrania i zapisuje charakterystykę do CSV.
+ * @details Analiza wielogodzinnych nagrań na serwerze, bez ekranu (`AllanDeviation::analyzeFile()`).
+ * @param argc [in] Liczba argumentów.
+ * @param argv [in] Argumenty wiersza poleceń.
+ * @return Kod wyjścia.
+ */
+static int runAllanDeviation(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("Orienta");
+    app.setOrganizationName("Orienta");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Orienta Allan deviation analysis of a recording."));
+    parser.addHelpOption();
+    const QCommandLineOption recordingOption(QStringLiteral("allan-deviation"),
+                                             QStringLiteral("Recording (simulation_data*.log) to analyze."),
+                                             QStringLiteral("recording"));
+    const QCommandLineOption outputOption(QStringLiteral("output"),
+                                          QStringLiteral("Output CSV file (default: <recording>_adev.csv)."),
+                                          QStringLiteral("csv"));
+    const QCommandLineOption threadsOption(QStringLiteral("threads"),
+                                           QStringLiteral("Worker threads (default: all cores)."),
+                                           QStringLiteral("count"), QStringLiteral("0"));
+    parser.addOptions({recordingOption, outputOption, threadsOption});
+    parser.process(app);
+
+    const QString recordingPath = parser.value(recordingOption);
+    const QFileInfo recordingInfo(recordingPath);
+    const QString outputPath = parser.isSet(outputOption)
+                                   ? parser.value(outputOption)
+                                   : recordingInfo.dir().filePath(recordingInfo.completeBaseName() +
+                                                                  QStringLiteral("_adev.csv"));
+
+    int nextReport = ALLAN_REPORT_STEP_PERMILLE_MAIN;
+    AllanDeviation::Result result;
+    QString errorString;
+    const bool succeeded = AllanDeviation::analyzeFile(recordingPath, result, &errorString, [&nextReport](int permille) {
+        if (permille >= nextReport) {
+            qInfo().noquote() << QStringLiteral("analyzed %1 %").arg(permille / 10);
+            nextReport = (permille / ALLAN_REPORT_STEP_PERMILLE_MAIN + 1) * ALLAN_REPORT_STEP_PERMILLE_MAIN;
+        }
+        return true;
+    }, parser.value(threadsOption).toInt());
+    if (!succeeded) {
+        qCritical() << "Allan deviation analysis failed:" << errorString;
+        return 1;
+    }
+    if (!AllanDeviation::writeCsv(result, outputPath, &errorString)) {
+        qCritical() << "Cannot write" << outputPath << "-" << errorString;
+        return 1;
+    }
+    qInfo().noquote() << QStringLiteral("%1 frames, tau0 %2 s, %3 points written to %4")
+            .arg(result.frameCount).arg(result.samplePeriodS).arg(result.points.size()).arg(outputPath);
+    return 0;
+}
 
 /**
  * @brief Główna funkcja aplikacji "Orienta" (punkt wejścia).
@@ -83,6 +263,21 @@
  * @see QApplication
  */
 int main(int argc, char *argv[]) {
+    // Tryb bez okna rozpoznawany przed utworzeniem QApplication (nie wymaga ekranu ani WebEngine)
+    if (std::any_of(argv + 1, argv + argc, [](const char *argument) { return std::strcmp(argument, "--headless") == 0; })) {
+        return runHeadless(argc, argv);
+    }
+    if (std::any_of(argv + 1, argv + argc, [](const char *argument) {
+        return std::strcmp(argument, "--allan-deviation") == 0;
+    })) {
+        return runAllanDeviation(argc, argv);
+    }
+
+#ifdef ORIENTA_WEBENGINE_MAP
+    // Schematy URL dla QWebEngine muszą być zarejestrowane przed utworzeniem QApplication.
+    MapTileSchemeHandler::registerUrlScheme();
+#endif
+
     // Inicjalizacja obiektu aplikacji Qt, przekazanie argumentów wiersza poleceń.
     // Obiekt `app` musi istnieć przez cały czas działania aplikacji.
     QApplication app(argc, argv);
@@ -90,9 +285,30 @@ int main(int argc, char *argv[]) {
     // Ustawienie nazwy aplikacji. Może być używane przez Qt wewnętrznie
     // oraz przez system operacyjny (np. do identyfikacji procesu).
     app.setApplicationName("Orienta");
-    // Opcjonalnie można też ustawić wersję aplikacji i nazwę organizacji:
+    // Nazwa organizacji wyznacza lokalizację QSettings (m.in. ustawienia mapy offline).
+    app.setOrganizationName("Orienta");
+    // Opcjonalnie można też ustawić wersję aplikacji:
     // app.setApplicationVersion("1.0.0");
-    // app.setOrganizationName("Wydział Fotoniki Elektroniki i Mikrosystemów W12N");
+
+    // Opcje wiersza poleceń
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    const QCommandLineOption mapBackendOption(
+        QStringLiteral("map-backend"),
+        QStringLiteral("Map backend: webengine (Leaflet) or native (low memory)."),
+        QStringLiteral("backend"));
+    parser.addOption(mapBackendOption);
+    parser.process(app);
+    if (parser.isSet(mapBackendOption)) {
+        bool validBackend = false;
+        const auto backend = GPSDataHandler::backendFromName(parser.value(mapBackendOption), &validBackend);
+        if (validBackend) {
+            GPSDataHandler::setBackendOverride(backend);
+        } else {
+            qWarning() << "Unknown or unavailable map backend" << parser.value(mapBackendOption)
+                       << "- using the configured one.";
+        }
+    }
 
     // Utworzenie instancji głównego okna aplikacji.
     // Główne okno jest sercem interfejsu użytkownika.
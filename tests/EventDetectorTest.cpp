@@ -0,0 +1,80 @@
+/**
+ * @file EventDetectorTest.cpp
+ * @brief Testy klasy EventDetector (QtTest).
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-18
+ * @bug Brak znanych błędów.
+ * @version 1.0.0
+ */
+
+#include "EventDetector.h"
+#include <QTest>
+#include <array>
+
+constexpr int FRAME_SIZE_EDT = 6; // Żyroskop X, Y, Z, akcelerometr X, Y, Z
+constexpr int ACC_Z_IDX_EDT = 5;
+constexpr qint64 NS_PER_MS_EDT = 1000000LL;
+
+/**
+ * @class EventDetectorTest
+ * @brief Sprawdza detektor pochodnej na paczkach ramek o prawie równych znacznikach czasu.
+ */
+class EventDetectorTest : public QObject {
+    Q_OBJECT
+
+private:
+    /**
+     * @brief Przetwarza ramki spoczynku (1 g na osi Z) z podanymi odchyleniami osi Z.
+     * @param detector [in,out] Detektor.
+     * @param accZDeltasMg [in] Odchylenia od 1 g kolejnych ramek [mg].
+     * @param timestampsNs [in] Czasy ramek [ns].
+     * @return Liczba zdarzeń zakończonych w paczce.
+     */
+    static int processAccZ(EventDetector &detector, const QVector<float> &accZDeltasMg,
+                           const QVector<qint64> &timestampsNs) {
+        QVector<std::array<float, FRAME_SIZE_EDT>> frames(accZDeltasMg.size());
+        QVector<const float *> framePointers;
+        for (int i = 0; i < frames.size(); ++i) {
+            frames[i].fill(0.0f);
+            frames[i][ACC_Z_IDX_EDT] = 1000.0f + accZDeltasMg[i];
+            framePointers.append(frames[i].data());
+        }
+        return detector.process(framePointers.constData(), timestampsNs.constData(),
+                                static_cast<int>(framePointers.size()));
+    }
+
+private slots:
+    /** @brief Paczka ramek odebranych co 1 µs z szumem kilku mg nie może wyglądać jak szarpnięcie. */
+    void burstOfNearIdenticalTimestamps() {
+        EventDetector detector;
+        QVector<float> deltas;
+        QVector<qint64> timestamps;
+        qint64 timestampNs = 10 * NS_PER_MS_EDT;
+        for (int burst = 0; burst < 50; ++burst) {
+            for (int i = 0; i < 10; ++i) {
+                deltas.append(i % 2 == 0 ? 8.0f : -8.0f);
+                timestamps.append(timestampNs + i * 1000);
+            }
+            timestampNs += 10 * NS_PER_MS_EDT; // Paczka co 10 ms
+        }
+        QCOMPARE(processAccZ(detector, deltas, timestamps), 0);
+        QVERIFY(!detector.isActive(EventDetector::Kind::Derivative));
+    }
+
+    /** @brief Skok o 2 g w ciągu 5 ms (400 g/s) jest wykrywany przy ramkach co 1 ms. */
+    void stepAtRegularRate() {
+        EventDetector detector;
+        QVector<float> deltas;
+        QVector<qint64> timestamps;
+        for (int i = 0; i < 100; ++i) {
+            deltas.append(i < 50 ? 0.0f : qMin(2000.0f, (i - 49) * 400.0f));
+            timestamps.append(i * NS_PER_MS_EDT);
+        }
+        processAccZ(detector, deltas, timestamps);
+        QVERIFY(detector.isActive(EventDetector::Kind::Derivative) || !detector.events().isEmpty());
+    }
+};
+
+QTEST_APPLESS_MAIN(EventDetectorTest)
+
+#include "EventDetectorTest.moc"
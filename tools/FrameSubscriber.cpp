@@ -0,0 +1,204 @@
+/**
+ * @file FrameSubscriber.cpp
+ * @brief Klient strumienia ramek publikowanych przez aplikację (target `wds_Orienta_frame_sub`).
+ * @details Łączy się z serwerem `FramePublisher` (gniazdo lokalne), dekoduje rekordy `FrameWireFormat`
+ * i co sekundę wypisuje statystyki na stderr. Z opcją `--output` zapisuje ramki w formacie
+ * nagrań (`FrameRecorder`), który tryb symulacji odtwarza w rzeczywistym tempie - działa więc jako
+ * rejestrator równoległy do GUI, bez ponownego otwierania portu szeregowego.
+ *
+ * Opcja `--slow-ms` celowo spowalnia odbiór, aby sprawdzić politykę wolnego klienta
+ * (rekordy `Overflow`, rozłączenie po `FramePublisher::SLOW_CLIENT_TIMEOUT_MS`).
+ *
+ * Przykład:
+ * @code
+ * wds_Orienta --headless --serial /tmp/ttyORIENTA &
+ * wds_Orienta_frame_sub --device 1 --output recording.log
+ * @endcode
+ * @author Mateusz Wojtaszek
+ * @date 2025-06-06
+ * @bug Brak znanych błędów.
+ */
+
+#include "FrameWireFormat.h"
+#include "FrameRecorder.h"
+#include "FramePublisher.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QLocalSocket>
+#include <QTextStream>
+#include <QThread>
+#include <QDebug>
+
+#include <chrono>
+#include <climits>
+#include <csignal>
+
+constexpr int CONNECT_TIMEOUT_MS_FS = 3000;
+constexpr int READ_TIMEOUT_MS_FS = 200;
+constexpr qint64 REPORT_INTERVAL_MS_FS = 1000;
+
+static volatile std::sig_atomic_t stopRequested = 0;
+
+static void handleStopSignal(int) {
+    stopRequested = 1;
+}
+
+/**
+ * @brief Liczniki klienta raportowane co sekundę.
+ */
+struct SubscriberStats {
+    quint64 frames = 0; //!< Odebrane ramki (wszystkich urządzeń).
+    quint64 recorded = 0; //!< Ramki zapisane do pliku.
+    quint64 dropped = 0; //!< Ramki pominięte przez serwer (rekordy `Overflow`).
+    quint64 bytes = 0; //!< Odebrane bajty.
+    qint64 lastLatencyUs = 0; //!< Opóźnienie ostatniej ramki od czasu odbioru przez hosta.
+};
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("wds_Orienta_frame_sub");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Subscribes to frames published by Orienta over a local socket."));
+    parser.addHelpOption();
+    const QCommandLineOption serverOption(QStringLiteral("server"), QStringLiteral("Local socket server name."),
+                                          QStringLiteral("name"),
+                                          QString::fromLatin1(FramePublisher::DEFAULT_SERVER_NAME));
+    const QCommandLineOption outputOption(QStringLiteral("output"),
+                                          QStringLiteral("Record frames to a simulation log (replayable in Orienta)."),
+                                          QStringLiteral("file"));
+    const QCommandLineOption deviceOption(QStringLiteral("device"),
+                                          QStringLiteral("Only record frames of this device id (0 = first seen)."),
+                                          QStringLiteral("id"), QStringLiteral("0"));
+    const QCommandLineOption slowOption(QStringLiteral("slow-ms"),
+                                        QStringLiteral("Sleep after every read to emulate a slow consumer."),
+                                        QStringLiteral("ms"), QStringLiteral("0"));
+    const QCommandLineOption durationOption(QStringLiteral("duration"),
+                                            QStringLiteral("Run time in seconds (0 = until interrupted)."),
+                                            QStringLiteral("seconds"), QStringLiteral("0"));
+    parser.addOptions({serverOption, outputOption, deviceOption, slowOption, durationOption});
+    parser.process(app);
+
+    const int slowMs = qMax(0, parser.value(slowOption).toInt());
+    const qint64 durationMs = static_cast<qint64>(qMax(0.0, parser.value(durationOption).toDouble()) * 1000.0);
+    int recordedDevice = parser.value(deviceOption).toInt();
+
+    FrameRecorder recorder;
+    if (parser.isSet(outputOption) && !recorder.open(parser.value(outputOption))) {
+        qCritical() << "Failed to open recording file" << parser.value(outputOption) << ":" << recorder.errorString();
+        return 1;
+    }
+
+    QLocalSocket socket;
+    socket.connectToServer(parser.value(serverOption), QIODevice::ReadOnly);
+    if (!socket.waitForConnected(CONNECT_TIMEOUT_MS_FS)) {
+        qCritical() << "Cannot connect to" << parser.value(serverOption) << ":" << socket.errorString();
+        return 1;
+    }
+
+    std::signal(SIGINT, handleStopSignal);
+    std::signal(SIGTERM, handleStopSignal);
+
+    QTextStream err(stderr);
+    QByteArray buffer;
+    qsizetype readOffset = 0;
+    bool greeted = false;
+    SensorFrame frame;
+    SubscriberStats stats;
+    SubscriberStats lastReport;
+    QElapsedTimer runTimer;
+    runTimer.start();
+    qint64 nextReportMs = REPORT_INTERVAL_MS_FS;
+
+    while (!stopRequested && (durationMs == 0 || runTimer.elapsed() < durationMs)) {
+        if (socket.state() != QLocalSocket::ConnectedState && socket.bytesAvailable() == 0) {
+            err << "Server closed the connection.\n";
+            break;
+        }
+        if (socket.bytesAvailable() == 0 && !socket.waitForReadyRead(READ_TIMEOUT_MS_FS)) {
+            if (socket.state() != QLocalSocket::ConnectedState) {
+                err << "Server closed the connection.\n";
+                break;
+            }
+        }
+        const QByteArray chunk = socket.readAll();
+        stats.bytes += static_cast<quint64>(chunk.size());
+        buffer.append(chunk);
+
+        if (!greeted && buffer.size() >= FrameWireFormat::GREETING_BYTES) {
+            if (!FrameWireFormat::checkGreeting(buffer)) {
+                qCritical() << "Unsupported stream format from" << socket.fullServerName();
+                return 1;
+            }
+            greeted = true;
+            readOffset = FrameWireFormat::GREETING_BYTES;
+        }
+        while (greeted) {
+            FrameWireFormat::RecordType type;
+            quint32 droppedFrames = 0;
+            qsizetype recordBytes = 0;
+            const FrameWireFormat::DecodeStatus status = FrameWireFormat::decodeRecord(
+                buffer.constData() + readOffset, buffer.size() - readOffset, type, frame, droppedFrames, recordBytes);
+            if (status == FrameWireFormat::DecodeStatus::Incomplete) {
+                break;
+            }
+            if (status == FrameWireFormat::DecodeStatus::Invalid) {
+                qCritical() << "Corrupted record in frame stream - disconnecting.";
+                return 1;
+            }
+            readOffset += recordBytes;
+            if (type == FrameWireFormat::RecordType::Overflow) {
+                stats.dropped += droppedFrames;
+                if (recorder.isOpen()) {
+                    recorder.writeGap(static_cast<int>(qMin<quint32>(droppedFrames, INT_MAX)));
+                }
+                continue;
+            }
+            ++stats.frames;
+            // Ten sam zegar co LatencyTracer::nowNs() (steady_clock) - czasy są porównywalne między procesami
+            const qint64 nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+            stats.lastLatencyUs = (nowNs - frame.hostTimestampNs) / 1000;
+            if (recordedDevice == 0) {
+                recordedDevice = frame.deviceId;
+            }
+            if (recorder.isOpen() && frame.deviceId == recordedDevice) {
+                if (frame.lostFramesBefore > 0) {
+                    recorder.writeGap(frame.lostFramesBefore);
+                }
+                recorder.write(frame);
+                ++stats.recorded;
+            }
+        }
+        if (readOffset > 0 && readOffset == buffer.size()) {
+            buffer.clear(); // Wszystko zdekodowane - bez przesuwania danych
+            readOffset = 0;
+        } else if (readOffset > buffer.size() / 2) {
+            buffer.remove(0, readOffset);
+            readOffset = 0;
+        }
+
+        if (runTimer.elapsed() >= nextReportMs) {
+            err << QStringLiteral("frames/s %1  bytes/s %2  recorded %3  dropped by server %4  latency %5 us\n")
+                    .arg(stats.frames - lastReport.frames)
+                    .arg(stats.bytes - lastReport.bytes)
+                    .arg(stats.recorded - lastReport.recorded)
+                    .arg(stats.dropped - lastReport.dropped)
+                    .arg(stats.lastLatencyUs);
+            err.flush();
+            lastReport = stats;
+            nextReportMs += REPORT_INTERVAL_MS_FS;
+        }
+        if (slowMs > 0) {
+            QThread::msleep(static_cast<unsigned long>(slowMs));
+        }
+    }
+
+    err << "Total frames: " << stats.frames << ", recorded: " << stats.recorded
+        << ", dropped by server: " << stats.dropped << "\n";
+    err.flush();
+    recorder.close();
+    return 0;
+}
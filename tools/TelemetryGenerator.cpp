@@ -0,0 +1,489 @@
+/**
+ * @file TelemetryGenerator.cpp
+ * @brief Generator syntetycznej telemetrii na pseudoterminalu lub w sieci (target `wds_Orienta_telemetry_gen`).
+ * @details Otwiera parę PTY (`openpty`) i zapisuje do strony master ramki w formacie
+ * `CSV_PAYLOAD*CRC16_HEX\r\n` oczekiwanym przez `SerialPortHandler` (12 wartości IMU + 2 GPS).
+ * Aplikacja łączy się ze stroną slave jak ze zwykłym portem szeregowym, co pozwala na testy
+ * przepustowości, opóźnień i testy długotrwałe bez sprzętu.
+ *
+ * Z opcją `--udp host:port` każda ramka jest wysyłana jako osobny datagram, a z `--tcp-listen port`
+ * generator udostępnia strumień TCP (jak głowica sensora przez Wi-Fi) - aplikacja odbiera je
+ * przez `NetworkFrameSource` (*Settings › Add Network Device...*).
+ *
+ * Możliwości:
+ * - stała częstotliwość ramek (np. 1-10 kHz), harmonogram oparty o zegar monotoniczny,
+ * - wstrzykiwanie uszkodzeń (zmieniony bajt ładunku lub sumy kontrolnej),
+ * - dzielenie linii na kilka zapisów (symulacja porcji `readyRead`),
+ * - paczki ramek wysyłane jednocześnie (burst),
+ * - opcjonalny 16-bitowy numer sekwencyjny ramki i pomijanie ramek (test wykrywania strat).
+ *
+ * Przykład:
+ * @code
+ * wds_Orienta_telemetry_gen --rate 5000 --corrupt 0.01 --split 0.2 --burst-every 1000 --burst-size 500 \
+ *     --link /tmp/ttyORIENTA
+ * wds_Orienta_telemetry_gen --rate 2000 --sequence --udp 127.0.0.1:5005
+ * wds_Orienta_telemetry_gen --rate 1000 --tcp-listen 5006
+ * @endcode
+ * @author Mateusz Wojtaszek
+ * @date 2025-05-31
+ * @bug Brak znanych błędów.
+ */
+
+#include "FrameParser.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFile>
+#include <QTextStream>
+#include <QDebug>
+
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstring>
+#include <random>
+#include <thread>
+
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <termios.h>
+#include <unistd.h>
+#if defined(Q_OS_MACOS)
+#include <util.h>
+#else
+#include <pty.h>
+#endif
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int IMU_VALUE_COUNT_TG = 12;
+constexpr double BASE_LATITUDE_TG = 51.1079; // Wrocław
+constexpr double BASE_LONGITUDE_TG = 17.0595;
+constexpr quint64 SEQUENCE_MODULUS_TG = 65536; // 16-bitowy licznik jak w SequenceTracker
+constexpr auto SCHEDULER_TICK_TG = std::chrono::microseconds(500); // Ramki należne w ticku wysyłane razem
+
+static volatile std::sig_atomic_t stopRequested = 0;
+
+static void handleStopSignal(int) {
+    stopRequested = 1;
+}
+
+/**
+ * @brief Liczniki generatora raportowane co sekundę.
+ */
+struct GeneratorStats {
+    quint64 frames = 0; //!< Wysłane ramki.
+    quint64 bytes = 0; //!< Wysłane bajty.
+    quint64 corrupted = 0; //!< Ramki z celowo uszkodzoną treścią.
+    quint64 split = 0; //!< Ramki wysłane w kilku zapisach.
+    quint64 dropped = 0; //!< Zapisy odrzucone, bo bufor PTY/gniazda był pełny lub brak odbiorcy.
+    quint64 skipped = 0; //!< Numery sekwencyjne celowo pominięte (symulacja utraty ramek).
+};
+
+/**
+ * @brief Źródło wartości IMU: wiersze plików symulacyjnych lub przebiegi sinusoidalne.
+ */
+class ImuSource {
+public:
+    explicit ImuSource(const QStringList &files) {
+        for (const QString &path: files) {
+            QFile file(path);
+            if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+                qWarning() << "Failed to open simulation data file:" << path;
+                continue;
+            }
+            while (!file.atEnd()) {
+                const QByteArray line = file.readLine().trimmed();
+                QVector<float> values;
+                if (!line.startsWith('#') &&
+                    FrameParser::parseCsv(line, IMU_VALUE_COUNT_TG, values) == FrameParser::Status::Ok) {
+                    m_rows.append(line);
+                }
+            }
+        }
+    }
+
+    /** @brief Zwraca 12 wartości IMU w postaci CSV dla ramki o numerze `index`. */
+    QByteArray row(quint64 index) const {
+        if (!m_rows.isEmpty()) {
+            return m_rows[static_cast<qsizetype>(index % static_cast<quint64>(m_rows.size()))];
+        }
+        // Przebiegi syntetyczne: wolny obrót wokół osi Z i grawitacja na osi Z
+        const double t = static_cast<double>(index) * 0.001;
+        const double yaw = std::fmod(t * 10.0, 360.0);
+        const double yawRad = yaw * M_PI / 180.0;
+        return QStringLiteral("%1,%2,%3,%4,%5,%6,%7,%8,%9,%10,%11,%12")
+                .arg(std::sin(t) * 5.0, 0, 'f', 2).arg(std::cos(t) * 5.0, 0, 'f', 2).arg(10.0, 0, 'f', 2)
+                .arg(std::sin(t * 3.0) * 50.0, 0, 'f', 2).arg(std::cos(t * 3.0) * 50.0, 0, 'f', 2).arg(1000.0, 0, 'f', 2)
+                .arg(std::cos(yawRad) * 250.0, 0, 'f', 2).arg(std::sin(yawRad) * 250.0, 0, 'f', 2).arg(-270.0, 0, 'f', 2)
+                .arg(std::sin(t) * 10.0, 0, 'f', 2).arg(std::cos(t) * 10.0, 0, 'f', 2).arg(yaw, 0, 'f', 2)
+                .toLatin1();
+    }
+
+    /** @brief Informuje, czy źródłem są pliki symulacyjne. */
+    bool usesFiles() const { return !m_rows.isEmpty(); }
+
+private:
+    QList<QByteArray> m_rows; //!< Wiersze CSV z plików symulacyjnych.
+};
+
+/**
+ * @brief Buduje kompletną ramkę `CSV*CRC16\r\n` (z opcjonalnym numerem sekwencyjnym i uszkodzeniem).
+ */
+static QByteArray buildFrame(const ImuSource &source, quint64 index, bool withSequence, bool corrupt,
+                             std::mt19937 &random) {
+    const double angle = static_cast<double>(index) * 1.0e-4;
+    QByteArray payload = source.row(index);
+    payload += ',' + QByteArray::number(BASE_LATITUDE_TG + 0.001 * std::sin(angle), 'f', 6);
+    payload += ',' + QByteArray::number(BASE_LONGITUDE_TG + 0.001 * std::cos(angle), 'f', 6);
+    if (withSequence) {
+        payload += ',' + QByteArray::number(index % SEQUENCE_MODULUS_TG);
+    }
+    const QByteArray crcHex = QByteArray::number(FrameParser::calculateCrc16(payload), 16).toUpper().rightJustified(4, '0');
+    QByteArray frame = payload + '*' + crcHex + "\r\n";
+    if (corrupt) {
+        // Zmiana jednego bajtu ładunku lub sumy kontrolnej (bez końca linii)
+        std::uniform_int_distribution<qsizetype> position(0, frame.size() - 3);
+        const qsizetype at = position(random);
+        frame[at] = static_cast<char>(frame[at] ^ 0x01);
+    }
+    return frame;
+}
+
+/**
+ * @brief Zapisuje dane do strony master (lub gniazda) bez blokowania.
+ * @return `true`, jeśli zapisano całość; `false`, jeśli bufor jest pełny lub odbiorca się rozłączył.
+ */
+static bool writeAll(int fd, const QByteArray &data) {
+    qsizetype written = 0;
+    while (written < data.size()) {
+        const ssize_t result = ::write(fd, data.constData() + written, static_cast<size_t>(data.size() - written));
+        if (result > 0) {
+            written += result;
+        } else if (result < 0 && errno == EINTR) {
+            continue;
+        } else if (result < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+            return false; // Odbiorca rozłączony (EPIPE, ECONNRESET) lub nieosiągalny (ECONNREFUSED)
+        } else if (written == 0) {
+            return false; // EAGAIN - nic nie zapisano, ramkę można pominąć w całości
+        } else {
+            // Częściowo zapisana ramka - dokończ, aby nie rozsynchronizować strumienia
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Otwiera nieblokujące gniazdo UDP połączone z `host:port` (każdy `write()` to jeden datagram).
+ * @return Deskryptor gniazda albo -1.
+ */
+static int openUdpSender(const QString &target) {
+    const qsizetype separator = target.lastIndexOf(':');
+    if (separator <= 0) {
+        qCritical() << "Invalid --udp target, expected host:port:" << target;
+        return -1;
+    }
+    const QByteArray host = target.left(separator).toLatin1();
+    const QByteArray port = target.mid(separator + 1).toLatin1();
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_DGRAM;
+    addrinfo *addresses = nullptr;
+    if (getaddrinfo(host.constData(), port.constData(), &hints, &addresses) != 0 || !addresses) {
+        qCritical() << "Cannot resolve --udp target" << target;
+        return -1;
+    }
+    int fd = -1;
+    for (const addrinfo *address = addresses; address && fd < 0; address = address->ai_next) {
+        fd = ::socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+        if (fd >= 0 && ::connect(fd, address->ai_addr, address->ai_addrlen) != 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+    freeaddrinfo(addresses);
+    if (fd < 0) {
+        qCritical() << "Failed to open UDP socket to" << target << ":" << strerror(errno);
+        return -1;
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    return fd;
+}
+
+/**
+ * @brief Otwiera nieblokujące gniazdo TCP nasłuchujące na wszystkich interfejsach.
+ * @return Deskryptor gniazda albo -1.
+ */
+static int openTcpListener(quint16 port) {
+    const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        qCritical() << "Failed to create TCP socket:" << strerror(errno);
+        return -1;
+    }
+    const int reuse = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(port);
+    if (::bind(fd, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0 || ::listen(fd, 1) != 0) {
+        qCritical() << "Failed to listen on TCP port" << port << ":" << strerror(errno);
+        ::close(fd);
+        return -1;
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    return fd;
+}
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("wds_Orienta_telemetry_gen");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        QStringLiteral("Writes CRC'd Orienta telemetry frames to a pseudo-terminal, UDP datagrams or a TCP stream."));
+    parser.addHelpOption();
+    const QCommandLineOption rateOption(QStringLiteral("rate"), QStringLiteral("Frames per second."),
+                                        QStringLiteral("hz"), QStringLiteral("1000"));
+    const QCommandLineOption durationOption(QStringLiteral("duration"),
+                                            QStringLiteral("Run time in seconds (0 = until interrupted)."),
+                                            QStringLiteral("seconds"), QStringLiteral("0"));
+    const QCommandLineOption corruptOption(QStringLiteral("corrupt"),
+                                           QStringLiteral("Probability of corrupting a frame (0-1)."),
+                                           QStringLiteral("probability"), QStringLiteral("0"));
+    const QCommandLineOption splitOption(QStringLiteral("split"),
+                                         QStringLiteral("Probability of splitting a frame across writes (0-1)."),
+                                         QStringLiteral("probability"), QStringLiteral("0"));
+    const QCommandLineOption burstEveryOption(QStringLiteral("burst-every"),
+                                              QStringLiteral("Send an extra burst every N milliseconds (0 = off)."),
+                                              QStringLiteral("ms"), QStringLiteral("0"));
+    const QCommandLineOption burstSizeOption(QStringLiteral("burst-size"),
+                                             QStringLiteral("Frames in each burst."),
+                                             QStringLiteral("frames"), QStringLiteral("100"));
+    const QCommandLineOption linkOption(QStringLiteral("link"),
+                                        QStringLiteral("Create a symlink to the slave device at this path."),
+                                        QStringLiteral("path"));
+    const QCommandLineOption dataOption(QStringLiteral("data"),
+                                        QStringLiteral("Simulation log used as IMU source (may be repeated)."),
+                                        QStringLiteral("file"));
+    const QCommandLineOption sequenceOption(QStringLiteral("sequence"),
+                                            QStringLiteral("Append a 16-bit frame sequence number to every frame."));
+    const QCommandLineOption dropOption(QStringLiteral("drop"),
+                                        QStringLiteral("Probability of skipping a sequence number (0-1, implies --sequence)."),
+                                        QStringLiteral("probability"), QStringLiteral("0"));
+    const QCommandLineOption seedOption(QStringLiteral("seed"), QStringLiteral("Random seed."),
+                                        QStringLiteral("seed"), QStringLiteral("1"));
+    const QCommandLineOption udpOption(QStringLiteral("udp"),
+                                       QStringLiteral("Send every frame as a UDP datagram to host:port instead of a PTY."),
+                                       QStringLiteral("host:port"));
+    const QCommandLineOption tcpListenOption(QStringLiteral("tcp-listen"),
+                                             QStringLiteral("Serve the frame stream to one TCP client on this port "
+                                                 "instead of a PTY."),
+                                             QStringLiteral("port"));
+    parser.addOptions({rateOption, durationOption, corruptOption, splitOption, burstEveryOption, burstSizeOption,
+                       linkOption, dataOption, sequenceOption, dropOption, seedOption, udpOption, tcpListenOption});
+    parser.process(app);
+
+    const double rateHz = qMax(1.0, parser.value(rateOption).toDouble());
+    const double durationS = qMax(0.0, parser.value(durationOption).toDouble());
+    const double corruptProbability = qBound(0.0, parser.value(corruptOption).toDouble(), 1.0);
+    const double splitProbability = qBound(0.0, parser.value(splitOption).toDouble(), 1.0);
+    const int burstEveryMs = qMax(0, parser.value(burstEveryOption).toInt());
+    const int burstSize = qMax(1, parser.value(burstSizeOption).toInt());
+    const double dropProbability = qBound(0.0, parser.value(dropOption).toDouble(), 1.0);
+    const bool withSequence = parser.isSet(sequenceOption) || dropProbability > 0.0;
+
+    QStringList dataFiles = parser.values(dataOption);
+    if (dataFiles.isEmpty()) {
+        const QDir sourceDir(QStringLiteral(ORIENTA_SOURCE_DIR));
+        for (const QString &fileName: sourceDir.entryList({QStringLiteral("simulation_data*.log")}, QDir::Files)) {
+            dataFiles << sourceDir.filePath(fileName);
+        }
+    }
+    const ImuSource source(dataFiles);
+
+    const bool datagramMode = parser.isSet(udpOption);
+    const bool tcpMode = !datagramMode && parser.isSet(tcpListenOption);
+    int masterFd = -1; // Strona master PTY, gniazdo UDP albo połączenie TCP (-1 - brak klienta)
+    int slaveFd = -1;
+    int listenFd = -1;
+    char slaveName[256] = {};
+    QString outputName;
+    const QString linkPath = parser.value(linkOption);
+    if (datagramMode) {
+        masterFd = openUdpSender(parser.value(udpOption));
+        if (masterFd < 0) {
+            return 1;
+        }
+        outputName = QStringLiteral("udp://") + parser.value(udpOption);
+    } else if (tcpMode) {
+        listenFd = openTcpListener(static_cast<quint16>(parser.value(tcpListenOption).toUInt()));
+        if (listenFd < 0) {
+            return 1;
+        }
+        outputName = QStringLiteral("tcp://0.0.0.0:") + parser.value(tcpListenOption);
+        std::signal(SIGPIPE, SIG_IGN); // Rozłączenie klienta zgłaszane przez EPIPE, a nie sygnał
+    } else {
+        if (openpty(&masterFd, &slaveFd, slaveName, nullptr, nullptr) != 0) {
+            qCritical() << "openpty failed:" << strerror(errno);
+            return 1;
+        }
+        // Surowy tryb - bez translacji końców linii i echa; strona slave pozostaje otwarta,
+        // aby zapis do master nie kończył się EIO przed podłączeniem aplikacji.
+        termios attributes{};
+        tcgetattr(slaveFd, &attributes);
+        cfmakeraw(&attributes);
+        tcsetattr(slaveFd, TCSANOW, &attributes);
+        fcntl(masterFd, F_SETFL, fcntl(masterFd, F_GETFL) | O_NONBLOCK);
+
+        if (!linkPath.isEmpty()) {
+            QFile::remove(linkPath);
+            if (!QFile::link(QString::fromLocal8Bit(slaveName), linkPath)) {
+                qWarning() << "Failed to create symlink" << linkPath;
+            }
+        }
+        outputName = QString::fromLocal8Bit(slaveName) +
+                     (linkPath.isEmpty() ? QString() : QStringLiteral(" (") + linkPath + ")");
+    }
+
+    std::signal(SIGINT, handleStopSignal);
+    std::signal(SIGTERM, handleStopSignal);
+
+    QTextStream err(stderr);
+    err << (datagramMode || tcpMode ? "Output: " : "Slave device: ") << outputName
+        << "\nRate: " << rateHz << " Hz, source: " << (source.usesFiles() ? "simulation logs" : "synthetic")
+        << "\n";
+    err.flush();
+
+    std::mt19937 random(parser.value(seedOption).toUInt());
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    GeneratorStats stats;
+    GeneratorStats lastReport;
+    quint64 frameIndex = 0;
+    const auto framePeriod = std::chrono::duration<double>(1.0 / rateHz);
+    const Clock::time_point start = Clock::now();
+    Clock::time_point nextReport = start + std::chrono::seconds(1);
+    Clock::time_point nextBurst = start + std::chrono::milliseconds(burstEveryMs);
+    quint64 scheduledFrames = 0;
+
+    auto sendFrame = [&](QByteArray &pending) {
+        if (withSequence) {
+            while (unit(random) < dropProbability) {
+                ++frameIndex; // Numer pominięty - odbiorca powinien zgłosić lukę
+                ++stats.skipped;
+            }
+        }
+        const bool corrupt = unit(random) < corruptProbability;
+        const QByteArray frame = buildFrame(source, frameIndex++, withSequence, corrupt, random);
+        stats.corrupted += corrupt;
+        if (datagramMode) {
+            // Jedna ramka na datagram - dzielenie linii nie dotyczy UDP
+            if (writeAll(masterFd, frame)) {
+                stats.bytes += frame.size();
+            } else {
+                ++stats.dropped;
+            }
+            ++stats.frames;
+            return;
+        }
+        if (unit(random) < splitProbability && frame.size() > 2) {
+            // Opróżnij zebrane ramki i wyślij bieżącą w dwóch zapisach z krótką przerwą
+            std::uniform_int_distribution<qsizetype> cut(1, frame.size() - 1);
+            const qsizetype at = cut(random);
+            pending += frame.left(at);
+            if (masterFd < 0 || !writeAll(masterFd, pending)) {
+                ++stats.dropped;
+                pending.clear();
+                return;
+            }
+            stats.bytes += pending.size();
+            pending = frame.mid(at);
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            ++stats.split;
+        } else {
+            pending += frame;
+        }
+        ++stats.frames;
+    };
+
+    while (!stopRequested) {
+        const Clock::time_point now = Clock::now();
+        const double elapsedS = std::chrono::duration<double>(now - start).count();
+        if (durationS > 0.0 && elapsedS >= durationS) {
+            break;
+        }
+
+        if (tcpMode && masterFd < 0) {
+            masterFd = ::accept(listenFd, nullptr, nullptr); // Nieblokujące - klient mógł jeszcze nie przyjść
+            if (masterFd >= 0) {
+                fcntl(masterFd, F_SETFL, fcntl(masterFd, F_GETFL) | O_NONBLOCK);
+                err << "TCP client connected\n";
+                err.flush();
+            }
+        }
+
+        // Wszystkie ramki należne do tej chwili wysyłane jednym zapisem
+        const auto dueFrames = static_cast<quint64>(elapsedS / framePeriod.count());
+        QByteArray pending;
+        while (scheduledFrames < dueFrames) {
+            sendFrame(pending);
+            ++scheduledFrames;
+        }
+        if (burstEveryMs > 0 && now >= nextBurst) {
+            for (int i = 0; i < burstSize; ++i) {
+                sendFrame(pending);
+            }
+            nextBurst += std::chrono::milliseconds(burstEveryMs);
+        }
+        if (!pending.isEmpty()) {
+            if (masterFd >= 0 && writeAll(masterFd, pending)) {
+                stats.bytes += pending.size();
+            } else {
+                ++stats.dropped;
+                if (tcpMode && masterFd >= 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+                    ::close(masterFd); // Klient rozłączony - czekaj na kolejnego
+                    masterFd = -1;
+                    err << "TCP client disconnected\n";
+                    err.flush();
+                }
+            }
+        }
+
+        if (now >= nextReport) {
+            err << QStringLiteral("frames/s %1  bytes/s %2  corrupted %3  split %4  dropped writes %5  skipped %6\n")
+                    .arg(stats.frames - lastReport.frames)
+                    .arg(stats.bytes - lastReport.bytes)
+                    .arg(stats.corrupted - lastReport.corrupted)
+                    .arg(stats.split - lastReport.split)
+                    .arg(stats.dropped - lastReport.dropped)
+                    .arg(stats.skipped - lastReport.skipped);
+            err.flush();
+            lastReport = stats;
+            nextReport += std::chrono::seconds(1);
+        }
+        std::this_thread::sleep_until(now + SCHEDULER_TICK_TG);
+    }
+
+    err << "Total frames: " << stats.frames << ", corrupted: " << stats.corrupted << ", split: " << stats.split
+        << ", dropped writes: " << stats.dropped << ", skipped sequence numbers: " << stats.skipped << "\n";
+    err.flush();
+    if (!linkPath.isEmpty() && slaveFd >= 0) {
+        QFile::remove(linkPath);
+    }
+    if (slaveFd >= 0) {
+        ::close(slaveFd);
+    }
+    if (masterFd >= 0) {
+        ::close(masterFd);
+    }
+    if (listenFd >= 0) {
+        ::close(listenFd);
+    }
+    return 0;
+}
@@ -1,6 +1,74 @@
 <?xml version="1.0" encoding="utf-8"?>
 <!DOCTYPE TS>
 <TS version="2.1" language="pl_PL">
+<context>
+    <name>AllanDeviationDialog</name>
+    <message>
+        <location filename="../src/AllanDeviationDialog.cpp" line="38"/>
+        <source>Allan Deviation - %1</source>
+        <translation>Odchylenie Allana - %1</translation>
+    </message>
+    <message>
+        <location filename="../src/AllanDeviationDialog.cpp" line="41"/>
+        <source>Gyroscope [dps]</source>
+        <translation>Żyroskop [dps]</translation>
+    </message>
+    <message>
+        <location filename="../src/AllanDeviationDialog.cpp" line="41"/>
+        <source>Accelerometer [mg]</source>
+        <translation>Akcelerometr [mg]</translation>
+    </message>
+    <message>
+        <location filename="../src/AllanDeviationDialog.cpp" line="41"/>
+        <source>Magnetometer [mG]</source>
+        <translation>Magnetometr [mG]</translation>
+    </message>
+    <message>
+        <location filename="../src/AllanDeviationDialog.cpp" line="46"/>
+        <source>%1 frames, tau0 = %2 ms</source>
+        <translation>%1 ramek, tau0 = %2 ms</translation>
+    </message>
+    <message>
+        <location filename="../src/AllanDeviationDialog.cpp" line="49"/>
+        <source>Sensor:</source>
+        <translation>Czujnik:</translation>
+    </message>
+    <message>
+        <location filename="../src/AllanDeviationDialog.cpp" line="55"/>
+        <source>Export CSV...</source>
+        <translation>Eksportuj CSV...</translation>
+    </message>
+    <message>
+        <location filename="../src/AllanDeviationDialog.cpp" line="78"/>
+        <source>Averaging time τ [s]</source>
+        <translation>Czas uśredniania τ [s]</translation>
+    </message>
+    <message>
+        <location filename="../src/AllanDeviationDialog.cpp" line="81"/>
+        <source>Allan deviation %1</source>
+        <translation>Odchylenie Allana %1</translation>
+    </message>
+    <message>
+        <location filename="../src/AllanDeviationDialog.cpp" line="114"/>
+        <source>Export Allan Deviation</source>
+        <translation>Eksport odchylenia Allana</translation>
+    </message>
+    <message>
+        <location filename="../src/AllanDeviationDialog.cpp" line="115"/>
+        <source>CSV files (*.csv)</source>
+        <translation>Pliki CSV (*.csv)</translation>
+    </message>
+    <message>
+        <location filename="../src/AllanDeviationDialog.cpp" line="121"/>
+        <source>Allan Deviation</source>
+        <translation>Odchylenie Allana</translation>
+    </message>
+    <message>
+        <location filename="../src/AllanDeviationDialog.cpp" line="121"/>
+        <source>Failed to write CSV file: %1</source>
+        <translation>Nie udało się zapisać pliku CSV: %1</translation>
+    </message>
+</context>
 <context>
     <name>DemoWindow</name>
     <message>
@@ -15,8 +83,178 @@
         <translation>Symuluj obrót</translation>
     </message>
 </context>
+<context>
+    <name>EventTimelineView</name>
+    <message>
+        <location filename="../src/EventTimelineView.cpp" line="167"/>
+        <source>Acceleration threshold</source>
+        <translation>Próg przyspieszenia</translation>
+    </message>
+    <message>
+        <location filename="../src/EventTimelineView.cpp" line="167"/>
+        <source>Acceleration derivative</source>
+        <translation>Pochodna przyspieszenia</translation>
+    </message>
+    <message>
+        <location filename="../src/EventTimelineView.cpp" line="167"/>
+        <source>Rotation energy</source>
+        <translation>Energia obrotu</translation>
+    </message>
+    <message>
+        <location filename="../src/EventTimelineView.cpp" line="170"/>
+        <source>Click to replay the recording from this event</source>
+        <translation>Kliknij, aby odtworzyć nagranie od tego zdarzenia</translation>
+    </message>
+    <message>
+        <location filename="../src/EventTimelineView.cpp" line="171"/>
+        <source>Live event - cannot be replayed</source>
+        <translation>Zdarzenie na żywo - nie można go odtworzyć</translation>
+    </message>
+    <message>
+        <location filename="../src/EventTimelineView.cpp" line="224"/>
+        <source>Start above</source>
+        <translation>Początek powyżej</translation>
+    </message>
+    <message>
+        <location filename="../src/EventTimelineView.cpp" line="225"/>
+        <source>End below</source>
+        <translation>Koniec poniżej</translation>
+    </message>
+    <message>
+        <location filename="../src/EventTimelineView.cpp" line="226"/>
+        <source>Acceleration threshold (|a| - 1 g)</source>
+        <translation>Próg przyspieszenia (|a| - 1 g)</translation>
+    </message>
+    <message>
+        <location filename="../src/EventTimelineView.cpp" line="227"/>
+        <source>Acceleration derivative (jerk)</source>
+        <translation>Pochodna przyspieszenia (szarpnięcie)</translation>
+    </message>
+    <message>
+        <location filename="../src/EventTimelineView.cpp" line="228"/>
+        <source>Rotation energy (RMS |ω|)</source>
+        <translation>Energia obrotu (RMS |ω|)</translation>
+    </message>
+    <message>
+        <location filename="../src/EventTimelineView.cpp" line="229"/>
+        <source>Clear</source>
+        <translation>Wyczyść</translation>
+    </message>
+    <message>
+        <location filename="../src/EventTimelineView.cpp" line="230"/>
+        <source>Time</source>
+        <translation>Czas</translation>
+    </message>
+    <message>
+        <location filename="../src/EventTimelineView.cpp" line="230"/>
+        <source>Detector</source>
+        <translation>Detektor</translation>
+    </message>
+    <message>
+        <location filename="../src/EventTimelineView.cpp" line="230"/>
+        <source>Peak</source>
+        <translation>Szczyt</translation>
+    </message>
+    <message>
+        <location filename="../src/EventTimelineView.cpp" line="230"/>
+        <source>Duration [ms]</source>
+        <translation>Czas trwania [ms]</translation>
+    </message>
+    <message numerus="yes">
+        <location filename="../src/EventTimelineView.cpp" line="220"/>
+        <source>%n event(s)</source>
+        <translation>
+            <numerusform>%n zdarzenie</numerusform>
+            <numerusform>%n zdarzenia</numerusform>
+            <numerusform>%n zdarzeń</numerusform>
+        </translation>
+    </message>
+</context>
+<context>
+    <name>FilterSettingsDialog</name>
+    <message>
+        <location filename="../src/FilterSettingsDialog.cpp" line="40"/>
+        <source>High-pass</source>
+        <translation>Górnoprzepustowy</translation>
+    </message>
+    <message>
+        <location filename="../src/FilterSettingsDialog.cpp" line="42"/>
+        <source>Notch</source>
+        <translation>Zaporowy (notch)</translation>
+    </message>
+    <message>
+        <location filename="../src/FilterSettingsDialog.cpp" line="45"/>
+        <source>Low-pass</source>
+        <translation>Dolnoprzepustowy</translation>
+    </message>
+    <message>
+        <location filename="../src/FilterSettingsDialog.cpp" line="47"/>
+        <source>Moving average</source>
+        <translation>Średnia ruchoma</translation>
+    </message>
+    <message>
+        <location filename="../src/FilterSettingsDialog.cpp" line="49"/>
+        <source>Show raw traces on charts</source>
+        <translation>Pokaż przebiegi surowe na wykresach</translation>
+    </message>
+    <message>
+        <location filename="../src/FilterSettingsDialog.cpp" line="50"/>
+        <source>Sensor Filters</source>
+        <translation>Filtry czujników</translation>
+    </message>
+    <message>
+        <location filename="../src/FilterSettingsDialog.cpp" line="61"/>
+        <source> samples</source>
+        <translation> próbek</translation>
+    </message>
+    <message>
+        <location filename="../src/FilterSettingsDialog.cpp" line="65"/>
+        <source>Sample rate:</source>
+        <translation>Częstotliwość próbkowania:</translation>
+    </message>
+</context>
 <context>
     <name>ImuDataHandler</name>
+    <message>
+        <location filename="../src/ImuDataHandler.cpp" line="376"/>
+        <source>Events</source>
+        <translation>Zdarzenia</translation>
+    </message>
+    <message>
+        <location filename="../src/ImuDataHandler.cpp" line="229"/>
+        <source>At rest</source>
+        <translation>Spoczynek</translation>
+    </message>
+    <message>
+        <location filename="../src/ImuDataHandler.cpp" line="229"/>
+        <source>Moving</source>
+        <translation>Ruch</translation>
+    </message>
+    <message>
+        <location filename="../src/ImuDataHandler.cpp" line="231"/>
+        <source>%1 - bias not estimated yet (keep the sensor still)</source>
+        <translation>%1 - bias jeszcze nie wyznaczony (pozostaw czujnik nieruchomo)</translation>
+    </message>
+    <message>
+        <location filename="../src/ImuDataHandler.cpp" line="234"/>
+        <source>%1 - bias removed: X %2, Y %3, Z %4 dps</source>
+        <translation>%1 - bias usunięty: X %2, Y %3, Z %4 dps</translation>
+    </message>
+    <message>
+        <location filename="../src/ImuDataHandler.cpp" line="235"/>
+        <source>%1 - bias (not removed): X %2, Y %3, Z %4 dps</source>
+        <translation>%1 - bias (nieusuwany): X %2, Y %3, Z %4 dps</translation>
+    </message>
+    <message>
+        <location filename="../src/ImuDataHandler.cpp" line="203"/>
+        <source>Calibrated - coverage %1%, fit error %2%</source>
+        <translation>Skalibrowano - pokrycie %1%, błąd dopasowania %2%</translation>
+    </message>
+    <message>
+        <location filename="../src/ImuDataHandler.cpp" line="205"/>
+        <source>Calibrating - rotate the sensor (%1%)</source>
+        <translation>Kalibracja - obracaj czujnikiem (%1%)</translation>
+    </message>
     <message>
         <location filename="../src/ImuDataHandler.cpp" line="202"/>
         <location filename="../src/ImuDataHandler.cpp" line="431"/>
@@ -29,6 +267,18 @@
         <source>Graph</source>
         <translation>Wykres</translation>
     </message>
+    <message>
+        <location filename="../src/ImuDataHandler.cpp" line="339"/>
+        <location filename="../src/ImuDataHandler.cpp" line="611"/>
+        <source>Spectrum</source>
+        <translation>Widmo</translation>
+    </message>
+    <message>
+        <location filename="../src/ImuDataHandler.cpp" line="355"/>
+        <location filename="../src/ImuDataHandler.cpp" line="634"/>
+        <source>Statistics</source>
+        <translation>Statystyki</translation>
+    </message>
     <message>
         <location filename="../src/ImuDataHandler.cpp" line="297"/>
         <location filename="../src/ImuDataHandler.cpp" line="438"/>
@@ -124,6 +374,241 @@
         <source>Select Serial Port</source>
         <translation>Wybierz port szeregowy</translation>
     </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="127"/>
+        <source>Add Serial Device...</source>
+        <translation>Dodaj urządzenie szeregowe...</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="127"/>
+        <source>Disconnect All Devices</source>
+        <translation>Rozłącz wszystkie urządzenia</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="127"/>
+        <source>Add Network Device...</source>
+        <translation>Dodaj urządzenie sieciowe...</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="127"/>
+        <source>Add Network Device</source>
+        <translation>Dodaj urządzenie sieciowe</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="127"/>
+        <source>Source address (udp://[address]:port or tcp://host:port):</source>
+        <translation>Adres źródła (udp://[adres]:port lub tcp://host:port):</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="127"/>
+        <source>Receiving telemetry from %1</source>
+        <translation>Odbiór telemetrii z %1</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="127"/>
+        <source>Network Source Error</source>
+        <translation>Błąd źródła sieciowego</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="127"/>
+        <source>Publish Frames (Local Socket)</source>
+        <translation>Publikuj ramki (gniazdo lokalne)</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="127"/>
+        <source>\nPublished on %1: %2 frames, %3 client(s), %4 dropped for slow clients</source>
+        <translation>\nPublikacja na %1: %2 ramek, klientów: %3, pominięte dla wolnych klientów: %4</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="127"/>
+        <source>Frame publishing stopped.</source>
+        <translation>Publikacja ramek zatrzymana.</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="127"/>
+        <source>Publishing frames on %1</source>
+        <translation>Publikacja ramek na %1</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="127"/>
+        <source>Frame Publishing</source>
+        <translation>Publikacja ramek</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="127"/>
+        <source>Failed to start the local frame server: %1</source>
+        <translation>Nie udało się uruchomić lokalnego serwera ramek: %1</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="127"/>
+        <source>Export Frames (Shared Memory)</source>
+        <translation>Eksportuj ramki (pamięć współdzielona)</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="127"/>
+        <source>Orientation Source</source>
+        <translation>Źródło orientacji</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="127"/>
+        <source>Device (Onboard Fusion)</source>
+        <translation>Urządzenie (fuzja w czujniku)</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="127"/>
+        <source>Host AHRS (Madgwick)</source>
+        <translation>AHRS w aplikacji (Madgwick)</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="127"/>
+        <source>Host AHRS (Mahony)</source>
+        <translation>AHRS w aplikacji (Mahony)</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="127"/>
+        <source>Orientation: angles computed by the device.</source>
+        <translation>Orientacja: kąty wyliczane przez urządzenie.</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="127"/>
+        <source>Orientation: host AHRS (%1 backend).</source>
+        <translation>Orientacja: AHRS w aplikacji (jądro %1).</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="127"/>
+        <source>Magnetic Declination...</source>
+        <translation>Deklinacja magnetyczna...</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="127"/>
+        <source>Magnetic Declination</source>
+        <translation>Deklinacja magnetyczna</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="127"/>
+        <source>Declination in degrees (east positive):</source>
+        <translation>Deklinacja w stopniach (dodatnia na wschód):</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="127"/>
+        <source>Compass shows true heading (declination %1°).</source>
+        <translation>Kompas pokazuje kurs geograficzny (deklinacja %1°).</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="127"/>
+        <source>Magnetometer Calibration</source>
+        <translation>Kalibracja magnetometru</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="127"/>
+        <source>Apply Correction</source>
+        <translation>Stosuj korekcję</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="127"/>
+        <source>Reset Calibration</source>
+        <translation>Resetuj kalibrację</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="127"/>
+        <source>Remove Gyro Bias</source>
+        <translation>Usuwaj bias żyroskopu</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="127"/>
+        <source>Filters...</source>
+        <translation>Filtry...</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="208"/>
+        <source>Allan Deviation...</source>
+        <translation>Odchylenie Allana...</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="1002"/>
+        <source>Allan Deviation</source>
+        <translation>Odchylenie Allana</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="1008"/>
+        <source>Analyzing %1...</source>
+        <translation>Analiza %1...</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="1008"/>
+        <source>Cancel</source>
+        <translation>Anuluj</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="1042"/>
+        <source>Analysis failed: %1</source>
+        <translation>Analiza nie powiodła się: %1</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="1060"/>
+        <source>Disconnect the devices to replay recorded events.</source>
+        <translation>Rozłącz urządzenia, aby odtworzyć zapisane zdarzenia.</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="1077"/>
+        <source>Replaying from %1 s before the event at %2 s.</source>
+        <translation>Odtwarzanie od %1 s przed zdarzeniem w chwili %2 s.</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="127"/>
+        <source>Sensor filters disabled.</source>
+        <translation>Filtry czujników wyłączone.</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="127"/>
+        <source>Sensor filters: %1 stage(s) at %2 Hz (%3 backend).</source>
+        <translation>Filtry czujników: %1 stopni przy %2 Hz (jądro %3).</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="127"/>
+        <source>Magnetometer calibration reset - rotate the sensor in all directions.</source>
+        <translation>Kalibracja magnetometru zresetowana - obracaj czujnikiem we wszystkich kierunkach.</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="127"/>
+        <source>\nShared memory %1: %2 frames written</source>
+        <translation>\nPamięć współdzielona %1: zapisano %2 ramek</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="127"/>
+        <source>Shared memory export stopped.</source>
+        <translation>Eksport do pamięci współdzielonej zatrzymany.</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="127"/>
+        <source>Exporting frames to shared memory %1</source>
+        <translation>Eksport ramek do pamięci współdzielonej %1</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="127"/>
+        <source>Shared Memory Export</source>
+        <translation>Eksport do pamięci współdzielonej</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="127"/>
+        <source>Failed to create the shared memory segment: %1</source>
+        <translation>Nie udało się utworzyć segmentu pamięci współdzielonej: %1</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="127"/>
+        <source>Failed to open %1. Reason: %2</source>
+        <translation>Nie udało się otworzyć %1. Powód: %2</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="127"/>
+        <source>IMU View Device</source>
+        <translation>Urządzenie widoku IMU</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="127"/>
+        <source>GPS View Device</source>
+        <translation>Urządzenie widoku GPS</translation>
+    </message>
     <message>
         <location filename="../src/MainWindow.cpp" line="142"/>
         <source>Language successfully changed to English.</source>
@@ -276,13 +761,28 @@
         <translation>Zmień liczbę próbek (na 200)</translation>
     </message>
 </context>
+<context>
+    <name>NetworkFrameSource</name>
+    <message>
+        <source>Invalid address &quot;%1&quot; - expected udp://[address]:port or tcp://host:port.</source>
+        <translation>Niepoprawny adres &quot;%1&quot; - oczekiwano udp://[adres]:port lub tcp://host:port.</translation>
+    </message>
+    <message>
+        <source>Connection to %1 timed out.</source>
+        <translation>Przekroczono czas oczekiwania na połączenie z %1.</translation>
+    </message>
+    <message>
+        <source>Socket not initialized.</source>
+        <translation>Gniazdo nie zostało zainicjalizowane.</translation>
+    </message>
+</context>
 <context>
     <name>SensorGraph</name>
     <message>
         <location filename="../src/SensorGraph.cpp" line="53"/>
         <location filename="../src/SensorGraph.cpp" line="166"/>
-        <source>Sample Index</source>
-        <translation>Indeks próbki</translation>
+        <source>Time [s]</source>
+        <translation>Czas [s]</translation>
     </message>
     <message>
         <location filename="../src/SensorGraph.cpp" line="59"/>
@@ -311,4 +811,160 @@
         <translation>Obiekt portu szeregowego nie został zainicjalizowany.</translation>
     </message>
 </context>
+<context>
+    <name>SpectrumView</name>
+    <message>
+        <location filename="../src/SpectrumView.cpp" line="121"/>
+        <source>Gyroscope X</source>
+        <translation>Żyroskop X</translation>
+    </message>
+    <message>
+        <location filename="../src/SpectrumView.cpp" line="122"/>
+        <source>Gyroscope Y</source>
+        <translation>Żyroskop Y</translation>
+    </message>
+    <message>
+        <location filename="../src/SpectrumView.cpp" line="123"/>
+        <source>Gyroscope Z</source>
+        <translation>Żyroskop Z</translation>
+    </message>
+    <message>
+        <location filename="../src/SpectrumView.cpp" line="124"/>
+        <source>Accelerometer X</source>
+        <translation>Akcelerometr X</translation>
+    </message>
+    <message>
+        <location filename="../src/SpectrumView.cpp" line="125"/>
+        <source>Accelerometer Y</source>
+        <translation>Akcelerometr Y</translation>
+    </message>
+    <message>
+        <location filename="../src/SpectrumView.cpp" line="126"/>
+        <source>Accelerometer Z</source>
+        <translation>Akcelerometr Z</translation>
+    </message>
+    <message>
+        <location filename="../src/SpectrumView.cpp" line="132"/>
+        <source>Channel:</source>
+        <translation>Kanał:</translation>
+    </message>
+    <message>
+        <location filename="../src/SpectrumView.cpp" line="133"/>
+        <source>FFT size:</source>
+        <translation>Długość FFT:</translation>
+    </message>
+    <message>
+        <location filename="../src/SpectrumView.cpp" line="134"/>
+        <source>Overlap:</source>
+        <translation>Nakładanie:</translation>
+    </message>
+    <message>
+        <location filename="../src/SpectrumView.cpp" line="227"/>
+        <source>Collecting samples...</source>
+        <translation>Zbieranie próbek...</translation>
+    </message>
+    <message>
+        <location filename="../src/SpectrumView.cpp" line="267"/>
+        <source>Time →</source>
+        <translation>Czas →</translation>
+    </message>
+</context>
+<context>
+    <name>StatisticsView</name>
+    <message>
+        <location filename="../src/StatisticsView.cpp" line="104"/>
+        <source>Window:</source>
+        <translation>Okno:</translation>
+    </message>
+    <message>
+        <location filename="../src/StatisticsView.cpp" line="105"/>
+        <source>Mean</source>
+        <translation>Średnia</translation>
+    </message>
+    <message>
+        <location filename="../src/StatisticsView.cpp" line="105"/>
+        <source>Std. dev.</source>
+        <translation>Odch. std.</translation>
+    </message>
+    <message>
+        <location filename="../src/StatisticsView.cpp" line="105"/>
+        <source>Min</source>
+        <translation>Min</translation>
+    </message>
+    <message>
+        <location filename="../src/StatisticsView.cpp" line="105"/>
+        <source>Max</source>
+        <translation>Maks</translation>
+    </message>
+    <message>
+        <location filename="../src/StatisticsView.cpp" line="105"/>
+        <source>RMS</source>
+        <translation>RMS</translation>
+    </message>
+    <message>
+        <location filename="../src/StatisticsView.cpp" line="107"/>
+        <source>Gyroscope X [dps]</source>
+        <translation>Żyroskop X [dps]</translation>
+    </message>
+    <message>
+        <location filename="../src/StatisticsView.cpp" line="107"/>
+        <source>Gyroscope Y [dps]</source>
+        <translation>Żyroskop Y [dps]</translation>
+    </message>
+    <message>
+        <location filename="../src/StatisticsView.cpp" line="107"/>
+        <source>Gyroscope Z [dps]</source>
+        <translation>Żyroskop Z [dps]</translation>
+    </message>
+    <message>
+        <location filename="../src/StatisticsView.cpp" line="108"/>
+        <source>Accelerometer X [mg]</source>
+        <translation>Akcelerometr X [mg]</translation>
+    </message>
+    <message>
+        <location filename="../src/StatisticsView.cpp" line="108"/>
+        <source>Accelerometer Y [mg]</source>
+        <translation>Akcelerometr Y [mg]</translation>
+    </message>
+    <message>
+        <location filename="../src/StatisticsView.cpp" line="108"/>
+        <source>Accelerometer Z [mg]</source>
+        <translation>Akcelerometr Z [mg]</translation>
+    </message>
+    <message>
+        <location filename="../src/StatisticsView.cpp" line="109"/>
+        <source>Magnetometer X [mG]</source>
+        <translation>Magnetometr X [mG]</translation>
+    </message>
+    <message>
+        <location filename="../src/StatisticsView.cpp" line="109"/>
+        <source>Magnetometer Y [mG]</source>
+        <translation>Magnetometr Y [mG]</translation>
+    </message>
+    <message>
+        <location filename="../src/StatisticsView.cpp" line="109"/>
+        <source>Magnetometer Z [mG]</source>
+        <translation>Magnetometr Z [mG]</translation>
+    </message>
+    <message>
+        <location filename="../src/StatisticsView.cpp" line="110"/>
+        <source>Roll [°]</source>
+        <translation>Przechylenie [°]</translation>
+    </message>
+    <message>
+        <location filename="../src/StatisticsView.cpp" line="110"/>
+        <source>Pitch [°]</source>
+        <translation>Pochylenie [°]</translation>
+    </message>
+    <message>
+        <location filename="../src/StatisticsView.cpp" line="110"/>
+        <source>Yaw [°]</source>
+        <translation>Odchylenie [°]</translation>
+    </message>
+    <message>
+        <location filename="../src/StatisticsView.cpp" line="99"/>
+        <source>%1 samples over %2 s</source>
+        <translation>%1 próbek w %2 s</translation>
+    </message>
+</context>
 </TS>